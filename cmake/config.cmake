@@ -102,7 +102,7 @@ set(OMR_GC_MINIMUM_OBJECT_SIZE ON CACHE BOOL "TODO: Document")
 set(OMR_GC_MODRON_STANDARD ON CACHE BOOL "TODO: Document")
 set(OMR_GC_NON_ZERO_TLH ON CACHE BOOL "TODO: Document")
 set(OMR_GC_THREAD_LOCAL_HEAP ON CACHE BOOL "TODO: Document")
-set(OMR_GC_COMPRESSED_POINTERS OFF CACHE BOOL "TODO: Document")
+set(OMR_GC_COMPRESSED_POINTERS OFF CACHE BOOL "Store object references as 32-bit shifted offsets (64-bit only)")
 set(OMR_GC_TLH_PREFETCH_FTA OFF CACHE BOOL "TODO: Document")
 set(OMR_GC_OBJECT_MAP OFF CACHE BOOL "TODO: Document")
 set(OMR_GC_DYNAMIC_CLASS_UNLOADING OFF CACHE BOOL "TODO: Document")
@@ -121,7 +121,8 @@ set(OMR_GC_STACCATO OFF CACHE BOOL "TODO: Document")
 set(OMR_GC_VLHGC OFF CACHE BOOL "TODO: Document")
 
 set(OMR_INTERP_HAS_SEMAPHORES ON CACHE BOOL "TODO: Document")
-set(OMR_INTERP_COMPRESSED_OBJECT_HEADER OFF CACHE BOOL "TODO: Document")
+# The object header is compressed along with references unless explicitly overridden
+set(OMR_INTERP_COMPRESSED_OBJECT_HEADER ${OMR_GC_COMPRESSED_POINTERS} CACHE BOOL "Use a 32-bit object header (requires OMR_GC_COMPRESSED_POINTERS)")
 set(OMR_INTERP_SMALL_MONITOR_SLOT OFF CACHE BOOL "TODO: Document")
 
 set(OMR_THR_ADAPTIVE_SPIN ON CACHE BOOL "TODO: Document")
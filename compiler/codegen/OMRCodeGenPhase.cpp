@@ -71,6 +71,7 @@
 #include "optimizer/StructuralAnalysis.hpp"
 #include "ras/Debug.hpp"                              // for TR_DebugBase, etc
 #include "runtime/Runtime.hpp"                        // for setDllSlip
+#include "env/CompilePhaseProfiler.hpp"
 #include "env/RegionProfiler.hpp"
 
 #include <map>
@@ -130,6 +131,7 @@ OMR::CodeGenPhase::performAll()
       PhaseValue phaseToDo = PhaseList[i];
       TR::RegionProfiler rp(_cg->comp()->trMemory()->heapMemoryRegion(), *_cg->comp(), "codegen/%s/%s",
          _cg->comp()->getHotnessName(_cg->comp()->getMethodHotness()), self()->getName(phaseToDo));
+      TR::CompilePhaseProfiler pp(*_cg->comp(), TR::CompilePhaseProfile::CodeGenPhase, phaseToDo, self()->getName(phaseToDo));
       _phaseToFunctionTable[phaseToDo](_cg, self());
       }
    }
@@ -100,6 +100,7 @@
 #include "ras/IlVerifier.hpp"                  // for TR::IlVerifier
 #include "control/Recompilation.hpp"           // for TR_Recompilation, etc
 #include "runtime/CodeCacheExceptions.hpp"
+#include "runtime/PersistentMethodCache.hpp"    // for TR::PersistentMethodCache
 #include "ilgen/IlGen.hpp"                     // for TR_IlGenerator
 #include "env/RegionProfiler.hpp"              // for TR::RegionProfiler
 // this ratio defines how full the alias memory region is allowed to become before
@@ -1009,7 +1010,14 @@ int32_t OMR::Compilation::compile()
    LexicalTimer t("compile", self()->signature(), self()->phaseTimer());
    TR::LexicalMemProfiler mp("compile", self()->signature(), self()->phaseMemProfiler());
 
-   if (_ilGenSuccess)
+   // A body compiled from identical IL in an earlier run makes optimization and codegen unnecessary
+   TR::PersistentMethodCache *methodCache = TR::PersistentMethodCache::instance();
+   TR::PersistentMethodCache::Key methodCacheKey;
+   bool loadedFromMethodCache = false;
+   if (_ilGenSuccess && methodCache)
+      loadedFromMethodCache = methodCache->load(self(), methodCacheKey);
+
+   if (_ilGenSuccess && !loadedFromMethodCache)
       {
       _methodSymbol->detectInternalCycles(_methodSymbol->getFlowGraph(), self());
 
@@ -1106,6 +1114,9 @@ int32_t OMR::Compilation::compile()
       if (_recompilationInfo)
          _recompilationInfo->endOfCompilation();
 
+      if (methodCache)
+         methodCache->store(self(), methodCacheKey);
+
 #ifdef J9_PROJECT_SPECIFIC
       if (self()->getOptions()->getVerboseOption(TR_VerboseInlining))
          {
@@ -1650,6 +1661,11 @@ OMR::Compilation::createDummyGuard(TR::Compilation * comp, int16_t calleeIndex,
    }
 
 
+bool OMR::Compilation::needsStaticRelocations()
+   {
+   return self()->getOption(TR_EmitRelocatableELFFile) || NULL != TR::PersistentMethodCache::instance();
+   }
+
 bool OMR::Compilation::generateArraylets()
    {
    if (TR::Compiler->om.canGenerateArraylets())
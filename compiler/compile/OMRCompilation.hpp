@@ -672,6 +672,13 @@ public:
 
    void setIlVerifier(TR::IlVerifier *ilVerifier) { _ilVerifier = ilVerifier; }
 
+   /**
+    * @brief Whether absolute addresses of call targets must be described by
+    * TR::StaticRelocations, because the code will be written to a relocatable
+    * object file or to the persistent method cache
+    */
+   bool needsStaticRelocations();
+
    typedef std::pair<const void * const, TR::DebugCounterBase *> DebugCounterEntry;
    typedef TR::typed_allocator<DebugCounterEntry, TR::Allocator> DebugCounterMapAllocator;
    typedef std::map<const void *, TR::DebugCounterBase *, std::less<const void *>, DebugCounterMapAllocator> DebugCounterMap;
@@ -45,6 +45,7 @@
 #include "env/IO.hpp"                          // for IO
 #include "env/JitConfig.hpp"
 #include "env/PersistentInfo.hpp"              // for PersistentInfo
+#include "env/CompilePhaseProfiler.hpp"        // for CompilePhaseProfile
 #include "env/Processors.hpp"
 #include "env/TRMemory.hpp"                    // for TR_Memory, etc
 #include "env/defines.h"                       // for TR_HOST_64BIT, etc
@@ -57,6 +58,7 @@
 #include "env/SystemSegmentProvider.hpp"
 #include "env/DebugSegmentProvider.hpp"
 #include "runtime/CodeCacheManager.hpp"
+#include "runtime/PersistentMethodCache.hpp"
 
 #if defined (_MSC_VER) && _MSC_VER < 1900
 #define snprintf _snprintf
@@ -148,6 +150,8 @@ int32_t commonJitInit(OMR::FrontEnd &fe, char *cmdLineOptions)
    TR::Options::setCanJITCompile(true);
    TR::Options::getCmdLineOptions()->setOption(TR_NoRecompile);
    TR::CompilationController::init(NULL);
+   TR::CompilePhaseProfile::initialize();
+   TR::PersistentMethodCache::initialize();
 
    void *pseudoTOC = NULL;
 #if defined(TR_TARGET_POWER)
@@ -273,9 +277,6 @@ compileMethodFromDetails(
       TR_Hotness hotness,
       int32_t &rc)
    {
-   uint64_t translationStartTime = TR::Compiler->vm.getUSecClock();
-   OMR::FrontEnd &fe = OMR::FrontEnd::singleton();
-   auto jitConfig = fe.jitConfig();
    TR::RawAllocator rawAllocator;
    TR::SystemSegmentProvider defaultSegmentProvider(1 << 16, rawAllocator);
    TR::DebugSegmentProvider debugSegmentProvider(1 << 16, rawAllocator);
@@ -283,6 +284,22 @@ compileMethodFromDetails(
       TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging) ?
          static_cast<TR::SegmentAllocator &>(debugSegmentProvider) :
          static_cast<TR::SegmentAllocator &>(defaultSegmentProvider);
+   return compileMethodFromDetails(omrVMThread, details, hotness, rc, scratchSegmentProvider);
+   }
+
+uint8_t *
+compileMethodFromDetails(
+      OMR_VMThread *omrVMThread,
+      TR::IlGeneratorMethodDetails & details,
+      TR_Hotness hotness,
+      int32_t &rc,
+      TR::SegmentProvider &scratchSegmentProvider,
+      uint8_t **codeMemory)
+   {
+   uint64_t translationStartTime = TR::Compiler->vm.getUSecClock();
+   OMR::FrontEnd &fe = OMR::FrontEnd::singleton();
+   auto jitConfig = fe.jitConfig();
+   TR::RawAllocator rawAllocator;
    TR::Region dispatchRegion(scratchSegmentProvider, rawAllocator);
    TR_Memory trMemory(*fe.persistentMemory(), dispatchRegion);
    TR_ResolvedMethod & compilee = *((TR_ResolvedMethod *)details.getMethod());
@@ -291,6 +308,8 @@ compileMethodFromDetails(
 
    // initialize return code before compilation starts
    rc = COMPILATION_REQUESTED;
+   if (NULL != codeMemory)
+      *codeMemory = NULL;
 
    uint8_t *startPC = 0;
 
@@ -379,6 +398,8 @@ compileMethodFromDetails(
          //OMR::MethodMetaDataPOD *metaData = fe.createMethodMetaData(&compiler);
 
          startPC = compiler.cg()->getCodeStart();
+         if (NULL != codeMemory)
+            *codeMemory = compiler.cg()->getBinaryBufferStart();
          uint64_t translationTime = TR::Compiler->vm.getUSecClock() - translationStartTime;
 
          if (TR::Options::isAnyVerboseOptionSet(TR_VerboseCompileEnd, TR_VerbosePerformance))
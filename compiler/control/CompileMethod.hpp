@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2016 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -27,8 +27,21 @@ struct OMR_VMThread;
 class TR_ResolvedMethod;
 namespace TR { class IlGeneratorMethodDetails; }
 namespace TR { class JitConfig; }
+namespace TR { class SegmentProvider; }
 
 int32_t init_options(TR::JitConfig *jitConfig, char * cmdLineOptions);
 int32_t commonJitInit(OMR::FrontEnd &fe, char * cmdLineOptions);
 uint8_t *compileMethod(OMR_VMThread *omrVMThread, TR_ResolvedMethod &compilee, TR_Hotness hotness, int32_t &rc);
 uint8_t *compileMethodFromDetails(OMR_VMThread *omrVMThread, TR::IlGeneratorMethodDetails &details, TR_Hotness hotness, int32_t &rc);
+
+/**
+ * @brief Compile using scratch memory drawn from the given segment provider
+ * rather than from a provider created for this compilation alone.  Callers
+ * that compile repeatedly can pass a long lived TR::SegmentPool to keep the
+ * scratch segments warm between compilations.
+ *
+ * If codeMemory is not NULL it receives the code cache allocation holding the
+ * compiled body, which the caller may hand back with
+ * TR::CodeCacheManager::freeCodeMemory() if the body is never used.
+ */
+uint8_t *compileMethodFromDetails(OMR_VMThread *omrVMThread, TR::IlGeneratorMethodDetails &details, TR_Hotness hotness, int32_t &rc, TR::SegmentProvider &scratchSegmentProvider, uint8_t **codeMemory = NULL);
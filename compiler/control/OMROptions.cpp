@@ -36,6 +36,8 @@
 #include "control/OptimizationPlan.hpp"  // for TR_OptimizationPlan
 #include "control/Recompilation.hpp"     // for TR_PersistentJittedBodyInfo, etc
 #include "env/CompilerEnv.hpp"
+#include "env/PersistentAllocator.hpp"  // for PersistentAllocator
+#include "env/TRMemory.hpp"              // for TR_MemoryBase
 #include "env/IO.hpp"                    // for IO
 #include "env/ObjectModel.hpp"           // for ObjectModel
 #include "env/Processors.hpp"            // for TR_Processor, etc
@@ -94,6 +96,8 @@ using namespace OMR;
 
 static char * EXCLUDED_METHOD_OPTIONS_PREFIX = "ifExcluded";
 
+extern const char * objectName[];
+
 // The following options must be placed in alphabetical order for them to work properly
 TR::OptionTable OMR::Options::_jitOptions[] = {
 
@@ -766,6 +770,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableVirtualPersistentMemory",      "M\tenable persistent memory to be allocated using virtual memory allocators",
                                           SET_OPTION_BIT(TR_EnableVirtualPersistentMemory), "F", NOT_IN_SUBSET},
    {"enableVpicForResolvedVirtualCalls",  "O\tenable PIC for resolved virtual calls",         SET_OPTION_BIT(TR_EnableVPICForResolvedVirtualCalls), "F"},
+   {"enableWorklistDataFlowSolver",       "O\tsolve bit vector dataflow analyses with a block worklist in reverse postorder",
+                                          SET_OPTION_BIT(TR_EnableWorklistDataFlowSolver), "F"},
    {"enableYieldVMAccess",                "O\tenable yielding of VM access when GC is waiting", SET_OPTION_BIT(TR_EnableYieldVMAccess), "F"},
    {"enableZEpilogue",                  "O\tenable 64-bit 390 load-multiple breakdown.", SET_OPTION_BIT(TR_Enable39064Epilogue), "F"},
    {"enumerateAddresses=", "D\tselect kinds of addresses to be replaced by unique identifiers in trace file", TR::Options::setAddressEnumerationBits, offsetof(OMR::Options, _addressToEnumerate), 0, "F"},
@@ -954,6 +960,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
         SET_OPTION_BIT(TR_LexicalMemProfiler), "F"},
    {"memUsage=",               "D\tgather lexical memory profiling statistics of the list of memory types: stack, heap or persistent",
         TR::Options::setRegex, offsetof(OMR::Options, _memUsage), 0, "P"},
+   {"methodCacheFile=", "L<filename>\treuse compiled methods across runs through the method cache in filename", TR::Options::setString, offsetof(OMR::Options,_methodCacheFileName), 0, "P%s", NOT_IN_SUBSET},
    {"methodOverrideRatSize=", "M<nnn>\tsize of runtime assumption table for method override ops",
                                TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_methodOverrideRatSize, 0, "F%d", NOT_IN_SUBSET},
    {"milcount=",           "O<nnn>\tnumber of invocations before compiling methods with many iterations loops",
@@ -1018,12 +1025,16 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"paranoidOptCheck",   "O\tcheck the trees and cfgs after every optimization phase", SET_OPTION_BIT(TR_EnableParanoidOptCheck), "F"},
    {"performLookaheadAtWarmCold", "O\tallow lookahead to be performed at cold and warm", SET_OPTION_BIT(TR_PerformLookaheadAtWarmCold), "F"},
    {"perfTool", "M\tenable PerfTool", SET_OPTION_BIT(TR_PerfTool), "F", NOT_IN_SUBSET },
+   {"persistentMemoryLimit=", "M<category>:<nnn>\tcap the persistent memory in use for an allocation category, in KB",
+        TR::Options::setPersistentMemoryLimit, 0, 0, "F", NOT_IN_SUBSET},
    {"poisonDeadSlots",    "O\tpaints all dead slots with deadf00d", SET_OPTION_BIT(TR_PoisonDeadSlots), "F"},
    {"prepareForOSREvenIfThatDoesNothing",   "O\temit the call to prepareForOSR even if there is no slot sharing", SET_OPTION_BIT(TR_EnablePrepareForOSREvenIfThatDoesNothing), "F"},
    {"printAbsoluteTimestampInVerboseLog", "O\tPrint Absolute Timestamp in vlog", SET_OPTION_BIT(TR_PrintAbsoluteTimestampInVerboseLog), "F", NOT_IN_SUBSET},
    {"printErrorInfoOnCompFailure",        "O\tPrint compilation error info to stderr", SET_OPTION_BIT(TR_PrintErrorInfoOnCompFailure), "F", NOT_IN_SUBSET},
    {"privatizeOverlaps",  "O\tif BCD storageRefs are going to overlap then do the move through a temp", SET_OPTION_BIT(TR_PrivatizeOverlaps), "F"},
    {"profile",            "O\tcompile a profiling method body", SET_OPTION_BIT(TR_Profile), "F"},
+   {"profileCompilePhases", "I\tcollect compile time and scratch memory per optimization and codegen phase, reported at JIT shutdown", SET_OPTION_BIT(TR_ProfileCompilePhases), "F", NOT_IN_SUBSET },
+   {"profileCompilePhasesFile=", "L<filename>\twrite the compile phase profile as CSV to filename instead of stderr", TR::Options::setString, offsetof(OMR::Options,_compilePhaseProfileFileName), 0, "P%s", NOT_IN_SUBSET},
    {"profileCompileTime",   "I\tgenerate a perf report for a specific compilation", SET_OPTION_BIT(TR_CompileTimeProfiler), "F" },
    {"profileMemoryRegions", "I\tenable the collection of scratch memory profiling data", SET_OPTION_BIT(TR_ProfileMemoryRegions), "F" },
    {"profilingCompNodecountThreshold=", "M<nnn>\tthreshold for doubling the method to do a profiling compile is considered expensive",
@@ -1104,6 +1115,10 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
         TR::Options::set32BitNumeric,offsetof(OMR::Options,_test390LitPoolBuffer), 0, "F%d"},
    {"test390StackBufferSize=", "L\tInsert buffer in stack to force testing of large stack sizes",
         TR::Options::set32BitNumeric,offsetof(OMR::Options,_test390StackBuffer), 0, "F%d"},
+   {"tieredCompilationSampleInterval=", "R<nnn>\tmilliseconds between scans of tiered method invocation counts",
+        TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_tieredCompilationSampleInterval, 0, "F%d", NOT_IN_SUBSET},
+   {"tieredCompilationThreshold=", "R<nnn>\tinvocations before a tiered method is recompiled at hot",
+        TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_tieredCompilationThreshold, 0, "F%d", NOT_IN_SUBSET},
    {"timing", "M\ttime individual phases and optimizations", SET_OPTION_BIT(TR_Timing), "F" },
    {"timingCumulative", "M\ttime cumulative phases (ILgen,Optimizer,codegen)", SET_OPTION_BIT(TR_CummTiming), "F" },
 #if defined(TR_HOST_X86) || defined(TR_HOST_POWER)
@@ -1321,6 +1336,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"useVmTotalCpuTimeAsAbstractTime", "M\tUse VmTotalCpuTime as abstractTime", SET_OPTION_BIT(TR_UseVmTotalCpuTimeAsAbstractTime), "F", NOT_IN_SUBSET },
    {"varyInlinerAggressivenessWithTime", "M\tVary inliner aggressiveness with abstract time", SET_OPTION_BIT(TR_VaryInlinerAggressivenessWithTime), "F", NOT_IN_SUBSET },
    {"verifyReferenceCounts", "I\tverify the sanity of object reference counts before manipulation", SET_OPTION_BIT(TR_VerifyReferenceCounts), "F"},
+   {"verifyWorklistDataFlowSolver", "I\tsolve bit vector dataflow analyses with both solvers and compare the results", SET_OPTION_BIT(TR_VerifyWorklistDataFlowSolver), "F"},
    {"virtualMemoryCheckFrequencySec=", "O<nnn>\tFrequency of the virtual memory check (only applicable for 32 bit systems)",
         TR::Options::setStaticNumeric, (intptrj_t)&OMR::Options::_virtualMemoryCheckFrequencySec, 0, "F%d", NOT_IN_SUBSET},
    {"waitOnCompilationQueue",        "M\tPerform synchronous wait until compilation queue empty. Primarily for use with Compiler.command", SET_OPTION_BIT(TR_WaitBit), "F", NOT_IN_SUBSET},
@@ -1527,6 +1543,28 @@ OMR::Options::setStringForPrivateBase(char *option, void *base, TR::OptionTable
    }
 
 
+char *
+OMR::Options::setPersistentMemoryLimit(char *option, void *base, TR::OptionTable *entry)
+   {
+   char *separator = strchr(option, ':');
+   if (NULL == separator)
+      return option;
+
+   size_t nameLength = separator - option;
+   for (uint32_t category = 0; category < TR_MemoryBase::NumObjectTypes; category++)
+      {
+      if (strlen(objectName[category]) == nameLength && 0 == strncmp(objectName[category], option, nameLength))
+         {
+         option = separator + 1;
+         size_t limit = static_cast<size_t>(TR::Options::getNumericValue(option)) * 1024;
+         TR::Compiler->persistentAllocator().setLimit(category, limit);
+         return option;
+         }
+      }
+   return option;
+   }
+
+
 char *
 OMR::Options::setStaticString(char *option, void *base, TR::OptionTable *entry)
    {
@@ -1681,6 +1719,10 @@ int32_t       OMR::Options::_numUsableCompilationThreads = -1; // -1 means not i
 
 int32_t       OMR::Options::_trampolineSpacePercentage = 0; // 0 means no change from default
 
+int32_t       OMR::Options::_tieredCompilationThreshold = 10000;
+
+int32_t       OMR::Options::_tieredCompilationSampleInterval = 10;
+
 bool          OMR::Options::_realTimeGC=false;
 
 bool          OMR::Options::_countsAreProvidedByUser = false;
@@ -4881,6 +4923,37 @@ OMR::Options::resetBit(char *option, void *base, TR::OptionTable *entry)
    }
 
 
+void
+OMR::Options::visitOptionValues(OptionValueVisitor &visitor)
+   {
+   char *base = reinterpret_cast<char *>(this);
+   for (TR::OptionTable *entry = _jitOptions; entry->name; entry++)
+      {
+      // Instance options live at an offset from this; static ones at the address in parm1
+      TR::OptionFunctionPtr fcn = entry->fcn;
+      if (fcn == TR::Options::setNumeric || fcn == TR::Options::setValue)
+         visitor.visitNumeric(entry, *reinterpret_cast<intptrj_t *>(base + entry->parm1));
+      else if (fcn == TR::Options::set32BitNumeric || fcn == TR::Options::set32BitSignedNumeric
+               || fcn == TR::Options::set32BitHexadecimal || fcn == TR::Options::set32BitValue)
+         visitor.visitNumeric(entry, *reinterpret_cast<int32_t *>(base + entry->parm1));
+      else if (fcn == TR::Options::set64BitSignedNumeric)
+         visitor.visitNumeric(entry, *reinterpret_cast<int64_t *>(base + entry->parm1));
+      else if (fcn == TR::Options::setStaticNumeric || fcn == TR::Options::setStatic32BitValue)
+         visitor.visitNumeric(entry, *reinterpret_cast<int32_t *>(entry->parm1));
+      else if (fcn == TR::Options::setStaticNumericKBAdjusted)
+         visitor.visitNumeric(entry, *reinterpret_cast<size_t *>(entry->parm1));
+      else if (fcn == TR::Options::setStaticHexadecimal)
+         visitor.visitNumeric(entry, *reinterpret_cast<uintptrj_t *>(entry->parm1));
+      else if (fcn == TR::Options::setStaticBool)
+         visitor.visitNumeric(entry, *reinterpret_cast<bool *>(entry->parm1));
+      else if (fcn == TR::Options::setString)
+         visitor.visitString(entry, *reinterpret_cast<char **>(base + entry->parm1));
+      else if (fcn == TR::Options::setStaticString)
+         visitor.visitString(entry, *reinterpret_cast<char **>(entry->parm1));
+      }
+   }
+
+
 char *
 OMR::Options::setValue(char *option, void *base, TR::OptionTable *entry)
    {
@@ -738,9 +738,9 @@ enum TR_CompilationOptions
    TR_ProfileMemoryRegions                            = 0x00800000 + 21,
    TR_DisableConverterReducer                         = 0x01000000 + 21,
    TR_CompileTimeProfiler                             = 0x02000000 + 21,
-   // Available                                       = 0x04000000 + 21,
-   // Available                                       = 0x08000000 + 21,
-   // Available                                       = 0x10000000 + 21,
+   TR_ProfileCompilePhases                            = 0x04000000 + 21,
+   TR_EnableWorklistDataFlowSolver                    = 0x08000000 + 21,
+   TR_VerifyWorklistDataFlowSolver                    = 0x10000000 + 21,
    TR_PerformLookaheadAtWarmCold                      = 0x20000000 + 21,
    // Available                                       = 0x40000000 + 21,
    TR_ActivateCompThreadWhenHighPriReqIsBlocked       = 0x80000000 + 21,
@@ -1773,6 +1773,9 @@ public:
 
    static int32_t getNumUsableCompilationThreads() { return _numUsableCompilationThreads; }
 
+   static int32_t getTieredCompilationThreshold() { return _tieredCompilationThreshold; }
+   static int32_t getTieredCompilationSampleInterval() { return _tieredCompilationSampleInterval; }
+
    static int32_t getTrampolineSpacePercentage() { return _trampolineSpacePercentage; }
    static size_t getScratchSpaceLimit() { return _scratchSpaceLimit; }
    static void setScratchSpaceLimit(size_t newScratchSpaceLimit) { _scratchSpaceLimit = newScratchSpaceLimit; }
@@ -1839,6 +1842,9 @@ public:
 
    static int32_t _trampolineSpacePercentage;
 
+   static int32_t _tieredCompilationThreshold;
+   static int32_t _tieredCompilationSampleInterval;
+
    static size_t _scratchSpaceLimit;
    static size_t _scratchSpaceLowerBound;
    static uint32_t _minBytesToLeaveAllocatedInSharedPool; // 0 to disable the feature and revert to old behavior
@@ -1956,6 +1962,26 @@ public:
    void disableCHOpts(); // disable CHOpts, but also IPA and prex which depend on the chtable
 
    const char *getObjectFileName() { return _objectFileName; }
+   const char *getCompilePhaseProfileFileName() { return _compilePhaseProfileFileName; }
+   const char *getMethodCacheFileName() { return _methodCacheFileName; }
+
+   /**
+    * @brief Receives the values of the numeric and string options of the JIT option table
+    */
+   class OptionValueVisitor
+      {
+   public:
+      virtual ~OptionValueVisitor() {}
+      virtual void visitNumeric(TR::OptionTable *entry, int64_t value) = 0;
+      virtual void visitString(TR::OptionTable *entry, const char *value) = 0;
+      };
+
+   /**
+    * @brief Report the current value of every numeric and string option in the JIT option
+    * table, whether it was set on the command line or holds its default. Options with their
+    * own processing methods are not reported.
+    */
+   void visitOptionValues(OptionValueVisitor &visitor);
 
 protected:
    void  jitPreProcess();
@@ -2142,6 +2168,11 @@ private:
    //
    static char *setStaticString(char *option, void *base, TR::OptionTable *entry);
 
+   // Cap the persistent memory in use for an allocation category; the option value is
+   // <category>:<nnn>, where category names a TR_MemoryBase::ObjectType and nnn is in KB
+   //
+   static char *setPersistentMemoryLimit(char *option, void *base, TR::OptionTable *entry);
+
    /**
    * \brief Option processing function for strings
    *
@@ -2445,6 +2476,8 @@ protected:
    int32_t                     _loopyAsyncCheckInsertionMaxEntryFreq;
 
    char *                      _objectFileName; //Name of the relocatable ELF file *.o if one is to be generated
+   char *                      _compilePhaseProfileFileName; //Name of the CSV file the compile phase profile is written to
+   char *                      _methodCacheFileName; //Name of the file compiled methods are cached in across runs
 
    }; // TR::Options
 
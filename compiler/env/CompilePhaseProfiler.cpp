@@ -0,0 +1,250 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/CompilePhaseProfiler.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#if defined(LINUX) && !defined(OMRZTPF)
+#include <time.h>
+#endif
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/TRMemory.hpp"
+#include "env/VMEnv.hpp"
+#include "infra/Assert.hpp"
+
+TR::CompilePhaseProfile *TR::CompilePhaseProfile::_instance = NULL;
+
+static const char *kindNames[TR::CompilePhaseProfile::NumKinds] =
+   {
+   "opt",
+   "codegen"
+   };
+
+TR::CompilePhaseProfile::CompilePhaseProfile()
+   {
+   memset(_entries, 0, sizeof(_entries));
+   MUTEX_INIT(_mutex);
+   }
+
+void
+TR::CompilePhaseProfile::initialize()
+   {
+   if (NULL == _instance && TR::Options::getCmdLineOptions()->getOption(TR_ProfileCompilePhases))
+      _instance = new (TR::Compiler->persistentAllocator(), std::nothrow) CompilePhaseProfile();
+   }
+
+void
+TR::CompilePhaseProfile::shutdown()
+   {
+   CompilePhaseProfile *profile = _instance;
+   if (NULL == profile)
+      return;
+   _instance = NULL;
+
+   const char *fileName = TR::Options::getCmdLineOptions()->getCompilePhaseProfileFileName();
+   FILE *file = (NULL != fileName) ? fopen(fileName, "w") : NULL;
+   profile->writeCSV((NULL != file) ? file : stderr);
+   if (NULL != file)
+      fclose(file);
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   for (int32_t kind = 0; kind < NumKinds; kind++)
+      {
+      for (int32_t i = 0; i < MAX_ENTRIES_PER_KIND; i++)
+         {
+         if (NULL != profile->_entries[kind][i])
+            allocator.deallocate(profile->_entries[kind][i]);
+         }
+      }
+   MUTEX_DESTROY(profile->_mutex);
+   allocator.deallocate(profile);
+   }
+
+uint64_t
+TR::CompilePhaseProfile::threadCPUTime()
+   {
+#if defined(LINUX) && !defined(OMRZTPF)
+   struct timespec now;
+   if (0 == clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now))
+      return static_cast<uint64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+#endif
+   return 0;
+   }
+
+void
+TR::CompilePhaseProfile::record(Kind kind, int32_t index, const char *name, uint64_t wallTime, uint64_t cpuTime, size_t regionBytes)
+   {
+   TR_ASSERT(index >= 0 && index < MAX_ENTRIES_PER_KIND, "Phase index %d out of range for the compile phase profile", index);
+   if (index < 0 || index >= MAX_ENTRIES_PER_KIND)
+      return;
+
+   MUTEX_ENTER(_mutex);
+   Entry *entry = _entries[kind][index];
+   if (NULL == entry)
+      {
+      entry = static_cast<Entry *>(TR::Compiler->persistentAllocator().allocate(sizeof(Entry), std::nothrow));
+      if (NULL != entry)
+         {
+         memset(entry, 0, sizeof(Entry));
+         entry->_kind = kind;
+         entry->_name = name;
+         _entries[kind][index] = entry;
+         }
+      }
+   if (NULL != entry)
+      {
+      entry->_count += 1;
+      entry->_totalWallTime += wallTime;
+      entry->_maxWallTime = wallTime > entry->_maxWallTime ? wallTime : entry->_maxWallTime;
+      entry->_totalCPUTime += cpuTime;
+      entry->_totalRegionBytes += regionBytes;
+      entry->_peakRegionBytes = regionBytes > entry->_peakRegionBytes ? regionBytes : entry->_peakRegionBytes;
+      entry->_wallTimeHistogram[bucketFor(wallTime)] += 1;
+      }
+   MUTEX_EXIT(_mutex);
+   }
+
+int32_t
+TR::CompilePhaseProfile::bucketFor(uint64_t time)
+   {
+   if (time < SUB_BUCKETS)
+      return static_cast<int32_t>(time);
+
+   int32_t highBit = 63;
+   while (0 == (time & (static_cast<uint64_t>(1) << highBit)))
+      highBit--;
+   if (highBit > MAX_TIME_BITS)
+      return NUM_BUCKETS - 1;
+
+   int32_t shift = highBit - SUB_BUCKET_BITS;
+   int32_t subBucket = static_cast<int32_t>(time >> shift) & (SUB_BUCKETS - 1);
+   return SUB_BUCKETS * (shift + 1) + subBucket;
+   }
+
+uint64_t
+TR::CompilePhaseProfile::bucketUpperBound(int32_t bucket)
+   {
+   if (bucket < SUB_BUCKETS)
+      return bucket;
+
+   int32_t shift = bucket / SUB_BUCKETS - 1;
+   uint64_t subBucket = bucket % SUB_BUCKETS;
+   return ((SUB_BUCKETS + subBucket + 1) << shift) - 1;
+   }
+
+uint64_t
+TR::CompilePhaseProfile::percentile(const Entry *entry, uint32_t percent)
+   {
+   uint64_t rank = (entry->_count * percent + 99) / 100;
+   uint64_t seen = 0;
+   for (int32_t bucket = 0; bucket < NUM_BUCKETS; bucket++)
+      {
+      seen += entry->_wallTimeHistogram[bucket];
+      if (seen >= rank)
+         {
+         uint64_t bound = bucketUpperBound(bucket);
+         return bound < entry->_maxWallTime ? bound : entry->_maxWallTime;
+         }
+      }
+   return entry->_maxWallTime;
+   }
+
+int
+TR::CompilePhaseProfile::compareTotalWallTime(const void *left, const void *right)
+   {
+   const Entry *l = *static_cast<const Entry * const *>(left);
+   const Entry *r = *static_cast<const Entry * const *>(right);
+   if (l->_totalWallTime != r->_totalWallTime)
+      return l->_totalWallTime > r->_totalWallTime ? -1 : 1;
+   return 0;
+   }
+
+// Phases are listed by total wall time, most expensive first
+void
+TR::CompilePhaseProfile::writeCSV(FILE *file)
+   {
+   Entry *sorted[NumKinds * MAX_ENTRIES_PER_KIND];
+   int32_t numEntries = 0;
+
+   MUTEX_ENTER(_mutex);
+   for (int32_t kind = 0; kind < NumKinds; kind++)
+      {
+      for (int32_t i = 0; i < MAX_ENTRIES_PER_KIND; i++)
+         {
+         if (NULL != _entries[kind][i])
+            sorted[numEntries++] = _entries[kind][i];
+         }
+      }
+   qsort(sorted, numEntries, sizeof(sorted[0]), compareTotalWallTime);
+
+   fprintf(file, "kind,name,count,total_wall_us,p99_wall_us,max_wall_us,total_cpu_us,total_region_bytes,peak_region_bytes\n");
+   for (int32_t i = 0; i < numEntries; i++)
+      {
+      Entry *entry = sorted[i];
+      fprintf(file, "%s,\"%s\",%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+         kindNames[entry->_kind],
+         entry->_name,
+         static_cast<unsigned long long>(entry->_count),
+         static_cast<unsigned long long>(entry->_totalWallTime),
+         static_cast<unsigned long long>(percentile(entry, 99)),
+         static_cast<unsigned long long>(entry->_maxWallTime),
+         static_cast<unsigned long long>(entry->_totalCPUTime),
+         static_cast<unsigned long long>(entry->_totalRegionBytes),
+         static_cast<unsigned long long>(entry->_peakRegionBytes));
+      }
+   MUTEX_EXIT(_mutex);
+   fflush(file);
+   }
+
+TR::CompilePhaseProfiler::CompilePhaseProfiler(TR::Compilation &compilation, TR::CompilePhaseProfile::Kind kind, int32_t index, const char *name) :
+   _profile(TR::CompilePhaseProfile::instance()),
+   _compilation(compilation),
+   _kind(kind),
+   _index(index),
+   _name(name),
+   _startWallTime(0),
+   _startCPUTime(0),
+   _startRegionBytes(0)
+   {
+   if (NULL != _profile)
+      {
+      _startRegionBytes = _compilation.trMemory()->heapMemoryRegion().bytesAllocated();
+      _startCPUTime = TR::CompilePhaseProfile::threadCPUTime();
+      _startWallTime = TR::Compiler->vm.getUSecClock();
+      }
+   }
+
+TR::CompilePhaseProfiler::~CompilePhaseProfiler()
+   {
+   if (NULL != _profile)
+      {
+      uint64_t wallTime = TR::Compiler->vm.getUSecClock() - _startWallTime;
+      uint64_t cpuTime = TR::CompilePhaseProfile::threadCPUTime() - _startCPUTime;
+      size_t regionBytes = _compilation.trMemory()->heapMemoryRegion().bytesAllocated() - _startRegionBytes;
+      _profile->record(_kind, _index, _name, wallTime, cpuTime, regionBytes);
+      }
+   }
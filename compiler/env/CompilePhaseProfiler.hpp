@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_COMPILE_PHASE_PROFILER_HPP
+#define OMR_COMPILE_PHASE_PROFILER_HPP
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "omrmutex.h"
+
+namespace TR { class Compilation; }
+
+namespace TR {
+
+/**
+ * @brief Process wide profile of where compile time and scratch memory go.
+ *
+ * When the JIT is started with -Xjit:profileCompilePhases, every optimization
+ * and code generation phase run by any compilation is recorded here: the
+ * number of invocations, total and 99th percentile wall time, total CPU time
+ * of the compiling thread, and the peak growth of the compilation's heap
+ * region during one invocation.  The profile is written as CSV when the JIT
+ * shuts down, to the file named by -Xjit:profileCompilePhasesFile= or to
+ * stderr.
+ */
+class CompilePhaseProfile
+   {
+public:
+   enum Kind
+      {
+      Optimization,
+      CodeGenPhase,
+      NumKinds
+      };
+
+   static const int32_t MAX_ENTRIES_PER_KIND = 512;
+
+   /** @brief Create the profile if the command line options ask for one */
+   static void initialize();
+
+   /** @brief Write the CSV report, if profiling, and discard the profile */
+   static void shutdown();
+
+   static CompilePhaseProfile *instance() { return _instance; }
+
+   void record(Kind kind, int32_t index, const char *name, uint64_t wallTime, uint64_t cpuTime, size_t regionBytes);
+
+   /** @brief CPU time consumed so far by the calling thread, in microseconds, or 0 if unavailable */
+   static uint64_t threadCPUTime();
+
+   // Wall times are bucketed 8 per power of two, so the percentile is within 12.5%
+   static const int32_t SUB_BUCKET_BITS = 3;
+   static const int32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+   static const int32_t MAX_TIME_BITS = 36;
+   static const int32_t NUM_BUCKETS = SUB_BUCKETS * (MAX_TIME_BITS - SUB_BUCKET_BITS + 2);
+
+   struct Entry
+      {
+      Kind _kind;
+      const char *_name;
+      uint64_t _count;
+      uint64_t _totalWallTime;
+      uint64_t _maxWallTime;
+      uint64_t _totalCPUTime;
+      uint64_t _totalRegionBytes;
+      uint64_t _peakRegionBytes;
+      uint32_t _wallTimeHistogram[NUM_BUCKETS];
+      };
+
+   /** @brief Histogram bucket that a wall time falls in; times beyond MAX_TIME_BITS share the last bucket */
+   static int32_t bucketFor(uint64_t time);
+
+   /** @brief Largest wall time that falls in the given histogram bucket */
+   static uint64_t bucketUpperBound(int32_t bucket);
+
+   /** @brief Upper bound of the given percentile of the entry's wall times, capped at the maximum seen */
+   static uint64_t percentile(const Entry *entry, uint32_t percent);
+
+private:
+   CompilePhaseProfile();
+
+   static int compareTotalWallTime(const void *left, const void *right);
+
+   void writeCSV(FILE *file);
+
+   static CompilePhaseProfile *_instance;
+
+   MUTEX _mutex;   /**< Guards _entries and their contents */
+   Entry *_entries[NumKinds][MAX_ENTRIES_PER_KIND];
+   };
+
+/**
+ * @brief Records the optimization or code generation phase running in its scope
+ * into the CompilePhaseProfile, if there is one.
+ */
+class CompilePhaseProfiler
+   {
+public:
+   CompilePhaseProfiler(TR::Compilation &compilation, TR::CompilePhaseProfile::Kind kind, int32_t index, const char *name);
+   ~CompilePhaseProfiler();
+
+private:
+   TR::CompilePhaseProfile *_profile;
+   TR::Compilation &_compilation;
+   TR::CompilePhaseProfile::Kind _kind;
+   int32_t _index;
+   const char *_name;
+   uint64_t _startWallTime;
+   uint64_t _startCPUTime;
+   size_t _startRegionBytes;
+   };
+
+}
+
+#endif // OMR_COMPILE_PHASE_PROFILER_HPP
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2016 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -21,25 +21,279 @@
 
 #include "env/PersistentAllocator.hpp"
 
+#include <string.h>
+#include "AtomicSupport.hpp"     // for VM_AtomicSupport
+#include "infra/Assert.hpp"      // for TR_ASSERT
+#include "infra/ThreadLocal.h"   // for tlsDefine, tlsGet, tlsSet
+
+#if defined(SUPPORTS_THREAD_LOCAL)
+namespace
+{
+
+/**
+ * The part of a slab a thread carves blocks from without taking the allocator mutex.
+ * A thread serves one allocator at a time; the chunk is abandoned when it moves on.
+ */
+struct PersistentAllocatorThreadChunk
+   {
+   uintptr_t _allocatorId;
+   uint8_t *_cursor;
+   uint8_t *_end;
+   };
+
+}
+
+tlsDefine(PersistentAllocatorThreadChunk *, persistentAllocatorThreadChunk);
+
+// 0 until the first allocator starts allocating the thread chunk key, 1 while it does, 2 after
+static volatile uintptr_t persistentAllocatorThreadChunkKeyState = 0;
+
+// Allocate the thread local key for the chunks once per process, however many
+// allocators are created; later callers wait until the key is usable
+static void
+allocateThreadChunkKey()
+   {
+   if (2 == persistentAllocatorThreadChunkKeyState)
+      return;
+   if (0 == VM_AtomicSupport::lockCompareExchange(&persistentAllocatorThreadChunkKeyState, 0, 1))
+      {
+      tlsAlloc(persistentAllocatorThreadChunk);
+      VM_AtomicSupport::writeBarrier();
+      persistentAllocatorThreadChunkKeyState = 2;
+      }
+   else
+      {
+      while (2 != persistentAllocatorThreadChunkKeyState)
+         VM_AtomicSupport::yieldCPU();
+      VM_AtomicSupport::readBarrier();
+      }
+   }
+#endif /* defined(SUPPORTS_THREAD_LOCAL) */
+
+static volatile uintptr_t persistentAllocatorCount = 0;
+
 OMR::PersistentAllocator::PersistentAllocator(const TR::PersistentAllocatorKit &allocatorKit) :
-   _rawAllocator(allocatorKit.rawAllocator)
+   _rawAllocator(allocatorKit.rawAllocator),
+   _id(VM_AtomicSupport::add(&persistentAllocatorCount, 1)),
+   _slabs(NULL),
+   _slabCursor(NULL),
+   _slabEnd(NULL),
+   _bytesReserved(0)
    {
+   memset(_freeBlocks, 0, sizeof(_freeBlocks));
+   memset(const_cast<uintptr_t *>(_bytesInUse), 0, sizeof(_bytesInUse));
+   for (uint32_t i = 0; i < MAX_CATEGORIES; i++)
+      _limits[i] = static_cast<uintptr_t>(-1);
+   MUTEX_INIT(_mutex);
+#if defined(SUPPORTS_THREAD_LOCAL)
+   allocateThreadChunkKey();
+#endif
+   }
+
+OMR::PersistentAllocator::~PersistentAllocator() throw()
+   {
+   while (NULL != _slabs)
+      {
+      Slab *slab = _slabs;
+      _slabs = slab->_next;
+      _rawAllocator.deallocate(slab);
+      }
+   MUTEX_DESTROY(_mutex);
    }
 
 void *
 OMR::PersistentAllocator::allocate(size_t size, const std::nothrow_t tag, void * hint) throw()
    {
-   return _rawAllocator.allocate(size, tag, hint);
+   return allocate(size, 0, tag);
    }
 
 void *
 OMR::PersistentAllocator::allocate(size_t size, void * hint)
    {
-   return _rawAllocator.allocate(size, hint);
+   void * const alloc = allocate(size, 0, std::nothrow);
+   if (!alloc) throw std::bad_alloc();
+   return alloc;
+   }
+
+void *
+OMR::PersistentAllocator::allocate(size_t size, uint32_t category, const std::nothrow_t tag) throw()
+   {
+   TR_ASSERT(category < MAX_CATEGORIES, "Persistent allocation category %u out of range", category);
+   if (size > MAX_SMALL_SIZE)
+      return allocateLarge(size, category);
+
+   size_t sizeClass = (size > 0) ? (size - 1) / ALIGNMENT : 0;
+   size_t blockSize = sizeof(BlockHeader) + (sizeClass + 1) * ALIGNMENT;
+   if (!reserve(category, blockSize))
+      return NULL;
+
+   BlockHeader *block = allocateFromThreadChunk(blockSize);
+   if (NULL == block)
+      block = allocateLocked(sizeClass, blockSize);
+   if (NULL == block)
+      {
+      unreserve(category, blockSize);
+      return NULL;
+      }
+
+   block->_size = static_cast<uint32_t>(blockSize);
+   block->_category = static_cast<uint16_t>(category);
+   block->_sizeClass = static_cast<uint16_t>(sizeClass);
+   return block + 1;
    }
 
 void
 OMR::PersistentAllocator::deallocate(void * p, const size_t sizeHint) throw()
    {
-   _rawAllocator.deallocate(p, sizeHint);
+   if (NULL == p)
+      return;
+
+   BlockHeader *block = static_cast<BlockHeader *>(p) - 1;
+   unreserve(block->_category, block->_size);
+   if (LARGE_BLOCK == block->_sizeClass)
+      {
+      VM_AtomicSupport::subtract(&_bytesReserved, block->_size);
+      _rawAllocator.deallocate(block);
+      return;
+      }
+
+   FreeBlock *freeBlock = reinterpret_cast<FreeBlock *>(block);
+   MUTEX_ENTER(_mutex);
+   freeBlock->_next = _freeBlocks[block->_sizeClass];
+   _freeBlocks[block->_sizeClass] = freeBlock;
+   MUTEX_EXIT(_mutex);
+   }
+
+size_t
+OMR::PersistentAllocator::bytesInUse() const throw()
+   {
+   size_t total = 0;
+   for (uint32_t i = 0; i < MAX_CATEGORIES; i++)
+      total += _bytesInUse[i];
+   return total;
+   }
+
+bool
+OMR::PersistentAllocator::reserve(uint32_t category, size_t size) throw()
+   {
+   uintptr_t inUse = VM_AtomicSupport::add(&_bytesInUse[category], size);
+   if (inUse > _limits[category])
+      {
+      VM_AtomicSupport::subtract(&_bytesInUse[category], size);
+      return false;
+      }
+   return true;
+   }
+
+void
+OMR::PersistentAllocator::unreserve(uint32_t category, size_t size) throw()
+   {
+   VM_AtomicSupport::subtract(&_bytesInUse[category], size);
+   }
+
+void *
+OMR::PersistentAllocator::allocateLarge(size_t size, uint32_t category) throw()
+   {
+   if (size > UINT32_MAX - sizeof(BlockHeader))
+      return NULL;
+
+   size_t blockSize = sizeof(BlockHeader) + size;
+   if (!reserve(category, blockSize))
+      return NULL;
+
+   BlockHeader *block = static_cast<BlockHeader *>(_rawAllocator.allocate(blockSize, std::nothrow));
+   if (NULL == block)
+      {
+      unreserve(category, blockSize);
+      return NULL;
+      }
+   VM_AtomicSupport::add(&_bytesReserved, blockSize);
+
+   block->_size = static_cast<uint32_t>(blockSize);
+   block->_category = static_cast<uint16_t>(category);
+   block->_sizeClass = LARGE_BLOCK;
+   return block + 1;
+   }
+
+OMR::PersistentAllocator::BlockHeader *
+OMR::PersistentAllocator::allocateFromThreadChunk(size_t blockSize) throw()
+   {
+#if defined(SUPPORTS_THREAD_LOCAL)
+   PersistentAllocatorThreadChunk *chunk = tlsGet(persistentAllocatorThreadChunk, PersistentAllocatorThreadChunk *);
+   if (NULL != chunk
+       && chunk->_allocatorId == _id
+       && static_cast<size_t>(chunk->_end - chunk->_cursor) >= blockSize)
+      {
+      BlockHeader *block = reinterpret_cast<BlockHeader *>(chunk->_cursor);
+      chunk->_cursor += blockSize;
+      return block;
+      }
+#endif /* defined(SUPPORTS_THREAD_LOCAL) */
+   return NULL;
+   }
+
+// Reuse a free block of the right size class, or carve a new one.  With thread local
+// storage, new blocks come from a fresh chunk reserved for the calling thread.
+OMR::PersistentAllocator::BlockHeader *
+OMR::PersistentAllocator::allocateLocked(size_t sizeClass, size_t blockSize) throw()
+   {
+   BlockHeader *block = NULL;
+   MUTEX_ENTER(_mutex);
+   FreeBlock *freeBlock = _freeBlocks[sizeClass];
+   if (NULL != freeBlock)
+      {
+      _freeBlocks[sizeClass] = freeBlock->_next;
+      block = &freeBlock->_header;
+      }
+   else
+      {
+#if defined(SUPPORTS_THREAD_LOCAL)
+      PersistentAllocatorThreadChunk *chunk = tlsGet(persistentAllocatorThreadChunk, PersistentAllocatorThreadChunk *);
+      if (NULL == chunk)
+         {
+         // The record is never freed, and does not live in any allocator's slabs, so a
+         // thread can always tell whether its chunk belongs to the allocator it is calling
+         chunk = static_cast<PersistentAllocatorThreadChunk *>(_rawAllocator.allocate(sizeof(PersistentAllocatorThreadChunk), std::nothrow));
+         if (NULL != chunk)
+            {
+            chunk->_allocatorId = 0;
+            tlsSet(persistentAllocatorThreadChunk, chunk);
+            }
+         }
+      uint8_t *chunkBase = (NULL != chunk) ? carveFromSlab(THREAD_CHUNK_SIZE) : NULL;
+      if (NULL != chunkBase)
+         {
+         chunk->_allocatorId = _id;
+         chunk->_cursor = chunkBase + blockSize;
+         chunk->_end = chunkBase + THREAD_CHUNK_SIZE;
+         block = reinterpret_cast<BlockHeader *>(chunkBase);
+         }
+#else
+      block = reinterpret_cast<BlockHeader *>(carveFromSlab(blockSize));
+#endif /* defined(SUPPORTS_THREAD_LOCAL) */
+      }
+   MUTEX_EXIT(_mutex);
+   return block;
+   }
+
+// Caller must hold _mutex
+uint8_t *
+OMR::PersistentAllocator::carveFromSlab(size_t size) throw()
+   {
+   if (static_cast<size_t>(_slabEnd - _slabCursor) < size)
+      {
+      // Keep the usable part of the slab a whole number of thread chunks
+      size_t headerSize = ALIGNMENT * ((sizeof(Slab) + ALIGNMENT - 1) / ALIGNMENT);
+      Slab *slab = static_cast<Slab *>(_rawAllocator.allocate(headerSize + SLAB_SIZE, std::nothrow));
+      if (NULL == slab)
+         return NULL;
+      VM_AtomicSupport::add(&_bytesReserved, headerSize + SLAB_SIZE);
+      slab->_next = _slabs;
+      _slabs = slab;
+      _slabCursor = reinterpret_cast<uint8_t *>(slab) + headerSize;
+      _slabEnd = _slabCursor + SLAB_SIZE;
+      }
+   uint8_t *result = _slabCursor;
+   _slabCursor += size;
+   return result;
    }
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2016 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -37,21 +37,59 @@ namespace TR { using OMR::PersistentAllocator; }
 
 #include "env/RawAllocator.hpp"  // for RawAllocator
 #include "env/PersistentAllocatorKit.hpp" // for PersistentAllocatorKit
+#include "omrmutex.h"  // for MUTEX
 
 namespace OMR {
 
+/**
+ * @brief Allocator for JIT memory that lives beyond a single compilation.
+ *
+ * Requests up to MAX_SMALL_SIZE bytes are rounded up to one of a set of size
+ * classes and carved out of large slabs obtained from the raw allocator.
+ * Freed blocks are kept on a free list per size class and handed out again
+ * to later requests of the same class, so long-running processes reuse
+ * persistent memory instead of fragmenting the system heap.  On platforms
+ * with thread local storage, each thread carves blocks without locking from
+ * a small chunk of slab reserved for it; the shared free lists and slabs are
+ * guarded by a mutex.  Larger requests go straight to the raw allocator.
+ *
+ * Every block records the category (a TR_MemoryBase::ObjectType) it was
+ * allocated for, so the bytes in use per category can be queried and capped
+ * with setLimit() or -Xjit:persistentMemoryLimit=<category>:<nnn>.
+ */
 class PersistentAllocator
    {
 public:
+   static const uint32_t MAX_CATEGORIES = 256;  /**< Number of distinct allocation categories tracked */
+   static const size_t MAX_SMALL_SIZE = 512;    /**< Largest request served from the size class slabs */
+
    PersistentAllocator(const TR::PersistentAllocatorKit &allocatorKit);
+   ~PersistentAllocator() throw();
 
    void *allocate(size_t size, const std::nothrow_t tag, void * hint = 0) throw();
    void * allocate(size_t size, void * hint = 0);
+   void *allocate(size_t size, uint32_t category, const std::nothrow_t tag) throw();
    void deallocate(void * p, const size_t sizeHint = 0) throw();
 
+   /** @brief Bytes, including block headers, currently allocated for the given category */
+   size_t bytesInUse(uint32_t category) const throw() { return _bytesInUse[category]; }
+
+   /** @brief Bytes currently allocated across all categories */
+   size_t bytesInUse() const throw();
+
+   /** @brief Bytes obtained from the raw allocator, for slabs and large blocks */
+   size_t bytesReserved() const throw() { return _bytesReserved; }
+
+   /**
+    * @brief Cap the bytes in use for a category; allocations that would exceed
+    * the cap fail as if the system were out of memory.
+    */
+   void setLimit(uint32_t category, size_t limit) throw() { _limits[category] = limit; }
+   size_t limit(uint32_t category) const throw() { return _limits[category]; }
+
    friend bool operator ==(const PersistentAllocator &left, const PersistentAllocator &right)
       {
-      return left._rawAllocator == right._rawAllocator;
+      return &left == &right;
       }
 
    friend bool operator !=(const PersistentAllocator &left, const PersistentAllocator &right)
@@ -62,8 +100,47 @@ public:
 private:
    PersistentAllocator(const PersistentAllocator &);
 
-   TR::RawAllocator _rawAllocator;
+   struct BlockHeader
+      {
+      uint32_t _size;       /**< Size of the block including this header */
+      uint16_t _category;
+      uint16_t _sizeClass;  /**< Index into _freeBlocks, or LARGE_BLOCK */
+      };
+
+   struct FreeBlock
+      {
+      BlockHeader _header;
+      FreeBlock *_next;
+      };
 
+   struct Slab
+      {
+      Slab *_next;
+      };
+
+   static const size_t ALIGNMENT = sizeof(BlockHeader);
+   static const size_t NUM_SIZE_CLASSES = MAX_SMALL_SIZE / ALIGNMENT;
+   static const uint16_t LARGE_BLOCK = 0xFFFF;
+   static const size_t SLAB_SIZE = 64 * 1024;
+   static const size_t THREAD_CHUNK_SIZE = 4 * 1024;
+
+   bool reserve(uint32_t category, size_t size) throw();
+   void unreserve(uint32_t category, size_t size) throw();
+   void *allocateLarge(size_t size, uint32_t category) throw();
+   BlockHeader *allocateFromThreadChunk(size_t blockSize) throw();
+   BlockHeader *allocateLocked(size_t sizeClass, size_t blockSize) throw();
+   uint8_t *carveFromSlab(size_t size) throw();
+
+   TR::RawAllocator _rawAllocator;
+   uintptr_t const _id;                              /**< Distinguishes this allocator in per-thread chunks */
+   MUTEX _mutex;                                     /**< Guards the slabs and free lists */
+   Slab *_slabs;
+   uint8_t *_slabCursor;
+   uint8_t *_slabEnd;
+   FreeBlock *_freeBlocks[NUM_SIZE_CLASSES];
+   volatile uintptr_t _bytesReserved;
+   volatile uintptr_t _bytesInUse[MAX_CATEGORIES];
+   uintptr_t _limits[MAX_CATEGORIES];
    };
 
 }
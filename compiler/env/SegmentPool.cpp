@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2017 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -20,12 +20,17 @@
  *******************************************************************************/
 
 #include "env/SegmentPool.hpp"
+#include <new>
 #include "env/MemorySegment.hpp"
+#include "infra/Assert.hpp"
 
 TR::SegmentPool::SegmentPool(TR::SegmentProvider &backingProvider, size_t poolSize, TR::RawAllocator rawAllocator) :
    SegmentProvider(backingProvider.defaultSegmentSize()),
    _poolSize(poolSize),
    _storedSegments(0),
+   _requests(0),
+   _reusedSegments(0),
+   _trimmedSegments(0),
    _backingProvider(backingProvider),
    _segmentStack(StackContainer(DequeAllocator(rawAllocator)))
    {
@@ -33,33 +38,40 @@ TR::SegmentPool::SegmentPool(TR::SegmentProvider &backingProvider, size_t poolSi
 
 TR::SegmentPool::~SegmentPool() throw()
    {
-   while (!_segmentStack.empty())
-      {
-      TR_ASSERT(_storedSegments > 0, "Too many segments");
-      TR::MemorySegment &topSegment = _segmentStack.top().get();
-      _segmentStack.pop();
-      _backingProvider.release(topSegment);
-      --_storedSegments;
-      }
+   trim();
    TR_ASSERT(0 == _storedSegments, "Lost a segment");
    }
 
 TR::MemorySegment &
 TR::SegmentPool::request(size_t requiredSize)
    {
+   ++_requests;
    if (
       requiredSize <= defaultSegmentSize()
       && !_segmentStack.empty()
       )
       {
+      TR_ASSERT(_storedSegments > 0, "We lost a segment");
       --_storedSegments;
-      TR_ASSERT(0 <= _storedSegments, "We lost a segment");
+      ++_reusedSegments;
       TR::MemorySegment &recycledSegment = _segmentStack.top().get();
       _segmentStack.pop();
       recycledSegment.reset();
       return recycledSegment;
       }
-   return _backingProvider.request(requiredSize);
+   try
+      {
+      return _backingProvider.request(requiredSize);
+      }
+   catch (const std::bad_alloc &)
+      {
+      // Memory is tight: give the cached segments back and try once more
+      // before letting the failure propagate.
+      if (_segmentStack.empty())
+         throw;
+      trim();
+      return _backingProvider.request(requiredSize);
+      }
    }
 
 void
@@ -85,3 +97,23 @@ TR::SegmentPool::release(TR::MemorySegment &segment) throw()
       _backingProvider.release(segment);
       }
    }
+
+size_t
+TR::SegmentPool::bytesAllocated() const throw()
+   {
+   return _backingProvider.bytesAllocated();
+   }
+
+void
+TR::SegmentPool::trim(size_t segmentsToKeep) throw()
+   {
+   while (_storedSegments > segmentsToKeep)
+      {
+      TR_ASSERT(!_segmentStack.empty(), "Too many segments");
+      TR::MemorySegment &topSegment = _segmentStack.top().get();
+      _segmentStack.pop();
+      _backingProvider.release(topSegment);
+      --_storedSegments;
+      ++_trimmedSegments;
+      }
+   }
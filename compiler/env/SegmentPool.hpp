@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2016 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -35,6 +35,12 @@ namespace TR {
 
 /**
  * @brief The SegmentPool class maintains a pool of memory segments.
+ *
+ * Segments of the default size that are released to the pool are kept, up to
+ * the pool size, and handed back out by subsequent requests instead of going
+ * back to the backing provider.  A pool that outlives a single compilation
+ * therefore keeps its working set warm across compilations.  The pool is not
+ * thread safe; each compilation thread is expected to own its own pool.
  */
 
 class SegmentPool : public TR::SegmentProvider
@@ -45,10 +51,27 @@ public:
 
    virtual TR::MemorySegment &request(size_t requiredSize);
    virtual void release(TR::MemorySegment &) throw();
+   virtual size_t bytesAllocated() const throw();
+
+   /**
+    * @brief Return cached segments to the backing provider until at most
+    * segmentsToKeep remain in the pool.
+    */
+   void trim(size_t segmentsToKeep = 0) throw();
+
+   size_t poolSize() const throw() { return _poolSize; }
+   size_t storedSegments() const throw() { return _storedSegments; }
+
+   size_t requests() const throw() { return _requests; }               /**< Number of segments requested from the pool */
+   size_t reusedSegments() const throw() { return _reusedSegments; }   /**< Number of requests satisfied from cached segments */
+   size_t trimmedSegments() const throw() { return _trimmedSegments; } /**< Number of cached segments returned to the backing provider */
 
 private:
    size_t const _poolSize;
    size_t _storedSegments;
+   size_t _requests;
+   size_t _reusedSegments;
+   size_t _trimmedSegments;
    TR::SegmentProvider &_backingProvider;
 
    typedef TR::typed_allocator<
@@ -477,7 +477,7 @@ public:
    void * allocatePersistentMemory(size_t const size, ObjectType const ot = UnknownType) throw()
       {
       _totalPersistentAllocations[ot] += size;
-      void * persistentMemory = _persistentAllocator.get().allocate(size, std::nothrow);
+      void * persistentMemory = _persistentAllocator.get().allocate(size, ot, std::nothrow);
       return persistentMemory;
       }
 
@@ -504,6 +504,8 @@ public:
    size_t _totalPersistentAllocations[TR_MemoryBase::NumObjectTypes];
    };
 
+static_assert(TR_MemoryBase::NumObjectTypes <= TR::PersistentAllocator::MAX_CATEGORIES, "PersistentAllocator must track every ObjectType");
+
 extern TR_PersistentMemory * trPersistentMemory;
 
 class TR_TypedPersistentAllocatorBase
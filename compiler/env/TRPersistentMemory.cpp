@@ -89,11 +89,13 @@ TR_PersistentMemory::TR_PersistentMemory(
 void
 TR_PersistentMemory::printMemStats()
    {
+   TR::PersistentAllocator &allocator = _persistentAllocator.get();
    fprintf(stderr, "TR_PersistentMemory Stats:\n");
    for (uint32_t i = 0; i < TR_MemoryBase::NumObjectTypes; i++)
       {
-      fprintf(stderr, "\t_totalPersistentAllocations[%s]=%lu\n", objectName[i], (unsigned long)_totalPersistentAllocations[i]);
+      fprintf(stderr, "\t_totalPersistentAllocations[%s]=%lu inUse=%lu\n", objectName[i], (unsigned long)_totalPersistentAllocations[i], (unsigned long)allocator.bytesInUse(i));
       }
+   fprintf(stderr, "\tinUse=%lu reserved=%lu\n", (unsigned long)allocator.bytesInUse(), (unsigned long)allocator.bytesReserved());
    fprintf(stderr, "\n");
    }
 
@@ -101,10 +103,12 @@ void
 TR_PersistentMemory::printMemStatsToVlog()
    {
    TR_VerboseLog::vlogAcquire();
+   TR::PersistentAllocator &allocator = _persistentAllocator.get();
    TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "TR_PersistentMemory Stats:");
    for (uint32_t i = 0; i < TR_MemoryBase::NumObjectTypes; i++)
       {
-      TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "\t_totalPersistentAllocations[%s]=%lu", objectName[i], (unsigned long)_totalPersistentAllocations[i]);
+      TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "\t_totalPersistentAllocations[%s]=%lu inUse=%lu", objectName[i], (unsigned long)_totalPersistentAllocations[i], (unsigned long)allocator.bytesInUse(i));
       }
+   TR_VerboseLog::writeLine(TR_Vlog_MEMORY, "\tinUse=%lu reserved=%lu", (unsigned long)allocator.bytesInUse(), (unsigned long)allocator.bytesReserved());
    TR_VerboseLog::vlogRelease();
    }
@@ -733,7 +733,7 @@ OMR::IlBuilder::CreateLocalStruct(TR::IlType *structType)
 void
 OMR::IlBuilder::StoreIndirect(const char *type, const char *field, TR::IlValue *object, TR::IlValue *value)
    {
-   TR::SymbolReference *symRef = (TR::SymbolReference*)_types->FieldReference(type, field);
+   TR::SymbolReference *symRef = (TR::SymbolReference*)_types->FieldReference(type, field, _methodBuilder);
    TR::DataType fieldType = symRef->getSymbol()->getDataType();
    TraceIL("IlBuilder[ %p ]::StoreIndirect %s.%s (%d) into (%d)\n", this, type, field, value->getID(), object->getID());
    TR::ILOpCodes storeOp = comp()->il.opCodeForIndirectStore(fieldType);
@@ -767,7 +767,7 @@ OMR::IlBuilder::VectorLoad(const char *name)
 TR::IlValue *
 OMR::IlBuilder::LoadIndirect(const char *type, const char *field, TR::IlValue *object)
    {
-   TR::SymbolReference *symRef = (TR::SymbolReference *)_types->FieldReference(type, field);
+   TR::SymbolReference *symRef = (TR::SymbolReference *)_types->FieldReference(type, field, _methodBuilder);
    TR::DataType fieldType = symRef->getSymbol()->getDataType();
    TR::IlValue *returnValue = newValue(fieldType, TR::Node::createWithSymRef(comp()->il.opCodeForIndirectLoad(fieldType), 1, loadValue(object), 0, symRef));
    TraceIL("IlBuilder[ %p ]::%d is LoadIndirect %s.%s from (%d)\n", this, returnValue->getID(), type, field, object->getID());
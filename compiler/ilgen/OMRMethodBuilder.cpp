@@ -107,11 +107,14 @@ OMR::MethodBuilder::MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineS
    _symbolIsArray(str_comparator, trMemory()->heapMemoryRegion()),
    _memoryLocations(str_comparator, trMemory()->heapMemoryRegion()),
    _functions(str_comparator, trMemory()->heapMemoryRegion()),
+   _fieldSymRefs(std::less<OMR::FieldInfo *>(), trMemory()->heapMemoryRegion()),
    _cachedParameterTypes(0),
    _definingFile(""),
    _newSymbolsAreTemps(false),
    _nextValueID(0),
    _useBytecodeBuilders(false),
+   _useFastCompilation(false),
+   _useTieredCompilation(false),
    _countBlocksWorklist(0),
    _connectTreesWorklist(0),
    _allBytecodeBuilders(0),
@@ -139,11 +142,14 @@ OMR::MethodBuilder::MethodBuilder(TR::MethodBuilder *callerMB, TR::VirtualMachin
    _symbolIsArray(str_comparator, trMemory()->heapMemoryRegion()),
    _memoryLocations(str_comparator, trMemory()->heapMemoryRegion()),
    _functions(str_comparator, trMemory()->heapMemoryRegion()),
+   _fieldSymRefs(std::less<OMR::FieldInfo *>(), trMemory()->heapMemoryRegion()),
    _cachedParameterTypes(0),
    _definingFile(""),
    _newSymbolsAreTemps(false),
    _nextValueID(0),
    _useBytecodeBuilders(false),
+   _useFastCompilation(false),
+   _useTieredCompilation(false),
    _countBlocksWorklist(0),
    _connectTreesWorklist(0),
    _allBytecodeBuilders(0),
@@ -170,6 +176,7 @@ OMR::MethodBuilder::~MethodBuilder()
    _symbolIsArray.clear();
    _memoryLocations.clear();
    _functions.clear();
+   _fieldSymRefs.clear();
    }
 
 TR::MethodBuilder *
@@ -189,6 +196,17 @@ OMR::MethodBuilder::getNextValueID()
    return _nextValueID++;
    }
 
+OMR::MethodBuilder::FieldSymRefMap &
+OMR::MethodBuilder::fieldSymRefs()
+   {
+   TR::MethodBuilder *caller = callerMethodBuilder();
+   if (caller != NULL)
+      // field symbol references are shared by the whole compilation
+      return caller->fieldSymRefs();
+
+   return _fieldSymRefs;
+   }
+
 int32_t
 OMR::MethodBuilder::getNextInlineSiteIndex()
    {
@@ -211,6 +229,25 @@ OMR::MethodBuilder::callerMethodBuilder()
 void
 OMR::MethodBuilder::setupForBuildIL()
    {
+   // A MethodBuilder may be compiled more than once (e.g. recompiled by tiered compilation),
+   // so drop anything that refers to a previous compilation's symbols or memory
+   _symbols.clear();
+   _fieldSymRefs.clear();
+   _symbolNameFromSlot.clear();
+   for (ParameterMap::iterator it = _parameterSlot.begin(); it != _parameterSlot.end(); it++)
+      _symbolNameFromSlot.insert(std::make_pair(it->second, it->first));
+   _blocks = NULL;
+   _numBlocks = 0;
+   _blocksAllocatedUpFront = false;
+   _count = -1;
+   _connectedTrees = false;
+   _comesBack = true;
+   _countBlocksWorklist = NULL;
+   _connectTreesWorklist = NULL;
+   _allBytecodeBuilders = NULL;
+   _bytecodeWorklist = NULL;
+   _bytecodeHasBeenInWorklist = NULL;
+
    initSequence();
 
    _entryBlock = cfg()->getStart()->asBlock();
@@ -32,6 +32,7 @@
 #define MAX_LINE_NUM_LEN 7
 
 class TR_BitVector;
+namespace OMR { class FieldInfo; }
 namespace TR { class BytecodeBuilder; }
 namespace TR { class ResolvedMethod; }
 namespace TR { class SymbolReference; }
@@ -69,6 +70,28 @@ class MethodBuilder : public TR::IlBuilder
    bool usesBytecodeBuilders()                               { return _useBytecodeBuilders; }
    void setUseBytecodeBuilders()                             { _useBytecodeBuilders = true; }
 
+   /**
+    * @brief select the fast compilation tier for this method
+    * The fast tier runs only local optimizations and the cheap register
+    * allocator (cold hotness rather than warm), trading generated code
+    * quality for a shorter compile; use it for short-lived code where
+    * compile latency matters more than peak performance.
+    */
+   bool usesFastCompilation()                                { return _useFastCompilation; }
+   void setUseFastCompilation()                              { _useFastCompilation = true; }
+
+   /**
+    * @brief compile this method cheaply first and recompile it at hot once it is invoked often
+    * The entry point returned for a tiered method is a stub that counts invocations; once the
+    * count reaches -Xjit:tieredCompilationThreshold the method is recompiled on a compilation
+    * thread and the stub is redirected to the new body. buildIL() is therefore run again,
+    * so the builder must stay alive until shutdownJit(), or until it has been passed to
+    * retireMethodBuilder(). Other builders sharing its
+    * TypeDictionary may be compiled at the same time as the recompilation.
+    */
+   bool usesTieredCompilation()                              { return _useTieredCompilation; }
+   void setUseTieredCompilation()                            { _useTieredCompilation = true; }
+
    void addToAllBytecodeBuildersList(TR::BytecodeBuilder *bcBuilder);
    void addToTreeConnectingWorklist(TR::BytecodeBuilder *builder);
    void addToBlockCountingWorklist(TR::BytecodeBuilder *builder);
@@ -81,6 +104,16 @@ class MethodBuilder : public TR::IlBuilder
 
    TR::TypeDictionary *typeDictionary()                      { return _types; }
 
+   typedef TR::typed_allocator<std::pair<OMR::FieldInfo * const, TR::SymbolReference *>, TR::Region &> FieldSymRefMapAllocator;
+   typedef std::map<OMR::FieldInfo *, TR::SymbolReference *, std::less<OMR::FieldInfo *>, FieldSymRefMapAllocator> FieldSymRefMap;
+
+   /**
+    * @brief returns the symbol references created for struct and union fields in the current compilation
+    * If this is an inlined MethodBuilder, the caller's map is returned so that the
+    * whole compilation shares one symbol reference per field.
+    */
+   FieldSymRefMap &fieldSymRefs();
+
    const char *getDefiningFile()                             { return _definingFile; }
    const char *getDefiningLine()                             { return _definingLine; }
 
@@ -303,6 +336,9 @@ class MethodBuilder : public TR::IlBuilder
    typedef std::map<const char *, TR::ResolvedMethod *, StrComparator, FunctionMapAllocator> FunctionMap;
    FunctionMap                 _functions;
 
+   // This map should only be accessed inside a compilation via fieldSymRefs
+   FieldSymRefMap              _fieldSymRefs;
+
    TR::IlType                ** _cachedParameterTypes;
    const char                * _definingFile;
    char                        _definingLine[MAX_LINE_NUM_LEN];
@@ -312,6 +348,8 @@ class MethodBuilder : public TR::IlBuilder
    int32_t                     _nextValueID;
 
    bool                        _useBytecodeBuilders;
+   bool                        _useFastCompilation;
+   bool                        _useTieredCompilation;
    uint32_t                    _numBlocksBeforeWorklist;
    List<TR::BytecodeBuilder> * _countBlocksWorklist;
    List<TR::BytecodeBuilder> * _connectTreesWorklist;
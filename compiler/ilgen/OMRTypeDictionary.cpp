@@ -26,12 +26,12 @@
 #include "compile/SymbolReferenceTable.hpp"
 #include "compile/Compilation.hpp"
 #include "env/FrontEnd.hpp"
+#include "ilgen/MethodBuilder.hpp"
 #include "ilgen/TypeDictionary.hpp"
 #include "env/Region.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "env/TRMemory.hpp"
 #include "infra/Assert.hpp"
-#include "infra/BitVector.hpp"
 #include "infra/STLUtils.hpp"
 
 
@@ -73,15 +73,10 @@ public:
       _next(0),
       _name(name),
       _offset(offset),
-      _type(type),
-      _symRef(0)
+      _type(type)
       {
       }
 
-   void cacheSymRef(TR::SymbolReference *symRef) { _symRef = symRef; }
-   TR::SymbolReference *getSymRef()              { return _symRef; }
-   void clearSymRef()                            { _symRef = NULL; }
-
    TR::IlType *getType()                         { return _type; }
 
    TR::DataType getPrimitiveType()               { return _type->getPrimitiveType(); }
@@ -96,7 +91,6 @@ public:
    const char          * _name;
    size_t                _offset;
    TR::IlType          * _type;
-   TR::SymbolReference * _symRef;
    };
 
 
@@ -124,12 +118,10 @@ public:
    TR::IlType * getFieldType(const char *fieldName);
    size_t getFieldOffset(const char *fieldName);
 
-   TR::SymbolReference *getFieldSymRef(const char *name);
+   TR::SymbolReference *getFieldSymRef(const char *name, TR::MethodBuilder::FieldSymRefMap &fieldSymRefs);
    bool isStruct() { return true; }
    virtual size_t getSize() { return _size; }
 
-   void clearSymRefs();
-
 protected:
    FieldInfo * findField(const char *fieldName);
 
@@ -144,14 +136,12 @@ class UnionType : public TR::IlType
 public:
    TR_ALLOC(TR_Memory::IlGenerator)
 
-   UnionType(const char *name, TR_Memory* trMemory) :
+   UnionType(const char *name) :
       TR::IlType(name),
       _firstField(0),
       _lastField(0),
       _size(0),
-      _closed(false),
-      _symRefBV(4, trMemory),
-      _trMemory(trMemory)
+      _closed(false)
       { }
    virtual ~UnionType()
       { }
@@ -162,12 +152,10 @@ public:
    void AddField(const char *name, TR::IlType *fieldType);
    TR::IlType * getFieldType(const char *fieldName);
 
-   TR::SymbolReference *getFieldSymRef(const char *name);
+   TR::SymbolReference *getFieldSymRef(const char *name, TR::MethodBuilder::FieldSymRefMap &fieldSymRefs);
    virtual bool isUnion() { return true; }
    virtual size_t getSize() { return _size; }
 
-   void clearSymRefs();
-
 protected:
    FieldInfo * findField(const char *fieldName);
 
@@ -175,8 +163,6 @@ protected:
    FieldInfo * _lastField;
    size_t      _size;
    bool        _closed;
-   TR_BitVector _symRefBV;
-   TR_Memory* _trMemory;
    };
 
 class PointerType : public TR::IlType
@@ -278,13 +264,14 @@ OMR::StructType::getFieldOffset(const char *fieldName)
    }
 
 TR::IlReference *
-OMR::StructType::getFieldSymRef(const char *fieldName)
+OMR::StructType::getFieldSymRef(const char *fieldName, TR::MethodBuilder::FieldSymRefMap &fieldSymRefs)
    {
    OMR::FieldInfo *info = findField(fieldName);
    if (NULL == info)
       return NULL;
 
-   TR::SymbolReference *symRef = info->getSymRef();
+   TR::MethodBuilder::FieldSymRefMap::iterator cached = fieldSymRefs.find(info);
+   TR::SymbolReference *symRef = (cached != fieldSymRefs.end()) ? cached->second : NULL;
    if (NULL == symRef)
       {
       TR::Compilation *comp = TR::comp();
@@ -308,23 +295,12 @@ OMR::StructType::getFieldSymRef(const char *fieldName)
       else
          comp->getSymRefTab()->aliasBuilder.nonIntPrimitiveShadowSymRefs().set(refNum);
 
-      info->cacheSymRef(symRef);
+      fieldSymRefs.insert(std::make_pair(info, symRef));
       }
 
    return (TR::IlReference *)symRef;
    }
 
-void
-OMR::StructType::clearSymRefs()
-   {
-   OMR::FieldInfo *field = _firstField;
-   while (field)
-      {
-      field->clearSymRef();
-      field = field->_next;
-      }
-   }
-
 
 void
 OMR::UnionType::AddField(const char *name, TR::IlType *typeInfo)
@@ -372,12 +348,13 @@ OMR::UnionType::getFieldType(const char *fieldName)
    }
 
 TR::IlReference *
-OMR::UnionType::getFieldSymRef(const char *fieldName)
+OMR::UnionType::getFieldSymRef(const char *fieldName, TR::MethodBuilder::FieldSymRefMap &fieldSymRefs)
    {
    OMR::FieldInfo *info = findField(fieldName);
    TR_ASSERT(info, "Struct %s has no field with name %s\n", getName(), fieldName);
 
-   TR::SymbolReference *symRef = info->getSymRef();
+   TR::MethodBuilder::FieldSymRefMap::iterator cached = fieldSymRefs.find(info);
+   TR::SymbolReference *symRef = (cached != fieldSymRefs.end()) ? cached->second : NULL;
    if (NULL == symRef)
       {
       // create a symref for the new field and set its bitvector
@@ -392,32 +369,21 @@ OMR::UnionType::getFieldSymRef(const char *fieldName)
       symRef->setOffset(0);
       symRef->setReallySharesSymbol();
 
-      TR_SymRefIterator sit(_symRefBV, symRefTab);
-      for (TR::SymbolReference *sr = sit.getNext(); sr; sr = sit.getNext())
-          {
-          symRefTab->makeSharedAliases(symRef, sr);
-          }
+      // every field of a union overlaps every other, so alias the new symref with
+      // the symrefs already created for this union's fields in this compilation
+      for (OMR::FieldInfo *field = _firstField; field != NULL; field = field->getNext())
+         {
+         TR::MethodBuilder::FieldSymRefMap::iterator other = fieldSymRefs.find(field);
+         if (other != fieldSymRefs.end())
+            symRefTab->makeSharedAliases(symRef, other->second);
+         }
 
-      _symRefBV.set(symRef->getReferenceNumber());
-
-      info->cacheSymRef(symRef);
+      fieldSymRefs.insert(std::make_pair(info, symRef));
       }
 
    return static_cast<TR::IlReference *>(symRef);
    }
 
-void
-OMR::UnionType::clearSymRefs()
-   {
-   OMR::FieldInfo *field = _firstField;
-   while (field)
-      {
-      field->clearSymRef();
-      field = field->_next;
-      }
-   _symRefBV.init(4, _trMemory);
-   }
-
 
 // Note: _memoryRegion and the corresponding TR::SegmentProvider and TR::Memory instances are stored as pointers within TypeDictionary
 // in order to avoid increasing the number of header files needed to compile against the JitBuilder library. Because we are storing
@@ -561,7 +527,7 @@ OMR::TypeDictionary::DefineUnion(const char *unionName)
    {
    TR_ASSERT_FATAL(_unionsByName.find(unionName) == _unionsByName.end(), "Union '%s' already exists", unionName);
    
-   OMR::UnionType *newType = new (PERSISTENT_NEW) OMR::UnionType(unionName, trMemory());
+   OMR::UnionType *newType = new (PERSISTENT_NEW) OMR::UnionType(unionName);
    _unionsByName.insert(std::make_pair(unionName, newType));
 
    return newType;
@@ -598,44 +564,26 @@ OMR::TypeDictionary::PointerTo(TR::IlType *baseType)
    }
 
 TR::IlReference *
-OMR::TypeDictionary::FieldReference(const char *typeName, const char *fieldName)
+OMR::TypeDictionary::FieldReference(const char *typeName, const char *fieldName, TR::MethodBuilder *methodBuilder)
    {
    StructMap::iterator structIterator = _structsByName.find(typeName);
    if (structIterator != _structsByName.end())
       {
       OMR::StructType *theStruct = structIterator->second;
-      return theStruct->getFieldSymRef(fieldName);
+      return theStruct->getFieldSymRef(fieldName, methodBuilder->fieldSymRefs());
       }
 
    UnionMap::iterator unionIterator = _unionsByName.find(typeName);
    if (unionIterator != _unionsByName.end())
       {
       OMR::UnionType *theUnion = unionIterator->second;
-      return theUnion->getFieldSymRef(fieldName);
+      return theUnion->getFieldSymRef(fieldName, methodBuilder->fieldSymRefs());
       }
 
    TR_ASSERT_FATAL(false, "No type with name '%s'", typeName);
    return NULL;
    }
 
-void
-OMR::TypeDictionary::NotifyCompilationDone()
-   {
-   // clear all symbol references for fields
-   for (StructMap::iterator it = _structsByName.begin(); it != _structsByName.end(); it++)
-      {
-      OMR::StructType *aStruct = it->second;
-      aStruct->clearSymRefs();
-      }
-
-   // clear all symbol references for union fields
-   for (UnionMap::iterator it = _unionsByName.begin(); it != _unionsByName.end(); it++)
-      {
-      OMR::UnionType *aUnion = it->second;
-      aUnion->clearSymRefs();
-      }
-   }
-
 OMR::StructType *
 OMR::TypeDictionary::getStruct(const char *structName)
    {
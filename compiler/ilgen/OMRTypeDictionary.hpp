@@ -31,6 +31,7 @@ class TR_Memory;
 
 namespace OMR { class StructType; }
 namespace OMR { class UnionType; }
+namespace TR  { class MethodBuilder; }
 namespace TR  { class SegmentProvider; }
 namespace TR  { class Region; }
 namespace TR  { typedef TR::SymbolReference IlReference; }
@@ -195,7 +196,13 @@ public:
    TR::IlType *PointerTo(const char *structName);
    TR::IlType *PointerTo(TR::DataType baseType)  { return PointerTo(_primitiveType[baseType]); }
 
-   TR::IlReference *FieldReference(const char *typeName, const char *fieldName);
+   /**
+    * @brief returns the symbol reference for a field of a struct or union in the compilation of methodBuilder
+    * Field symbol references belong to a single compilation and are cached by the compiled
+    * MethodBuilder rather than by the dictionary, so any number of MethodBuilders sharing
+    * this dictionary can be compiled at the same time.
+    */
+   TR::IlReference *FieldReference(const char *typeName, const char *fieldName, TR::MethodBuilder *methodBuilder);
    TR_Memory *trMemory() { return memoryManager._trMemory; }
    TR::IlType *getWord() { return Word; }
 
@@ -371,11 +378,6 @@ public:
       return PointerTo(toIlType<typename std::remove_pointer<T>::type>());
    }
 
-   /*
-    * @brief advise that compilation is complete so compilation-specific objects like symbol references can be cleared from caches
-    */
-   void NotifyCompilationDone();
-
 protected:
    // We have MemoryManager as the first member of TypeDictionary, so that
    // it is the last one to get destroyed and all objects allocated using
@@ -24,50 +24,14 @@
 #include <stdint.h>                   // for int32_t, uint32_t
 #include <stdio.h>                    // for sprintf
 #include "compile/Compilation.hpp"    // for Compilation
+#include "infra/Bit.hpp"              // for populationCount
 #include "ras/Debug.hpp"              // for TR_DebugBase
 
-// Number of bits set in a byte containing the index value
-//
-static int8_t bitsInByte[] =
-   {
-   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
-   1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
-   1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
-   2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
-   1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
-   2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
-   2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
-   3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
-   1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 5,
-   2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
-   2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
-   3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
-   2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 6,
-   3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
-   3, 4, 4, 5, 4, 5, 5, 6, 4, 5, 5, 6, 5, 6, 6, 7,
-   4, 5, 5, 6, 5, 6, 6, 7, 5, 6, 6, 7, 6, 7, 7, 8
-   };
-
 int32_t TR_BitVector::elementCount()
    {
    int32_t count = 0;
    for (int32_t i = _firstChunkWithNonZero; i <= _lastChunkWithNonZero; i++)
-      {
-      if (_chunks[i])
-         {
-         uint8_t *p = (uint8_t*)&_chunks[i];
-         count += bitsInByte[p[0]];
-         count += bitsInByte[p[1]];
-         count += bitsInByte[p[2]];
-         count += bitsInByte[p[3]];
-#if BITS_IN_CHUNK == 64
-         count += bitsInByte[p[4]];
-         count += bitsInByte[p[5]];
-         count += bitsInByte[p[6]];
-         count += bitsInByte[p[7]];
-#endif
-         }
-      }
+      count += populationCount(_chunks[i]);
    return count;
    }
 
@@ -80,23 +44,7 @@ int32_t TR_BitVector::commonElementCount(TR_BitVector& v2)
    int32_t high = _lastChunkWithNonZero <= v2._lastChunkWithNonZero ? _lastChunkWithNonZero : v2._lastChunkWithNonZero;
    int32_t count = 0;
    for (int32_t i = low; i <= high; i++)
-      {
-      chunk_t tmp = _chunks[i] & v2._chunks[i];
-      if (tmp)
-         {
-         uint8_t *p = (uint8_t*)&tmp;
-         count += bitsInByte[p[0]];
-         count += bitsInByte[p[1]];
-         count += bitsInByte[p[2]];
-         count += bitsInByte[p[3]];
-#if BITS_IN_CHUNK == 64
-         count += bitsInByte[p[4]];
-         count += bitsInByte[p[5]];
-         count += bitsInByte[p[6]];
-         count += bitsInByte[p[7]];
-#endif
-         }
-      }
+      count += populationCount(_chunks[i] & v2._chunks[i]);
    return count;
    }
 
@@ -107,20 +55,9 @@ bool TR_BitVector::hasMoreThanOneElement()
       return true;
    if (_lastChunkWithNonZero < 0)
       return false;
-   int32_t count = 0;
-   uint8_t *p = (uint8_t*)&_chunks[_firstChunkWithNonZero];
-   count += bitsInByte[p[0]];
-   count += bitsInByte[p[1]];
-   count += bitsInByte[p[2]];
-   count += bitsInByte[p[3]];
-#if BITS_IN_CHUNK == 64
-   count += bitsInByte[p[4]];
-   count += bitsInByte[p[5]];
-   count += bitsInByte[p[6]];
-   count += bitsInByte[p[7]];
-#endif
-
-   return (count > 1);
+   // More than one bit is set if clearing the lowest set bit leaves any behind
+   chunk_t chunk = _chunks[_firstChunkWithNonZero];
+   return (chunk & (chunk - 1)) != 0;
    }
 
 void TR_BitVector::setChunkSize(int32_t chunkSize)
@@ -168,17 +105,18 @@ void TR_BitVector::setChunkSize(int32_t chunkSize)
    TR_ASSERT(_growable == growable, "Bit vector is not growable");
 
    chunk_t *newChunks = _region != NULL ? (chunk_t*)_region->allocate(chunkSize*sizeof(chunk_t)) : (chunk_t*)TR_Memory::jitPersistentAlloc(chunkSize*sizeof(chunk_t), TR_Memory::BitVector);
-   memset(newChunks, 0, chunkSize*sizeof(chunk_t));
    #ifdef TRACK_TRBITVECTOR_MEMORY
    _memoryUsed += chunkSize*sizeof(chunk_t);
    #endif
+   uint32_t chunksToCopy = 0;
    if (_chunks)
       {
-      uint32_t chunksToCopy = (chunkSize < _numChunks) ? chunkSize : _numChunks;
+      chunksToCopy = (chunkSize < _numChunks) ? chunkSize : _numChunks;
       memcpy(newChunks, _chunks, chunksToCopy*sizeof(chunk_t));
       if(_region == NULL)
          jitPersistentFree(_chunks);
       }
+   memset(newChunks + chunksToCopy, 0, (chunkSize - chunksToCopy)*sizeof(chunk_t));
 
    _chunks = newChunks;
    _numChunks = chunkSize;
@@ -45,6 +45,13 @@ typedef uint32_t chunk_t;
 
 #define BV_SANITY_CHECK 0
 
+// x86-64 always has SSE2, so whole-vector operations work on 128 bits at a time
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+#define BITVECTOR_SSE2
+#include <emmintrin.h>
+#define CHUNKS_PER_VECTOR (int32_t)(sizeof(__m128i)/sizeof(chunk_t))
+#endif
+
 enum TR_BitContainerType
    {
    singleton,
@@ -346,7 +353,7 @@ class TR_BitVector
       TR_ASSERT(n >= 0, "assertion failure");
       int32_t chunkIndex = getChunkIndex(n);
       if (chunkIndex >= _numChunks)
-         setChunkSize(chunkIndex+1);
+         growChunkSize(chunkIndex);
       if (chunkIndex < _firstChunkWithNonZero)
          _firstChunkWithNonZero = chunkIndex;
       if (chunkIndex > _lastChunkWithNonZero)
@@ -386,7 +393,9 @@ class TR_BitVector
          return;
       if (_chunks[chunkIndex]) {
         _chunks[chunkIndex] &= ~getBitMask(n);
-        if (updateLowHigh && _chunks[chunkIndex] == 0)
+        // Emptying an interior chunk cannot move either end of the non-zero range
+        if (updateLowHigh && _chunks[chunkIndex] == 0
+            && (chunkIndex == _firstChunkWithNonZero || chunkIndex == _lastChunkWithNonZero))
           resetLowAndHighChunks(_firstChunkWithNonZero, _lastChunkWithNonZero);
       }
 
@@ -430,12 +439,12 @@ class TR_BitVector
          {
          // Copy all of the used words from the 2nd vector
          int32_t low = v2._firstChunkWithNonZero;
-         for (i = _firstChunkWithNonZero; i < low; i++)
-            _chunks[i] = 0;
-         for (i = low ; i <= high; i++)
-            _chunks[i] = v2._chunks[i];
-         for (i = high+1; i <= _lastChunkWithNonZero; i++)
-            _chunks[i] = 0;
+         if (_firstChunkWithNonZero < low)
+            memset(_chunks + _firstChunkWithNonZero, 0, (low - _firstChunkWithNonZero) * sizeof(chunk_t));
+         if (_chunks != v2._chunks)
+            memcpy(_chunks + low, v2._chunks + low, (high - low + 1) * sizeof(chunk_t));
+         if (high < _lastChunkWithNonZero)
+            memset(_chunks + high + 1, 0, (_lastChunkWithNonZero - high) * sizeof(chunk_t));
          _firstChunkWithNonZero = low;
          _lastChunkWithNonZero = high;
          }
@@ -458,8 +467,7 @@ class TR_BitVector
          setChunkSize(v2Used);
 
       // OR in all of the words from the 2nd vector
-      for (int32_t i = v2._firstChunkWithNonZero; i <= v2._lastChunkWithNonZero; i++)
-         _chunks[i] |= v2._chunks[i];
+      orChunks(_chunks, v2._chunks, v2._firstChunkWithNonZero, v2._lastChunkWithNonZero);
       if (_firstChunkWithNonZero > v2._firstChunkWithNonZero)
          _firstChunkWithNonZero = v2._firstChunkWithNonZero;
       if (_lastChunkWithNonZero < v2._lastChunkWithNonZero)
@@ -514,8 +522,7 @@ class TR_BitVector
          }
 
       // AND in all of the words from the 2nd vector
-      for (i = low; i <= high; i++)
-         _chunks[i] &= v2._chunks[i];
+      andChunks(_chunks, v2._chunks, low, high);
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(low, high);
@@ -540,10 +547,7 @@ class TR_BitVector
          low = _firstChunkWithNonZero;
       if (high > _lastChunkWithNonZero)
          high = _lastChunkWithNonZero;
-      for (int32_t i = low; i<= high; i++)
-         if (_chunks[i] & v2._chunks[i])
-            return true;
-      return false;
+      return anyChunksIntersect(_chunks, v2._chunks, low, high);
       }
 
    // Perform a bitwise negation (AND-NOT) between this vector and a second vector
@@ -563,8 +567,7 @@ class TR_BitVector
          low = _firstChunkWithNonZero;
       if (high > _lastChunkWithNonZero)
          high = _lastChunkWithNonZero;
-      for (int32_t i = low; i<= high; i++)
-         _chunks[i] &= ~v2._chunks[i];
+      andNotChunks(_chunks, v2._chunks, low, high);
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(_firstChunkWithNonZero, _lastChunkWithNonZero);
@@ -604,10 +607,7 @@ class TR_BitVector
          return false;
       if (_lastChunkWithNonZero != v2._lastChunkWithNonZero)
          return false;
-      for (int32_t i = _firstChunkWithNonZero; i <= _lastChunkWithNonZero; i++)
-         if (_chunks[i] != v2._chunks[i])
-            return false;
-      return true;
+      return allChunksEqual(_chunks, v2._chunks, _firstChunkWithNonZero, _lastChunkWithNonZero);
       }
 
    bool operator!= (TR_BitVector& v2){ return !operator==(v2); }
@@ -709,8 +709,8 @@ class TR_BitVector
    //
    void empty()
       {
-      for (int32_t i = _firstChunkWithNonZero; i <= _lastChunkWithNonZero; i++)
-         _chunks[i] = 0;
+      if (_lastChunkWithNonZero >= 0)
+         memset(_chunks + _firstChunkWithNonZero, 0, (_lastChunkWithNonZero - _firstChunkWithNonZero + 1) * sizeof(chunk_t));
       _firstChunkWithNonZero = _numChunks;
       _lastChunkWithNonZero = -1;
 #if BV_SANITY_CHECK
@@ -962,6 +962,114 @@ class TR_BitVector
    // given chunk index
    //
    void setChunkSize(int32_t chunkSize);
+
+   // Grow the chunk array to hold the given chunk index, with room to spare so
+   // that setting an increasing run of bits does not re-allocate for each chunk
+   //
+   void growChunkSize(int32_t chunkIndex)
+      {
+      int32_t chunkSize = _numChunks + (_numChunks >> 1);
+      setChunkSize(chunkSize > chunkIndex ? chunkSize : chunkIndex+1);
+      }
+
+   // Word operations over chunks [low, high] of two vectors. The two arrays may
+   // be the same array, since each chunk is only combined with its counterpart.
+   //
+   static void orChunks(chunk_t *target, const chunk_t *source, int32_t low, int32_t high)
+      {
+      int32_t i = low;
+#if defined(BITVECTOR_SSE2)
+      for ( ; i + CHUNKS_PER_VECTOR <= high + 1; i += CHUNKS_PER_VECTOR)
+         {
+         __m128i t = _mm_loadu_si128((const __m128i *)(target + i));
+         __m128i s = _mm_loadu_si128((const __m128i *)(source + i));
+         _mm_storeu_si128((__m128i *)(target + i), _mm_or_si128(t, s));
+         }
+#endif
+      for ( ; i <= high; i++)
+         target[i] |= source[i];
+      }
+
+   static void andChunks(chunk_t *target, const chunk_t *source, int32_t low, int32_t high)
+      {
+      int32_t i = low;
+#if defined(BITVECTOR_SSE2)
+      for ( ; i + CHUNKS_PER_VECTOR <= high + 1; i += CHUNKS_PER_VECTOR)
+         {
+         __m128i t = _mm_loadu_si128((const __m128i *)(target + i));
+         __m128i s = _mm_loadu_si128((const __m128i *)(source + i));
+         _mm_storeu_si128((__m128i *)(target + i), _mm_and_si128(t, s));
+         }
+#endif
+      for ( ; i <= high; i++)
+         target[i] &= source[i];
+      }
+
+   static void andNotChunks(chunk_t *target, const chunk_t *source, int32_t low, int32_t high)
+      {
+      int32_t i = low;
+#if defined(BITVECTOR_SSE2)
+      for ( ; i + CHUNKS_PER_VECTOR <= high + 1; i += CHUNKS_PER_VECTOR)
+         {
+         __m128i t = _mm_loadu_si128((const __m128i *)(target + i));
+         __m128i s = _mm_loadu_si128((const __m128i *)(source + i));
+         _mm_storeu_si128((__m128i *)(target + i), _mm_andnot_si128(s, t));
+         }
+#endif
+      for ( ; i <= high; i++)
+         target[i] &= ~source[i];
+      }
+
+   static bool anyChunksIntersect(const chunk_t *a, const chunk_t *b, int32_t low, int32_t high)
+      {
+      int32_t i = low;
+#if defined(BITVECTOR_SSE2)
+      const __m128i zero = _mm_setzero_si128();
+      for ( ; i + CHUNKS_PER_VECTOR <= high + 1; i += CHUNKS_PER_VECTOR)
+         {
+         __m128i common = _mm_and_si128(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+         if (_mm_movemask_epi8(_mm_cmpeq_epi8(common, zero)) != 0xFFFF)
+            return true;
+         }
+#endif
+      for ( ; i <= high; i++)
+         if (a[i] & b[i])
+            return true;
+      return false;
+      }
+
+   static bool allChunksEqual(const chunk_t *a, const chunk_t *b, int32_t low, int32_t high)
+      {
+      int32_t i = low;
+#if defined(BITVECTOR_SSE2)
+      for ( ; i + CHUNKS_PER_VECTOR <= high + 1; i += CHUNKS_PER_VECTOR)
+         {
+         __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i)));
+         if (_mm_movemask_epi8(same) != 0xFFFF)
+            return false;
+         }
+#endif
+      for ( ; i <= high; i++)
+         if (a[i] != b[i])
+            return false;
+      return true;
+      }
+
+   // Given a non-zero chunk, calculate the index within the chunk of its first set bit
+   //
+   static int32_t getFirstIndexInChunk(chunk_t chunk)
+      {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(BITVECTOR_BIT_NUMBERING_MSB)
+      return BITS_IN_CHUNK == 64 ? __builtin_clzll((unsigned long long)chunk) : __builtin_clz((unsigned int)chunk);
+#elif defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll((unsigned long long)chunk);
+#else
+      int32_t bitIndex = 0;
+      for (chunk_t mask = getBitMask(0); !(chunk & mask); mask = incrementBitMask(mask))
+         bitIndex++;
+      return bitIndex;
+#endif
+      }
    };
 
 class TR_BitVectorIterator
@@ -1036,7 +1144,6 @@ class TR_BitVectorIterator
       if (tmpChunk == ~(chunk_t) 0)
          return;
 
-      chunk_t  mask = TR_BitVector::getBitMask(_curIndex);
       // zero the trailing bits from the chunk
       //tmpChunk &= ~(mask - 1);
       tmpChunk &= TR_BitVector::getBitMask(_curIndex, BITS_IN_CHUNK-1);
@@ -1054,17 +1161,10 @@ class TR_BitVectorIterator
             curChunk++;
          } while(! _bitVector->_chunks[curChunk]);
          tmpChunk = _bitVector->_chunks[curChunk];
-         _curIndex = curChunk << SHIFT;
-         mask = TR_BitVector::getBitMask(0);
-         }
-      // here we are guaranteed to have a chunk with at least one bit set
-
-      //_curIndex = (_curIndex & ~(TR_BitVector::_numBitsChunk-1)) + TrailingZero(tmpChunk);
-      while (!(tmpChunk & mask)) // sequential check
-         {
-         _curIndex++;
-         mask = TR_BitVector::incrementBitMask(mask);
          }
+      // here we are guaranteed to have a chunk with at least one bit set, and none
+      // before _curIndex
+      _curIndex = (curChunk << SHIFT) + TR_BitVector::getFirstIndexInChunk(tmpChunk);
       }
 
    TR_BitVector *_bitVector;
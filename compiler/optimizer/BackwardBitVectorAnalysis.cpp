@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2017 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -1432,6 +1432,8 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeNode
 
 template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBlockStructure(TR_BlockStructure *blockStructure, bool checkForChange)
    {
+   this->_numberOfBlockVisits++;
+
    initializeInfo(this->_regularInfo);
    initializeInfo(this->_exceptionInfo);
 
@@ -1582,6 +1584,31 @@ template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBloc
 
 
 
+// Set the current out set along each edge of a block to the in set of the
+// successor and analyze the block. Successors that have not been analyzed
+// yet contribute the initial information.
+// Returns true if the in set of the block changed.
+//
+template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::analyzeBlockFromWorklist(TR_BlockStructure *blockStructure)
+   {
+   TR::Block *block = blockStructure->getBlock();
+   bool firstVisit = !blockStructure->hasBeenAnalyzedBefore();
+
+   TR_SuccessorIterator successors(block);
+   for (auto succ = successors.getFirst(); succ; succ = successors.getNext())
+      {
+      int32_t succNum = succ->getTo()->getNumber();
+      TR_BlockStructure *succStructure = toBlock(succ->getTo())->getStructureOf();
+      if (succStructure && succStructure->hasBeenAnalyzedBefore())
+         this->copyFromInto(this->getAnalysisInfo(succStructure)->_inSetInfo, _currentOutSetInfo[succNum]);
+      else
+         this->initializeInfo(_currentOutSetInfo[succNum]);
+      }
+
+   bool changed = blockStructure->doDataFlowAnalysis(this, true);
+   return changed || firstVisit;
+   }
+
 template<class Container>void TR_BackwardDFSetAnalysis<Container *>::analyzeNode(TR::Node *node, vcount_t visitCount, TR_BlockStructure *blockStructure, Container *_analysisInfo)
    {
    }
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2017 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -26,6 +26,7 @@
 #include "control/Options.hpp"
 #include "control/Options_inlines.hpp"
 #include "env/TRMemory.hpp"                         // for BitVector, etc
+#include "env/VerboseLog.hpp"                       // for TR_VerboseLog
 #include "il/Block.hpp"                             // for Block, toBlock
 #include "il/Node.hpp"                              // for Node, etc
 #include "il/TreeTop.hpp"                           // for TreeTop
@@ -34,6 +35,7 @@
 #include "infra/Cfg.hpp"                            // for CFG
 #include "infra/Link.hpp"                           // for TR_LinkHead
 #include "infra/List.hpp"
+#include "infra/Stack.hpp"                          // for TR_Stack
 #include "infra/CfgEdge.hpp"                        // for CFGEdge
 #include "infra/CfgNode.hpp"                        // for CFGNode
 #include "optimizer/Structure.hpp"
@@ -92,6 +94,239 @@ performAnalysis(TR_Structure *rootStructure,
    return true;
    }
 
+template<class Container>
+bool
+TR_BasicDFSetAnalysis<Container *>::
+useWorklistSolver()
+   {
+   return comp()->getOption(TR_EnableWorklistDataFlowSolver) && canUseWorklistSolver();
+   }
+
+// Solve the analysis over the given root structure. The structural solver
+// is used unless the worklist solver is enabled; when the worklist solver is
+// being verified both are run and the resulting block in sets are compared.
+template<class Container>
+bool
+TR_BasicDFSetAnalysis<Container *>::
+doAnalysis(TR_Structure *rootStructure, bool checkForChanges)
+   {
+   bool verify = useWorklistSolver() && comp()->getOption(TR_VerifyWorklistDataFlowSolver);
+   bool traceSolver = trace() || traceBVA() || comp()->getOption(TR_TraceBBVA);
+   bool verboseSolver = TR::Options::getVerboseOption(TR_VerbosePerformance);
+   bool changed;
+   int32_t structuralVisits = 0;
+   Container **structuralInSets = NULL;
+
+   _numberOfBlockVisits = 0;
+   if (!useWorklistSolver() || verify)
+      {
+      changed = rootStructure->doDataFlowAnalysis(this, checkForChanges);
+      structuralVisits = _numberOfBlockVisits;
+      if (traceSolver)
+         traceMsg(comp(), "%s solved by the structural solver in %d block visits\n", getAnalysisName(), structuralVisits);
+      if (verboseSolver)
+         TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "%s: structural solver, %d block visits, %s",
+            getAnalysisName(), structuralVisits, comp()->signature());
+      if (!verify)
+         return changed;
+
+      structuralInSets = (Container **)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(Container *));
+      memset(structuralInSets, 0, _numberOfNodes*sizeof(Container *));
+      for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+         {
+         TR_BlockStructure *blockStructure = toBlock(node)->getStructureOf();
+         if (blockStructure && blockStructure->hasBeenAnalyzedBefore())
+            {
+            this->allocateContainer(&structuralInSets[node->getNumber()]);
+            this->copyFromInto(getAnalysisInfo(blockStructure)->_inSetInfo, structuralInSets[node->getNumber()]);
+            }
+         }
+
+      rootStructure->resetAnalyzedStatus();
+      _numberOfBlockVisits = 0;
+      }
+
+   // The worklist solver never summarizes regions, so it must not rely on
+   // region summaries computed by the structural solver when verifying.
+   //
+   bool hadImproperRegion = _hasImproperRegion;
+   _hasImproperRegion = true;
+   changed = solveWithWorklist();
+   _hasImproperRegion = hadImproperRegion;
+
+   if (traceSolver)
+      traceMsg(comp(), "%s solved by the worklist solver in %d block visits over %d passes\n", getAnalysisName(), _numberOfBlockVisits, _numberOfWorklistPasses);
+   if (verboseSolver)
+      TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "%s: worklist solver, %d block visits, %d passes, %s",
+         getAnalysisName(), _numberOfBlockVisits, _numberOfWorklistPasses, comp()->signature());
+
+   if (verify)
+      {
+      for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+         {
+         TR_BlockStructure *blockStructure = toBlock(node)->getStructureOf();
+         if (!blockStructure)
+            continue;
+         Container *structuralInSet = structuralInSets[node->getNumber()];
+         bool same;
+         if (!blockStructure->hasBeenAnalyzedBefore())
+            same = (structuralInSet == NULL);
+         else
+            same = structuralInSet && (*structuralInSet == *getAnalysisInfo(blockStructure)->_inSetInfo);
+         TR_ASSERT_FATAL(same, "%s: worklist solver result differs from structural solver at block_%d in %s",
+            getAnalysisName(), node->getNumber(), comp()->signature());
+         }
+      }
+
+   return changed;
+   }
+
+// Order the blocks with structure in reverse postorder of the direction of
+// the analysis, so that a block is normally visited after its inputs.
+// Returns the number of blocks ordered; priority[n] is the position of
+// block n in the order, or -1 if block n has no structure.
+template<class Container>
+int32_t
+TR_BasicDFSetAnalysis<Container *>::
+computeWorklistOrder(TR::Block **order, int32_t *priority)
+   {
+   enum { Unvisited, InProgress, Done };
+   uint8_t *state = (uint8_t *)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(uint8_t));
+   memset(state, Unvisited, _numberOfNodes*sizeof(uint8_t));
+
+   int32_t numBlocks = 0;
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      priority[node->getNumber()] = -1;
+      if (toBlock(node)->getStructureOf())
+         numBlocks++;
+      }
+
+   bool forward = isForwardAnalysis();
+   TR_Stack<TR::CFGNode *> stack(trMemory(), 32, false, stackAlloc);
+   int32_t next = numBlocks;
+   TR::CFGNode *root = forward ? _cfg->getStart() : _cfg->getEnd();
+   TR::CFGNode *node = _cfg->getFirstNode();
+   while (true)
+      {
+      if (!root)
+         {
+         // Pick up blocks that cannot be reached from the start (or cannot
+         // reach the end for a backward analysis).
+         for (; node && (state[node->getNumber()] != Unvisited || !toBlock(node)->getStructureOf()); node = node->getNext())
+            ;
+         if (!node)
+            break;
+         root = node;
+         }
+
+      if (toBlock(root)->getStructureOf())
+         stack.push(root);
+      root = NULL;
+
+      while (!stack.isEmpty())
+         {
+         TR::CFGNode *current = stack.top();
+         uint8_t &currentState = state[current->getNumber()];
+         if (currentState == Unvisited)
+            {
+            currentState = InProgress;
+            TR::CFGEdgeList *lists[2];
+            lists[0] = forward ? &current->getSuccessors() : &current->getPredecessors();
+            lists[1] = forward ? &current->getExceptionSuccessors() : &current->getExceptionPredecessors();
+            for (int32_t i = 0; i < 2; i++)
+               {
+               for (auto edge = lists[i]->begin(); edge != lists[i]->end(); ++edge)
+                  {
+                  TR::CFGNode *other = forward ? (*edge)->getTo() : (*edge)->getFrom();
+                  if (state[other->getNumber()] == Unvisited && toBlock(other)->getStructureOf())
+                     stack.push(other);
+                  }
+               }
+            }
+         else
+            {
+            stack.pop();
+            if (currentState == InProgress)
+               {
+               currentState = Done;
+               order[--next] = toBlock(current);
+               priority[current->getNumber()] = next;
+               }
+            }
+         }
+      }
+
+   TR_ASSERT(next == 0, "worklist order is missing %d blocks\n", next);
+   return numBlocks;
+   }
+
+// Visit blocks from a worklist kept in reverse postorder. Each pass walks
+// forward through the order visiting only the pending blocks; when the
+// result of a block changes, the blocks that consume it are added to the
+// current pass if they come later in the order and to the next pass
+// otherwise (i.e. along a back edge). Since blocks are only ever added
+// ahead of the current position, a single cursor finds every pending block
+// and a pass costs one walk of the order.
+template<class Container>
+bool
+TR_BasicDFSetAnalysis<Container *>::
+solveWithWorklist()
+   {
+   TR::Block **order = (TR::Block **)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(TR::Block *));
+   int32_t *priority = (int32_t *)trMemory()->allocateStackMemory(_numberOfNodes*sizeof(int32_t));
+   int32_t numBlocks = computeWorklistOrder(order, priority);
+
+   TR_BitVector pending(numBlocks, trMemory(), stackAlloc);
+   TR_BitVector nextPass(numBlocks, trMemory(), stackAlloc);
+   nextPass.setAll(numBlocks);
+
+   bool forward = isForwardAnalysis();
+   bool anyBlockChanged = false;
+   int32_t iterations = 0;
+   _numberOfWorklistPasses = 0;
+   while (!nextPass.isEmpty())
+      {
+      pending = nextPass;
+      nextPass.empty();
+      _numberOfWorklistPasses++;
+
+      for (int32_t index = 0; index < numBlocks; index++)
+         {
+         if (!pending.isSet(index))
+            continue;
+
+         if ((++iterations % 20) == 0 &&
+             comp()->compilationShouldBeInterrupted(forward ? FBVA_ANALYZE_CONTEXT : BBVA_ANALYZE_CONTEXT))
+            {
+            comp()->failCompilation<TR::CompilationInterrupted>("interrupted in bit vector analysis worklist");
+            }
+
+         TR::Block *block = order[index];
+         if (!analyzeBlockFromWorklist(block->getStructureOf()))
+            continue;
+
+         anyBlockChanged = true;
+         TR::CFGEdgeList *lists[2];
+         lists[0] = forward ? &block->getSuccessors() : &block->getPredecessors();
+         lists[1] = forward ? &block->getExceptionSuccessors() : &block->getExceptionPredecessors();
+         for (int32_t i = 0; i < 2; i++)
+            {
+            for (auto edge = lists[i]->begin(); edge != lists[i]->end(); ++edge)
+               {
+               int32_t otherIndex = priority[(forward ? (*edge)->getTo() : (*edge)->getFrom())->getNumber()];
+               if (otherIndex > index)
+                  pending.set(otherIndex);
+               else if (otherIndex >= 0)
+                  nextPass.set(otherIndex);
+               }
+            }
+         }
+      }
+
+   return anyBlockChanged;
+   }
+
 template<class Container>
 void
 TR_BasicDFSetAnalysis<Container *>::
@@ -164,6 +399,14 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
    else
       _hasImproperRegion = true;
 
+   // The worklist solver works on blocks only, so there is no need to
+   // summarize gen and kill sets for regions. When verifying it the
+   // structural solver runs first and still uses the summaries.
+   //
+   if (useWorklistSolver() &&
+       !comp()->getOption(TR_VerifyWorklistDataFlowSolver))
+      _hasImproperRegion = true;
+
    if (comp()->getVisitCount() > HIGH_VISIT_COUNT)
       {
       comp()->resetVisitCounts(1);
@@ -1388,6 +1631,8 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeNodeI
 
 template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlockStructure(TR_BlockStructure *blockStructure, bool checkForChange)
    {
+   this->_numberOfBlockVisits++;
+
    if (this->supportsGenAndKillSets() &&
        canGenAndKillForStructure(blockStructure))
       {
@@ -1519,6 +1764,35 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlock
 
 
 
+// Compute the in set of a block from the out sets of its predecessors and
+// analyze it. Predecessors that have not been analyzed yet are skipped, as
+// they are by the structural solver on the first pass over a loop.
+// Returns true if the out sets of the block changed.
+//
+template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeBlockFromWorklist(TR_BlockStructure *blockStructure)
+   {
+   TR::Block *block = blockStructure->getBlock();
+   bool firstVisit = !blockStructure->hasBeenAnalyzedBefore();
+
+   initializeInSetInfo();
+   TR_PredecessorIterator predecessors(block);
+   for (auto pred = predecessors.getFirst(); pred; pred = predecessors.getNext())
+      {
+      TR_BlockStructure *predStructure = toBlock(pred->getFrom())->getStructureOf();
+      if (!predStructure || !predStructure->hasBeenAnalyzedBefore())
+         continue;
+
+      typename TR_BasicDFSetAnalysis<Container *>::ExtraAnalysisInfo *predInfo = this->getAnalysisInfo(predStructure);
+      compose(_currentInSetInfo, predInfo->getContainer(predInfo->_outSetInfo, block->getNumber()));
+      }
+
+   if (block == this->_cfg->getStart())
+      compose(_currentInSetInfo, _originalInSetInfo);
+
+   bool changed = blockStructure->doDataFlowAnalysis(this, true);
+   return changed || firstVisit;
+   }
+
 template<class Container>void TR_ForwardDFSetAnalysis<Container *>::analyzeBlockZeroStructure(TR_BlockStructure *blockStructure)
    {
    analyzeTreeTopsInBlockStructure(blockStructure);
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2017 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -40,7 +40,6 @@ class TR_RedundantExpressionAdjustment;
 // that may be of use for any dataflow analysis.
 //
 //
-#ifdef DEBUG
 static char *analysisNames[] =
    { "ReachingDefinitions",
      "AvailableExpressions",
@@ -69,8 +68,6 @@ static char *analysisNames[] =
 
 char* TR_DataFlowAnalysis::getAnalysisName() { return analysisNames[this->getKind()]; }
 
-#endif
-
 TR_ExceptionCheckMotion           *TR_DataFlowAnalysis::asExceptionCheckMotion()
    {return NULL;}
 TR_RedundantExpressionAdjustment *TR_DataFlowAnalysis::asRedundantExpressionAdjustment()
@@ -157,11 +157,7 @@ class TR_DataFlowAnalysis
       #include "optimizer/DataFlowAnalysis.enum"
       };
 
-   #ifdef DEBUG
-      char *getAnalysisName();
-   #else
-      char *getAnalysisName() { return 0; }
-   #endif
+   char *getAnalysisName();
 
    virtual Kind getKind() = 0;
 
@@ -253,6 +249,8 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
       _blockAnalysisInfo    = 0;
       _hasImproperRegion    = false;
       _nodesInCycle         = NULL;
+      _numberOfBlockVisits  = 0;
+      _numberOfWorklistPasses = 0;
       }
 
    bool traceBVA() { return _traceBVA;}
@@ -280,10 +278,18 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
    // Returns true if the analysis is to continue
    virtual bool postInitializationProcessing() {return true;}
 
-   bool doAnalysis(TR_Structure *rootStructure, bool checkForChanges)
-      {
-      return rootStructure->doDataFlowAnalysis(this, checkForChanges);
-      }
+   bool doAnalysis(TR_Structure *rootStructure, bool checkForChanges);
+
+   // Worklist solver: instead of iterating over the structure, visit blocks
+   // in reverse postorder and only revisit a block when one of its inputs
+   // has changed. Enabled with TR_EnableWorklistDataFlowSolver.
+   //
+   bool useWorklistSolver();
+   virtual bool canUseWorklistSolver() { return true; }
+   virtual bool isForwardAnalysis() = 0;
+   virtual bool analyzeBlockFromWorklist(TR_BlockStructure *) = 0;
+   bool solveWithWorklist();
+   int32_t computeWorklistOrder(TR::Block **order, int32_t *priority);
 
    virtual void initializeDFSetAnalysis() = 0;
 
@@ -360,6 +366,8 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
    int32_t _maxReferenceNumber;
    TR::Node **_supportedNodesAsArray;
    bool _hasImproperRegion;
+   int32_t _numberOfBlockVisits;
+   int32_t _numberOfWorklistPasses;
    };
 
 
@@ -389,6 +397,8 @@ template<class Container>class TR_ForwardDFSetAnalysis<Container *> :
    virtual bool analyzeBlockStructure(TR_BlockStructure *, bool);
    virtual void analyzeBlockZeroStructure(TR_BlockStructure *);
    virtual bool analyzeRegionStructure(TR_RegionStructure *, bool);
+   virtual bool isForwardAnalysis() { return true; }
+   virtual bool analyzeBlockFromWorklist(TR_BlockStructure *);
 
    virtual void compose(Container *, Container *);
    virtual void inverseCompose(Container *, Container *);
@@ -531,6 +541,8 @@ template<class Container>class TR_BackwardDFSetAnalysis<Container *> :
 
    virtual bool analyzeBlockStructure(TR_BlockStructure *, bool);
    virtual bool analyzeRegionStructure(TR_RegionStructure *, bool);
+   virtual bool isForwardAnalysis() { return false; }
+   virtual bool analyzeBlockFromWorklist(TR_BlockStructure *);
 
    virtual void compose(Container *, Container *);
    virtual void inverseCompose(Container *, Container *) {}
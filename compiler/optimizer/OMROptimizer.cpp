@@ -111,6 +111,7 @@
 #include "optimizer/ReorderIndexExpr.hpp"
 #include "optimizer/GlobalRegisterAllocator.hpp"
 #include "optimizer/RecognizedCallTransformer.hpp"
+#include "env/CompilePhaseProfiler.hpp"
 #include "env/RegionProfiler.hpp"
 
 #if defined (_MSC_VER) && _MSC_VER < 1900
@@ -1974,6 +1975,7 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
 #endif
       LexicalTimer t(manager->name(), comp()->phaseTimer());
       TR::LexicalMemProfiler mp(manager->name(), comp()->phaseMemProfiler());
+      TR::CompilePhaseProfiler pp(*comp(), TR::CompilePhaseProfile::Optimization, optNum, getOptimizationName(optNum));
       comp()->setAllocatorName(manager->name());
 
       int32_t origSymRefCount = comp()->getSymRefCount();
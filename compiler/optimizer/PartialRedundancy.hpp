@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2000, 2017 IBM Corp. and others
+ * Copyright (c) 2000, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -292,6 +292,7 @@ class TR_RedundantExpressionAdjustment
    virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, ContainerType *);
    ////virtual void analyzeTreeTopsInBlockStructure(TR_BlockStructure *);
    virtual bool analyzeBlockStructure(TR_BlockStructure *, bool);
+   virtual bool canUseWorklistSolver() { return false; }
    virtual bool postInitializationProcessing();
 
    private:
@@ -254,6 +254,41 @@ OMR::CodeCache::resizeCodeMemory(void *memoryBlock, size_t newSize)
    }
 
 
+// Free a block of code memory (with a method header) allocated from this code cache,
+// e.g. a method body that was compiled but never published
+//
+void
+OMR::CodeCache::freeCodeMemory(void *memoryBlock)
+   {
+   TR::CodeCacheConfig & config = _manager->codeCacheConfig();
+
+   CodeCacheMethodHeader *cacheHeader = (CodeCacheMethodHeader *) ((uint8_t *) memoryBlock - sizeof(CodeCacheMethodHeader));
+
+   // sanity check, the eyecatcher must be there
+   TR_ASSERT(cacheHeader->_eyeCatcher[0] == config.warmEyeCatcher()[0], "Missing eyecatcher during freeCodeMemory");
+
+   // Other compilations may be allocating from this cache
+   CacheCriticalSection freeing(self());
+
+   uint8_t *blockEnd = (uint8_t *) cacheHeader + cacheHeader->_size;
+   if (config.verboseReclamation())
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE,"--freeCodeMemory-- CC=%p cacheHeader=%p size=%u", this, cacheHeader, cacheHeader->_size);
+      }
+
+   if (blockEnd == _warmCodeAlloc)
+      {
+      // the last block allocated from the warm heap can simply be given back
+      _manager->increaseFreeSpaceInCodeCacheRepository(cacheHeader->_size);
+      _warmCodeAlloc = (uint8_t *) cacheHeader;
+      }
+   else
+      {
+      self()->addFreeBlock2((uint8_t *) cacheHeader, blockEnd);
+      }
+   }
+
+
 // Initialize a code cache
 //
 bool
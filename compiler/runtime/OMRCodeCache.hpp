@@ -117,6 +117,7 @@ public:
                                bool needsToBeContiguous,
                                bool isMethodHeaderNeeded=true);
    bool resizeCodeMemory(void *memoryBlock, size_t newSize);
+   void freeCodeMemory(void *memoryBlock);
 
    CodeCacheMethodHeader *addFreeBlock(void *metaData);
 
@@ -690,6 +690,16 @@ OMR::CodeCacheManager::addFreeBlock(void *metaData, uint8_t *startPC)
    }
 
 
+void
+OMR::CodeCacheManager::freeCodeMemory(void *memoryBlock)
+   {
+   TR::CodeCache *owningCodeCache = self()->findCodeCacheFromPC(memoryBlock);
+   TR_ASSERT(owningCodeCache, "Freeing code memory %p that is not in any code cache", memoryBlock);
+   if (owningCodeCache)
+      owningCodeCache->freeCodeMemory(memoryBlock);
+   }
+
+
 #ifdef CODECACHE_STATS
 #include "infra/Statistics.hpp"
 TR_StatsHisto<3> statNumReservedCaches("Caches already reserved", 1, 4);
@@ -171,6 +171,13 @@ public:
                                 bool needsToBeContiguous,
                                 bool isMethodHeaderNeeded=true);
 
+   /**
+    * @brief Return a block obtained from allocateCodeMemory() to the free list of its code cache
+    * The code in the block must no longer be reachable.
+    * @param memoryBlock the warm code address returned by allocateCodeMemory()
+    */
+   void freeCodeMemory(void *memoryBlock);
+
    TR::CodeCache * findCodeCacheFromPC(void *inCacheAddress);
 
    CodeCacheTrampolineCode * findMethodTrampoline(TR_OpaqueMethodBlock *method, void *callingPC);
@@ -0,0 +1,658 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/PersistentMethodCache.hpp"
+
+#include <map>
+#include <vector>
+#include <new>
+#include <string.h>
+#if defined(LINUX)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "AtomicSupport.hpp"
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/StaticRelocation.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/ResolvedMethod.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/TRMemory.hpp"
+#include "env/VerboseLog.hpp"
+#include "il/Block.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "il/symbol/ParameterSymbol.hpp"
+#include "il/symbol/ResolvedMethodSymbol.hpp"
+#include "il/symbol/StaticSymbol.hpp"
+#include "infra/Assert.hpp"
+#include "infra/List.hpp"
+
+// The file is created sparse, so this only bounds how much code it can hold
+#define METHOD_CACHE_FILE_SIZE (64 * 1024 * 1024)
+
+// Bump whenever the layout of the file or the IL hash changes
+#define METHOD_CACHE_FORMAT_VERSION 1
+
+#define METHOD_CACHE_BUILD_NAME_LENGTH 64
+
+TR::PersistentMethodCache *TR::PersistentMethodCache::_instance = NULL;
+
+struct TR::PersistentMethodCache::FileHeader
+   {
+   char _eyecatcher[8];
+   uint32_t _formatVersion;
+   uint32_t _pointerSize;
+   char _buildName[METHOD_CACHE_BUILD_NAME_LENGTH];   ///< TR_BUILD_NAME of the JIT that wrote the file
+   uint32_t _processorSignature;
+   uint32_t _processorFeatures[3];
+   uint64_t _used;                                     ///< bytes of the file holding the header and complete entries
+   };
+
+/**
+ * A cached body, followed by its relocations, the names they refer to and the
+ * code itself, starting at _codeOffset.  Entries are 8 byte aligned.
+ */
+struct TR::PersistentMethodCache::Entry
+   {
+   uint64_t _hash;
+   uint64_t _check;
+   uint32_t _size;             ///< bytes in the entry, including everything that follows it
+   uint32_t _codeOffset;       ///< offset of the code from the start of the entry
+   uint32_t _codeSize;         ///< bytes from the start of the binary buffer to the end of the code
+   uint32_t _entryPointOffset; ///< offset of the method's entry point into the binary buffer
+   uint32_t _numRelocations;
+   uint32_t _padding;
+   };
+
+/**
+ * An absolute 64 bit address of a call target, written at _offset into the binary buffer
+ */
+struct TR::PersistentMethodCache::Relocation
+   {
+   uint32_t _offset;
+   uint32_t _symbolOffset;     ///< offset of the target's NUL terminated name from the start of the entry
+   };
+
+static const char methodCacheEyecatcher[8] = { 'O', 'M', 'R', 'M', 'C', 'A', 'C', 'H' };
+
+namespace
+{
+
+/**
+ * Two independent 64 bit hashes over the same sequence of values: FNV-1a,
+ * and a multiply-rotate hash in the style of MurmurHash.
+ */
+class ILHasher
+   {
+public:
+   ILHasher() : _hash(14695981039346656037ULL), _check(0x9E3779B97F4A7C15ULL) {}
+
+   void add(uint64_t value)
+      {
+      for (int32_t i = 0; i < 8; i++)
+         {
+         _hash ^= (value >> (i * 8)) & 0xFF;
+         _hash *= 1099511628211ULL;
+         }
+      _check ^= value * 0x87C37B91114253D5ULL;
+      _check = ((_check << 31) | (_check >> 33)) * 0x4CF5AD432745937FULL;
+      }
+
+   void add(const char *string)
+      {
+      uint64_t length = 0;
+      for (const char *c = string; *c; c++, length++)
+         add(static_cast<uint64_t>(static_cast<uint8_t>(*c)));
+      add(length);
+      }
+
+   uint64_t hash() const { return _hash; }
+   uint64_t check() const { return _check; }
+
+private:
+   uint64_t _hash;
+   uint64_t _check;
+   };
+
+typedef TR::typed_allocator<std::pair<const ncount_t, uint32_t>, TR::Region &> NodeOrdinalAllocator;
+typedef std::map<ncount_t, uint32_t, std::less<ncount_t>, NodeOrdinalAllocator> NodeOrdinals;
+
+// Name and address in this process of each method called directly from the IL
+typedef std::pair<const char *, void *> CallTarget;
+typedef TR::typed_allocator<CallTarget, TR::Region &> CallTargetAllocator;
+typedef std::vector<CallTarget, CallTargetAllocator> CallTargets;
+
+enum SymbolHashKind
+   {
+   NoSymbol,
+   StaticSymbol,
+   DirectCallSymbol,
+   OtherSymbol
+   };
+
+// Hash a node and, the first time it is seen, its children; commoned nodes are
+// hashed as a reference to the order in which they were first seen.  Direct call
+// targets are collected for relocation.  Returns false if the node refers to
+// something the cache cannot relocate.
+bool
+hashNode(TR::Compilation *comp, TR::Node *node, ILHasher &hasher, NodeOrdinals &ordinals, CallTargets &callTargets)
+   {
+   NodeOrdinals::iterator seen = ordinals.find(node->getGlobalIndex());
+   if (seen != ordinals.end())
+      {
+      hasher.add(static_cast<uint64_t>(-1));
+      hasher.add(seen->second);
+      return true;
+      }
+   ordinals.insert(std::make_pair(node->getGlobalIndex(), static_cast<uint32_t>(ordinals.size())));
+
+   TR::ILOpCode &opCode = node->getOpCode();
+   if (opCode.isSwitch())
+      return false; // jump tables hold absolute addresses into the body
+
+   hasher.add(node->getOpCodeValue());
+   hasher.add(node->getDataType().getDataType());
+   hasher.add(node->getNumChildren());
+   hasher.add(node->getFlags().getValue());
+
+   if (opCode.isLoadConst())
+      {
+      switch (node->getDataType())
+         {
+         case TR::Float:
+            hasher.add(node->getFloatBits());
+            break;
+         case TR::Double:
+            hasher.add(node->getDoubleBits());
+            break;
+         case TR::Address:
+            hasher.add(node->getAddress());
+            break;
+         default:
+            if (node->getDataType().isIntegral())
+               hasher.add(node->get64bitIntegralValueAsUnsigned());
+            else
+               return false;
+         }
+      }
+
+   if (node->getOpCodeValue() == TR::BBStart)
+      hasher.add(node->getBlock()->getNumber());
+
+   if (opCode.isBranch())
+      hasher.add(node->getBranchDestination()->getNode()->getBlock()->getNumber());
+
+   if (opCode.hasSymbolReference())
+      {
+      TR::SymbolReference *symRef = node->getSymbolReference();
+      TR::Symbol *symbol = symRef->getSymbol();
+      if (symRef->isUnresolved())
+         return false;
+
+      hasher.add(symRef->getReferenceNumber());
+      hasher.add(symRef->getOffset());
+      hasher.add(symbol->getFlags());
+      hasher.add(symbol->getDataType().getDataType());
+      hasher.add(symbol->getSize());
+
+      if (symbol->isStatic())
+         {
+         hasher.add(StaticSymbol);
+         hasher.add(reinterpret_cast<uintptr_t>(symbol->castToStaticSymbol()->getStaticAddress()));
+         }
+      else if (opCode.isCall() && !opCode.isIndirect())
+         {
+         // Direct calls are relocated by name when the body is loaded
+         TR::ResolvedMethodSymbol *callee = symbol->getResolvedMethodSymbol();
+         if (NULL == callee || NULL == callee->getMethodAddress())
+            return false;
+         const char *name = callee->getResolvedMethod()->externalName(comp->trMemory());
+         hasher.add(DirectCallSymbol);
+         hasher.add(name);
+         callTargets.push_back(CallTarget(name, callee->getMethodAddress()));
+         }
+      else
+         {
+         hasher.add(OtherSymbol);
+         }
+      }
+   else
+      {
+      hasher.add(NoSymbol);
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!hashNode(comp, node->getChild(i), hasher, ordinals, callTargets))
+         return false;
+      }
+   return true;
+   }
+
+// Hashes the value of every numeric and string option, except log file options,
+// which do not affect the generated code
+class OptionHasher : public TR::Options::OptionValueVisitor
+   {
+public:
+   OptionHasher(ILHasher &hasher) : _hasher(hasher) {}
+
+   virtual void visitNumeric(TR::OptionTable *entry, int64_t value)
+      {
+      if (affectsCode(entry))
+         _hasher.add(static_cast<uint64_t>(value));
+      }
+
+   virtual void visitString(TR::OptionTable *entry, const char *value)
+      {
+      if (affectsCode(entry))
+         _hasher.add(NULL != value ? value : "");
+      }
+
+private:
+   static bool affectsCode(TR::OptionTable *entry) { return NULL == entry->helpText || 'L' != entry->helpText[0]; }
+
+   ILHasher &_hasher;
+   };
+
+// Hash the IL of a compilation together with everything else that shapes its code,
+// collecting the direct call targets found along the way
+void
+computeKey(TR::Compilation *comp, TR::PersistentMethodCache::Key &key, CallTargets &callTargets)
+   {
+   ILHasher hasher;
+   TR::ResolvedMethodSymbol *methodSymbol = comp->getJittedMethodSymbol();
+
+   hasher.add(METHOD_CACHE_FORMAT_VERSION);
+   hasher.add(comp->getOptLevel());
+   hasher.add(methodSymbol->getLinkageConvention());
+
+   // Every option bit of the compilation; the low bits of a mask select its word
+   TR::Options *options = comp->getOptions();
+   for (uint32_t word = 0; word <= TR_OWM; word++)
+      {
+      uint64_t bits = 0;
+      for (uint32_t bit = 5; bit < 32; bit++)
+         {
+         if (options->getAnyOption(word | (1u << bit)))
+            bits |= static_cast<uint64_t>(1) << bit;
+         }
+      hasher.add(bits);
+      }
+
+   // and every numeric and string option value
+   OptionHasher optionHasher(hasher);
+   options->visitOptionValues(optionHasher);
+
+   ListIterator<TR::ParameterSymbol> parameters(&methodSymbol->getParameterList());
+   for (TR::ParameterSymbol *parameter = parameters.getFirst(); NULL != parameter; parameter = parameters.getNext())
+      hasher.add(parameter->getDataType().getDataType());
+
+   NodeOrdinals ordinals(std::less<ncount_t>(), comp->trMemory()->currentStackRegion());
+   for (TR::TreeTop *treeTop = comp->getStartTree(); NULL != treeTop; treeTop = treeTop->getNextTreeTop())
+      {
+      if (!hashNode(comp, treeTop->getNode(), hasher, ordinals, callTargets))
+         {
+         key._cacheable = false;
+         return;
+         }
+      }
+
+   key._hash = hasher.hash();
+   key._check = hasher.check();
+   key._cacheable = true;
+   }
+
+void *
+findCallTarget(CallTargets &callTargets, const char *name)
+   {
+   for (CallTargets::iterator it = callTargets.begin(); it != callTargets.end(); ++it)
+      {
+      if (0 == strcmp(name, it->first))
+         return it->second;
+      }
+   return NULL;
+   }
+
+}
+
+TR::PersistentMethodCache::PersistentMethodCache(int fd, uint8_t *base, uint64_t capacity)
+   : _fd(fd),
+     _base(base),
+     _capacity(capacity),
+     _hits(0),
+     _misses(0),
+     _stores(0)
+   {
+   memset(_index, 0, sizeof(_index));
+   MUTEX_INIT(_mutex);
+   }
+
+void
+TR::PersistentMethodCache::initialize()
+   {
+#if defined(LINUX) && defined(TR_HOST_X86) && defined(TR_HOST_64BIT) && defined(TR_TARGET_X86)
+   TR::Options *options = TR::Options::getCmdLineOptions();
+   const char *fileName = options->getMethodCacheFileName();
+   if (NULL != _instance || NULL == fileName)
+      return;
+
+   // Relocatable object files need the static relocations of every body, which loaded bodies lack
+   if (options->getOption(TR_EmitRelocatableELFFile))
+      return;
+
+   int fd = open(fileName, O_RDWR | O_CREAT, 0644);
+   if (fd < 0)
+      return;
+
+   struct stat status;
+   if (0 != flock(fd, LOCK_EX | LOCK_NB)
+       || 0 != fstat(fd, &status)
+       || (status.st_size < METHOD_CACHE_FILE_SIZE && 0 != ftruncate(fd, METHOD_CACHE_FILE_SIZE)))
+      {
+      if (options->getVerboseOption(TR_VerbosePerformance))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Method cache %s is in use or cannot be resized; not caching methods", fileName);
+      close(fd);
+      return;
+      }
+
+   uint64_t capacity = status.st_size > METHOD_CACHE_FILE_SIZE ? status.st_size : METHOD_CACHE_FILE_SIZE;
+   void *base = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (MAP_FAILED == base)
+      {
+      close(fd);
+      return;
+      }
+
+   PersistentMethodCache *cache = new (TR::Compiler->persistentAllocator(), std::nothrow) PersistentMethodCache(fd, static_cast<uint8_t *>(base), capacity);
+   if (NULL == cache)
+      {
+      munmap(base, capacity);
+      close(fd);
+      return;
+      }
+
+   FileHeader expected;
+   memset(&expected, 0, sizeof(expected));
+   memcpy(expected._eyecatcher, methodCacheEyecatcher, sizeof(expected._eyecatcher));
+   expected._formatVersion = METHOD_CACHE_FORMAT_VERSION;
+   expected._pointerSize = sizeof(void *);
+   strncpy(expected._buildName, TR_BUILD_NAME, sizeof(expected._buildName) - 1);
+   expected._processorSignature = TR::Compiler->target.cpu.getX86ProcessorSignature(NULL);
+   expected._processorFeatures[0] = TR::Compiler->target.cpu.getX86ProcessorFeatureFlags(NULL);
+   expected._processorFeatures[1] = TR::Compiler->target.cpu.getX86ProcessorFeatureFlags2(NULL);
+   expected._processorFeatures[2] = TR::Compiler->target.cpu.getX86ProcessorFeatureFlags8(NULL);
+   expected._used = sizeof(FileHeader);
+
+   // Anything written by another JIT, on another processor, or not understood is thrown away
+   FileHeader *header = cache->header();
+   if (0 != memcmp(header, &expected, offsetof(FileHeader, _used)) || !cache->buildIndex())
+      {
+      if (options->getVerboseOption(TR_VerbosePerformance) && 0 != header->_eyecatcher[0])
+         TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Method cache %s was written by a different JIT or processor; discarding it", fileName);
+      cache->clearIndex();
+      memcpy(header, &expected, sizeof(FileHeader));
+      }
+
+   _instance = cache;
+#endif
+   }
+
+void
+TR::PersistentMethodCache::shutdown()
+   {
+   PersistentMethodCache *cache = _instance;
+   if (NULL == cache)
+      return;
+   _instance = NULL;
+
+   if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerbosePerformance))
+      {
+      TR_VerboseLog::writeLineLocked(
+         TR_Vlog_PERF,
+         "Method cache: %u hits, %u misses, %u methods stored, %llu of %llu bytes used",
+         cache->_hits,
+         cache->_misses,
+         cache->_stores,
+         static_cast<unsigned long long>(cache->header()->_used),
+         static_cast<unsigned long long>(cache->_capacity));
+      }
+
+   cache->clearIndex();
+#if defined(LINUX)
+   msync(cache->_base, cache->header()->_used, MS_SYNC);
+   munmap(cache->_base, cache->_capacity);
+   close(cache->_fd);
+#endif
+   MUTEX_DESTROY(cache->_mutex);
+   TR::Compiler->persistentAllocator().deallocate(cache);
+   }
+
+// Index every complete entry in the file; false if the file is damaged
+bool
+TR::PersistentMethodCache::buildIndex()
+   {
+   uint64_t used = header()->_used;
+   if (used < sizeof(FileHeader) || used > _capacity)
+      return false;
+
+   uint64_t offset = sizeof(FileHeader);
+   while (offset < used)
+      {
+      Entry *entry = reinterpret_cast<Entry *>(_base + offset);
+      if (used - offset < sizeof(Entry)
+          || entry->_size < sizeof(Entry)
+          || entry->_size > used - offset
+          || entry->_codeOffset > entry->_size
+          || entry->_codeSize > entry->_size - entry->_codeOffset
+          || !addToIndex(entry->_hash, entry->_check, offset))
+         return false;
+      offset += entry->_size;
+      }
+   return true;
+   }
+
+void
+TR::PersistentMethodCache::clearIndex()
+   {
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   for (int32_t i = 0; i < NUM_INDEX_BUCKETS; i++)
+      {
+      IndexEntry *indexEntry = _index[i];
+      while (NULL != indexEntry)
+         {
+         IndexEntry *next = indexEntry->_next;
+         allocator.deallocate(indexEntry);
+         indexEntry = next;
+         }
+      _index[i] = NULL;
+      }
+   }
+
+bool
+TR::PersistentMethodCache::addToIndex(uint64_t hash, uint64_t check, uint64_t offset)
+   {
+   IndexEntry *indexEntry = static_cast<IndexEntry *>(TR::Compiler->persistentAllocator().allocate(sizeof(IndexEntry), std::nothrow));
+   if (NULL == indexEntry)
+      return false;
+   indexEntry->_hash = hash;
+   indexEntry->_check = check;
+   indexEntry->_offset = offset;
+   indexEntry->_next = _index[hash % NUM_INDEX_BUCKETS];
+   _index[hash % NUM_INDEX_BUCKETS] = indexEntry;
+   return true;
+   }
+
+// Called with _mutex held; entries never move once written, so the result stays valid after it is released
+TR::PersistentMethodCache::Entry *
+TR::PersistentMethodCache::find(const Key &key)
+   {
+   for (IndexEntry *indexEntry = _index[key._hash % NUM_INDEX_BUCKETS]; NULL != indexEntry; indexEntry = indexEntry->_next)
+      {
+      if (indexEntry->_hash == key._hash && indexEntry->_check == key._check)
+         return reinterpret_cast<Entry *>(_base + indexEntry->_offset);
+      }
+   return NULL;
+   }
+
+bool
+TR::PersistentMethodCache::load(TR::Compilation *comp, Key &key)
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
+   CallTargets callTargets(CallTargetAllocator(comp->trMemory()->currentStackRegion()));
+   computeKey(comp, key, callTargets);
+   if (!key._cacheable)
+      return false;
+
+   MUTEX_ENTER(_mutex);
+   Entry *entry = find(key);
+   if (NULL == entry)
+      _misses++;
+   MUTEX_EXIT(_mutex);
+   if (NULL == entry)
+      return false;
+
+   // Resolve every call target before committing any code memory
+   Relocation *relocations = reinterpret_cast<Relocation *>(entry + 1);
+   void **targets = static_cast<void **>(comp->trMemory()->allocateStackMemory(entry->_numRelocations * sizeof(void *)));
+   for (uint32_t i = 0; i < entry->_numRelocations; i++)
+      {
+      const char *name = reinterpret_cast<const char *>(entry) + relocations[i]._symbolOffset;
+      targets[i] = findCallTarget(callTargets, name);
+      if (NULL == targets[i] || relocations[i]._offset > entry->_codeSize - sizeof(void *))
+         return false;
+      }
+
+   TR::CodeGenerator *cg = comp->cg();
+   cg->reserveCodeCache();
+   uint8_t *code = cg->allocateCodeMemory(entry->_codeSize, false);
+   memcpy(code, reinterpret_cast<uint8_t *>(entry) + entry->_codeOffset, entry->_codeSize);
+   for (uint32_t i = 0; i < entry->_numRelocations; i++)
+      memcpy(code + relocations[i]._offset, &targets[i], sizeof(void *));
+   TR::CodeGenerator::syncCode(code, entry->_codeSize);
+
+   cg->commitToCodeCache();
+   cg->setBinaryBufferStart(code);
+   cg->setPrePrologueSize(entry->_entryPointOffset);
+   cg->setBinaryBufferCursor(code + entry->_codeSize);
+
+   MUTEX_ENTER(_mutex);
+   _hits++;
+   MUTEX_EXIT(_mutex);
+   return true;
+   }
+
+void
+TR::PersistentMethodCache::store(TR::Compilation *comp, const Key &key)
+   {
+   if (!key._cacheable)
+      return;
+
+   TR::CodeGenerator *cg = comp->cg();
+   uint8_t *bufferStart = cg->getBinaryBufferStart();
+   uint32_t codeSize = static_cast<uint32_t>(cg->getCodeEnd() - bufferStart);
+   uint32_t entryPointOffset = static_cast<uint32_t>(cg->getCodeStart() - bufferStart);
+
+   // Only absolute 64 bit call targets can be relocated
+   uint32_t numRelocations = 0;
+   uint32_t namesSize = 0;
+   auto &staticRelocations = cg->getStaticRelocations();
+   for (auto it = staticRelocations.begin(); it != staticRelocations.end(); ++it)
+      {
+      if (it->size() != TR::StaticRelocationSize::word64
+          || it->type() != TR::StaticRelocationType::Absolute
+          || it->location() < bufferStart
+          || it->location() + sizeof(void *) > bufferStart + codeSize)
+         return;
+      numRelocations++;
+      namesSize += static_cast<uint32_t>(strlen(it->symbol())) + 1;
+      }
+
+   uint32_t codeOffset = static_cast<uint32_t>(sizeof(Entry) + numRelocations * sizeof(Relocation) + namesSize);
+   codeOffset = (codeOffset + 7) & ~7;
+   uint32_t size = (codeOffset + codeSize + 7) & ~7;
+
+   MUTEX_ENTER(_mutex);
+   FileHeader *fileHeader = header();
+   uint64_t offset = fileHeader->_used;
+   if (NULL != find(key) || size > _capacity - offset || !addToIndex(key._hash, key._check, offset))
+      {
+      MUTEX_EXIT(_mutex);
+      return;
+      }
+
+   uint8_t *start = _base + offset;
+   Entry *entry = reinterpret_cast<Entry *>(start);
+   entry->_hash = key._hash;
+   entry->_check = key._check;
+   entry->_size = size;
+   entry->_codeOffset = codeOffset;
+   entry->_codeSize = codeSize;
+   entry->_entryPointOffset = entryPointOffset;
+   entry->_numRelocations = numRelocations;
+   entry->_padding = 0;
+
+   Relocation *relocation = reinterpret_cast<Relocation *>(entry + 1);
+   uint32_t nameOffset = static_cast<uint32_t>(sizeof(Entry) + numRelocations * sizeof(Relocation));
+   for (auto it = staticRelocations.begin(); it != staticRelocations.end(); ++it, ++relocation)
+      {
+      size_t nameLength = strlen(it->symbol()) + 1;
+      relocation->_offset = static_cast<uint32_t>(it->location() - bufferStart);
+      relocation->_symbolOffset = nameOffset;
+      memcpy(start + nameOffset, it->symbol(), nameLength);
+      nameOffset += static_cast<uint32_t>(nameLength);
+      }
+   memcpy(start + codeOffset, bufferStart, codeSize);
+
+   // The entry only becomes part of the file once it is complete
+   VM_AtomicSupport::writeBarrier();
+   fileHeader->_used = offset + size;
+   _stores++;
+   MUTEX_EXIT(_mutex);
+   }
+
+uint32_t
+TR::PersistentMethodCache::hits()
+   {
+   MUTEX_ENTER(_mutex);
+   uint32_t hits = _hits;
+   MUTEX_EXIT(_mutex);
+   return hits;
+   }
+
+uint32_t
+TR::PersistentMethodCache::stores()
+   {
+   MUTEX_ENTER(_mutex);
+   uint32_t stores = _stores;
+   MUTEX_EXIT(_mutex);
+   return stores;
+   }
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef OMR_PERSISTENT_METHOD_CACHE_HPP
+#define OMR_PERSISTENT_METHOD_CACHE_HPP
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "omrmutex.h"
+
+namespace TR { class Compilation; }
+
+namespace TR {
+
+/**
+ * @brief Process wide, file backed cache of compiled method bodies.
+ *
+ * When the JIT is started with -Xjit:methodCacheFile=<file>, every compilation
+ * hashes its IL right after IL generation, together with its optimization
+ * level, option bits and the values of its numeric and string options.  If a body compiled from identical IL is found in the
+ * file, it is copied into the code cache, its call targets are relocated to
+ * their addresses in this process, and optimization and code generation are
+ * skipped.  Otherwise the body produced by the code generator is appended to
+ * the file for the next run.
+ *
+ * The file is memory mapped and stamped with the JIT build name and the host
+ * processor; a file written by a different JIT or on a different processor is
+ * discarded when it is opened.  Only a single process may use a given file at
+ * a time.
+ *
+ * Methods are only cached when their code is position independent apart from
+ * direct calls, which the code generator describes with TR::StaticRelocations.
+ * Static addresses and address constants are part of the IL hash, so methods
+ * that embed them only hit when those addresses match.  The cache is only
+ * implemented for x86-64 Linux.
+ */
+class PersistentMethodCache
+   {
+public:
+   /**
+    * @brief Identifies the IL of a compilation; computed by load() and consumed by store()
+    */
+   struct Key
+      {
+      Key() : _hash(0), _check(0), _cacheable(false) {}
+
+      uint64_t _hash;    ///< selects the entry
+      uint64_t _check;   ///< independent hash that guards against collisions on _hash
+      bool _cacheable;   ///< false if the IL contains something the cache cannot relocate
+      };
+
+   /** @brief Open the cache file if the command line options name one */
+   static void initialize();
+
+   /** @brief Report statistics, if verbose, and unmap the cache file */
+   static void shutdown();
+
+   static PersistentMethodCache *instance() { return _instance; }
+
+   /**
+    * @brief Look up the freshly generated IL of a compilation.
+    *
+    * On a hit the cached body is installed as the code generator's binary
+    * buffer, so that getCodeStart() and getCodeEnd() describe it.
+    *
+    * @param comp compilation whose IL generation has just completed
+    * @param key receives the key of the IL, for a later call to store()
+    * @return true if the compilation was satisfied from the cache
+    */
+   bool load(TR::Compilation *comp, Key &key);
+
+   /**
+    * @brief Append the body just produced by the code generator, if its key is cacheable
+    */
+   void store(TR::Compilation *comp, const Key &key);
+
+   /** @brief Number of compilations satisfied from the cache since it was opened */
+   uint32_t hits();
+
+   /** @brief Number of bodies added to the cache since it was opened */
+   uint32_t stores();
+
+private:
+   struct FileHeader;
+   struct Entry;
+   struct Relocation;
+
+   struct IndexEntry
+      {
+      uint64_t _hash;
+      uint64_t _check;
+      uint64_t _offset;     ///< offset of the Entry from the start of the file
+      IndexEntry *_next;
+      };
+
+   static const int32_t NUM_INDEX_BUCKETS = 1024;
+
+   PersistentMethodCache(int fd, uint8_t *base, uint64_t capacity);
+
+   bool buildIndex();
+   void clearIndex();
+   bool addToIndex(uint64_t hash, uint64_t check, uint64_t offset);
+   Entry *find(const Key &key);
+   FileHeader *header() { return reinterpret_cast<FileHeader *>(_base); }
+
+   static PersistentMethodCache *_instance;
+
+   MUTEX _mutex;        /**< Guards _index, the file's used size and the counters */
+   int _fd;
+   uint8_t *_base;      /**< Start of the mapping of the cache file */
+   uint64_t _capacity;  /**< Size of the mapping */
+   IndexEntry *_index[NUM_INDEX_BUCKETS];
+   uint32_t _hits;
+   uint32_t _misses;
+   uint32_t _stores;
+   };
+
+}
+
+#endif // OMR_PERSISTENT_METHOD_CACHE_HPP
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 1991, 2017 IBM Corp. and others
+ * Copyright (c) 1991, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -83,6 +83,10 @@ public:
 #if defined (OMR_INTERP_COMPRESSED_OBJECT_HEADER)
 	virtual void scavenger_fixupDestroyedSlot(MM_EnvironmentBase *env, MM_ForwardedHeader *forwardedHeader, MM_MemorySubSpaceSemiSpace *subSpaceNew);
 #endif /* OMR_INTERP_COMPRESSED_OBJECT_HEADER */
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+	virtual void scavenger_switchConcurrentForThread(MM_EnvironmentBase *env);
+	virtual void scavenger_fixupIndirectObjectSlots(MM_EnvironmentStandard *env, omrobjectptr_t objectPtr);
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
 #endif /* OMR_GC_MODRON_SCAVENGER */
 
 };
@@ -19,6 +19,10 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#if defined(LINUX) || defined(OSX)
+#include <execinfo.h>
+#endif /* defined(LINUX) || defined(OSX) */
+
 #include "ModronAssertions.h"
 #include "omr.h"
 #include "omrExampleVM.hpp"
@@ -50,6 +54,16 @@ MM_EnvironmentDelegate::detachVMThread(OMR_VM *omrVM, OMR_VMThread *omrVMThread,
 	}
 }
 
+uintptr_t
+MM_EnvironmentDelegate::captureStackFrames(uintptr_t *frames, uintptr_t maxFrames)
+{
+	uintptr_t frameCount = 0;
+#if defined(LINUX) || defined(OSX)
+	frameCount = (uintptr_t)backtrace((void **)frames, (int)maxFrames);
+#endif /* defined(LINUX) || defined(OSX) */
+	return frameCount;
+}
+
 void
 MM_EnvironmentDelegate::acquireVMAccess()
 {
@@ -163,6 +163,19 @@ public:
 	 */
 	bool objectAllocationNotify(omrobjectptr_t omrObject) { return true; }
 
+	/**
+	 * Capture the return addresses (or any other language specific frame identifiers) of the calling
+	 * thread's stack, innermost first. This is used by the allocation sampler to attribute sampled
+	 * allocations to their allocating call sites.
+	 *
+	 * The example has no interpreted frames of its own, so it records the native return addresses.
+	 *
+	 * @param[out] frames receives the frame identifiers
+	 * @param[in] maxFrames capacity of frames
+	 * @return the number of frames captured, 0 if the platform does not support stack capture
+	 */
+	uintptr_t captureStackFrames(uintptr_t *frames, uintptr_t maxFrames);
+
 	/**
 	 * Acquire shared VM access. Threads must acquire VM access before accessing any OMR internal
 	 * structures such as the heap. Requests for VM access will be blocked if any other thread is
@@ -157,6 +157,19 @@ public:
 		return getObjectSizeInBytesWithHeader(objectPtr);
 	}
 
+	/**
+	 * Get a key identifying the type of an initialized object, used to aggregate allocation samples
+	 * per type. Languages typically return the address of the class or shape of the object.
+	 *
+	 * @param[in] objectPtr points to the object
+	 * @return the type key of the object, or 0 if the language does not distinguish object types
+	 */
+	MMINLINE uintptr_t
+	getObjectTypeKey(omrobjectptr_t objectPtr)
+	{
+		return 0;
+	}
+
 	/**
 	 * If object initialization fails for any reason, this method must return NULL. In that case, the heap
 	 * memory allocated for the object will become floating garbage in the heap and will be recovered in
@@ -72,8 +72,10 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/env/OMRClassEnv.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRDebugEnv.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRVMEnv.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/CompilePhaseProfiler.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentAllocator.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/SegmentPool.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SystemSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/DebugSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/Region.cpp \
@@ -224,6 +226,8 @@ JIT_PRODUCT_SOURCE_FILES+=\
     $(JIT_PRODUCT_DIR)/tests/injectors/IndirectStoreIlInjector.cpp \
     $(JIT_PRODUCT_DIR)/tests/injectors/FooIlInjector.cpp \
     $(JIT_PRODUCT_DIR)/tests/injectors/Qux2IlInjector.cpp \
+    $(JIT_PRODUCT_DIR)/tests/BitVectorTest.cpp \
+    $(JIT_PRODUCT_DIR)/tests/CompilePhaseProfilerTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/BuilderTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/FooBarTest.cpp \
     $(JIT_PRODUCT_DIR)/tests/LimitFileTest.cpp \
@@ -265,6 +269,7 @@ JIT_PRODUCT_SOURCE_FILES+=\
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheManager.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheMemorySegment.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheConfig.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/PersistentMethodCache.cpp \
     $(JIT_PRODUCT_DIR)/compile/Method.cpp \
     $(JIT_PRODUCT_DIR)/control/TestJit.cpp \
     $(JIT_PRODUCT_DIR)/env/FrontEnd.cpp \
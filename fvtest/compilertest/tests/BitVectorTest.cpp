@@ -0,0 +1,288 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "infra/BitVector.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace {
+
+class BitVectorTest : public :: testing :: Test {
+
+	public:
+		BitVectorTest() :
+			segmentProvider(1 << 16, rawAllocator),
+			region(segmentProvider, rawAllocator)
+		{
+		}
+
+	protected:
+		TR::RawAllocator rawAllocator;
+		TR::SystemSegmentProvider segmentProvider;
+		TR::Region region;
+
+		// Check every bit covered by expected, and that iteration
+		// visits exactly the expected bits in increasing order
+		void expectBits(TR_BitVector &vector, const std::vector<bool> &expected) {
+			int32_t count = 0;
+			std::vector<int32_t> expectedElements;
+			for (int32_t i = 0; i < (int32_t)expected.size(); i++) {
+				ASSERT_EQ(expected[i], vector.isSet(i)) << "bit " << i;
+				if (expected[i]) {
+					expectedElements.push_back(i);
+					count++;
+				}
+			}
+			ASSERT_EQ(count, vector.elementCount());
+			ASSERT_EQ(count == 0, vector.isEmpty());
+			ASSERT_EQ(count > 1, vector.hasMoreThanOneElement());
+
+			std::vector<int32_t> elements;
+			TR_BitVectorIterator bvi(vector);
+			while (bvi.hasMoreElements())
+				elements.push_back(bvi.getNextElement());
+			ASSERT_EQ(expectedElements, elements);
+		}
+};
+
+// Bits that fall on either side of chunk boundaries, and on either side of the
+// pairs of chunks combined by the vectorized operations
+static const int32_t boundaryBits[] = {
+	0,
+	1,
+	BITS_IN_CHUNK - 1,
+	BITS_IN_CHUNK,
+	2 * BITS_IN_CHUNK - 1,
+	2 * BITS_IN_CHUNK,
+	3 * BITS_IN_CHUNK - 1,
+	4 * BITS_IN_CHUNK,
+	5 * BITS_IN_CHUNK + 1,
+	};
+
+#define NUM_BOUNDARY_BITS (int32_t)(sizeof(boundaryBits) / sizeof(boundaryBits[0]))
+
+//****** Empty vectors ******//
+
+TEST_F(BitVectorTest, emptyVector) {
+
+	TR_BitVector unsized(region);
+	TR_BitVector sized(1000, region);
+	std::vector<bool> none(1000, false);
+
+	expectBits(unsized, none);
+	expectBits(sized, none);
+	ASSERT_EQ(0, unsized.numChunks());
+	ASSERT_EQ(0, sized.numNonZeroChunks());
+
+	ASSERT_TRUE(unsized == sized) << "empty vectors of different sizes differ";
+	ASSERT_FALSE(unsized.intersects(sized));
+	ASSERT_EQ(0, unsized.commonElementCount(sized));
+
+	// Operations with an empty operand leave both vectors empty
+	unsized |= sized;
+	sized &= unsized;
+	sized -= unsized;
+	expectBits(unsized, none);
+	expectBits(sized, none);
+
+	// An empty vector is not changed by, and does not change, a non-empty one
+	TR_BitVector full(region);
+	full.setAll(300);
+	unsized &= full;
+	unsized -= full;
+	expectBits(unsized, none);
+	full -= unsized;
+	full &= sized;
+	expectBits(full, none);
+
+	// Assigning an empty vector empties the target
+	TR_BitVector target(region);
+	target.set(17);
+	target.set(700);
+	target = sized;
+	expectBits(target, none);
+	ASSERT_TRUE(target == unsized);
+}
+
+//****** Bits at word boundaries ******//
+
+TEST_F(BitVectorTest, wordBoundaries) {
+
+	const int32_t numBits = 8 * BITS_IN_CHUNK;
+	for (int32_t b = 0; b < NUM_BOUNDARY_BITS; b++) {
+		// A single bit, and its neighbours left unset
+		TR_BitVector single(numBits, region);
+		std::vector<bool> expected(numBits, false);
+		single.set(boundaryBits[b]);
+		expected[boundaryBits[b]] = true;
+		expectBits(single, expected);
+		ASSERT_EQ(1, single.numNonZeroChunks());
+
+		// Clearing it empties the vector
+		single.reset(boundaryBits[b]);
+		expected[boundaryBits[b]] = false;
+		expectBits(single, expected);
+	}
+
+	TR_BitVector all(region);
+	std::vector<bool> expected(8 * BITS_IN_CHUNK, false);
+	for (int32_t b = 0; b < NUM_BOUNDARY_BITS; b++) {
+		all.set(boundaryBits[b]);
+		expected[boundaryBits[b]] = true;
+	}
+	expectBits(all, expected);
+
+	// Clearing the first and last bits moves both ends of the non-zero window
+	all.reset(boundaryBits[0]);
+	all.reset(boundaryBits[1]);
+	all.reset(boundaryBits[NUM_BOUNDARY_BITS - 1]);
+	expected[boundaryBits[0]] = false;
+	expected[boundaryBits[1]] = false;
+	expected[boundaryBits[NUM_BOUNDARY_BITS - 1]] = false;
+	expectBits(all, expected);
+
+	// Iteration can start part way through a chunk
+	TR_BitVectorIterator bvi(all, BITS_IN_CHUNK + 1);
+	ASSERT_EQ(2 * BITS_IN_CHUNK - 1, bvi.getFirstElement());
+}
+
+//****** Whole vector operations ******//
+
+TEST_F(BitVectorTest, wholeVectorOperations) {
+
+	// Sizes with odd and even chunk counts so that every operation ends both on
+	// and off a vector boundary; the second operand starts at chunk 1 so that
+	// its non-zero window is not aligned to the first chunk either
+	const int32_t sizes[] = { 1, BITS_IN_CHUNK, 3 * BITS_IN_CHUNK, 5 * BITS_IN_CHUNK + 7, 1000 };
+	for (int32_t s = 0; s < (int32_t)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+		int32_t numBits = sizes[s];
+		std::vector<bool> a(numBits, false), b(numBits, false);
+		TR_BitVector va(numBits, region), vb(numBits, region);
+		for (int32_t i = 0; i < numBits; i++) {
+			if (i % 3 == 0) {
+				a[i] = true;
+				va.set(i);
+			}
+			if (i >= BITS_IN_CHUNK && i % 5 == 0) {
+				b[i] = true;
+				vb.set(i);
+			}
+		}
+
+		std::vector<bool> orResult(numBits), andResult(numBits), andNotResult(numBits);
+		int32_t common = 0;
+		for (int32_t i = 0; i < numBits; i++) {
+			orResult[i] = a[i] || b[i];
+			andResult[i] = a[i] && b[i];
+			andNotResult[i] = a[i] && !b[i];
+			if (andResult[i])
+				common++;
+		}
+
+		ASSERT_EQ(common > 0, va.intersects(vb)) << "size " << numBits;
+		ASSERT_EQ(common, va.commonElementCount(vb)) << "size " << numBits;
+
+		TR_BitVector result(region);
+		result = va;
+		ASSERT_TRUE(result == va) << "size " << numBits;
+		result |= vb;
+		expectBits(result, orResult);
+		ASSERT_EQ(orResult != a, result != va) << "size " << numBits;
+
+		result = va;
+		result &= vb;
+		expectBits(result, andResult);
+
+		result = va;
+		result -= vb;
+		expectBits(result, andNotResult);
+		ASSERT_FALSE(result.intersects(vb)) << "size " << numBits;
+
+		// Operating on a vector with itself
+		result = va;
+		result |= result;
+		expectBits(result, a);
+		result &= result;
+		expectBits(result, a);
+		result -= result;
+		expectBits(result, std::vector<bool>(numBits, false));
+	}
+}
+
+//****** Growth ******//
+
+TEST_F(BitVectorTest, growth) {
+
+	// Setting an increasing run of bits grows the vector as it goes
+	TR_BitVector run(BITS_IN_CHUNK, region);
+	const int32_t runLength = 50 * BITS_IN_CHUNK + 3;
+	std::vector<bool> expected(runLength, true);
+	for (int32_t i = 0; i < runLength; i++)
+		run.set(i);
+	expectBits(run, expected);
+	ASSERT_GE(run.numChunks(), 51);
+
+	// Growing keeps the bits already set and clears the new chunks, even where the
+	// vector held bits before they were reset
+	TR_BitVector sparse(region);
+	sparse.set(3);
+	sparse.set(2 * BITS_IN_CHUNK);
+	sparse.reset(2 * BITS_IN_CHUNK);
+	sparse.set(100 * BITS_IN_CHUNK + 5);
+	std::vector<bool> sparseExpected(101 * BITS_IN_CHUNK, false);
+	sparseExpected[3] = true;
+	sparseExpected[100 * BITS_IN_CHUNK + 5] = true;
+	expectBits(sparse, sparseExpected);
+
+	// A smaller vector grows to hold the bits of a larger one
+	TR_BitVector small(BITS_IN_CHUNK, region);
+	small.set(1);
+	small |= sparse;
+	sparseExpected[1] = true;
+	expectBits(small, sparseExpected);
+	ASSERT_GE(small.numChunks(), sparse.numChunks());
+
+	TR_BitVector copy(1, region);
+	copy = sparse;
+	ASSERT_TRUE(copy == sparse);
+
+	// Bits beyond the end of a vector read as unset
+	ASSERT_FALSE(small.isSet(small.numChunks() * BITS_IN_CHUNK + 1));
+
+	// Operations between vectors of different lengths only look at common chunks
+	TR_BitVector shorter(region);
+	shorter.set(3);
+	ASSERT_TRUE(shorter.intersects(sparse));
+	ASSERT_TRUE(sparse.intersects(shorter));
+	ASSERT_EQ(1, sparse.commonElementCount(shorter));
+	ASSERT_FALSE(shorter == sparse);
+	shorter &= sparse;
+	sparse -= shorter;
+	ASSERT_TRUE(shorter.isSet(3));
+	ASSERT_FALSE(sparse.isSet(3));
+	ASSERT_TRUE(sparse.isSet(100 * BITS_IN_CHUNK + 5));
+	ASSERT_EQ(1, sparse.elementCount());
+}
+
+}
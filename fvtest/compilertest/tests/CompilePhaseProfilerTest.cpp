@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "env/CompilePhaseProfiler.hpp"
+#include <string.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+typedef TR::CompilePhaseProfile Profile;
+
+// Build an entry the way record() does, from a list of wall times
+static void recordTimes(Profile::Entry &entry, const uint64_t *times, int32_t numTimes) {
+	memset(&entry, 0, sizeof(entry));
+	for (int32_t i = 0; i < numTimes; i++) {
+		entry._count += 1;
+		entry._totalWallTime += times[i];
+		entry._maxWallTime = times[i] > entry._maxWallTime ? times[i] : entry._maxWallTime;
+		entry._wallTimeHistogram[Profile::bucketFor(times[i])] += 1;
+	}
+}
+
+//****** Buckets ******//
+
+TEST(CompilePhaseProfilerTest, smallTimesHaveTheirOwnBucket) {
+	for (uint64_t time = 0; time < Profile::SUB_BUCKETS; time++) {
+		ASSERT_EQ((int32_t)time, Profile::bucketFor(time));
+		ASSERT_EQ(time, Profile::bucketUpperBound((int32_t)time));
+	}
+}
+
+TEST(CompilePhaseProfilerTest, bucketsAreContiguous) {
+	// Each bucket's upper bound falls in it, and the next time starts the next bucket
+	for (int32_t bucket = 0; bucket < Profile::NUM_BUCKETS - 1; bucket++) {
+		uint64_t bound = Profile::bucketUpperBound(bucket);
+		ASSERT_EQ(bucket, Profile::bucketFor(bound)) << "bound " << bound;
+		ASSERT_EQ(bucket + 1, Profile::bucketFor(bound + 1)) << "bound " << bound;
+	}
+}
+
+TEST(CompilePhaseProfilerTest, bucketsAreWithinAnEighth) {
+	const uint64_t times[] = { 8, 9, 15, 16, 17, 100, 1000, 1023, 1024, 1025, 123456, 99999999, ((uint64_t)1 << 36) - 1 };
+	for (int32_t i = 0; i < (int32_t)(sizeof(times) / sizeof(times[0])); i++) {
+		uint64_t bound = Profile::bucketUpperBound(Profile::bucketFor(times[i]));
+		ASSERT_LE(times[i], bound) << "time " << times[i];
+		ASSERT_LE(bound, times[i] + times[i] / Profile::SUB_BUCKETS) << "time " << times[i];
+	}
+}
+
+TEST(CompilePhaseProfilerTest, longTimesShareTheLastBucket) {
+	const int32_t lastBucket = Profile::NUM_BUCKETS - 1;
+	ASSERT_EQ(lastBucket, Profile::bucketFor(((uint64_t)1 << (Profile::MAX_TIME_BITS + 1)) - 1));
+	ASSERT_EQ(lastBucket, Profile::bucketFor((uint64_t)1 << (Profile::MAX_TIME_BITS + 1)));
+	ASSERT_EQ(lastBucket, Profile::bucketFor((uint64_t)1 << 63));
+	ASSERT_EQ(lastBucket, Profile::bucketFor(~(uint64_t)0));
+}
+
+//****** Percentiles ******//
+
+TEST(CompilePhaseProfilerTest, percentileOfNoTimes) {
+	Profile::Entry entry;
+	recordTimes(entry, NULL, 0);
+	ASSERT_EQ(0, Profile::percentile(&entry, 99));
+}
+
+TEST(CompilePhaseProfilerTest, percentileIsCappedAtTheMaximum) {
+	// 1000 falls in the bucket [960, 1023]; the maximum is the better bound
+	const uint64_t times[] = { 1000 };
+	Profile::Entry entry;
+	recordTimes(entry, times, 1);
+	ASSERT_EQ(1000, Profile::percentile(&entry, 50));
+	ASSERT_EQ(1000, Profile::percentile(&entry, 99));
+}
+
+TEST(CompilePhaseProfilerTest, percentileOfARange) {
+	uint64_t times[1000];
+	for (int32_t i = 0; i < 1000; i++)
+		times[i] = i + 1;
+	Profile::Entry entry;
+	recordTimes(entry, times, 1000);
+
+	// The exact percentiles are 500, 990 and 1000, reported as their bucket's upper
+	// bound; 990 shares the bucket [960, 1023] with the maximum, so is capped at it
+	ASSERT_EQ(Profile::bucketUpperBound(Profile::bucketFor(500)), Profile::percentile(&entry, 50));
+	ASSERT_EQ(1000, Profile::percentile(&entry, 99));
+	ASSERT_EQ(1000, Profile::percentile(&entry, 100));
+}
+
+TEST(CompilePhaseProfilerTest, percentileSkipsAnOutlier) {
+	// One very slow invocation in a hundred does not move the 99th percentile
+	uint64_t times[101];
+	for (int32_t i = 0; i < 100; i++)
+		times[i] = 20;
+	times[100] = 5000000;
+	Profile::Entry entry;
+	recordTimes(entry, times, 101);
+	ASSERT_EQ(Profile::bucketUpperBound(Profile::bucketFor(20)), Profile::percentile(&entry, 99));
+	ASSERT_EQ(5000000, Profile::percentile(&entry, 100));
+}
+
+}
@@ -0,0 +1,301 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <math.h>
+
+#include "omrcfg.h"
+#include "omrExampleVM.hpp"
+#include "omrgc.h"
+#include "omrport.h"
+
+#include "AllocationSampler.hpp"
+#include "GCExtensionsBase.hpp"
+#include "GCHeapTest.hpp"
+#include "ObjectAllocationInterface.hpp"
+#include "ObjectAllocationModel.hpp"
+
+#define ALLOCATION_SAMPLER_TEST_INTERVAL 4096
+#define ALLOCATION_SAMPLER_TEST_SITES 64
+
+/**
+ * Drives MM_AllocationSampler directly, or attaches one to the heap for the duration of a test. The example
+ * object model does not look at the objects to find their type, so the sampler is handed made up addresses.
+ * Objects allocated through the heap are all garbage, but the collections they cause need the (empty) root
+ * and object tables to scan.
+ */
+class AllocationSamplerTest : public GCHeapTest
+{
+protected:
+	virtual void
+	SetUp()
+	{
+		GCHeapTest::SetUp();
+		exampleVM->rootTable = hashTableNew(
+				exampleVM->_omrVM->_runtime->_portLibrary, OMR_GET_CALLSITE(), 0, sizeof(RootEntry), 0, 0, OMRMEM_CATEGORY_MM,
+				rootTableHashFn, rootTableHashEqualFn, NULL, NULL);
+		exampleVM->objectTable = hashTableNew(
+				exampleVM->_omrVM->_runtime->_portLibrary, OMR_GET_CALLSITE(), 0, sizeof(ObjectEntry), 0, 0, OMRMEM_CATEGORY_MM,
+				objectTableHashFn, objectTableHashEqualFn, NULL, NULL);
+		ASSERT_TRUE((NULL != exampleVM->rootTable) && (NULL != exampleVM->objectTable));
+	}
+
+	virtual void
+	TearDown()
+	{
+		hashTableFree(exampleVM->rootTable);
+		exampleVM->rootTable = NULL;
+		hashTableFree(exampleVM->objectTable);
+		exampleVM->objectTable = NULL;
+		GCHeapTest::TearDown();
+	}
+
+	/**
+	 * @return the bytes the sampler estimates have been allocated, with the number of samples taken
+	 */
+	uint64_t
+	estimate(MM_AllocationSampler *sampler, uintptr_t *sampleCount, uintptr_t *sampledBytes)
+	{
+		uint64_t estimatedBytes = 0;
+		sampler->getTotals(sampleCount, sampledBytes, &estimatedBytes);
+		return estimatedBytes;
+	}
+
+	/**
+	 * Notify the sampler of objectCount objects of objectSize bytes, all allocated out of line.
+	 */
+	void
+	allocateOutOfLine(MM_AllocationSampler *sampler, MM_AllocationSampler::ThreadState *state, uintptr_t objectCount, uintptr_t objectSize)
+	{
+		for (uintptr_t i = 0; i < objectCount; i++) {
+			sampler->allocationNotify(env, state, (void *)(uintptr_t)(0x10000 + (i * objectSize)), objectSize);
+		}
+		sampler->resolvePendingSample(env, state);
+	}
+
+	/**
+	 * Allocate objectCount garbage objects of objectSize bytes through the allocation interface.
+	 */
+	void
+	allocateObjects(uintptr_t objectCount, uintptr_t objectSize)
+	{
+		for (uintptr_t i = 0; i < objectCount; i++) {
+			MM_ObjectAllocationModel allocationModel(env, objectSize, MM_ObjectAllocationModel::selectObjectAllocationFlags(false, false, false, false));
+			ASSERT_TRUE(NULL != OMR_GC_AllocateObject(exampleVM->_omrVMThread, &allocationModel));
+		}
+	}
+
+	void
+	attach(MM_AllocationSampler *sampler)
+	{
+		env->_objectAllocationInterface->flushCache(env);
+		env->getExtensions()->allocationSampler = sampler;
+	}
+
+	void
+	detach()
+	{
+		/* flushing records the last sample and gives the TLH its real top back */
+		env->_objectAllocationInterface->flushCache(env);
+		env->getExtensions()->allocationSampler = NULL;
+	}
+};
+
+class gcFunctionalTestAllocationSampler : public AllocationSamplerTest {};
+class perfTestAllocationSampler : public AllocationSamplerTest {};
+
+/*
+ * Objects much smaller than the interval are sampled about once per interval allocated bytes, and weighting
+ * each sample by its probability estimates the allocated bytes without bias.
+ */
+TEST_F(gcFunctionalTestAllocationSampler, samplingRate)
+{
+	const uintptr_t objectSize = 64;
+	const uintptr_t objectCount = 1 << 20;
+	MM_AllocationSampler *sampler = MM_AllocationSampler::newInstance(env, ALLOCATION_SAMPLER_TEST_INTERVAL, ALLOCATION_SAMPLER_TEST_SITES);
+	ASSERT_TRUE(NULL != sampler);
+	MM_AllocationSampler::ThreadState state;
+	sampler->initializeThreadState(env, &state);
+
+	allocateOutOfLine(sampler, &state, objectCount, objectSize);
+
+	uintptr_t sampleCount = 0;
+	uintptr_t sampledBytes = 0;
+	uint64_t estimatedBytes = estimate(sampler, &sampleCount, &sampledBytes);
+	double expectedSamples = (double)objectCount * (1.0 - exp(-(double)objectSize / ALLOCATION_SAMPLER_TEST_INTERVAL));
+	double allocatedBytes = (double)(objectCount * objectSize);
+
+	/* about 16000 samples, so 5% is more than 6 standard deviations */
+	EXPECT_NEAR(expectedSamples, (double)sampleCount, expectedSamples * 0.05);
+	EXPECT_EQ(sampleCount * objectSize, sampledBytes);
+	EXPECT_NEAR(allocatedBytes, (double)estimatedBytes, allocatedBytes * 0.05);
+	EXPECT_EQ((uintptr_t)0, sampler->getDroppedSamples());
+
+	sampler->kill(env);
+}
+
+/*
+ * Objects larger than the interval are sampled almost every time, so each sample must weigh little more than the
+ * object itself rather than a whole interval.
+ */
+TEST_F(gcFunctionalTestAllocationSampler, largeObjectWeighting)
+{
+	const uintptr_t objectSize = 3 * ALLOCATION_SAMPLER_TEST_INTERVAL;
+	const uintptr_t objectCount = 20000;
+	MM_AllocationSampler *sampler = MM_AllocationSampler::newInstance(env, ALLOCATION_SAMPLER_TEST_INTERVAL, ALLOCATION_SAMPLER_TEST_SITES);
+	ASSERT_TRUE(NULL != sampler);
+	MM_AllocationSampler::ThreadState state;
+	sampler->initializeThreadState(env, &state);
+
+	allocateOutOfLine(sampler, &state, objectCount, objectSize);
+
+	uintptr_t sampleCount = 0;
+	uintptr_t sampledBytes = 0;
+	uint64_t estimatedBytes = estimate(sampler, &sampleCount, &sampledBytes);
+	double expectedSamples = (double)objectCount * (1.0 - exp(-3.0));
+	double allocatedBytes = (double)(objectCount * objectSize);
+
+	EXPECT_NEAR(expectedSamples, (double)sampleCount, expectedSamples * 0.02);
+	EXPECT_NEAR(allocatedBytes, (double)estimatedBytes, allocatedBytes * 0.02);
+
+	sampler->kill(env);
+}
+
+/*
+ * Bytes allocated from the TLH up to its lowered top count towards the sample, which is then taken on the object
+ * that did not fit below it, and the estimate covers the bytes allocated from the TLH as well as the sampled ones.
+ */
+TEST_F(gcFunctionalTestAllocationSampler, tlhAllocation)
+{
+	const uintptr_t objectSize = 48;
+	const uintptr_t allocatedBytes = 64 * 1024 * 1024;
+	MM_AllocationSampler *sampler = MM_AllocationSampler::newInstance(env, ALLOCATION_SAMPLER_TEST_INTERVAL, ALLOCATION_SAMPLER_TEST_SITES);
+	ASSERT_TRUE(NULL != sampler);
+	MM_AllocationSampler::ThreadState state;
+	sampler->initializeThreadState(env, &state);
+
+	uintptr_t allocated = 0;
+	uintptr_t samplePointCount = 0;
+	while (allocated < allocatedBytes) {
+		uintptr_t tlhBytes = (state.bytesUntilSample / objectSize) * objectSize;
+		sampler->tlhAllocationNotify(env, &state, tlhBytes);
+		ASSERT_LT(state.bytesUntilSample, objectSize);
+		sampler->allocationNotify(env, &state, (void *)(uintptr_t)(0x10000 + allocated), objectSize);
+		allocated += tlhBytes + objectSize;
+		samplePointCount += 1;
+	}
+	sampler->resolvePendingSample(env, &state);
+
+	uintptr_t sampleCount = 0;
+	uintptr_t sampledBytes = 0;
+	uint64_t estimatedBytes = estimate(sampler, &sampleCount, &sampledBytes);
+
+	/* every object that did not fit below the lowered top was sampled */
+	EXPECT_EQ(samplePointCount, sampleCount);
+	EXPECT_NEAR((double)allocated, (double)estimatedBytes, (double)allocated * 0.05);
+
+	sampler->kill(env);
+}
+
+/*
+ * Sampling through the allocation interface, across the collections the garbage brings about.
+ */
+TEST_F(gcFunctionalTestAllocationSampler, allocationInterface)
+{
+	const uintptr_t objectSize = 64;
+	const uintptr_t objectCount = 1 << 19;
+	MM_AllocationSampler *sampler = MM_AllocationSampler::newInstance(env, ALLOCATION_SAMPLER_TEST_INTERVAL, ALLOCATION_SAMPLER_TEST_SITES);
+	ASSERT_TRUE(NULL != sampler);
+
+	attach(sampler);
+	allocateObjects(objectCount, objectSize);
+	detach();
+
+	uintptr_t sampleCount = 0;
+	uintptr_t sampledBytes = 0;
+	uint64_t estimatedBytes = estimate(sampler, &sampleCount, &sampledBytes);
+	uintptr_t consumedSize = env->getExtensions()->objectModel.adjustSizeInBytes(objectSize);
+	double allocatedBytes = (double)(objectCount * consumedSize);
+
+	EXPECT_EQ(sampleCount * consumedSize, sampledBytes);
+	EXPECT_NEAR(allocatedBytes, (double)estimatedBytes, allocatedBytes * 0.05);
+	EXPECT_EQ((uintptr_t)0, sampler->getDroppedSamples());
+
+	/* objects keep being allocated correctly once the TLH has been given back its real top */
+	allocateObjects(objectCount / 4, objectSize);
+	EXPECT_EQ(OMR_ERROR_NONE, OMR_GC_SystemCollect(exampleVM->_omrVMThread, 0));
+
+	sampler->kill(env);
+}
+
+/**
+ * Overhead of the sampler at its default interval. Allocations which fit in the TLH cost the sampler nothing, so
+ * its overhead is the cost of a sample point spread over the bytes allocated between two of them. This compares
+ * that cost against the allocation rate measured without sampling, which is more stable than comparing the
+ * allocation rates with and without sampling, whose difference is well below the noise of the collections.
+ */
+TEST_F(perfTestAllocationSampler, overhead)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->getPortLibrary());
+	const uintptr_t objectSize = 64;
+	const uintptr_t objectCount = 1 << 21;
+	const uintptr_t samplePoints = 1 << 14;
+	const uintptr_t rounds = 5;
+	MM_AllocationSampler *sampler = MM_AllocationSampler::newInstance(env, ALLOCATION_SAMPLER_DEFAULT_INTERVAL, ALLOCATION_SAMPLER_DEFAULT_CAPACITY);
+	ASSERT_TRUE(NULL != sampler);
+	MM_AllocationSampler::ThreadState state;
+	sampler->initializeThreadState(env, &state);
+
+	uint64_t allocationMicros = UINT64_MAX;
+	uint64_t sampleMicros = UINT64_MAX;
+	allocateObjects(objectCount, objectSize);
+	for (uintptr_t round = 0; round < rounds; round++) {
+		uint64_t start = omrtime_hires_clock();
+		allocateObjects(objectCount, objectSize);
+		uint64_t micros = omrtime_hires_delta(start, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		if (micros < allocationMicros) {
+			allocationMicros = micros;
+		}
+
+		/* what a thread does at a sample point: catch up with the TLH, then sample the object crossing the point */
+		start = omrtime_hires_clock();
+		for (uintptr_t i = 0; i < samplePoints; i++) {
+			sampler->tlhAllocationNotify(env, &state, state.bytesUntilSample);
+			sampler->allocationNotify(env, &state, (void *)(uintptr_t)(0x10000 + (i * objectSize)), objectSize);
+		}
+		sampler->resolvePendingSample(env, &state);
+		micros = omrtime_hires_delta(start, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		if (micros < sampleMicros) {
+			sampleMicros = micros;
+		}
+	}
+
+	double nanosPerSample = ((double)sampleMicros * 1000.0) / (double)samplePoints;
+	double nanosPerByte = ((double)allocationMicros * 1000.0) / (double)(objectCount * objectSize);
+	double overheadPercent = (nanosPerSample * 100.0) / (nanosPerByte * (double)ALLOCATION_SAMPLER_DEFAULT_INTERVAL);
+	gcTestEnv->log("%.1f ns per sample, %.3f ns per allocated byte: %.3f%% overhead sampling every %zu bytes\n",
+		nanosPerSample, nanosPerByte, overheadPercent, (uintptr_t)ALLOCATION_SAMPLER_DEFAULT_INTERVAL);
+	RecordProperty("nanosPerSample", (int)nanosPerSample);
+	RecordProperty("overheadPercentX1000", (int)(overheadPercent * 1000.0));
+	EXPECT_LT(overheadPercent, 1.0);
+
+	sampler->kill(env);
+}
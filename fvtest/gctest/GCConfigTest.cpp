@@ -19,13 +19,23 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <vector>
+
 #include "CollectorLanguageInterface.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCConfigTest.hpp"
+#include "Heap.hpp"
+#include "HeapDumpReader.hpp"
+#include "HeapDumpWriter.hpp"
 #include "ObjectAllocationModel.hpp"
 #include "ObjectModel.hpp"
 #include "omrExampleVM.hpp"
 #include "omrgc.h"
+#include "ParallelGlobalGC.hpp"
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+#include "EnvironmentStandard.hpp"
+#include "Scavenger.hpp"
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
 #include "SlotObject.hpp"
 #include "StandardWriteBarrier.hpp"
 #include "VerboseWriterChain.hpp"
@@ -47,10 +57,26 @@ const char *gcTests[] = {"fvtest/gctest/configuration/sample_GC_config.xml",
                                 "fvtest/gctest/configuration/scavenger_GC_config.xml",
                                 "fvtest/gctest/configuration/scavenger_GC_backout_config.xml",
                                	"fvtest/gctest/configuration/global_GC_config.xml",
-								"fvtest/gctest/configuration/optavgpause_GC_config.xml"};
+								"fvtest/gctest/configuration/optavgpause_GC_config.xml",
+								"fvtest/gctest/configuration/sticky_mark_GC_config.xml",
+								"fvtest/gctest/configuration/prefault_heap_GC_config.xml",
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+								"fvtest/gctest/configuration/compressed_refs_GC_config.xml",
+#endif /* defined(OMR_GC_COMPRESSED_POINTERS) */
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+								"fvtest/gctest/configuration/concurrent_scavenger_GC_config.xml",
+#endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+#if defined(OMR_GC_MODRON_COMPACTION)
+								"fvtest/gctest/configuration/proactive_compaction_GC_config.xml",
+#endif /* defined(OMR_GC_MODRON_COMPACTION) */
+#if defined(OMR_GC_SEGREGATED_HEAP)
+								"fvtest/gctest/configuration/segregated_sweep_budget_GC_config.xml",
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
+};
 
 const char *perfTests[] = {"perftest/gctest/configuration/21645_core.20150126.202455.11862202.0001.xml",
-								"perftest/gctest/configuration/24404_core.20140723.091737.5812.0002.xml"};
+								"perftest/gctest/configuration/24404_core.20140723.091737.5812.0002.xml",
+								"perftest/gctest/configuration/pointer_graph_config.xml"};
 void
 GCConfigTest::SetUp()
 {
@@ -73,6 +99,8 @@ GCConfigTest::SetUp()
 	rc = OMR_GC_InitializeDispatcherThreads(exampleVM->_omrVMThread);
 	ASSERT_EQ(OMR_ERROR_NONE, rc) << "Setup(): OMR_GC_InitializeDispatcherThreads failed, rc=" << rc;
 
+	gcTestEnv->log("Reference slot size: %zu bytes, compressed reference shift: %zu\n", sizeof(fomrobject_t), (uintptr_t)exampleVM->_omrVM->_compressedPointersShift);
+
 	/* Instantiate collector interface */
 	env = MM_EnvironmentBase::getEnvironment(exampleVM->_omrVMThread);
 	cli = startupManager.createCollectorLanguageInterface(env);
@@ -665,6 +693,36 @@ done:
 	return rt;
 }
 
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+/* While a concurrent scavenge is in progress the mutator must not use a reference to an object in
+ * evacuate space, since the copy made by the collector (or another mutator) is the live one. The
+ * object table is only fixed up at the end of the cycle, so heal each entry as it is looked up.
+ */
+void
+GCConfigTest::readBarrier(ObjectEntry *objectEntry)
+{
+	MM_GCExtensionsBase *extensions = (MM_GCExtensionsBase *)exampleVM->_omrVM->_gcOmrVMExtensions;
+	MM_Scavenger *scavenger = extensions->scavenger;
+	if (extensions->isConcurrentScavengerEnabled() && scavenger->isConcurrentInProgress() && scavenger->isObjectInEvacuateMemory(objectEntry->objPtr)) {
+		scavenger->copyObjectSlot(MM_EnvironmentStandard::getEnvironment(env), (volatile omrobjectptr_t *)&objectEntry->objPtr);
+	}
+}
+
+/* Heal a reference read from a slot of parentPtr, and with -Xgc:concurrentScavengerSelfHealObject the rest of parentPtr too */
+void
+GCConfigTest::readBarrier(omrobjectptr_t parentPtr, GC_SlotObject *slotObject)
+{
+	MM_GCExtensionsBase *extensions = (MM_GCExtensionsBase *)exampleVM->_omrVM->_gcOmrVMExtensions;
+	MM_Scavenger *scavenger = extensions->scavenger;
+	if (extensions->isConcurrentScavengerEnabled() && scavenger->isConcurrentInProgress()) {
+		omrobjectptr_t objectPtr = slotObject->readReferenceFromSlot();
+		if ((NULL != objectPtr) && scavenger->isObjectInEvacuateMemory(objectPtr)) {
+			scavenger->mutatorReadBarrierSlowPath(MM_EnvironmentStandard::getEnvironment(env), parentPtr, slotObject);
+		}
+	}
+}
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
+
 int32_t
 GCConfigTest::removeObjectFromParentSlot(const char *name, ObjectEntry *parentEntry)
 {
@@ -682,6 +740,9 @@ GCConfigTest::removeObjectFromParentSlot(const char *name, ObjectEntry *parentEn
 
 	while (currentSlot < endSlot) {
 		GC_SlotObject slotObject(exampleVM->_omrVM, currentSlot);
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+		readBarrier(parentEntry->objPtr, &slotObject);
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
 		if (objEntry->objPtr == slotObject.readReferenceFromSlot()) {
 			gcTestEnv->log(LEVEL_VERBOSE, "Remove object %s(%p[0x%llx]) from parent %s(%p[0x%llx]) slot %p.\n", name, objEntry->objPtr, objEntry->objPtr->header.raw(), parentEntry->name, parentEntry->objPtr, parentEntry->objPtr->header.raw(), slotObject.readAddressFromSlot());
 			slotObject.writeReferenceToSlot(NULL);
@@ -950,6 +1011,7 @@ done:
 int32_t
 GCConfigTest::triggerOperation(pugi::xml_node node)
 {
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
 	int32_t rt = 0;
 	for (; node; node = node.next_sibling()) {
 		if (0 == strcmp(node.name(), "systemCollect")) {
@@ -960,19 +1022,170 @@ GCConfigTest::triggerOperation(pugi::xml_node node)
 			}
 			uint32_t gcCode = (uint32_t)atoi(gcCodeStr);
 			gcTestEnv->log("Invoking gc system collect with gcCode %d...\n", gcCode);
+			uint64_t startTime = omrtime_hires_clock();
 			rt = (int32_t)OMR_GC_SystemCollect(exampleVM->_omrVMThread, gcCode);
 			if (OMR_ERROR_NONE != rt) {
 				gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to perform OMR_GC_SystemCollect with error code %d.\n", __FILE__, __LINE__, rt);
 				goto done;
 			}
+			/* live footprint and collection time are the figures to compare between full and compressed reference builds */
+			uint64_t elapsedMicros = omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+			MM_Heap *heap = ((MM_GCExtensionsBase *)exampleVM->_omrVM->_gcOmrVMExtensions)->heap;
+			uintptr_t liveBytes = heap->getActiveMemorySize() - heap->getApproximateFreeMemorySize();
+			gcTestEnv->log("Time elapsed in gc: %llu us, live heap: %zu bytes\n", elapsedMicros, liveBytes);
 			OMRGCTEST_CHECK_RT(rt);
 			verboseManager->getWriterChain()->endOfCycle(env);
+		} else if (0 == strcmp(node.name(), "heapDump")) {
+			rt = heapDump(node);
+			OMRGCTEST_CHECK_RT(rt);
+		} else if (0 == strcmp(node.name(), "traverseGraph")) {
+			rt = traverseGraph(node);
+			OMRGCTEST_CHECK_RT(rt);
 		}
 	}
 done:
 	return rt;
 }
 
+int32_t
+GCConfigTest::heapDump(pugi::xml_node node)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
+	MM_GCExtensionsBase *extensions = (MM_GCExtensionsBase *)exampleVM->_omrVM->_gcOmrVMExtensions;
+	MM_ParallelGlobalGC *globalCollector = (MM_ParallelGlobalGC *)extensions->getGlobalCollector();
+	int32_t rt = 0;
+	char dumpFile[MAX_NAME_LENGTH];
+	omrstr_printf(dumpFile, MAX_NAME_LENGTH, "HeapDump_%d_%lld.bin", omrsysinfo_get_pid(), omrtime_current_time_millis());
+
+	gcTestEnv->log("Writing heap dump %s...\n", dumpFile);
+	MM_HeapDumpWriter *writer = MM_HeapDumpWriter::newInstance(env, globalCollector->getHeapWalker(), dumpFile);
+	if (NULL == writer) {
+		rt = 1;
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to create heap dump writer for %s.\n", __FILE__, __LINE__, dumpFile);
+		goto done;
+	}
+	{
+		int64_t startTime = omrtime_current_time_millis();
+		env->acquireExclusiveVMAccess();
+		bool written = writer->writeHeapDump(env);
+		env->releaseExclusiveVMAccess();
+		uintptr_t objectsWritten = writer->getObjectCount();
+		gcTestEnv->log("Wrote %zu objects, %llu bytes in %lld ms\n", objectsWritten, writer->getBytesWritten(), (omrtime_current_time_millis() - startTime));
+		writer->kill(env);
+		if (!written || (0 == objectsWritten)) {
+			rt = 1;
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to write heap dump %s.\n", __FILE__, __LINE__, dumpFile);
+			goto done;
+		}
+
+		/* read it back: every record must be well formed, with a non zero size, and the counts must agree */
+		MM_HeapDumpReader *reader = MM_HeapDumpReader::newInstance(gcTestEnv->portLib, dumpFile);
+		if (NULL == reader) {
+			rt = 1;
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to open heap dump %s.\n", __FILE__, __LINE__, dumpFile);
+			goto done;
+		}
+		MM_HeapDumpObject object;
+		uintptr_t objectsRead = 0;
+		uintptr_t referencesRead = 0;
+		uintptr_t reference = 0;
+		while (reader->nextObject(&object)) {
+			if (0 == object.size) {
+				rt = 1;
+			}
+			while (reader->nextReference(&reference)) {
+				referencesRead += 1;
+			}
+			objectsRead += 1;
+		}
+		if (reader->isCorrupt() || (objectsRead != objectsWritten)) {
+			rt = 1;
+		}
+		reader->kill();
+		gcTestEnv->log("Read %zu objects with %zu references\n", objectsRead, referencesRead);
+		if (0 != rt) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Heap dump %s does not match the heap: %zu objects written, %zu read.\n", __FILE__, __LINE__, dumpFile, objectsWritten, objectsRead);
+		}
+	}
+
+done:
+	omrfile_unlink(dumpFile);
+	return rt;
+}
+
+/*
+ * Walk the reachable graph from the roots like a mutator would, reading every reference slot through
+ * GC_SlotObject and touching every object it leads to. Reports the footprint of the graph and the time
+ * per reference followed, which are the figures that differ between full and compressed reference builds.
+ */
+int32_t
+GCConfigTest::traverseGraph(pugi::xml_node node)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
+	MM_GCExtensionsBase *extensions = (MM_GCExtensionsBase *)exampleVM->_omrVM->_gcOmrVMExtensions;
+	int32_t iterations = atoi(node.attribute("iterations").value());
+	if (0 >= iterations) {
+		iterations = 1;
+	}
+
+	uintptr_t objectCount = 0;
+	uintptr_t referenceCount = 0;
+	uintptr_t graphBytes = 0;
+	uintptr_t checksum = 0;
+	std::vector<omrobjectptr_t> pending;
+	uint64_t startTime = omrtime_hires_clock();
+	for (int32_t i = 0; i < iterations; i++) {
+		objectCount = 0;
+		referenceCount = 0;
+		graphBytes = 0;
+		J9HashTableState state;
+		RootEntry *rootEntry = (RootEntry *)hashTableStartDo(exampleVM->rootTable, &state);
+		while (NULL != rootEntry) {
+			if (NULL != rootEntry->rootPtr) {
+				pending.push_back(rootEntry->rootPtr);
+			}
+			rootEntry = (RootEntry *)hashTableNextDo(&state);
+		}
+		/* the test graphs are trees, so every object is reached exactly once */
+		while (!pending.empty()) {
+			omrobjectptr_t objectPtr = pending.back();
+			pending.pop_back();
+			uintptr_t size = extensions->objectModel.getConsumedSizeInBytesWithHeader(objectPtr);
+			fomrobject_t *currentSlot = (fomrobject_t *)objectPtr + 1;
+			fomrobject_t *endSlot = (fomrobject_t *)((uint8_t *)objectPtr + size);
+			while (currentSlot < endSlot) {
+				GC_SlotObject slotObject(exampleVM->_omrVM, currentSlot);
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+				readBarrier(objectPtr, &slotObject);
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
+				omrobjectptr_t childPtr = slotObject.readReferenceFromSlot();
+				if (NULL != childPtr) {
+					checksum += childPtr->header.raw();
+					pending.push_back(childPtr);
+					referenceCount += 1;
+				}
+				currentSlot += 1;
+			}
+			graphBytes += size;
+			objectCount += 1;
+		}
+	}
+	uint64_t elapsedNanos = omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_NANOSECONDS);
+
+	int32_t rt = 0;
+	if (0 == objectCount) {
+		rt = 1;
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d No objects reachable from the roots to traverse.\n", __FILE__, __LINE__);
+	} else {
+		uint64_t nanosPerReference = elapsedNanos / OMR_MAX(1, referenceCount * iterations);
+		gcTestEnv->log("Graph traversal: %zu objects, %zu references, %zu bytes (%zu bytes/object), %llu ns/reference over %d iterations (checksum %zx)\n",
+				objectCount, referenceCount, graphBytes, graphBytes / objectCount, nanosPerReference, iterations, checksum);
+		RecordProperty("graphBytes", (int)graphBytes);
+		RecordProperty("nanosPerReference", (int)nanosPerReference);
+	}
+	return rt;
+}
+
 int32_t
 GCConfigTest::iniXMLStr(const char *configStyle)
 {
@@ -29,6 +29,7 @@
 #include "ObjectAllocationInterface.hpp"
 #include "ObjectModel.hpp"
 #include "pugixml.hpp"
+#include "SlotObject.hpp"
 #include "StartupManagerTestExample.hpp"
 #include "VerboseManager.hpp"
 
@@ -110,7 +111,13 @@ protected:
 	int32_t verifyVerboseGC(pugi::xpath_node_set verboseGCs);
 	int32_t parseGarbagePolicy(pugi::xml_node node);
 	int32_t triggerOperation(pugi::xml_node node);
+	int32_t heapDump(pugi::xml_node node);
+	int32_t traverseGraph(pugi::xml_node node);
 	int32_t iniXMLStr(const char *configStyle);
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+	void readBarrier(ObjectEntry *objectEntry);
+	void readBarrier(omrobjectptr_t parentPtr, GC_SlotObject *slotObject);
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
 
 	/* This implementation assumes that existing entries hashed into the rootTable and objectTable can
 	 * be moved whenever new entries are added. This complicates the usage of ObjectEntry pointers that
@@ -133,7 +140,13 @@ protected:
 	{
 		ObjectEntry searchEntry;
 		searchEntry.name = name;
-		return (ObjectEntry *)hashTableFind(exampleVM->objectTable, &searchEntry);
+		ObjectEntry *foundEntry = (ObjectEntry *)hashTableFind(exampleVM->objectTable, &searchEntry);
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+		if (NULL != foundEntry) {
+			readBarrier(foundEntry);
+		}
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
+		return foundEntry;
 	}
 
 	ObjectEntry *
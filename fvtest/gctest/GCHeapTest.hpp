@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(GCHEAPTEST_HPP_INCLUDED)
+#define GCHEAPTEST_HPP_INCLUDED
+
+#include "EnvironmentBase.hpp"
+#include "gcTestHelpers.hpp"
+
+/**
+ * Fixture for unit tests of individual GC components. It brings up a heap and collector
+ * from a configuration file, as GCConfigTest does, so the test body has an attached
+ * MM_EnvironmentBase to hand to the component under test, but it allocates no objects.
+ */
+class GCHeapTest : public ::testing::Test
+{
+	/*
+	 * Data members
+	 */
+protected:
+	OMR_VM_Example *exampleVM;
+	MM_EnvironmentBase *env;
+
+	/*
+	 * Function members
+	 */
+protected:
+	/**
+	 * @return the configuration file, relative to the source root, that the heap is built from
+	 */
+	virtual const char *configFile() { return "fvtest/gctest/configuration/sample_GC_config.xml"; }
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+public:
+	GCHeapTest()
+		: ::testing::Test()
+		, exampleVM(&(gcTestEnv->exampleVM))
+		, env(NULL)
+	{
+	}
+};
+
+#endif /* GCHEAPTEST_HPP_INCLUDED */
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#include "Forge.hpp"
+#include "GCHeapTest.hpp"
+#include "HeapLinkedFreeHeader.hpp"
+#include "LargeFreeEntryIndex.hpp"
+
+#define FREE_ENTRY_INDEX_TEST_ENTRIES 16
+#define FREE_ENTRY_INDEX_TEST_THRESHOLD 1024
+
+/**
+ * Free headers which are not in the heap. The index only compares their addresses, and
+ * rebuild() only reads their size and next pointer, so that is all that is set up.
+ */
+class LargeFreeEntryIndexTest : public GCHeapTest
+{
+protected:
+	MM_HeapLinkedFreeHeader *_freeEntries;
+
+	virtual void
+	SetUp()
+	{
+		GCHeapTest::SetUp();
+		_freeEntries = (MM_HeapLinkedFreeHeader *)env->getForge()->allocate(sizeof(MM_HeapLinkedFreeHeader) * FREE_ENTRY_INDEX_TEST_ENTRIES, OMR::GC::AllocationCategory::OTHER, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != _freeEntries);
+		for (uintptr_t i = 0; i < FREE_ENTRY_INDEX_TEST_ENTRIES; i++) {
+			_freeEntries[i].setNext(NULL);
+			_freeEntries[i].setSize(0);
+		}
+	}
+
+	virtual void
+	TearDown()
+	{
+		env->getForge()->free(_freeEntries);
+		_freeEntries = NULL;
+		GCHeapTest::TearDown();
+	}
+
+	MM_HeapLinkedFreeHeader *
+	freeEntry(uintptr_t index)
+	{
+		return &_freeEntries[index];
+	}
+};
+
+class gcFunctionalTestLargeFreeEntryIndex : public LargeFreeEntryIndexTest {};
+
+TEST_F(gcFunctionalTestLargeFreeEntryIndex, insertAndRemove)
+{
+	MM_LargeFreeEntryIndex *index = MM_LargeFreeEntryIndex::newInstance(env, 8, FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_TRUE(NULL != index);
+	ASSERT_EQ((uintptr_t)FREE_ENTRY_INDEX_TEST_THRESHOLD, index->getThreshold());
+	ASSERT_FALSE(index->isValid());
+	index->clear();
+	index->validate();
+	ASSERT_TRUE(index->isValid());
+	ASSERT_TRUE(index->isComplete());
+	ASSERT_EQ((uintptr_t)0, index->getLargestSize());
+	ASSERT_TRUE(NULL == index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+
+	/* entries below the threshold are not recorded */
+	index->insert(freeEntry(0), FREE_ENTRY_INDEX_TEST_THRESHOLD - 1);
+	ASSERT_EQ((uintptr_t)0, index->getLargestSize());
+	ASSERT_TRUE(NULL == index->findBestFit(0, NULL));
+
+	index->insert(freeEntry(1), 4096);
+	index->insert(freeEntry(2), FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	index->insert(freeEntry(3), 2048);
+	ASSERT_EQ((uintptr_t)4096, index->getLargestSize());
+	ASSERT_EQ(freeEntry(2), index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+
+	/* removing with the wrong size or an unrecorded entry changes nothing */
+	index->remove(freeEntry(3), 2049);
+	index->remove(freeEntry(4), 2048);
+	index->remove(freeEntry(0), FREE_ENTRY_INDEX_TEST_THRESHOLD - 1);
+	ASSERT_EQ(freeEntry(3), index->findBestFit(2048, NULL));
+
+	index->remove(freeEntry(3), 2048);
+	ASSERT_EQ(freeEntry(1), index->findBestFit(2048, NULL));
+	index->remove(freeEntry(1), 4096);
+	ASSERT_EQ((uintptr_t)FREE_ENTRY_INDEX_TEST_THRESHOLD, index->getLargestSize());
+	ASSERT_TRUE(NULL == index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD + 1, NULL));
+	index->remove(freeEntry(2), FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_EQ((uintptr_t)0, index->getLargestSize());
+	ASSERT_TRUE(index->isComplete());
+
+	index->kill(env);
+}
+
+TEST_F(gcFunctionalTestLargeFreeEntryIndex, bestFit)
+{
+	MM_LargeFreeEntryIndex *index = MM_LargeFreeEntryIndex::newInstance(env, FREE_ENTRY_INDEX_TEST_ENTRIES, FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_TRUE(NULL != index);
+	index->clear();
+
+	/* inserted out of address order, with ties in size */
+	index->insert(freeEntry(5), 8192);
+	index->insert(freeEntry(4), 3072);
+	index->insert(freeEntry(7), 3072);
+	index->insert(freeEntry(1), 3072);
+	index->insert(freeEntry(6), 2048);
+	index->validate();
+
+	/* the smallest entry that fits, ties broken by lowest address */
+	ASSERT_EQ(freeEntry(6), index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+	ASSERT_EQ(freeEntry(6), index->findBestFit(2048, NULL));
+	ASSERT_EQ(freeEntry(1), index->findBestFit(2049, NULL));
+	ASSERT_EQ(freeEntry(1), index->findBestFit(3072, NULL));
+	ASSERT_EQ(freeEntry(5), index->findBestFit(3073, NULL));
+	ASSERT_EQ(freeEntry(5), index->findBestFit(8192, NULL));
+	ASSERT_TRUE(NULL == index->findBestFit(8193, NULL));
+
+	/* an excluded entry is passed over for the next best one */
+	ASSERT_EQ(freeEntry(4), index->findBestFit(3072, freeEntry(1)));
+	ASSERT_EQ(freeEntry(1), index->findBestFit(2048, freeEntry(6)));
+	ASSERT_TRUE(NULL == index->findBestFit(8192, freeEntry(5)));
+
+	index->kill(env);
+}
+
+TEST_F(gcFunctionalTestLargeFreeEntryIndex, overflow)
+{
+	const uintptr_t capacity = 4;
+	MM_LargeFreeEntryIndex *index = MM_LargeFreeEntryIndex::newInstance(env, capacity, FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_TRUE(NULL != index);
+	index->clear();
+
+	for (uintptr_t i = 0; i < capacity; i++) {
+		index->insert(freeEntry(i), (i + 2) * FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	}
+	index->validate();
+	ASSERT_TRUE(index->isComplete());
+
+	/* a new smallest entry is dropped itself */
+	index->insert(freeEntry(8), FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_FALSE(index->isComplete());
+	ASSERT_TRUE(index->isValid());
+	ASSERT_EQ(freeEntry(0), index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+
+	/* a larger entry displaces the smallest record */
+	index->insert(freeEntry(9), 10 * FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_EQ((uintptr_t)(10 * FREE_ENTRY_INDEX_TEST_THRESHOLD), index->getLargestSize());
+	ASSERT_EQ(freeEntry(1), index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+	ASSERT_EQ(freeEntry(9), index->findBestFit(6 * FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+
+	/* removing records does not make the index complete again, only clearing it does */
+	index->remove(freeEntry(9), 10 * FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_FALSE(index->isComplete());
+	index->clear();
+	ASSERT_TRUE(index->isComplete());
+	ASSERT_FALSE(index->isValid());
+
+	index->kill(env);
+}
+
+TEST_F(gcFunctionalTestLargeFreeEntryIndex, rebuild)
+{
+	MM_LargeFreeEntryIndex *index = MM_LargeFreeEntryIndex::newInstance(env, 4, FREE_ENTRY_INDEX_TEST_THRESHOLD);
+	ASSERT_TRUE(NULL != index);
+
+	/* an address ordered free list alternating small and large entries */
+	for (uintptr_t i = 0; i < FREE_ENTRY_INDEX_TEST_ENTRIES; i++) {
+		uintptr_t size = (0 == (i % 2)) ? (FREE_ENTRY_INDEX_TEST_THRESHOLD / 2) : ((i + 1) * FREE_ENTRY_INDEX_TEST_THRESHOLD);
+		freeEntry(i)->setSize(size);
+		freeEntry(i)->setNext(((i + 1) < FREE_ENTRY_INDEX_TEST_ENTRIES) ? freeEntry(i + 1) : NULL);
+	}
+
+	index->rebuild(freeEntry(0));
+	ASSERT_TRUE(index->isValid());
+	/* 8 large entries do not fit in 4 records, so only the 4 largest are kept */
+	ASSERT_FALSE(index->isComplete());
+	ASSERT_EQ((uintptr_t)(FREE_ENTRY_INDEX_TEST_ENTRIES * FREE_ENTRY_INDEX_TEST_THRESHOLD), index->getLargestSize());
+	ASSERT_EQ(freeEntry(9), index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+	ASSERT_EQ(freeEntry(11), index->findBestFit(11 * FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+
+	/* a short enough list is recorded completely, and the small entries are skipped */
+	freeEntry(5)->setNext(NULL);
+	index->invalidate();
+	index->rebuild(freeEntry(0));
+	ASSERT_TRUE(index->isValid());
+	ASSERT_TRUE(index->isComplete());
+	ASSERT_EQ(freeEntry(1), index->findBestFit(FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+	ASSERT_EQ(freeEntry(3), index->findBestFit(3 * FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+	ASSERT_EQ(freeEntry(5), index->findBestFit(5 * FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+	ASSERT_TRUE(NULL == index->findBestFit(7 * FREE_ENTRY_INDEX_TEST_THRESHOLD, NULL));
+
+	index->kill(env);
+}
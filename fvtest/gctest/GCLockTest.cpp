@@ -0,0 +1,256 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrTest.h"
+#include "omrport.h"
+#include "omrthread.h"
+
+#include "AtomicOperations.hpp"
+#include "gcspinlock.h"
+#include "gcTestHelpers.hpp"
+
+#define LOCK_TEST_MAX_THREADS 128
+
+/**
+ * Uniform view of the two GC spinlock flavours so the same test body can drive either.
+ */
+struct LockTestLock {
+	bool queued;
+	J9GCSpinlock spinlock;
+	J9GCQueuedSpinlock queuedSpinlock;
+
+	void
+	init(bool isQueued)
+	{
+		queued = isQueued;
+		if (queued) {
+			ASSERT_EQ(0, omrgc_queued_spinlock_init(&queuedSpinlock));
+			queuedSpinlock.spinCount1 = 256;
+			queuedSpinlock.spinCount2 = 32;
+			queuedSpinlock.spinCount3 = 45;
+		} else {
+			ASSERT_EQ(0, omrgc_spinlock_init(&spinlock));
+			spinlock.spinCount1 = 256;
+			spinlock.spinCount2 = 32;
+			spinlock.spinCount3 = 45;
+		}
+	}
+
+	void
+	destroy()
+	{
+		if (queued) {
+			omrgc_queued_spinlock_destroy(&queuedSpinlock);
+		} else {
+			omrgc_spinlock_destroy(&spinlock);
+		}
+	}
+
+	void
+	acquire()
+	{
+		if (queued) {
+			omrgc_queued_spinlock_acquire(&queuedSpinlock, NULL);
+		} else {
+			omrgc_spinlock_acquire(&spinlock, NULL);
+		}
+	}
+
+	void
+	release()
+	{
+		if (queued) {
+			omrgc_queued_spinlock_release(&queuedSpinlock);
+		} else {
+			omrgc_spinlock_release(&spinlock);
+		}
+	}
+};
+
+struct LockTestData {
+	LockTestLock lock;
+	uintptr_t iterations;
+	volatile uintptr_t startedThreads;
+	volatile bool go;
+	uintptr_t counter; /**< only ever updated while holding lock */
+	uintptr_t orderCount;
+	uintptr_t order[LOCK_TEST_MAX_THREADS];
+};
+
+struct LockTestThreadArg {
+	LockTestData *data;
+	uintptr_t id;
+};
+
+static int J9THREAD_PROC
+lockTestCounterThread(void *entryArg)
+{
+	LockTestData *data = ((LockTestThreadArg *)entryArg)->data;
+
+	MM_AtomicOperations::add(&data->startedThreads, 1);
+	while (!data->go) {
+		omrthread_yield();
+	}
+	for (uintptr_t i = 0; i < data->iterations; i++) {
+		data->lock.acquire();
+		/* non-atomic read-modify-write; lost updates indicate broken mutual exclusion */
+		uintptr_t value = data->counter;
+		MM_AtomicOperations::nop();
+		data->counter = value + 1;
+		data->lock.release();
+	}
+	return 0;
+}
+
+static int J9THREAD_PROC
+lockTestOrderThread(void *entryArg)
+{
+	LockTestThreadArg *arg = (LockTestThreadArg *)entryArg;
+	LockTestData *data = arg->data;
+
+	data->lock.acquire();
+	data->order[data->orderCount] = arg->id;
+	data->orderCount += 1;
+	data->lock.release();
+	return 0;
+}
+
+static omrthread_t
+startLockTestThread(omrthread_entrypoint_t entryProc, LockTestThreadArg *arg)
+{
+	omrthread_t thread = NULL;
+	omrthread_attr_t attr = NULL;
+	EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_init(&attr));
+	EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE));
+	EXPECT_EQ(J9THREAD_SUCCESS, omrthread_create_ex(&thread, &attr, 0, entryProc, arg));
+	omrthread_attr_destroy(&attr);
+	return thread;
+}
+
+/**
+ * Run threadCount threads each taking the lock data->iterations times.
+ * @return elapsed time in microseconds
+ */
+static uint64_t
+runLockTestCounter(LockTestData *data, uintptr_t threadCount)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->getPortLibrary());
+	omrthread_t threads[LOCK_TEST_MAX_THREADS];
+	LockTestThreadArg args[LOCK_TEST_MAX_THREADS];
+
+	data->startedThreads = 0;
+	data->go = false;
+	data->counter = 0;
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		args[i].data = data;
+		args[i].id = i;
+		threads[i] = startLockTestThread(lockTestCounterThread, &args[i]);
+	}
+	while (threadCount != data->startedThreads) {
+		omrthread_yield();
+	}
+
+	uint64_t start = omrtime_hires_clock();
+	MM_AtomicOperations::writeBarrier();
+	data->go = true;
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		omrthread_join(threads[i]);
+	}
+	return omrtime_hires_delta(start, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+}
+
+static void
+verifyMutualExclusion(bool queued)
+{
+	static const uintptr_t threadCounts[] = {1, 2, 4, 8, 16};
+	LockTestData data;
+	data.lock.init(queued);
+	data.iterations = 2000;
+	for (uintptr_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+		runLockTestCounter(&data, threadCounts[i]);
+		ASSERT_EQ(threadCounts[i] * data.iterations, data.counter) << "lost updates with " << threadCounts[i] << " threads";
+	}
+	data.lock.destroy();
+}
+
+TEST(gcFunctionalTestLock, spinlockMutualExclusion)
+{
+	verifyMutualExclusion(false);
+}
+
+TEST(gcFunctionalTestLock, queuedSpinlockMutualExclusion)
+{
+	verifyMutualExclusion(true);
+}
+
+TEST(gcFunctionalTestLock, queuedSpinlockFIFO)
+{
+	const uintptr_t threadCount = 8;
+	omrthread_t threads[threadCount];
+	LockTestThreadArg args[threadCount];
+	LockTestData data;
+	data.lock.init(true);
+	data.orderCount = 0;
+
+	/* Hold the lock and let the waiters queue up one at a time */
+	data.lock.acquire();
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		J9GCQueuedSpinlockNode *tail = data.lock.queuedSpinlock.tail;
+		args[i].data = &data;
+		args[i].id = i;
+		threads[i] = startLockTestThread(lockTestOrderThread, &args[i]);
+		while (tail == data.lock.queuedSpinlock.tail) {
+			omrthread_sleep(1);
+		}
+	}
+	data.lock.release();
+
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		omrthread_join(threads[i]);
+	}
+	ASSERT_EQ(threadCount, data.orderCount);
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		ASSERT_EQ(i, data.order[i]) << "waiters acquired the lock out of arrival order";
+	}
+	ASSERT_TRUE(NULL == data.lock.queuedSpinlock.tail);
+	data.lock.destroy();
+}
+
+/**
+ * Contended lock throughput for 1 to LOCK_TEST_MAX_THREADS threads.
+ */
+TEST(perfTestLock, throughput)
+{
+	const uintptr_t totalAcquires = 1 << 16;
+	for (uintptr_t queued = 0; queued < 2; queued++) {
+		LockTestData data;
+		data.lock.init(1 == queued);
+		for (uintptr_t threadCount = 1; threadCount <= LOCK_TEST_MAX_THREADS; threadCount *= 2) {
+			data.iterations = totalAcquires / threadCount;
+			uint64_t micros = runLockTestCounter(&data, threadCount);
+			ASSERT_EQ(totalAcquires, data.counter);
+			gcTestEnv->log("%s spinlock, %3zu threads: %llu acquires/ms\n", (1 == queued) ? "queued" : "plain ",
+				threadCount, (unsigned long long)((totalAcquires * 1000) / ((0 == micros) ? 1 : micros)));
+		}
+		data.lock.destroy();
+	}
+}
@@ -0,0 +1,304 @@
+/*******************************************************************************
+ * Copyright (c) 2026, 2026 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+#include "omrport.h"
+#include "omrthread.h"
+
+#include "AtomicOperations.hpp"
+#include "Forge.hpp"
+#include "GCHeapTest.hpp"
+#include "HeapRegionDescriptorSegregated.hpp"
+#include "LockingFreeHeapRegionList.hpp"
+#include "LockingHeapRegionQueue.hpp"
+#include "ShardedFreeHeapRegionList.hpp"
+#include "ShardedHeapRegionQueue.hpp"
+
+#define REGION_LIST_TEST_REGIONS 256
+#define REGION_LIST_TEST_MAX_THREADS 16
+#define REGION_LIST_TEST_SHARDS 8
+
+/**
+ * Descriptors which are never backed by heap memory. The lists only link them through
+ * next/prev and read their range, so that is all that is set up.
+ */
+class RegionListTest : public GCHeapTest
+{
+protected:
+	void *_descriptorMemory;
+	uintptr_t _descriptorStride;
+
+	virtual void
+	SetUp()
+	{
+		GCHeapTest::SetUp();
+		_descriptorStride = MM_Math::roundToCeiling(sizeof(uintptr_t), sizeof(MM_HeapRegionDescriptorSegregated));
+		_descriptorMemory = env->getForge()->allocate(_descriptorStride * REGION_LIST_TEST_REGIONS, OMR::GC::AllocationCategory::OTHER, OMR_GET_CALLSITE());
+		ASSERT_TRUE(NULL != _descriptorMemory);
+		for (uintptr_t i = 0; i < REGION_LIST_TEST_REGIONS; i++) {
+			MM_HeapRegionDescriptorSegregated *descriptor = new (region(i)) MM_HeapRegionDescriptorSegregated(env, NULL, NULL);
+			descriptor->setRangeCount(1);
+		}
+	}
+
+	virtual void
+	TearDown()
+	{
+		env->getForge()->free(_descriptorMemory);
+		_descriptorMemory = NULL;
+		GCHeapTest::TearDown();
+	}
+
+	MM_HeapRegionDescriptorSegregated *
+	region(uintptr_t index)
+	{
+		return (MM_HeapRegionDescriptorSegregated *)((uintptr_t)_descriptorMemory + (index * _descriptorStride));
+	}
+
+	/**
+	 * @return true if every test region is on the list exactly once
+	 */
+	bool
+	drainAndCheck(MM_FreeHeapRegionList *list)
+	{
+		bool seen[REGION_LIST_TEST_REGIONS];
+		memset(seen, 0, sizeof(seen));
+		uintptr_t count = 0;
+		MM_HeapRegionDescriptorSegregated *cur = NULL;
+		while (NULL != (cur = list->pop())) {
+			uintptr_t index = ((uintptr_t)cur - (uintptr_t)_descriptorMemory) / _descriptorStride;
+			if ((index >= REGION_LIST_TEST_REGIONS) || seen[index]) {
+				return false;
+			}
+			seen[index] = true;
+			count += 1;
+		}
+		return (REGION_LIST_TEST_REGIONS == count) && list->isEmpty();
+	}
+};
+
+class gcFunctionalTestRegionList : public RegionListTest {};
+class perfTestRegionList : public RegionListTest {};
+
+TEST_F(gcFunctionalTestRegionList, shardAlignment)
+{
+	for (uintptr_t shardCount = 1; shardCount <= 9; shardCount += 2) {
+		MM_ShardedHeapRegionQueue *queue = MM_ShardedHeapRegionQueue::newInstance(env, MM_HeapRegionList::HRL_KIND_SWEEP, true, shardCount);
+		MM_ShardedFreeHeapRegionList *list = MM_ShardedFreeHeapRegionList::newInstance(env, MM_HeapRegionList::HRL_KIND_FREE, true, shardCount);
+		ASSERT_TRUE((NULL != queue) && (NULL != list));
+		ASSERT_EQ(shardCount, queue->getShardCount());
+		ASSERT_EQ(shardCount, list->getShardCount());
+		for (uintptr_t i = 0; i < shardCount; i++) {
+			ASSERT_EQ((uintptr_t)0, (uintptr_t)queue->getShard(i) % HEAP_REGION_SHARD_ALIGNMENT) << "queue shard " << i << " of " << shardCount;
+			ASSERT_EQ((uintptr_t)0, (uintptr_t)list->getShard(i) % HEAP_REGION_SHARD_ALIGNMENT) << "list shard " << i << " of " << shardCount;
+		}
+		queue->kill(env);
+		list->kill(env);
+	}
+}
+
+TEST_F(gcFunctionalTestRegionList, shardedQueue)
+{
+	MM_ShardedHeapRegionQueue *queue = MM_ShardedHeapRegionQueue::newInstance(env, MM_HeapRegionList::HRL_KIND_SWEEP, true, 4);
+	MM_LockingHeapRegionQueue *target = MM_LockingHeapRegionQueue::newInstance(env, MM_HeapRegionList::HRL_KIND_LOCAL_WORK, true, true);
+	ASSERT_TRUE((NULL != queue) && (NULL != target));
+	ASSERT_TRUE(queue->isEmpty());
+	ASSERT_TRUE(NULL == queue->dequeue());
+
+	for (uintptr_t i = 0; i < REGION_LIST_TEST_REGIONS; i++) {
+		queue->enqueue(region(i));
+	}
+	ASSERT_FALSE(queue->isEmpty());
+	ASSERT_EQ((uintptr_t)REGION_LIST_TEST_REGIONS, queue->getTotalRegions());
+
+	/* a bulk dequeue takes from the home shard first and moves on to the others */
+	ASSERT_EQ((uintptr_t)(REGION_LIST_TEST_REGIONS / 2), queue->dequeue(target, REGION_LIST_TEST_REGIONS / 2));
+	ASSERT_EQ((uintptr_t)(REGION_LIST_TEST_REGIONS / 2), queue->getTotalRegions());
+	ASSERT_EQ((uintptr_t)(REGION_LIST_TEST_REGIONS / 2), target->getTotalRegions());
+
+	/* moving a whole queue back in keeps every region */
+	queue->enqueue(target);
+	ASSERT_TRUE(target->isEmpty());
+	ASSERT_EQ((uintptr_t)REGION_LIST_TEST_REGIONS, queue->getTotalRegions());
+
+	uintptr_t dequeued = 0;
+	while (NULL != queue->dequeue()) {
+		dequeued += 1;
+	}
+	ASSERT_EQ((uintptr_t)REGION_LIST_TEST_REGIONS, dequeued);
+	ASSERT_TRUE(queue->isEmpty());
+
+	target->kill(env);
+	queue->kill(env);
+}
+
+TEST_F(gcFunctionalTestRegionList, shardedFreeList)
+{
+	MM_ShardedFreeHeapRegionList *list = MM_ShardedFreeHeapRegionList::newInstance(env, MM_HeapRegionList::HRL_KIND_FREE, true, 4);
+	MM_ShardedFreeHeapRegionList *other = MM_ShardedFreeHeapRegionList::newInstance(env, MM_HeapRegionList::HRL_KIND_FREE, true, 3);
+	MM_ShardedHeapRegionQueue *queue = MM_ShardedHeapRegionQueue::newInstance(env, MM_HeapRegionList::HRL_KIND_SWEEP, true, 2);
+	ASSERT_TRUE((NULL != list) && (NULL != other) && (NULL != queue));
+	ASSERT_TRUE(list->isEmpty());
+	ASSERT_TRUE(NULL == list->pop());
+
+	for (uintptr_t i = 0; i < REGION_LIST_TEST_REGIONS; i++) {
+		list->push(region(i));
+	}
+	ASSERT_EQ((uintptr_t)REGION_LIST_TEST_REGIONS, list->getTotalRegions());
+	ASSERT_EQ((uintptr_t)1, list->getMaxRegions());
+	ASSERT_TRUE(drainAndCheck(list));
+
+	/* bulk pushes from a differently sharded list and from a queue */
+	for (uintptr_t i = 0; i < REGION_LIST_TEST_REGIONS; i++) {
+		if (0 == (i % 2)) {
+			other->push(region(i));
+		} else {
+			queue->enqueue(region(i));
+		}
+	}
+	list->push(other);
+	list->push(queue);
+	ASSERT_TRUE(other->isEmpty());
+	ASSERT_TRUE(queue->isEmpty());
+	ASSERT_EQ((uintptr_t)REGION_LIST_TEST_REGIONS, list->getTotalRegions());
+	ASSERT_TRUE(drainAndCheck(list));
+
+	queue->kill(env);
+	other->kill(env);
+	list->kill(env);
+}
+
+struct RegionListTestData {
+	MM_FreeHeapRegionList *list;
+	uintptr_t iterations;
+	volatile uintptr_t startedThreads;
+	volatile bool go;
+	volatile uintptr_t emptyPops;
+};
+
+static int J9THREAD_PROC
+regionListTestThread(void *entryArg)
+{
+	RegionListTestData *data = (RegionListTestData *)entryArg;
+
+	MM_AtomicOperations::add(&data->startedThreads, 1);
+	while (!data->go) {
+		omrthread_yield();
+	}
+	for (uintptr_t i = 0; i < data->iterations; i++) {
+		MM_HeapRegionDescriptorSegregated *region = data->list->pop();
+		if (NULL == region) {
+			MM_AtomicOperations::add(&data->emptyPops, 1);
+		} else {
+			data->list->push(region);
+		}
+	}
+	return 0;
+}
+
+/**
+ * Run threadCount threads each popping and pushing back a region data->iterations times.
+ * @return elapsed time in microseconds
+ */
+static uint64_t
+runRegionListTest(RegionListTestData *data, uintptr_t threadCount)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->getPortLibrary());
+	omrthread_t threads[REGION_LIST_TEST_MAX_THREADS];
+
+	data->startedThreads = 0;
+	data->go = false;
+	data->emptyPops = 0;
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		omrthread_attr_t attr = NULL;
+		EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_init(&attr));
+		EXPECT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE));
+		EXPECT_EQ(J9THREAD_SUCCESS, omrthread_create_ex(&threads[i], &attr, 0, regionListTestThread, data));
+		omrthread_attr_destroy(&attr);
+	}
+	while (threadCount != data->startedThreads) {
+		omrthread_yield();
+	}
+
+	uint64_t start = omrtime_hires_clock();
+	MM_AtomicOperations::writeBarrier();
+	data->go = true;
+	for (uintptr_t i = 0; i < threadCount; i++) {
+		omrthread_join(threads[i]);
+	}
+	return omrtime_hires_delta(start, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+}
+
+TEST_F(gcFunctionalTestRegionList, shardedFreeListConcurrent)
+{
+	MM_ShardedFreeHeapRegionList *list = MM_ShardedFreeHeapRegionList::newInstance(env, MM_HeapRegionList::HRL_KIND_FREE, true, 4);
+	ASSERT_TRUE(NULL != list);
+	for (uintptr_t i = 0; i < REGION_LIST_TEST_REGIONS; i++) {
+		list->push(region(i));
+	}
+
+	/* every thread returns what it takes, so no pop can find the whole list empty and no region may be lost */
+	RegionListTestData data;
+	data.list = list;
+	data.iterations = 5000;
+	runRegionListTest(&data, 8);
+	ASSERT_EQ((uintptr_t)0, data.emptyPops);
+	ASSERT_TRUE(drainAndCheck(list));
+
+	list->kill(env);
+}
+
+/**
+ * Pop/push throughput of the sharded free list against the single locking list it replaces.
+ */
+TEST_F(perfTestRegionList, throughput)
+{
+	const uintptr_t totalOperations = 1 << 18;
+	for (uintptr_t sharded = 0; sharded < 2; sharded++) {
+		MM_FreeHeapRegionList *list = NULL;
+		if (1 == sharded) {
+			list = MM_ShardedFreeHeapRegionList::newInstance(env, MM_HeapRegionList::HRL_KIND_FREE, true, REGION_LIST_TEST_SHARDS);
+		} else {
+			list = MM_LockingFreeHeapRegionList::newInstance(env, MM_HeapRegionList::HRL_KIND_FREE, true);
+		}
+		ASSERT_TRUE(NULL != list);
+		for (uintptr_t i = 0; i < REGION_LIST_TEST_REGIONS; i++) {
+			list->push(region(i));
+		}
+
+		RegionListTestData data;
+		data.list = list;
+		for (uintptr_t threadCount = 1; threadCount <= REGION_LIST_TEST_MAX_THREADS; threadCount *= 2) {
+			data.iterations = totalOperations / threadCount;
+			uint64_t micros = runRegionListTest(&data, threadCount);
+			gcTestEnv->log("%s free list, %2zu threads: %llu pop/push pairs/ms\n", (1 == sharded) ? "sharded" : "locking",
+				threadCount, (unsigned long long)((totalOperations * 1000) / ((0 == micros) ? 1 : micros)));
+		}
+		ASSERT_TRUE(drainAndCheck(list));
+		list->kill(env);
+	}
+}
+
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
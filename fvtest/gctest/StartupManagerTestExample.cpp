@@ -91,10 +91,22 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 #else
 						gcTestEnv->log(LEVEL_ERROR, "WARNING: GCPolicy=gencon ignored, requires OMR_GC_MODRON_SCAVENGER (see configure_common.mk)\n");
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+					} else if (0 == j9_cmdla_stricmp(attr.value(), "segregated")) {
+#if defined(OMR_GC_SEGREGATED_HEAP)
+						_useSegregatedGC = true;
+#else
+						gcTestEnv->log(LEVEL_ERROR, "WARNING: GCPolicy=segregated ignored, requires OMR_GC_SEGREGATED_HEAP\n");
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 					} else  if (0 != j9_cmdla_stricmp(attr.value(), "optavgpause")) {
-						gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized GC policy (expected gencon or optavgpause): %s\n", attr.value());
+						gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized GC policy (expected gencon, optavgpause or segregated): %s\n", attr.value());
 						result = false;
 					}
+				} else if (0 == strcmp(attr.name(), "sweepBudget")) {
+#if defined(OMR_GC_SEGREGATED_HEAP)
+					extensions->segregatedSweepBudget = atoi(attr.value());
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: sweepBudget ignored, requires OMR_GC_SEGREGATED_HEAP\n");
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 				} else if (0 == strcmp(attr.name(), "concurrentMark")) {
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
 					extensions->concurrentMark = (0 == j9_cmdla_stricmp(attr.value(), "true"));
@@ -107,6 +119,52 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 				} else if (0 == strcmp(attr.name(), "forcePoisonEvacuate")) {
 					extensions->fvtest_forcePoisonEvacuate = (0 == j9_cmdla_stricmp(attr.value(), "true"));
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+				} else if (0 == strcmp(attr.name(), "concurrentScavenger")) {
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+					extensions->concurrentScavenger = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+					extensions->concurrentScavengerForced = extensions->concurrentScavenger;
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: concurrentScavenger ignored, requires OMR_GC_CONCURRENT_SCAVENGER\n");
+#endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+				} else if (0 == strcmp(attr.name(), "concurrentScavengerSelfHealObject")) {
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+					extensions->concurrentScavengerSelfHealObject = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: concurrentScavengerSelfHealObject ignored, requires OMR_GC_CONCURRENT_SCAVENGER\n");
+#endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+				} else if (0 == strcmp(attr.name(), "proactiveCompaction")) {
+#if defined(OMR_GC_MODRON_COMPACTION)
+					extensions->proactiveCompaction = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+					if (extensions->proactiveCompaction) {
+						/* proactive compaction is a compaction trigger, so triggered compaction has to be enabled */
+						extensions->noCompactOnGlobalGC = 0;
+					}
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: proactiveCompaction ignored, requires OMR_GC_MODRON_COMPACTION\n");
+#endif /* defined(OMR_GC_MODRON_COMPACTION) */
+				} else if (0 == strcmp(attr.name(), "proactiveCompactionWindowSize")) {
+#if defined(OMR_GC_MODRON_COMPACTION)
+					extensions->proactiveCompactionWindowSize = atoi(attr.value()) * unitSize;
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: proactiveCompactionWindowSize ignored, requires OMR_GC_MODRON_COMPACTION\n");
+#endif /* defined(OMR_GC_MODRON_COMPACTION) */
+				} else if (0 == strcmp(attr.name(), "compressedRefsShift")) {
+#if defined(OMR_GC_COMPRESSED_POINTERS)
+					uintptr_t shift = (uintptr_t)attr.as_int();
+					if (shift <= LOW_MEMORY_HEAP_CEILING_SHIFT) {
+						extensions->shouldForceSpecifiedShiftingCompression = true;
+						extensions->forcedShiftingCompressionAmount = shift;
+					} else {
+						gcTestEnv->log(LEVEL_ERROR, "Failed: compressedRefsShift must be in range 0..%d: %s\n", LOW_MEMORY_HEAP_CEILING_SHIFT, attr.value());
+						result = false;
+					}
+#else
+					gcTestEnv->log(LEVEL_ERROR, "WARNING: compressedRefsShift ignored, requires OMR_GC_COMPRESSED_POINTERS\n");
+#endif /* defined(OMR_GC_COMPRESSED_POINTERS) */
+				} else if (0 == strcmp(attr.name(), "stickyMarkBits")) {
+					extensions->stickyMarkBits = (0 == j9_cmdla_stricmp(attr.value(), "true"));
+				} else if (0 == strcmp(attr.name(), "prefaultHeapOnExpand")) {
+					extensions->prefaultHeapOnExpand = (0 == j9_cmdla_stricmp(attr.value(), "true"));
 				} else if ((0 == strcmp(attr.name(), "verboseLog")) || (0 == strcmp(attr.name(), "numOfFiles")) || (0 == strcmp(attr.name(), "numOfCycles")) || (0 == strcmp(attr.name(), "sizeUnit"))) {
 				} else {
 					gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized option: %s\n", attr.name());
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "JBTestUtil.hpp"
+
+struct Pair
+   {
+   int32_t first;
+   int32_t second;
+   };
+
+DEFINE_TYPES(PairTypeDictionary)
+   {
+   DEFINE_STRUCT(Pair);
+   DEFINE_FIELD(Pair, first, Int32);
+   DEFINE_FIELD(Pair, second, Int32);
+   CLOSE_STRUCT(Pair);
+   }
+
+/*
+ * Computes (p->first * multiplier) + p->second; each instance bakes in a
+ * different multiplier so every compiled body is distinguishable.
+ */
+class ScaledPairBuilder : public TR::MethodBuilder
+   {
+   public:
+   ScaledPairBuilder(TR::TypeDictionary *types, int32_t multiplier)
+      : TR::MethodBuilder(types),
+        _multiplier(multiplier)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("scaledPair");
+      DefineParameter("p", types->PointerTo("Pair"));
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      Return(
+         Add(
+            Mul(
+               LoadIndirect("Pair", "first", Load("p")),
+               ConstInt32(_multiplier)),
+            LoadIndirect("Pair", "second", Load("p"))));
+      return true;
+      }
+
+   private:
+   int32_t _multiplier;
+   };
+
+/*
+ * A ScaledPairBuilder that waits in buildIL() until every builder of its group has
+ * started generating IL, so a group only completes if its members are compiled at
+ * the same time. Gives up after a few seconds rather than hanging the test.
+ */
+class RendezvousPairBuilder : public ScaledPairBuilder
+   {
+   public:
+   RendezvousPairBuilder(TR::TypeDictionary *types, int32_t multiplier, std::atomic<int32_t> *arrived, int32_t groupSize)
+      : ScaledPairBuilder(types, multiplier),
+        _arrived(arrived),
+        _groupSize(groupSize),
+        _metGroup(false)
+      {
+      }
+
+   virtual bool buildIL()
+      {
+      _arrived->fetch_add(1);
+      std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (_arrived->load() < _groupSize && std::chrono::steady_clock::now() < deadline)
+         std::this_thread::yield();
+      _metGroup = (_arrived->load() >= _groupSize);
+      return ScaledPairBuilder::buildIL();
+      }
+
+   bool metGroup() { return _metGroup; }
+
+   private:
+   std::atomic<int32_t> *_arrived;
+   int32_t _groupSize;
+   bool _metGroup;
+   };
+
+/*
+ * A builder whose IL generation always fails.
+ */
+class FailingPairBuilder : public TR::MethodBuilder
+   {
+   public:
+   FailingPairBuilder(TR::TypeDictionary *types)
+      : TR::MethodBuilder(types)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("failingPair");
+      DefineParameter("p", types->PointerTo("Pair"));
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      return false;
+      }
+   };
+
+typedef int32_t (ScaledPairFunction)(Pair *);
+
+#define NUM_ASYNC_BUILDERS 32
+
+class AsyncCompileTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:compilationThreads=4,acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator")) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+
+   // Compile every builder asynchronously, then check each body against its multiplier
+   static void compileAndVerify(ScaledPairBuilder **builders, int32_t count)
+      {
+      JitBuilder::CompileRequest *requests[NUM_ASYNC_BUILDERS];
+      for (int32_t i = 0; i < count; i++)
+         {
+         requests[i] = compileMethodBuilderAsync(builders[i]);
+         ASSERT_NE((JitBuilder::CompileRequest *)NULL, requests[i]);
+         }
+
+      for (int32_t i = 0; i < count; i++)
+         {
+         uint8_t *entry = NULL;
+         int32_t rc = waitForMethodBuilderCompilation(requests[i], &entry);
+         ASSERT_EQ(0, rc) << "Failed to compile builder " << i;
+         ASSERT_NE((uint8_t *)NULL, entry);
+
+         Pair pair = { 3, 5 };
+         ScaledPairFunction *scaledPair = (ScaledPairFunction *)entry;
+         ASSERT_EQ((3 * (i + 1)) + 5, scaledPair(&pair)) << "Wrong body for builder " << i;
+         }
+      }
+   };
+
+TEST_F(AsyncCompileTest, PrivateTypeDictionaries)
+   {
+   PairTypeDictionary *types[NUM_ASYNC_BUILDERS];
+   ScaledPairBuilder *builders[NUM_ASYNC_BUILDERS];
+   for (int32_t i = 0; i < NUM_ASYNC_BUILDERS; i++)
+      {
+      types[i] = new PairTypeDictionary();
+      builders[i] = new ScaledPairBuilder(types[i], i + 1);
+      }
+
+   compileAndVerify(builders, NUM_ASYNC_BUILDERS);
+
+   for (int32_t i = 0; i < NUM_ASYNC_BUILDERS; i++)
+      {
+      delete builders[i];
+      delete types[i];
+      }
+   }
+
+TEST_F(AsyncCompileTest, SharedTypeDictionary)
+   {
+   PairTypeDictionary types;
+   ScaledPairBuilder *builders[NUM_ASYNC_BUILDERS];
+   for (int32_t i = 0; i < NUM_ASYNC_BUILDERS; i++)
+      builders[i] = new ScaledPairBuilder(&types, i + 1);
+
+   compileAndVerify(builders, NUM_ASYNC_BUILDERS);
+
+   for (int32_t i = 0; i < NUM_ASYNC_BUILDERS; i++)
+      delete builders[i];
+   }
+
+TEST_F(AsyncCompileTest, SharedTypeDictionaryOverlaps)
+   {
+   PairTypeDictionary types;
+   std::atomic<int32_t> arrived(0);
+   RendezvousPairBuilder first(&types, 1, &arrived, 2);
+   RendezvousPairBuilder second(&types, 2, &arrived, 2);
+
+   JitBuilder::CompileRequest *firstRequest = compileMethodBuilderAsync(&first);
+   JitBuilder::CompileRequest *secondRequest = compileMethodBuilderAsync(&second);
+   ASSERT_NE((JitBuilder::CompileRequest *)NULL, firstRequest);
+   ASSERT_NE((JitBuilder::CompileRequest *)NULL, secondRequest);
+
+   uint8_t *firstEntry = NULL;
+   uint8_t *secondEntry = NULL;
+   ASSERT_EQ(0, waitForMethodBuilderCompilation(firstRequest, &firstEntry));
+   ASSERT_EQ(0, waitForMethodBuilderCompilation(secondRequest, &secondEntry));
+
+   EXPECT_TRUE(first.metGroup() && second.metGroup()) << "Builders sharing a type dictionary were not compiled concurrently";
+
+   Pair pair = { 3, 5 };
+   ASSERT_EQ(8, ((ScaledPairFunction *)firstEntry)(&pair));
+   ASSERT_EQ(11, ((ScaledPairFunction *)secondEntry)(&pair));
+   }
+
+TEST_F(AsyncCompileTest, BatchCompile)
+   {
+   PairTypeDictionary types;
+   TR::MethodBuilder *builders[NUM_ASYNC_BUILDERS];
+   for (int32_t i = 0; i < NUM_ASYNC_BUILDERS; i++)
+      builders[i] = new ScaledPairBuilder(&types, i + 1);
+
+   uint8_t *entries[NUM_ASYNC_BUILDERS];
+   ASSERT_EQ(0, compileMethodBuilders(builders, NUM_ASYNC_BUILDERS, entries)) << "Failed to compile batch";
+
+   Pair pair = { 3, 5 };
+   for (int32_t i = 0; i < NUM_ASYNC_BUILDERS; i++)
+      {
+      ASSERT_NE((uint8_t *)NULL, entries[i]);
+      ScaledPairFunction *scaledPair = (ScaledPairFunction *)entries[i];
+      ASSERT_EQ((3 * (i + 1)) + 5, scaledPair(&pair)) << "Wrong body for builder " << i;
+      }
+
+   for (int32_t i = 0; i < NUM_ASYNC_BUILDERS; i++)
+      delete builders[i];
+   }
+
+TEST_F(AsyncCompileTest, BatchCompileFailure)
+   {
+   PairTypeDictionary types;
+   ScaledPairBuilder first(&types, 1);
+   FailingPairBuilder failing(&types);
+   ScaledPairBuilder last(&types, 3);
+   TR::MethodBuilder *builders[] = { &first, &failing, &last };
+
+   uint8_t *entries[3];
+   ASSERT_NE(0, compileMethodBuilders(builders, 3, entries));
+   for (int32_t i = 0; i < 3; i++)
+      ASSERT_EQ((uint8_t *)NULL, entries[i]) << "Entry returned for builder " << i << " of a failed batch";
+   }
+
+/*
+ * The asynchronous entry points must fail cleanly when there is no compile
+ * thread pool, i.e. before initializeJit() or after shutdownJit().
+ */
+TEST(AsyncCompileWithoutJitTest, RequestsRejected)
+   {
+   ASSERT_EQ((JitBuilder::CompileRequest *)NULL, compileMethodBuilderAsync(NULL));
+
+   uint8_t *entry = (uint8_t *)&entry;
+   ASSERT_NE(0, waitForMethodBuilderCompilation(NULL, &entry));
+   ASSERT_EQ((uint8_t *)NULL, entry);
+
+   TR::MethodBuilder *builders[] = { NULL };
+   uint8_t *entries[] = { (uint8_t *)&entry };
+   ASSERT_NE(0, compileMethodBuilders(builders, 1, entries));
+   ASSERT_EQ((uint8_t *)NULL, entries[0]);
+   }
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "JBTestUtil.hpp"
+
+typedef int32_t (*SumOfProductsFunction)(int32_t);
+
+// sum of i * (i & 3) for i in [0, n), with a loop invariant early exit
+DEFINE_BUILDER( SumOfProducts,
+                Int32,
+                PARAM("n", Int32) )
+   {
+   Store("sum", ConstInt32(0));
+
+   TR::IlBuilder *loop = NULL;
+   ForLoopUp("i", &loop, ConstInt32(0), Load("n"), ConstInt32(1));
+
+   TR::IlBuilder *skip = NULL;
+   loop->IfThen(&skip, loop->LessThan(loop->Load("n"), loop->ConstInt32(0)));
+   skip->Return(skip->ConstInt32(-1));
+
+   loop->Store("sum",
+      loop->Add(
+         loop->Load("sum"),
+         loop->Mul(
+            loop->Load("i"),
+            loop->And(loop->Load("i"), loop->ConstInt32(3)))));
+
+   Return(Load("sum"));
+   return true;
+   }
+
+static int32_t
+sumOfProducts(int32_t n)
+   {
+   int32_t sum = 0;
+   for (int32_t i = 0; i < n; i++)
+      sum += i * (i & 3);
+   return sum;
+   }
+
+#define COMPILATION_TIER_LOG "CompilationTierTest.log"
+
+class CompilationTierTest : public ::testing::Test
+   {
+   public:
+
+   // traceOpts writes the name of every optimization that is performed to the log
+   static void SetUpTestCase()
+      {
+      remove(COMPILATION_TIER_LOG);
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:traceOpts,log=" COMPILATION_TIER_LOG ",acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator")) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      remove(COMPILATION_TIER_LOG);
+      }
+
+   static SumOfProductsFunction compileAt(TR::MethodBuilder *builder)
+      {
+      uint8_t *entry = NULL;
+      int32_t rc = compileMethodBuilder(builder, &entry);
+      EXPECT_EQ(0, rc) << "Failed to compile method " << builder->getMethodName();
+      return (SumOfProductsFunction)entry;
+      }
+
+   // Returns the optimizations traced to the log since the given offset, and
+   // moves the offset past them
+   static std::vector<std::string> optimizationsLoggedSince(long *offset)
+      {
+      std::vector<std::string> opts;
+      FILE *log = fopen(COMPILATION_TIER_LOG, "r");
+      if (NULL == log)
+         return opts;
+      fseek(log, *offset, SEEK_SET);
+      char line[256];
+      while (NULL != fgets(line, sizeof(line), log))
+         {
+         char name[256];
+         // optimization names are indented; group markers and other output are not names
+         if ((' ' == line[0]) && (1 == sscanf(line, " %255[A-Za-z]", name)) && (NULL == strchr(line, '<')))
+            opts.push_back(name);
+         }
+      *offset = ftell(log);
+      fclose(log);
+      return opts;
+      }
+   };
+
+TEST_F(CompilationTierTest, FastTierRunsColdStrategy)
+   {
+   TR::TypeDictionary types;
+   long offset = 0;
+
+   SumOfProducts warmBuilder(&types);
+   ASSERT_FALSE(warmBuilder.usesFastCompilation());
+   ASSERT_NE((SumOfProductsFunction)NULL, compileAt(&warmBuilder));
+   std::vector<std::string> warmOpts = optimizationsLoggedSince(&offset);
+
+   SumOfProducts fastBuilder(&types);
+   fastBuilder.setUseFastCompilation();
+   ASSERT_TRUE(fastBuilder.usesFastCompilation());
+   ASSERT_NE((SumOfProductsFunction)NULL, compileAt(&fastBuilder));
+   std::vector<std::string> fastOpts = optimizationsLoggedSince(&offset);
+
+   // the cold strategy is a strict subset of the warm one: local optimizations only
+   ASSERT_FALSE(fastOpts.empty()) << "no optimizations traced to " COMPILATION_TIER_LOG;
+   EXPECT_LT(fastOpts.size(), warmOpts.size());
+   EXPECT_NE(fastOpts.end(), std::find(fastOpts.begin(), fastOpts.end(), "localCSE"));
+   EXPECT_NE(warmOpts.end(), std::find(warmOpts.begin(), warmOpts.end(), "globalValuePropagation"));
+   EXPECT_EQ(fastOpts.end(), std::find(fastOpts.begin(), fastOpts.end(), "globalValuePropagation"));
+   }
+
+TEST_F(CompilationTierTest, FastTierMatchesWarmTier)
+   {
+   TR::TypeDictionary types;
+
+   SumOfProducts warmBuilder(&types);
+   SumOfProductsFunction warmFunction = compileAt(&warmBuilder);
+   ASSERT_NE((SumOfProductsFunction)NULL, warmFunction);
+
+   SumOfProducts fastBuilder(&types);
+   fastBuilder.setUseFastCompilation();
+   SumOfProductsFunction fastFunction = compileAt(&fastBuilder);
+   ASSERT_NE((SumOfProductsFunction)NULL, fastFunction);
+   ASSERT_NE(warmFunction, fastFunction);
+
+   int32_t inputs[] = { 0, 1, 2, 5, 17, 1000 };
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+      {
+      EXPECT_EQ(sumOfProducts(inputs[i]), warmFunction(inputs[i])) << "warm tier, n = " << inputs[i];
+      EXPECT_EQ(sumOfProducts(inputs[i]), fastFunction(inputs[i])) << "fast tier, n = " << inputs[i];
+      }
+   }
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+/*
+ * Three nested loops with a diamond in the innermost one, so that the
+ * dataflow analyses run by the optimizer have to iterate around back edges
+ * at several loop nesting levels.
+ */
+DEFINE_BUILDER( NestedLoops,
+                Int32,
+                PARAM("n", Int32) )
+   {
+   Store("sum", ConstInt32(0));
+   Store("last", ConstInt32(0));
+
+   TR::IlBuilder *outer = NULL;
+   ForLoopUp("i", &outer, ConstInt32(0), Load("n"), ConstInt32(1));
+
+   TR::IlBuilder *middle = NULL;
+   outer->ForLoopUp("j", &middle, outer->ConstInt32(0), outer->Load("i"), outer->ConstInt32(1));
+
+   TR::IlBuilder *inner = NULL;
+   middle->ForLoopUp("k", &inner, middle->ConstInt32(0), middle->Load("j"), middle->ConstInt32(1));
+
+   TR::IlBuilder *thenPath = NULL, *elsePath = NULL;
+   inner->IfThenElse(&thenPath, &elsePath, inner->LessThan(inner->Load("k"), inner->Load("last")));
+   thenPath->Store("sum", thenPath->Add(thenPath->Load("sum"), thenPath->Mul(thenPath->Load("k"), thenPath->Load("i"))));
+   elsePath->Store("last", elsePath->Add(elsePath->Load("last"), elsePath->Load("j")));
+
+   outer->Store("sum", outer->Add(outer->Load("sum"), outer->Load("last")));
+
+   Return(Load("sum"));
+   return true;
+   }
+
+typedef int32_t (NestedLoopsFunction)(int32_t);
+
+static int32_t
+nestedLoops(int32_t n)
+   {
+   int32_t sum = 0;
+   int32_t last = 0;
+   for (int32_t i = 0; i < n; i++)
+      {
+      for (int32_t j = 0; j < i; j++)
+         for (int32_t k = 0; k < j; k++)
+            {
+            if (k < last)
+               sum += k * i;
+            else
+               last += j;
+            }
+      sum += last;
+      }
+   return sum;
+   }
+
+class DataFlowSolverTest : public ::testing::Test
+   {
+   public:
+
+   static void startJit(const char *options)
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)options)) << "Failed to initialize the JIT.";
+      }
+
+   static void compileAndRun()
+      {
+      TR::TypeDictionary types;
+      NestedLoops builder(&types);
+      uint8_t *entry = NULL;
+      int32_t rc = compileMethodBuilder(&builder, &entry);
+      ASSERT_EQ(0, rc) << "Failed to compile method " << builder.getMethodName();
+
+      NestedLoopsFunction *nested = (NestedLoopsFunction *)entry;
+      for (int32_t n = 0; n < 12; n++)
+         EXPECT_EQ(nestedLoops(n), nested(n)) << "n = " << n;
+      }
+   };
+
+TEST_F(DataFlowSolverTest, WorklistSolver)
+   {
+   startJit("-Xjit:enableWorklistDataFlowSolver,acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator");
+   compileAndRun();
+   shutdownJit();
+   }
+
+// Runs both solvers on every analysis and fails the compilation fatally if
+// they disagree on any block.
+TEST_F(DataFlowSolverTest, WorklistSolverMatchesStructuralSolver)
+   {
+   startJit("-Xjit:enableWorklistDataFlowSolver,verifyWorklistDataFlowSolver,acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator");
+   compileAndRun();
+   shutdownJit();
+   }
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <chrono>
+#include <stdio.h>
+#include "JBTestUtil.hpp"
+
+#define HUGE_METHOD_LOCALS 600
+#define HUGE_METHOD_SUM_STRIDE 16
+
+/*
+ * A straight line of conditional updates, one local per update, with every
+ * sixteenth local live until the end of the method. The dataflow analyses see
+ * thousands of symbols and blocks, which is where their bit vectors matter.
+ */
+class HugeMethod : public TR::MethodBuilder
+   {
+   public:
+   HugeMethod(TR::TypeDictionary *types)
+      : TR::MethodBuilder(types)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("HugeMethod");
+      DefineParameter("x", Int32);
+      DefineReturnType(Int32);
+      for (int32_t i = 0; i < HUGE_METHOD_LOCALS; i++)
+         snprintf(_names[i], sizeof(_names[i]), "v%d", i);
+      }
+
+   virtual bool buildIL()
+      {
+      Store(_names[0], Load("x"));
+      for (int32_t i = 1; i < HUGE_METHOD_LOCALS; i++)
+         {
+         Store(_names[i], Load(_names[i-1]));
+         TR::IlBuilder *thenPath = NULL;
+         IfThen(&thenPath, LessThan(ConstInt32(i % 7), Load("x")));
+         thenPath->Store(_names[i], thenPath->Add(thenPath->Load(_names[i]), thenPath->ConstInt32(i)));
+         }
+
+      Store("sum", ConstInt32(0));
+      for (int32_t i = 0; i < HUGE_METHOD_LOCALS; i += HUGE_METHOD_SUM_STRIDE)
+         Store("sum", Add(Load("sum"), Load(_names[i])));
+      Return(Load("sum"));
+      return true;
+      }
+
+   private:
+   char _names[HUGE_METHOD_LOCALS][8];
+   };
+
+typedef int32_t (HugeMethodFunction)(int32_t);
+
+static int32_t
+hugeMethod(int32_t x)
+   {
+   int32_t v = x;
+   int32_t sum = v;
+   for (int32_t i = 1; i < HUGE_METHOD_LOCALS; i++)
+      {
+      if (i % 7 < x)
+         v += i;
+      if (0 == i % HUGE_METHOD_SUM_STRIDE)
+         sum += v;
+      }
+   return sum;
+   }
+
+/*
+ * Compiles the huge method (initializeJit() passes acceptHugeMethods) and records
+ * the compile time as the test's compileMillis property, so that changes to the
+ * dataflow analyses can be measured on it.
+ */
+TEST(HugeMethodTest, CompileTime)
+   {
+   ASSERT_TRUE(initializeJit()) << "Failed to initialize the JIT.";
+
+   TR::TypeDictionary types;
+   HugeMethod *builder = new HugeMethod(&types);
+   uint8_t *entry = NULL;
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   int32_t rc = compileMethodBuilder(builder, &entry);
+   std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+   ASSERT_EQ(0, rc) << "Failed to compile method " << builder->getMethodName();
+   RecordProperty("compileMillis", (int)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+
+   HugeMethodFunction *huge = (HugeMethodFunction *)entry;
+   for (int32_t x = -1; x < 9; x++)
+      EXPECT_EQ(hugeMethod(x), huge(x)) << "x = " << x;
+
+   delete builder;
+   shutdownJit();
+   }
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+#include "runtime/PersistentMethodCache.hpp"
+
+#include <stdio.h>
+
+// The method cache is only implemented on x86-64 Linux; elsewhere bodies are always compiled
+#if defined(__linux__) && defined(__x86_64__)
+#define METHOD_CACHE_SUPPORTED
+#endif
+
+#define METHOD_CACHE_FILE "jitbuildertest.methodcache"
+
+typedef double (*PolynomialFunction)(double);
+
+static double
+halve(double x)
+   {
+   #define HALVE_LINE LINETOSTR(__LINE__)
+   return x / 2.0;
+   }
+
+// halve(3.5 x^2 - 1.25 x + 0.75): floating point constants and a direct call to relocate
+DEFINE_BUILDER( CachedPolynomial,
+                Double,
+                PARAM("x", Double) )
+   {
+   DefineFunction((char *)"halve",
+                  (char *)__FILE__,
+                  (char *)HALVE_LINE,
+                  (void *)&halve,
+                  Double,
+                  1,
+                  Double);
+
+   TR::IlValue *x = Load("x");
+   TR::IlValue *value = Add(Mul(Sub(Mul(ConstDouble(3.5), x), ConstDouble(1.25)), x), ConstDouble(0.75));
+   Return(Call("halve", 1, value));
+   return true;
+   }
+
+// Same shape as CachedPolynomial with a different constant, so different IL
+DEFINE_BUILDER( OtherCachedPolynomial,
+                Double,
+                PARAM("x", Double) )
+   {
+   DefineFunction((char *)"halve",
+                  (char *)__FILE__,
+                  (char *)HALVE_LINE,
+                  (void *)&halve,
+                  Double,
+                  1,
+                  Double);
+
+   TR::IlValue *x = Load("x");
+   TR::IlValue *value = Add(Mul(Sub(Mul(ConstDouble(3.5), x), ConstDouble(1.5)), x), ConstDouble(0.75));
+   Return(Call("halve", 1, value));
+   return true;
+   }
+
+class MethodCacheTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      remove(METHOD_CACHE_FILE);
+      }
+
+   static void TearDownTestCase()
+      {
+      remove(METHOD_CACHE_FILE);
+      }
+
+   static void startJit(const char *extraOptions = "")
+      {
+      char options[256];
+      snprintf(options, sizeof(options), "-Xjit:methodCacheFile=" METHOD_CACHE_FILE ",acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator%s", extraOptions);
+      ASSERT_TRUE(initializeJitWithOptions(options)) << "Failed to initialize the JIT.";
+      }
+
+   // Compile CachedPolynomial in a fresh JIT and check where its body came from
+   static void compileInJit(const char *extraOptions, uint32_t expectedHits, uint32_t expectedStores)
+      {
+      startJit(extraOptions);
+         {
+         TR::TypeDictionary types;
+         CachedPolynomial builder(&types);
+         PolynomialFunction polynomial = compile(&builder);
+         ASSERT_NE((PolynomialFunction)NULL, polynomial);
+         EXPECT_DOUBLE_EQ(6.125, polynomial(2.0));
+         }
+#if defined(METHOD_CACHE_SUPPORTED)
+      EXPECT_EQ(expectedHits, TR::PersistentMethodCache::instance()->hits());
+      EXPECT_EQ(expectedStores, TR::PersistentMethodCache::instance()->stores());
+#endif
+      shutdownJit();
+      }
+
+   static PolynomialFunction compile(TR::MethodBuilder *builder)
+      {
+      uint8_t *entry = NULL;
+      int32_t rc = compileMethodBuilder(builder, &entry);
+      EXPECT_EQ(0, rc) << "Failed to compile method " << builder->getMethodName();
+      return (PolynomialFunction)entry;
+      }
+   };
+
+TEST_F(MethodCacheTest, BodyIsReusedAfterRestart)
+   {
+   startJit();
+      {
+      TR::TypeDictionary types;
+      CachedPolynomial builder(&types);
+      PolynomialFunction polynomial = compile(&builder);
+      ASSERT_NE((PolynomialFunction)NULL, polynomial);
+      EXPECT_DOUBLE_EQ(0.375, polynomial(0.0));
+      EXPECT_DOUBLE_EQ(6.125, polynomial(2.0));
+      }
+#if defined(METHOD_CACHE_SUPPORTED)
+   ASSERT_NE((TR::PersistentMethodCache *)NULL, TR::PersistentMethodCache::instance());
+   EXPECT_EQ(0u, TR::PersistentMethodCache::instance()->hits());
+   EXPECT_EQ(1u, TR::PersistentMethodCache::instance()->stores());
+#endif
+   shutdownJit();
+
+   startJit();
+      {
+      TR::TypeDictionary types;
+      CachedPolynomial builder(&types);
+      PolynomialFunction polynomial = compile(&builder);
+      ASSERT_NE((PolynomialFunction)NULL, polynomial);
+      EXPECT_DOUBLE_EQ(0.375, polynomial(0.0));
+      EXPECT_DOUBLE_EQ(6.125, polynomial(2.0));
+      EXPECT_DOUBLE_EQ(18.0, polynomial(-3.0));
+      }
+#if defined(METHOD_CACHE_SUPPORTED)
+   EXPECT_EQ(1u, TR::PersistentMethodCache::instance()->hits());
+   EXPECT_EQ(0u, TR::PersistentMethodCache::instance()->stores());
+#endif
+
+      {
+      TR::TypeDictionary types;
+      OtherCachedPolynomial builder(&types);
+      PolynomialFunction polynomial = compile(&builder);
+      ASSERT_NE((PolynomialFunction)NULL, polynomial);
+      EXPECT_DOUBLE_EQ(5.875, polynomial(2.0));
+      }
+#if defined(METHOD_CACHE_SUPPORTED)
+   EXPECT_EQ(1u, TR::PersistentMethodCache::instance()->hits());
+   EXPECT_EQ(1u, TR::PersistentMethodCache::instance()->stores());
+#endif
+   shutdownJit();
+   }
+
+TEST_F(MethodCacheTest, ChangedOptionValueMisses)
+   {
+   remove(METHOD_CACHE_FILE);
+   compileInJit("", 0, 1);
+
+   // A numeric option is part of the key just like the option bits
+   compileInJit(",alwaysWorthInliningThreshold=123", 0, 1);
+
+   // Both bodies are now cached
+   compileInJit("", 1, 0);
+   compileInJit(",alwaysWorthInliningThreshold=123", 1, 0);
+   }
+
+TEST_F(MethodCacheTest, ChangedBuildStampMisses)
+   {
+   remove(METHOD_CACHE_FILE);
+   compileInJit("", 0, 1);
+
+#if defined(METHOD_CACHE_SUPPORTED)
+   // Overwrite the first character of the build name stamped into the file header,
+   // after its eyecatcher, format version and pointer size
+   FILE *file = fopen(METHOD_CACHE_FILE, "r+b");
+   ASSERT_NE((FILE *)NULL, file);
+   ASSERT_EQ(0, fseek(file, 16, SEEK_SET));
+   ASSERT_EQ(1u, fwrite("?", 1, 1, file));
+   fclose(file);
+
+   // The file looks like it came from another JIT and is discarded
+   compileInJit("", 0, 1);
+#endif
+
+   compileInJit("", 1, 0);
+   }
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <new>
+#include "JBTestUtil.hpp"
+#include "env/PersistentAllocator.hpp"
+#include "env/PersistentAllocatorKit.hpp"
+#include "env/RawAllocator.hpp"
+
+#define TEST_CATEGORY 7
+#define OTHER_CATEGORY 8
+
+TEST(PersistentAllocatorTest, FreedBlocksAreReused)
+   {
+   TR::RawAllocator rawAllocator;
+   TR::PersistentAllocator allocator((TR::PersistentAllocatorKit(rawAllocator)));
+
+   // Warm up the allocator so the first slab is in place
+   allocator.deallocate(allocator.allocate(24, TEST_CATEGORY, std::nothrow));
+   size_t reserved = allocator.bytesReserved();
+   ASSERT_GT(reserved, 0u);
+
+   // Freed blocks of a size class are handed out again, so allocating and freeing
+   // far more than a slab's worth never needs another one
+   for (int32_t i = 0; i < 100000; i++)
+      {
+      void *block = allocator.allocate(17 + (i % 8), TEST_CATEGORY, std::nothrow);
+      ASSERT_NE((void *)NULL, block);
+      allocator.deallocate(block);
+      }
+   ASSERT_EQ(reserved, allocator.bytesReserved());
+
+   // Requests rounding up to the same size class get the same block back once the
+   // calling thread's chunk is used up
+   void *freed = allocator.allocate(20, TEST_CATEGORY, std::nothrow);
+   allocator.deallocate(freed);
+   bool reused = false;
+   void *held[1024];
+   int32_t numHeld = 0;
+   while (!reused && numHeld < 1024)
+      {
+      held[numHeld] = allocator.allocate(24, TEST_CATEGORY, std::nothrow);
+      reused = (held[numHeld] == freed);
+      numHeld++;
+      }
+   ASSERT_TRUE(reused) << "Freed block was never handed out again";
+   for (int32_t i = 0; i < numHeld; i++)
+      allocator.deallocate(held[i]);
+   }
+
+TEST(PersistentAllocatorTest, BytesInUseAreTrackedPerCategory)
+   {
+   TR::RawAllocator rawAllocator;
+   TR::PersistentAllocator allocator((TR::PersistentAllocatorKit(rawAllocator)));
+
+   void *small = allocator.allocate(40, TEST_CATEGORY, std::nothrow);
+   size_t smallInUse = allocator.bytesInUse(TEST_CATEGORY);
+   ASSERT_GE(smallInUse, 40u);
+   ASSERT_EQ(0u, allocator.bytesInUse(OTHER_CATEGORY));
+
+   // Large blocks bypass the slabs but are accounted for the same way
+   void *large = allocator.allocate(4 * TR::PersistentAllocator::MAX_SMALL_SIZE, OTHER_CATEGORY, std::nothrow);
+   ASSERT_NE((void *)NULL, large);
+   ASSERT_GE(allocator.bytesInUse(OTHER_CATEGORY), 4 * TR::PersistentAllocator::MAX_SMALL_SIZE);
+   ASSERT_EQ(smallInUse, allocator.bytesInUse(TEST_CATEGORY));
+   ASSERT_EQ(allocator.bytesInUse(TEST_CATEGORY) + allocator.bytesInUse(OTHER_CATEGORY), allocator.bytesInUse());
+
+   allocator.deallocate(small);
+   allocator.deallocate(large);
+   ASSERT_EQ(0u, allocator.bytesInUse(TEST_CATEGORY));
+   ASSERT_EQ(0u, allocator.bytesInUse(OTHER_CATEGORY));
+   ASSERT_EQ(0u, allocator.bytesInUse());
+   }
+
+TEST(PersistentAllocatorTest, AllocationsFailAtTheLimit)
+   {
+   TR::RawAllocator rawAllocator;
+   TR::PersistentAllocator allocator((TR::PersistentAllocatorKit(rawAllocator)));
+   allocator.setLimit(TEST_CATEGORY, 256);
+   ASSERT_EQ(256u, allocator.limit(TEST_CATEGORY));
+
+   void *first = allocator.allocate(100, TEST_CATEGORY, std::nothrow);
+   ASSERT_NE((void *)NULL, first);
+   void *second = allocator.allocate(100, TEST_CATEGORY, std::nothrow);
+   ASSERT_NE((void *)NULL, second);
+
+   // Neither a small nor a large block fits under the cap any more; other categories are unaffected
+   ASSERT_EQ((void *)NULL, allocator.allocate(100, TEST_CATEGORY, std::nothrow));
+   ASSERT_EQ((void *)NULL, allocator.allocate(2 * TR::PersistentAllocator::MAX_SMALL_SIZE, TEST_CATEGORY, std::nothrow));
+   size_t inUse = allocator.bytesInUse(TEST_CATEGORY);
+   ASSERT_LE(inUse, 256u);
+   void *other = allocator.allocate(100, OTHER_CATEGORY, std::nothrow);
+   ASSERT_NE((void *)NULL, other);
+
+   // Freeing makes room again
+   allocator.deallocate(first);
+   void *third = allocator.allocate(100, TEST_CATEGORY, std::nothrow);
+   ASSERT_NE((void *)NULL, third);
+
+   allocator.deallocate(second);
+   allocator.deallocate(third);
+   allocator.deallocate(other);
+   }
+
+TEST(PersistentAllocatorTest, LimitOptionNamesACategory)
+   {
+   ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:persistentMemoryLimit=PersistentInfo:65536,acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator")) << "Failed to initialize the JIT.";
+   shutdownJit();
+
+   // Unknown categories and limits without a category are command line errors
+   ASSERT_FALSE(initializeJitWithOptions((char *)"-Xjit:persistentMemoryLimit=NoSuchCategory:64"));
+   ASSERT_FALSE(initializeJitWithOptions((char *)"-Xjit:persistentMemoryLimit=64,acceptHugeMethods"));
+   }
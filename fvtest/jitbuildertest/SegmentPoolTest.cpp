@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <new>
+#include "gtest/gtest.h"
+#include "env/MemorySegment.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/SegmentPool.hpp"
+#include "env/SystemSegmentProvider.hpp"
+
+#define TEST_SEGMENT_SIZE (1 << 16)
+
+/*
+ * Hands out system segments, but can be told to fail the next request the way an
+ * exhausted system would.
+ */
+class FailingSegmentProvider : public TR::SegmentProvider
+   {
+   public:
+   FailingSegmentProvider(TR::RawAllocator rawAllocator)
+      : TR::SegmentProvider(TEST_SEGMENT_SIZE),
+        _systemSegmentProvider(TEST_SEGMENT_SIZE, rawAllocator),
+        _failNextRequest(false),
+        _released(0)
+      {
+      }
+
+   ~FailingSegmentProvider() throw() {}
+
+   virtual TR::MemorySegment &request(size_t requiredSize)
+      {
+      if (_failNextRequest)
+         {
+         _failNextRequest = false;
+         throw std::bad_alloc();
+         }
+      return _systemSegmentProvider.request(requiredSize);
+      }
+
+   virtual void release(TR::MemorySegment &segment) throw()
+      {
+      _released++;
+      _systemSegmentProvider.release(segment);
+      }
+
+   virtual size_t bytesAllocated() const throw() { return _systemSegmentProvider.bytesAllocated(); }
+
+   void failNextRequest() { _failNextRequest = true; }
+   size_t released() const { return _released; }
+
+   private:
+   TR::SystemSegmentProvider _systemSegmentProvider;
+   bool _failNextRequest;
+   size_t _released;
+   };
+
+TEST(SegmentPoolTest, ReusesReleasedSegments)
+   {
+   TR::RawAllocator rawAllocator;
+   FailingSegmentProvider backingProvider(rawAllocator);
+   TR::SegmentPool pool(backingProvider, 2, rawAllocator);
+
+   TR::MemorySegment &first = pool.request(TEST_SEGMENT_SIZE);
+   TR::MemorySegment &second = pool.request(TEST_SEGMENT_SIZE);
+   TR::MemorySegment &third = pool.request(TEST_SEGMENT_SIZE);
+   pool.release(first);
+   pool.release(second);
+   pool.release(third);
+
+   // Only two segments fit in the pool; the third went straight back
+   ASSERT_EQ(2, pool.storedSegments());
+   ASSERT_EQ(1, backingProvider.released());
+
+   TR::MemorySegment &reused = pool.request(TEST_SEGMENT_SIZE);
+   ASSERT_EQ(&second, &reused) << "The most recently released segment should be handed out first";
+   ASSERT_EQ(4, pool.requests());
+   ASSERT_EQ(1, pool.reusedSegments());
+   ASSERT_EQ(1, pool.storedSegments());
+
+   // Larger requests are never satisfied from the cache
+   TR::MemorySegment &large = pool.request(2 * TEST_SEGMENT_SIZE);
+   ASSERT_EQ(1, pool.reusedSegments());
+   pool.release(large);
+   ASSERT_EQ(2, backingProvider.released());
+   ASSERT_EQ(1, pool.storedSegments());
+
+   pool.release(reused);
+   pool.trim(1);
+   ASSERT_EQ(1, pool.storedSegments());
+   ASSERT_EQ(1, pool.trimmedSegments());
+   pool.trim();
+   ASSERT_EQ(0, pool.storedSegments());
+   ASSERT_EQ(2, pool.trimmedSegments());
+   ASSERT_EQ(4, backingProvider.released());
+   }
+
+TEST(SegmentPoolTest, TrimsWhenBackingProviderFails)
+   {
+   TR::RawAllocator rawAllocator;
+   FailingSegmentProvider backingProvider(rawAllocator);
+   TR::SegmentPool pool(backingProvider, 2, rawAllocator);
+
+   pool.release(pool.request(TEST_SEGMENT_SIZE));
+   ASSERT_EQ(1, pool.storedSegments());
+
+   // A request the cache cannot satisfy gives the cached segments back and retries
+   backingProvider.failNextRequest();
+   TR::MemorySegment &large = pool.request(2 * TEST_SEGMENT_SIZE);
+   ASSERT_EQ(0, pool.storedSegments());
+   ASSERT_EQ(1, pool.trimmedSegments());
+   pool.release(large);
+
+   // With nothing cached the failure propagates
+   backingProvider.failNextRequest();
+   ASSERT_THROW(pool.request(TEST_SEGMENT_SIZE), std::bad_alloc);
+   }
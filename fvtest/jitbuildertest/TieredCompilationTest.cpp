@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <chrono>
+#include <thread>
+
+struct Accumulator
+   {
+   int32_t total;
+   int32_t calls;
+   };
+
+DEFINE_TYPES(AccumulatorTypeDictionary)
+   {
+   DEFINE_STRUCT(Accumulator);
+   DEFINE_FIELD(Accumulator, total, Int32);
+   DEFINE_FIELD(Accumulator, calls, Int32);
+   CLOSE_STRUCT(Accumulator);
+   }
+
+/*
+ * Adds 0 + 1 + ... + (n - 1) to acc->total, bumps acc->calls and returns the new total.
+ * Counts its buildIL() calls so tests can tell when it has been recompiled.
+ */
+class AccumulateBuilder : public TR::MethodBuilder
+   {
+   public:
+   AccumulateBuilder(TR::TypeDictionary *types)
+      : TR::MethodBuilder(types),
+        _buildCount(0)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("accumulate");
+      DefineParameter("acc", types->PointerTo("Accumulator"));
+      DefineParameter("n", Int32);
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      _buildCount++;
+
+      Store("sum", ConstInt32(0));
+
+      TR::IlBuilder *loop = NULL;
+      ForLoopUp("i", &loop, ConstInt32(0), Load("n"), ConstInt32(1));
+      loop->Store("sum", loop->Add(loop->Load("sum"), loop->Load("i")));
+
+      StoreIndirect("Accumulator", "total", Load("acc"),
+         Add(LoadIndirect("Accumulator", "total", Load("acc")), Load("sum")));
+      StoreIndirect("Accumulator", "calls", Load("acc"),
+         Add(LoadIndirect("Accumulator", "calls", Load("acc")), ConstInt32(1)));
+
+      Return(LoadIndirect("Accumulator", "total", Load("acc")));
+      return true;
+      }
+
+   volatile int32_t _buildCount;
+   };
+
+typedef int32_t (AccumulateFunction)(Accumulator *, int32_t);
+
+#define TIERED_COMPILATION_THRESHOLD 100
+
+class TieredCompilationTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:compilationThreads=1,tieredCompilationThreshold=100,tieredCompilationSampleInterval=1,acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator")) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+   };
+
+TEST_F(TieredCompilationTest, MethodBuilderCanBeCompiledAgain)
+   {
+   AccumulatorTypeDictionary types;
+   AccumulateBuilder builder(&types);
+
+   uint8_t *first = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&builder, &first));
+   uint8_t *second = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&builder, &second));
+   ASSERT_EQ(2, builder._buildCount);
+   ASSERT_NE(first, second);
+
+   Accumulator acc = { 0, 0 };
+   ASSERT_EQ(45, ((AccumulateFunction *)first)(&acc, 10));
+   ASSERT_EQ(90, ((AccumulateFunction *)second)(&acc, 10));
+   ASSERT_EQ(2, acc.calls);
+   }
+
+TEST_F(TieredCompilationTest, HotMethodIsRecompiled)
+   {
+   AccumulatorTypeDictionary types;
+   AccumulateBuilder builder(&types);
+   builder.setUseTieredCompilation();
+
+   uint8_t *entry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&builder, &entry));
+   ASSERT_EQ(1, builder._buildCount);
+   AccumulateFunction *accumulate = (AccumulateFunction *)entry;
+
+   // Keep calling through the same entry point; it must give the right answer before,
+   // during and after the switch to the hot body
+   Accumulator acc = { 0, 0 };
+   int32_t expected = 0;
+   int32_t callsAfterRecompile = 0;
+   auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+   while (callsAfterRecompile < TIERED_COMPILATION_THRESHOLD && std::chrono::steady_clock::now() < deadline)
+      {
+      expected += 45;
+      ASSERT_EQ(expected, accumulate(&acc, 10));
+      if (builder._buildCount > 1)
+         callsAfterRecompile++;
+      else if (acc.calls >= TIERED_COMPILATION_THRESHOLD)
+         std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+
+   ASSERT_EQ(2, builder._buildCount) << "Method was not recompiled";
+   ASSERT_EQ(expected, acc.total);
+
+   // builder must outlive its hot compilation; with a single compile thread, any request
+   // queued after it completes after it
+   AccumulateBuilder barrier(&types);
+   uint8_t *barrierEntry = NULL;
+   ASSERT_EQ(0, waitForMethodBuilderCompilation(compileMethodBuilderAsync(&barrier), &barrierEntry));
+   }
+
+TEST_F(TieredCompilationTest, ColdMethodIsNotRecompiled)
+   {
+   AccumulatorTypeDictionary types;
+   AccumulateBuilder builder(&types);
+   builder.setUseTieredCompilation();
+
+   uint8_t *entry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&builder, &entry));
+
+   Accumulator acc = { 0, 0 };
+   for (int32_t i = 0; i < TIERED_COMPILATION_THRESHOLD / 2; i++)
+      ((AccumulateFunction *)entry)(&acc, 4);
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+   ASSERT_EQ(1, builder._buildCount);
+   ASSERT_EQ((TIERED_COMPILATION_THRESHOLD / 2) * 6, acc.total);
+   }
+
+TEST_F(TieredCompilationTest, RetiredMethodIsNotRecompiled)
+   {
+   AccumulatorTypeDictionary types;
+   AccumulateBuilder *builder = new AccumulateBuilder(&types);
+   builder->setUseTieredCompilation();
+
+   uint8_t *entry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(builder, &entry));
+   retireMethodBuilder(builder);
+
+   // Retiring leaves the entry point working without ever going back to the builder
+   Accumulator acc = { 0, 0 };
+   for (int32_t i = 0; i < 2 * TIERED_COMPILATION_THRESHOLD; i++)
+      ((AccumulateFunction *)entry)(&acc, 4);
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   ASSERT_EQ(1, builder->_buildCount);
+
+   delete builder;
+   for (int32_t i = 0; i < 2 * TIERED_COMPILATION_THRESHOLD; i++)
+      ((AccumulateFunction *)entry)(&acc, 4);
+   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+   ASSERT_EQ(4 * TIERED_COMPILATION_THRESHOLD * 6, acc.total);
+   }
+
+TEST_F(TieredCompilationTest, RetireWaitsForRecompilation)
+   {
+   AccumulatorTypeDictionary types;
+   AccumulateBuilder *builder = new AccumulateBuilder(&types);
+   builder->setUseTieredCompilation();
+
+   uint8_t *entry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(builder, &entry));
+
+   // Cross the threshold and give the sampler a chance to queue the recompilation
+   Accumulator acc = { 0, 0 };
+   for (int32_t i = 0; i < TIERED_COMPILATION_THRESHOLD; i++)
+      ((AccumulateFunction *)entry)(&acc, 4);
+   std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+   // Whether or not the recompilation already ran, the builder is free to go afterwards
+   retireMethodBuilder(builder);
+   int32_t buildCount = builder->_buildCount;
+   delete builder;
+   ASSERT_LE(buildCount, 2);
+
+   for (int32_t i = 0; i < TIERED_COMPILATION_THRESHOLD; i++)
+      ((AccumulateFunction *)entry)(&acc, 4);
+   ASSERT_EQ(2 * TIERED_COMPILATION_THRESHOLD * 6, acc.total);
+   }
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "omrport.h"
+
+#include "AllocationSampler.hpp"
+
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ObjectModel.hpp"
+
+MM_AllocationSampler *
+MM_AllocationSampler::newInstance(MM_EnvironmentBase *env, uintptr_t samplingInterval, uintptr_t capacity)
+{
+	MM_AllocationSampler *sampler = (MM_AllocationSampler *)env->getForge()->allocate(sizeof(MM_AllocationSampler), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL != sampler) {
+		new(sampler) MM_AllocationSampler(samplingInterval, capacity);
+		if (!sampler->initialize(env)) {
+			sampler->kill(env);
+			sampler = NULL;
+		}
+	}
+	return sampler;
+}
+
+bool
+MM_AllocationSampler::initialize(MM_EnvironmentBase *env)
+{
+	if ((0 == _samplingInterval) || (0 == _capacity)) {
+		return false;
+	}
+
+	/* round the table up to a power of 2 so that probing can mask instead of divide */
+	uintptr_t capacity = 1;
+	while (capacity < _capacity) {
+		capacity <<= 1;
+	}
+	_capacity = capacity;
+
+	_sites = (Site *)env->getForge()->allocate(_capacity * sizeof(Site), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL == _sites) {
+		return false;
+	}
+	memset(_sites, 0, _capacity * sizeof(Site));
+
+	return true;
+}
+
+void
+MM_AllocationSampler::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+void
+MM_AllocationSampler::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _sites) {
+		env->getForge()->free(_sites);
+		_sites = NULL;
+	}
+}
+
+void
+MM_AllocationSampler::initializeThreadState(MM_EnvironmentBase *env, ThreadState *state)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	memset(state, 0, sizeof(ThreadState));
+	state->randomState = ((uint64_t)(uintptr_t)state) ^ omrtime_hires_clock();
+	if (0 == state->randomState) {
+		state->randomState = 0x9E3779B97F4A7C15ULL;
+	}
+	state->bytesUntilSample = nextSampleDistance(state);
+}
+
+/**
+ * Draw the number of bytes to allocate before the next sample from an exponential distribution
+ * with a mean of the sampling interval (xorshift64* as the uniform source).
+ */
+uintptr_t
+MM_AllocationSampler::nextSampleDistance(ThreadState *state)
+{
+	uint64_t x = state->randomState;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	state->randomState = x;
+
+	/* 53 random bits give a uniform double in [0, 1) */
+	double uniform = (double)((x * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+	double distance = -log(1.0 - uniform) * (double)_samplingInterval;
+
+	if (distance < 1.0) {
+		return 1;
+	}
+	if (distance > (double)(UDATA_MAX >> 1)) {
+		return UDATA_MAX >> 1;
+	}
+	return (uintptr_t)distance;
+}
+
+void
+MM_AllocationSampler::tlhAllocationNotify(MM_EnvironmentBase *env, ThreadState *state, uintptr_t sizeInBytes)
+{
+	if (0 == state->randomState) {
+		initializeThreadState(env, state);
+	}
+	resolvePendingSample(env, state);
+
+	if (sizeInBytes < state->bytesUntilSample) {
+		state->bytesUntilSample -= sizeInBytes;
+	} else {
+		state->bytesUntilSample = 0;
+	}
+}
+
+void
+MM_AllocationSampler::takeSample(MM_EnvironmentBase *env, ThreadState *state, omrobjectptr_t object, uintptr_t sizeInBytes)
+{
+	resolvePendingSample(env, state);
+
+	if (NULL != object) {
+		state->pendingFrameCount = env->captureStackFrames(state->pendingFrames, ALLOCATION_SAMPLER_MAX_FRAMES);
+		state->pendingSize = sizeInBytes;
+		state->pendingObject = object;
+	}
+	state->bytesUntilSample = nextSampleDistance(state);
+}
+
+void
+MM_AllocationSampler::recordSample(MM_EnvironmentBase *env, omrobjectptr_t object, uintptr_t sizeInBytes, uintptr_t *frames, uintptr_t frameCount)
+{
+	uintptr_t typeKey = env->getExtensions()->objectModel.getObjectTypeKey(object);
+
+	/* An object of this size is sampled with probability 1 - exp(-size / interval), so weighting each sample
+	 * by the inverse of that probability gives an unbiased estimate of the bytes allocated at the site.
+	 */
+	double probability = 1.0 - exp(-(double)sizeInBytes / (double)_samplingInterval);
+	uint64_t estimatedBytes = (uint64_t)((double)sizeInBytes / probability);
+
+	uintptr_t hash = typeKey * (uintptr_t)0x9E3779B97F4A7C15ULL;
+	for (uintptr_t frame = 0; frame < frameCount; frame++) {
+		hash = (hash ^ frames[frame]) * (uintptr_t)0x100000001B3ULL;
+	}
+	hash ^= hash >> 17;
+	if (0 == hash) {
+		hash = 1;
+	}
+
+	uintptr_t mask = _capacity - 1;
+	for (uintptr_t probe = 0; probe < _capacity; probe++) {
+		Site *site = &_sites[(hash + probe) & mask];
+		uintptr_t siteHash = site->hash;
+
+		if (0 == siteHash) {
+			if (0 == MM_AtomicOperations::lockCompareExchange(&site->hash, 0, hash)) {
+				/* slot claimed - publish the key before anyone else may match against it */
+				site->typeKey = typeKey;
+				site->frameCount = frameCount;
+				memcpy(site->frames, frames, frameCount * sizeof(uintptr_t));
+				MM_AtomicOperations::writeBarrier();
+				site->ready = 1;
+				siteHash = hash;
+			} else {
+				siteHash = site->hash;
+			}
+		}
+
+		if (siteHash == hash) {
+			while (0 == site->ready) {
+				MM_AtomicOperations::yieldCPU();
+			}
+			MM_AtomicOperations::readBarrier();
+			if ((site->typeKey == typeKey)
+				&& (site->frameCount == frameCount)
+				&& (0 == memcmp(site->frames, frames, frameCount * sizeof(uintptr_t)))
+			) {
+				MM_AtomicOperations::add(&site->sampleCount, 1);
+				MM_AtomicOperations::add(&site->sampledBytes, sizeInBytes);
+				MM_AtomicOperations::addU64(&site->estimatedBytes, estimatedBytes);
+				return;
+			}
+		}
+	}
+
+	MM_AtomicOperations::add(&_droppedSamples, 1);
+}
+
+void
+MM_AllocationSampler::getTotals(uintptr_t *sampleCount, uintptr_t *sampledBytes, uint64_t *estimatedBytes)
+{
+	*sampleCount = 0;
+	*sampledBytes = 0;
+	*estimatedBytes = 0;
+	for (uintptr_t index = 0; index < _capacity; index++) {
+		if (0 != _sites[index].ready) {
+			*sampleCount += _sites[index].sampleCount;
+			*sampledBytes += _sites[index].sampledBytes;
+			*estimatedBytes += _sites[index].estimatedBytes;
+		}
+	}
+}
+
+int
+MM_AllocationSampler::compareSitesByEstimatedBytes(const void *element1, const void *element2)
+{
+	Site *site1 = *(Site **)element1;
+	Site *site2 = *(Site **)element2;
+
+	if (site1->estimatedBytes == site2->estimatedBytes) {
+		return 0;
+	} else if (site1->estimatedBytes < site2->estimatedBytes) {
+		return 1;
+	} else {
+		return -1;
+	}
+}
+
+void
+MM_AllocationSampler::dump(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	Site **sortedSites = (Site **)env->getForge()->allocate(_capacity * sizeof(Site *), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL == sortedSites) {
+		omrtty_printf("Unable to dump allocation samples: out of memory\n");
+		return;
+	}
+
+	uintptr_t siteCount = 0;
+	for (uintptr_t index = 0; index < _capacity; index++) {
+		if (0 != _sites[index].ready) {
+			sortedSites[siteCount] = &_sites[index];
+			siteCount += 1;
+		}
+	}
+	J9_SORT(sortedSites, siteCount, sizeof(Site *), compareSitesByEstimatedBytes);
+
+	omrtty_printf("Allocation samples (mean interval %zu bytes): %zu sites, %zu dropped samples\n", _samplingInterval, siteCount, _droppedSamples);
+	for (uintptr_t index = 0; index < siteCount; index++) {
+		Site *site = sortedSites[index];
+		omrtty_printf("  type 0x%zx: %zu samples, %zu sampled bytes, %llu estimated bytes\n",
+			site->typeKey, site->sampleCount, site->sampledBytes, site->estimatedBytes);
+		for (uintptr_t frame = 0; frame < site->frameCount; frame++) {
+			omrtty_printf("    at 0x%zx\n", site->frames[frame]);
+		}
+	}
+
+	env->getForge()->free(sortedSites);
+}
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base_Core
+ */
+
+#if !defined(ALLOCATIONSAMPLER_HPP_)
+#define ALLOCATIONSAMPLER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrgcconsts.h"
+#include "objectdescription.h"
+
+#include "Base.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Maximum number of stack frames recorded for a sampled allocation.
+ */
+#define ALLOCATION_SAMPLER_MAX_FRAMES 16
+
+/**
+ * Mean number of allocated bytes between samples when sampling is enabled by -Xgc:allocationSampling.
+ */
+#define ALLOCATION_SAMPLER_DEFAULT_INTERVAL (1024 * 1024)
+
+/**
+ * Default number of distinct (type, stack) sites tracked by the sampler.
+ */
+#define ALLOCATION_SAMPLER_DEFAULT_CAPACITY 4096
+
+/**
+ * Sampling allocation profiler.
+ *
+ * Allocating threads count down a randomized number of allocated bytes, drawn from an exponential
+ * distribution whose mean is the sampling interval, so that samples form a Poisson process over the
+ * allocated bytes and every byte has the same chance to be sampled. When the count runs out, the
+ * allocated object is sampled: the allocating thread's stack is captured through the environment
+ * delegate and, once the object has been initialized by the language, its type is obtained from the
+ * object model delegate.
+ *
+ * Objects allocated from a TLH, out of line or inline by the language, are not looked at one by one. Instead
+ * the TLH top is lowered to where the next sample is due, so the allocation crossing the sample point takes
+ * the TLH refresh path, where the bytes allocated from the TLH since the previous sample point are counted.
+ *
+ * Samples are aggregated per (type, stack) site into an open addressing table which allocating threads
+ * update without locking. Each site accumulates the number of samples, the sampled bytes and an unbiased
+ * estimate of the total bytes allocated from it.
+ *
+ * @ingroup GC_Base_Core
+ */
+class MM_AllocationSampler : public MM_Base
+{
+/*
+ * Data members
+ */
+public:
+	/**
+	 * Per allocating thread state, owned by its allocation interface.
+	 */
+	struct ThreadState {
+		uintptr_t bytesUntilSample; /**< allocated bytes remaining before the next sample is taken */
+		uint64_t randomState; /**< xorshift state used to draw the sampling distances */
+		omrobjectptr_t pendingObject; /**< sampled object waiting for the language to initialize it (NULL if none) */
+		uintptr_t pendingSize; /**< size in bytes of pendingObject */
+		uintptr_t pendingFrameCount; /**< number of valid entries in pendingFrames */
+		uintptr_t pendingFrames[ALLOCATION_SAMPLER_MAX_FRAMES]; /**< stack of the thread that allocated pendingObject */
+	};
+
+private:
+	struct Site {
+		volatile uintptr_t hash; /**< hash of the (type, stack) key, 0 if the slot is free */
+		volatile uintptr_t ready; /**< non zero once the key fields below have been written */
+		uintptr_t typeKey; /**< language type key of the sampled objects */
+		uintptr_t frameCount; /**< number of valid entries in frames */
+		uintptr_t frames[ALLOCATION_SAMPLER_MAX_FRAMES]; /**< allocating stack */
+		volatile uintptr_t sampleCount; /**< number of samples taken at this site */
+		volatile uintptr_t sampledBytes; /**< total size of the sampled objects */
+		volatile uint64_t estimatedBytes; /**< estimate of all the bytes allocated at this site */
+	};
+
+	Site *_sites; /**< open addressing table of sites */
+	uintptr_t _capacity; /**< number of slots in _sites (power of 2) */
+	uintptr_t _samplingInterval; /**< mean number of allocated bytes between samples */
+	volatile uintptr_t _droppedSamples; /**< samples lost because the table was full */
+
+/*
+ * Function members
+ */
+private:
+	uintptr_t nextSampleDistance(ThreadState *state);
+	void recordSample(MM_EnvironmentBase *env, omrobjectptr_t object, uintptr_t sizeInBytes, uintptr_t *frames, uintptr_t frameCount);
+	static int compareSitesByEstimatedBytes(const void *element1, const void *element2);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_AllocationSampler *newInstance(MM_EnvironmentBase *env, uintptr_t samplingInterval, uintptr_t capacity);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Prepare the state of a new allocating thread.
+	 */
+	void initializeThreadState(MM_EnvironmentBase *env, ThreadState *state);
+
+	/**
+	 * Account for an allocation made by the thread owning state, sampling it if the countdown runs out.
+	 * Must be called by the allocating thread, after tlhAllocationNotify() and before the language initializes
+	 * the object.
+	 */
+	MMINLINE void
+	allocationNotify(MM_EnvironmentBase *env, ThreadState *state, void *object, uintptr_t sizeInBytes)
+	{
+		if (sizeInBytes < state->bytesUntilSample) {
+			state->bytesUntilSample -= sizeInBytes;
+		} else {
+			takeSample(env, state, (omrobjectptr_t)object, sizeInBytes);
+		}
+	}
+
+	/**
+	 * Bring the thread owning state up to date at a TLH refresh or sample point: complete the previous sample,
+	 * whose object has been initialized by now, and account for the bytes allocated from the TLH since the last
+	 * call, which never go past the sample point since the TLH top was lowered to it.
+	 */
+	void tlhAllocationNotify(MM_EnvironmentBase *env, ThreadState *state, uintptr_t sizeInBytes);
+
+	/**
+	 * Capture the allocating stack for object and defer the rest of the sample until the object is initialized.
+	 */
+	void takeSample(MM_EnvironmentBase *env, ThreadState *state, omrobjectptr_t object, uintptr_t sizeInBytes);
+
+	/**
+	 * Complete a deferred sample. Called when the owning thread reaches its next TLH refresh or sample point,
+	 * and when its allocation caches are flushed for a collection, at which point the sampled object is initialized.
+	 */
+	MMINLINE void
+	resolvePendingSample(MM_EnvironmentBase *env, ThreadState *state)
+	{
+		if (NULL != state->pendingObject) {
+			recordSample(env, state->pendingObject, state->pendingSize, state->pendingFrames, state->pendingFrameCount);
+			state->pendingObject = NULL;
+		}
+	}
+
+	/**
+	 * Sum the statistics of all the sites collected so far.
+	 * @param[out] sampleCount number of samples taken
+	 * @param[out] sampledBytes total size of the sampled objects
+	 * @param[out] estimatedBytes estimate of all the bytes allocated
+	 */
+	void getTotals(uintptr_t *sampleCount, uintptr_t *sampledBytes, uint64_t *estimatedBytes);
+
+	MMINLINE uintptr_t getSamplingInterval() { return _samplingInterval; }
+	MMINLINE uintptr_t getDroppedSamples() { return _droppedSamples; }
+
+	/**
+	 * Print the sites collected so far, by decreasing estimated allocated bytes.
+	 */
+	void dump(MM_EnvironmentBase *env);
+
+	MM_AllocationSampler(uintptr_t samplingInterval, uintptr_t capacity)
+		: MM_Base()
+		, _sites(NULL)
+		, _capacity(capacity)
+		, _samplingInterval(samplingInterval)
+		, _droppedSamples(0)
+	{
+	}
+};
+
+#endif /* ALLOCATIONSAMPLER_HPP_ */
@@ -23,6 +23,7 @@
 #include "AllocateDescription.hpp"
 #include "Collector.hpp"
 #include "GCExtensionsBase.hpp"
+#include "GCTimeline.hpp"
 #include "FrequentObjectsStats.hpp"
 #include "Heap.hpp"
 #include "MemorySubSpace.hpp"
@@ -479,6 +480,7 @@ MM_Collector::garbageCollect(MM_EnvironmentBase* env, MM_MemorySubSpace* calling
 	Assert_MM_mustHaveExclusiveVMAccess(env->getOmrVMThread());
 
 	Assert_MM_true(NULL == env->_cycleState);
+	MM_GCTimeline::recordBegin(env, getBaseVirtualTypeId());
 	preCollect(env, callingSubSpace, allocateDescription, gcCode);
 	Assert_MM_true(NULL != env->_cycleState);
 
@@ -516,6 +518,12 @@ MM_Collector::garbageCollect(MM_EnvironmentBase* env, MM_MemorySubSpace* calling
 	Assert_MM_true(NULL != env->_cycleState);
 	env->_cycleState = NULL;
 
+	MM_GCTimeline *timeline = env->getExtensions()->gcTimeline;
+	if (NULL != timeline) {
+		timeline->end(env, getBaseVirtualTypeId());
+		timeline->flush(env);
+	}
+
 	return postCollectAllocationResult;
 }
 
@@ -26,6 +26,8 @@
 #include "Dispatcher.hpp"
 
 #include "EnvironmentBase.hpp"
+#include "GCTimeline.hpp"
+#include "ParallelPrefaultTask.hpp"
 #include "Task.hpp"
 
 MM_Dispatcher *
@@ -98,13 +100,18 @@ MM_Dispatcher::run(MM_EnvironmentBase *env, MM_Task *task, uintptr_t newThreadCo
 	task->masterSetup(env);
 	prepareThreadsForTask(env, task);
 	acceptTask(env);
+	MM_GCTimeline::recordBegin(env, task->getBaseVirtualTypeId());
 	task->run(env);
+	MM_GCTimeline::recordEnd(env, task->getBaseVirtualTypeId());
 	completeTask(env);
 	cleanupAfterTask(env);
 	task->masterCleanup(env);
 
 	/* restore the default thread count */
 	setThreadCount(defaultThreadCount);
+
+	/* heap ranges committed while the task ran could not be prefaulted by it */
+	MM_ParallelPrefaultTask::prefaultDeferredRanges(env);
 }
 
 bool 
@@ -379,6 +379,12 @@ public:
 	 */
 	bool objectAllocationNotify(omrobjectptr_t omrObject) { return _delegate.objectAllocationNotify(omrObject); }
 
+	/**
+	 * Capture the frames of the calling thread's stack, innermost first.
+	 * @return the number of frames stored in frames
+	 */
+	uintptr_t captureStackFrames(uintptr_t *frames, uintptr_t maxFrames) { return _delegate.captureStackFrames(frames, maxFrames); }
+
 	/**
 	 *	Verbose: allocation Failure Start Report if required
 	 *	set flag allocation Failure Start Report required
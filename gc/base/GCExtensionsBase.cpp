@@ -70,6 +70,10 @@ MM_GCExtensionsBase::initialize(MM_EnvironmentBase* env)
 
 	_omrVM = env->getOmrVM();
 
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	memset(customSmallCellSizes, 0, sizeof(customSmallCellSizes));
+#endif /* OMR_GC_SEGREGATED_HEAP */
+
 #if defined(OMR_GC_MODRON_STANDARD)
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	configurationOptions._gcPolicy = gc_policy_gencon;
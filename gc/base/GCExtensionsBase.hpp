@@ -45,16 +45,21 @@
 #include "ScavengerCopyScanRatio.hpp"
 #include "ScavengerStats.hpp"
 #include "SublistPool.hpp"
+#if defined(OMR_GC_SEGREGATED_HEAP)
+#include "sizeclasses.h"
+#endif /* OMR_GC_SEGREGATED_HEAP */
 
 class MM_CardTable;
 class MM_ClassLoaderRememberedSet;
 class MM_CollectorLanguageInterface;
 class MM_CompactGroupPersistentStats;
 class MM_CompressedCardTable;
+class MM_AllocationSampler;
 class MM_Configuration;
 class MM_Dispatcher;
 class MM_EnvironmentBase;
 class MM_FrequentObjectsStats;
+class MM_GCTimeline;
 class MM_GlobalAllocationManager;
 class MM_GlobalCollector;
 class MM_Heap;
@@ -62,6 +67,7 @@ class MM_HeapMap;
 class MM_HeapRegionManager;
 class MM_InterRegionRememberedSet;
 class MM_MemoryManager;
+class MM_MemoryHandle;
 class MM_MemorySubSpace;
 #if defined(OMR_GC_OBJECT_MAP)
 class MM_ObjectMap;
@@ -101,6 +107,19 @@ struct J9Pool;
 #define LOCALGC_ESTIMATE_FRAGMENTATION 		0x1
 #define GLOBALGC_ESTIMATE_FRAGMENTATION 	0x2
 
+/* Heap ranges committed from within a task that can wait for the dispatcher to prefault them */
+#define MAX_DEFERRED_PREFAULT_RANGES 8
+
+/**
+ * A committed heap range whose prefault was deferred until the dispatcher is free.
+ */
+struct MM_DeferredPrefaultRange {
+	const MM_MemoryHandle *memoryHandle; /**< handle of the memory backing the range, NULL for no NUMA interleaving */
+	void *lowAddress; /**< base of the range */
+	void *highAddress; /**< top (exclusive) of the range */
+	uintptr_t pageSize; /**< page size of the memory backing the range */
+};
+
 enum ExcessiveLevel {
 	excessive_gc_normal = 0,
 	excessive_gc_aggressive,
@@ -258,6 +277,7 @@ public:
 	MM_RememberedSetSATB* sATBBarrierRememberedSet; /**< The snapshot at the beginning barrier remembered set used for the write barrier */
 #endif /* OMR_GC_STACCATO */
 	ModronLnrlOptions lnrlOptions;
+	bool queuedHeapLocks; /**< Use FIFO queued spinlocks for the free list locks of the memory pools */
 
 	MM_OMRHookInterface omrHookInterface;
 	MM_PrivateHookInterface privateHookInterface;
@@ -310,6 +330,11 @@ public:
 	uintptr_t splitFreeListSplitAmount;
 	uintptr_t splitFreeListNumberChunksPrepared; /**< Used in MPSAOL postProcess. Shared for all MPSAOLs. Do not overwrite during postProcess for any MPSAOL. */
 	bool enableHybridMemoryPool;
+	uintptr_t largeObjectBestFitThreshold; /**< allocations of at least this size are satisfied best fit from a size ordered index of the free list (0 to disable) */
+	uintptr_t largeObjectBestFitIndexCapacity; /**< maximum number of free entries recorded in the best fit index of each memory pool */
+	bool prefaultHeapOnExpand; /**< touch every page of newly committed heap ranges on GC threads so mutators do not take the first-touch faults */
+	MM_DeferredPrefaultRange deferredPrefaultRanges[MAX_DEFERRED_PREFAULT_RANGES]; /**< ranges committed from within a task, prefaulted in parallel once that task completes */
+	volatile uintptr_t deferredPrefaultRangeCount; /**< number of entries of deferredPrefaultRanges claimed (may exceed the maximum when ranges did not fit) */
 
 	bool largeObjectArea;
 #if defined(OMR_GC_LARGE_OBJECT_AREA)
@@ -425,6 +450,7 @@ public:
 	uintptr_t concurrentScavengerBackgroundThreads; /**< number of background GC threads during concurrent phase of Scavenge */
 	bool concurrentScavengerBackgroundThreadsForced; /**< true if concurrentScavengerBackgroundThreads set via command line option */
 	uintptr_t concurrentScavengerSlack; /**< amount of bytes added on top of avearge allocated bytes during concurrent cycle, in calcualtion for survivor size */
+	bool concurrentScavengerSelfHealObject; /**< on a read barrier hit, heal every reference slot of the containing object rather than just the loaded slot */
 #endif	/* OMR_GC_CONCURRENT_SCAVENGER */
 	uintptr_t scavengerFailedTenureThreshold;
 	uintptr_t maxScavengeBeforeGlobal;
@@ -432,6 +458,7 @@ public:
 	uintptr_t scvArraySplitMinimumAmount; /**< minimum number of elements to split array scanning work in the scavenger */
 	uintptr_t scavengerScanCacheMaximumSize; /**< maximum size of scan and copy caches before rounding, zero (default) means calculate them */
 	uintptr_t scavengerScanCacheMinimumSize; /**< minimum size of scan and copy caches before rounding, zero (default) means calculate them */
+	uintptr_t scavengerParallelCopyThreshold; /**< objects of at least this many bytes are copied in scan cache sized chunks that idle GC threads can help with, zero disables */
 	bool tiltedScavenge;
 	bool debugTiltedScavenge;
 	double survivorSpaceMinimumSizeRatio;
@@ -487,10 +514,16 @@ public:
 	uintptr_t compactOnSystemGC;
 	uintptr_t nocompactOnSystemGC;
 	bool compactToSatisfyAllocate;
+	bool proactiveCompaction; /**< compact the most fragmented part of the heap when large allocations are predicted to start failing */
+	uintptr_t proactiveCompactionWindowSize; /**< size of the range compacted by a proactive compaction (0 for 1/8 of the tenure space) */
 #endif /* OMR_GC_MODRON_COMPACTION */
 
 	bool payAllocationTax;
 
+	bool stickyMarkBits; /**< Run flat global collections as sticky mark bit minor collections that keep the previous cycle's mark bits and trace only new objects and dirty cards */
+	uintptr_t stickyMarkMaxMinorCollections; /**< Maximum number of consecutive sticky mark bit minor collections before a full collection is forced */
+	uintptr_t stickyMarkMinFreePercent; /**< A full collection follows any sticky mark bit minor collection that leaves less than this percentage of the heap free */
+
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
 	bool concurrentMark;
 	bool concurrentKickoffEnabled;
@@ -577,6 +610,8 @@ public:
 	uintptr_t managedAllocationContextCount; /**< The number of allocation contexts which will be instantiated and managed by the GlobalAllocationManagerRealtime (currently 2*cpu_count) */
 #if defined(OMR_GC_SEGREGATED_HEAP)
 	MM_SizeClasses* defaultSizeClasses;
+	uintptr_t customSmallCellSizes[OMR_SIZECLASSES_NUM_SMALL + 1]; /**< Cell sizes loaded at startup to replace SMALL_SIZECLASSES (unused while customSmallCellSizes[OMR_SIZECLASSES_MAX_SMALL] is 0) */
+	bool sizeClassProfiling; /**< Record a histogram of allocation sizes and report fragmentation per size class at shutdown */
 #endif
 
 /* OMR_GC_REALTIME (in for all -- see 82589) */
@@ -584,6 +619,8 @@ public:
 	uintptr_t traceCostToCheckYield; /**< tracing cost (in number of objects marked and pointers scanned) after we try to yield */
 	uintptr_t sweepCostToCheckYield; /**< weighted count of free chunks/marked objects before we check yield in sweep small loop */
 	uintptr_t splitAvailableListSplitAmount; /**< Number of split available lists per size class, per defragment bucket */
+	uintptr_t regionListShardCount; /**< Number of shards in each shared region queue and in the single free region list of the segregated heap (0 to use unsharded locking lists) */
+	uintptr_t segregatedSweepBudget; /**< Maximum time in microseconds to spend sweeping small regions in a segregated GC pause, the rest is swept lazily by allocating threads (0 for no limit) */
 	uint32_t newThreadAllocationColor;
 	uintptr_t minimumFreeEntrySize;
 	uintptr_t arrayletsPerRegion;
@@ -604,6 +641,9 @@ public:
 	MM_Configuration* configuration; /**< holds the Configuration selected during startup */
 
 	MM_VerboseManagerBase* verboseGCManager;
+	MM_GCTimeline* gcTimeline; /**< per GC thread phase recorder enabled by -Xgc:timelineFile (NULL if disabled) */
+	uintptr_t allocationSamplingInterval; /**< mean number of allocated bytes between allocation samples (0 to disable sampling) */
+	MM_AllocationSampler* allocationSampler; /**< allocation sampling profiler enabled by -Xgc:allocationSamplingInterval (NULL if disabled) */
 
 	uintptr_t verbosegcCycleTime;
 	bool verboseExtensions;
@@ -1238,6 +1278,7 @@ public:
 		, staccatoRememberedSet(NULL)
 		, sATBBarrierRememberedSet(NULL)
 #endif /* OMR_GC_STACCATO */
+		, queuedHeapLocks(false)
 
 		, heapBaseForBarrierRange0(NULL)
 		, heapSizeForBarrierRange0(0)
@@ -1276,6 +1317,10 @@ public:
 		, gcModeString(NULL)
 		, splitFreeListSplitAmount(0)
 		, enableHybridMemoryPool(false)
+		, largeObjectBestFitThreshold(0)
+		, largeObjectBestFitIndexCapacity(256)
+		, prefaultHeapOnExpand(false)
+		, deferredPrefaultRangeCount(0)
 		, largeObjectArea(false)
 #if defined(OMR_GC_LARGE_OBJECT_AREA)
 		, largeObjectMinimumSize(64 * 1024)
@@ -1360,6 +1405,7 @@ public:
 		, concurrentScavengerBackgroundThreads(1)
 		, concurrentScavengerBackgroundThreadsForced(false)
 		, concurrentScavengerSlack(0)
+		, concurrentScavengerSelfHealObject(false)
 #endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
 		, scavengerFailedTenureThreshold(0)
 		, maxScavengeBeforeGlobal(0)
@@ -1367,6 +1413,7 @@ public:
 		, scvArraySplitMinimumAmount(DEFAULT_ARRAY_SPLIT_MINIMUM_SIZE)
 		, scavengerScanCacheMaximumSize(DEFAULT_SCAN_CACHE_MAXIMUM_SIZE)
 		, scavengerScanCacheMinimumSize(DEFAULT_SCAN_CACHE_MINIMUM_SIZE)
+		, scavengerParallelCopyThreshold(4 * DEFAULT_SCAN_CACHE_MAXIMUM_SIZE)
 		, tiltedScavenge(true)
 		, debugTiltedScavenge(false)
 		, survivorSpaceMinimumSizeRatio(0.10)
@@ -1410,8 +1457,13 @@ public:
 		, compactOnSystemGC(0)
 		, nocompactOnSystemGC(0)
 		, compactToSatisfyAllocate(false)
+		, proactiveCompaction(false)
+		, proactiveCompactionWindowSize(0)
 		, payAllocationTax(false)
 #endif /* OMR_GC_MODRON_COMPACTION */
+		, stickyMarkBits(false)
+		, stickyMarkMaxMinorCollections(8)
+		, stickyMarkMinFreePercent(20)
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
 		, concurrentMark(false)
 		, concurrentKickoffEnabled(true)
@@ -1486,11 +1538,14 @@ public:
 #endif /* OMR_GC_REALTIME */
 #if defined(OMR_GC_SEGREGATED_HEAP)
 		, defaultSizeClasses(NULL)
+		, sizeClassProfiling(false)
 #endif
 		, distanceToYieldTimeCheck(0)
 		, traceCostToCheckYield(500) /* weighted sum of marked objects and scanned pointers before we check yield in main tracing loop */
 		, sweepCostToCheckYield(500) /* weighted count of free chunks/marked objects before we check yield in sweep small loop */
 		, splitAvailableListSplitAmount(0)
+		, regionListShardCount(0)
+		, segregatedSweepBudget(0)
 		, newThreadAllocationColor(0)
 		, minimumFreeEntrySize((uintptr_t)-1) /* -1 => user did not override default minimumFreeEntrySize */
 		, arrayletsPerRegion(0)
@@ -1505,6 +1560,9 @@ public:
 		, allocationCacheIncrementSize(256)
 		, nonDeterministicSweep(false)
 		, verboseGCManager(NULL)
+		, gcTimeline(NULL)
+		, allocationSamplingInterval(0)
+		, allocationSampler(NULL)
 		, verbosegcCycleTime(1000)  /* by default metronome outputs verbosegc every 1sec */
 		, verboseExtensions(false)
 		, verboseNewFormat(true)
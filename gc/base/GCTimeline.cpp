@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "omrport.h"
+
+#include "GCTimeline.hpp"
+
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+
+MM_GCTimeline *
+MM_GCTimeline::newInstance(MM_EnvironmentBase *env, const char *fileName, uintptr_t threadCount, uintptr_t eventsPerThread)
+{
+	MM_GCTimeline *timeline = (MM_GCTimeline *)env->getForge()->allocate(sizeof(MM_GCTimeline), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL != timeline) {
+		new(timeline) MM_GCTimeline(threadCount, eventsPerThread);
+		if (!timeline->initialize(env, fileName)) {
+			timeline->kill(env);
+			timeline = NULL;
+		}
+	}
+	return timeline;
+}
+
+bool
+MM_GCTimeline::initialize(MM_EnvironmentBase *env, const char *fileName)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if ((0 == _threadCount) || (0 == _eventsPerThread)) {
+		return false;
+	}
+
+	_threadBuffers = (ThreadBuffer *)env->getForge()->allocate(_threadCount * sizeof(ThreadBuffer), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL == _threadBuffers) {
+		return false;
+	}
+	_events = (Event *)env->getForge()->allocate(_threadCount * _eventsPerThread * sizeof(Event), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL == _events) {
+		return false;
+	}
+	for (uintptr_t threadID = 0; threadID < _threadCount; threadID++) {
+		_threadBuffers[threadID].events = _events + (threadID * _eventsPerThread);
+		_threadBuffers[threadID].head = 0;
+		_threadBuffers[threadID].tail = 0;
+		_threadBuffers[threadID].dropped = 0;
+	}
+
+	_fileDescriptor = omrfile_open(fileName, EsOpenWrite | EsOpenCreate | EsOpenTruncate, 0666);
+	if (-1 == _fileDescriptor) {
+		omrtty_printf("Failed to open GC timeline file %s\n", fileName);
+		return false;
+	}
+	_startTime = omrtime_hires_clock();
+
+	/* name the thread tracks once, up front */
+	char line[128];
+	uintptr_t length = omrstr_printf(line, sizeof(line), "[\n");
+	appendOutput(env, line, length);
+	for (uintptr_t threadID = 0; threadID < _threadCount; threadID++) {
+		length = omrstr_printf(line, sizeof(line),
+			"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%zu,\"args\":{\"name\":\"GC thread %zu\"}}",
+			(_eventWritten ? ",\n" : ""), threadID, threadID);
+		appendOutput(env, line, length);
+		_eventWritten = true;
+	}
+	writeOutputBuffer(env);
+
+	return true;
+}
+
+void
+MM_GCTimeline::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+void
+MM_GCTimeline::tearDown(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if (-1 != _fileDescriptor) {
+		flush(env);
+		appendOutput(env, "\n]\n", 3);
+		writeOutputBuffer(env);
+		omrfile_close(_fileDescriptor);
+		_fileDescriptor = -1;
+	}
+	if (NULL != _events) {
+		env->getForge()->free(_events);
+		_events = NULL;
+	}
+	if (NULL != _threadBuffers) {
+		env->getForge()->free(_threadBuffers);
+		_threadBuffers = NULL;
+	}
+}
+
+void
+MM_GCTimeline::record(MM_EnvironmentBase *env, const char *name, char phase)
+{
+	uintptr_t threadID = env->getSlaveID();
+	if (threadID >= _threadCount) {
+		return;
+	}
+
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	ThreadBuffer *buffer = &_threadBuffers[threadID];
+	uintptr_t head = buffer->head;
+	if ((head - buffer->tail) >= _eventsPerThread) {
+		MM_AtomicOperations::add(&buffer->dropped, 1);
+		return;
+	}
+
+	Event *event = &buffer->events[head % _eventsPerThread];
+	event->name = name;
+	event->timestamp = omrtime_hires_clock();
+	event->phase = phase;
+
+	/* publish the event before the flushing thread can see it */
+	MM_AtomicOperations::writeBarrier();
+	buffer->head = head + 1;
+}
+
+void
+MM_GCTimeline::flush(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	for (uintptr_t threadID = 0; threadID < _threadCount; threadID++) {
+		ThreadBuffer *buffer = &_threadBuffers[threadID];
+		uintptr_t head = buffer->head;
+		MM_AtomicOperations::readBarrier();
+
+		for (uintptr_t index = buffer->tail; index < head; index++) {
+			Event *event = &buffer->events[index % _eventsPerThread];
+			writeEvent(env, event->name, event->phase, threadID, event->timestamp, 0);
+		}
+
+		uintptr_t dropped = buffer->dropped;
+		if (0 != dropped) {
+			MM_AtomicOperations::subtract(&buffer->dropped, dropped);
+			writeEvent(env, "events dropped", 'i', threadID, omrtime_hires_clock(), dropped);
+		}
+
+		/* the slots must be consumed before the owning thread is allowed to reuse them */
+		MM_AtomicOperations::readWriteBarrier();
+		buffer->tail = head;
+	}
+
+	writeOutputBuffer(env);
+}
+
+void
+MM_GCTimeline::writeEvent(MM_EnvironmentBase *env, const char *name, char phase, uintptr_t threadID, uint64_t timestamp, uintptr_t droppedCount)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	char line[256];
+	uintptr_t length = 0;
+
+	if (_eventWritten) {
+		appendOutput(env, ",\n", 2);
+	}
+	_eventWritten = true;
+
+	appendOutput(env, "{\"name\":\"", 9);
+	writeString(env, (NULL != name) ? name : "unknown");
+
+	/* Chrome trace timestamps are in microseconds */
+	uint64_t nanoseconds = omrtime_hires_delta(_startTime, timestamp, OMRPORT_TIME_DELTA_IN_NANOSECONDS);
+	length = omrstr_printf(line, sizeof(line), "\",\"cat\":\"gc\",\"ph\":\"%c\",\"ts\":%llu.%03llu,\"pid\":0,\"tid\":%zu",
+		phase, nanoseconds / 1000, nanoseconds % 1000, threadID);
+	appendOutput(env, line, length);
+
+	if (0 != droppedCount) {
+		length = omrstr_printf(line, sizeof(line), ",\"s\":\"t\",\"args\":{\"count\":%zu}", droppedCount);
+		appendOutput(env, line, length);
+	}
+	appendOutput(env, "}", 1);
+}
+
+void
+MM_GCTimeline::writeString(MM_EnvironmentBase *env, const char *string)
+{
+	for (const char *cursor = string; '\0' != *cursor; cursor++) {
+		char escaped[2] = { '\\', *cursor };
+		if (('"' == *cursor) || ('\\' == *cursor)) {
+			appendOutput(env, escaped, 2);
+		} else if ((unsigned char)*cursor >= 0x20) {
+			appendOutput(env, cursor, 1);
+		}
+	}
+}
+
+void
+MM_GCTimeline::appendOutput(MM_EnvironmentBase *env, const char *chars, uintptr_t length)
+{
+	if ((_outputLength + length) > sizeof(_outputBuffer)) {
+		writeOutputBuffer(env);
+	}
+	memcpy(_outputBuffer + _outputLength, chars, length);
+	_outputLength += length;
+}
+
+void
+MM_GCTimeline::writeOutputBuffer(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if (0 != _outputLength) {
+		omrfile_write(_fileDescriptor, _outputBuffer, _outputLength);
+		_outputLength = 0;
+	}
+}
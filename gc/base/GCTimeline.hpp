@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(GCTIMELINE_HPP_)
+#define GCTIMELINE_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+
+#include "Base.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+
+/**
+ * Default capacity of each GC thread's event ring.
+ */
+#define GC_TIMELINE_EVENTS_PER_THREAD 16384
+
+/**
+ * Records begin and end events of GC tasks, sub-phases and sync points for every GC thread and writes
+ * them to a file in the Chrome trace event format (JSON array form, loadable by chrome://tracing and Perfetto).
+ *
+ * Each GC thread owns the buffer matching its slave ID, so recording takes no lock. A buffer is a single producer /
+ * single consumer ring: the owning thread appends to it and the thread finishing a collection drains it in flush(),
+ * which lets threads of a concurrent phase keep recording while a flush is in progress.  Events that do not fit in a
+ * full buffer are dropped and reported as an instant event at the next flush.
+ *
+ * Event names are not copied: they must be string literals or otherwise outlive the recorder (task type IDs,
+ * sync point IDs).
+ *
+ * @ingroup GC_Base_Core
+ */
+class MM_GCTimeline : public MM_Base
+{
+/*
+ * Data members
+ */
+private:
+	struct Event {
+		const char *name; /**< name of the task, phase or sync point */
+		uint64_t timestamp; /**< omrtime_hires_clock() when the event was recorded */
+		char phase; /**< Chrome trace phase: 'B' for begin, 'E' for end */
+	};
+
+	struct ThreadBuffer {
+		Event *events; /**< ring of _eventsPerThread events */
+		volatile uintptr_t head; /**< number of events ever recorded (written by the owning thread only) */
+		volatile uintptr_t tail; /**< number of events ever flushed (written by the flushing thread only) */
+		volatile uintptr_t dropped; /**< number of events lost since the last flush because the ring was full */
+	};
+
+	ThreadBuffer *_threadBuffers; /**< one buffer per GC thread, indexed by slave ID */
+	uintptr_t _threadCount; /**< number of entries in _threadBuffers */
+	uintptr_t _eventsPerThread; /**< capacity of each ring */
+	Event *_events; /**< backing storage of all the rings */
+	intptr_t _fileDescriptor; /**< output file, -1 if not open */
+	bool _eventWritten; /**< true once the first event was written (controls the JSON separators) */
+	uint64_t _startTime; /**< omrtime_hires_clock() at creation, all timestamps are written relative to it */
+	char _outputBuffer[4096]; /**< formatting buffer for flush() */
+	uintptr_t _outputLength; /**< bytes used in _outputBuffer */
+
+/*
+ * Function members
+ */
+private:
+	void record(MM_EnvironmentBase *env, const char *name, char phase);
+	void writeEvent(MM_EnvironmentBase *env, const char *name, char phase, uintptr_t threadID, uint64_t timestamp, uintptr_t droppedCount);
+	void writeString(MM_EnvironmentBase *env, const char *string);
+	void appendOutput(MM_EnvironmentBase *env, const char *chars, uintptr_t length);
+	void writeOutputBuffer(MM_EnvironmentBase *env);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env, const char *fileName);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_GCTimeline *newInstance(MM_EnvironmentBase *env, const char *fileName, uintptr_t threadCount, uintptr_t eventsPerThread);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Record the beginning of a task, phase or sync point on the calling GC thread.
+	 */
+	MMINLINE void begin(MM_EnvironmentBase *env, const char *name) { record(env, name, 'B'); }
+
+	/**
+	 * Record the end of the innermost task, phase or sync point begun on the calling GC thread.
+	 */
+	MMINLINE void end(MM_EnvironmentBase *env, const char *name) { record(env, name, 'E'); }
+
+	/**
+	 * Convenience wrappers for call sites: do nothing unless the timeline is enabled.
+	 */
+	MMINLINE static void recordBegin(MM_EnvironmentBase *env, const char *name)
+	{
+		MM_GCTimeline *timeline = env->getExtensions()->gcTimeline;
+		if (NULL != timeline) {
+			timeline->begin(env, name);
+		}
+	}
+
+	MMINLINE static void recordEnd(MM_EnvironmentBase *env, const char *name)
+	{
+		MM_GCTimeline *timeline = env->getExtensions()->gcTimeline;
+		if (NULL != timeline) {
+			timeline->end(env, name);
+		}
+	}
+
+	/**
+	 * Write out every event recorded since the previous flush.  Called by the master thread at the end of
+	 * each collection.
+	 */
+	void flush(MM_EnvironmentBase *env);
+
+	MM_GCTimeline(uintptr_t threadCount, uintptr_t eventsPerThread)
+		: MM_Base()
+		, _threadBuffers(NULL)
+		, _threadCount(threadCount)
+		, _eventsPerThread(eventsPerThread)
+		, _events(NULL)
+		, _fileDescriptor(-1)
+		, _eventWritten(false)
+		, _startTime(0)
+		, _outputLength(0)
+	{
+	}
+};
+
+#endif /* GCTIMELINE_HPP_ */
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "LargeFreeEntryIndex.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+
+MM_LargeFreeEntryIndex *
+MM_LargeFreeEntryIndex::newInstance(MM_EnvironmentBase *env, uintptr_t capacity, uintptr_t threshold)
+{
+	MM_LargeFreeEntryIndex *index = (MM_LargeFreeEntryIndex *)env->getForge()->allocate(sizeof(MM_LargeFreeEntryIndex), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != index) {
+		new(index) MM_LargeFreeEntryIndex(capacity, threshold);
+		if (!index->initialize(env)) {
+			index->kill(env);
+			index = NULL;
+		}
+	}
+	return index;
+}
+
+bool
+MM_LargeFreeEntryIndex::initialize(MM_EnvironmentBase *env)
+{
+	if (0 == _capacity) {
+		return false;
+	}
+	_entries = (Entry *)env->getForge()->allocate(_capacity * sizeof(Entry), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	return NULL != _entries;
+}
+
+void
+MM_LargeFreeEntryIndex::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+void
+MM_LargeFreeEntryIndex::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _entries) {
+		env->getForge()->free(_entries);
+		_entries = NULL;
+	}
+}
+
+uintptr_t
+MM_LargeFreeEntryIndex::lowerBound(uintptr_t size, MM_HeapLinkedFreeHeader *freeEntry)
+{
+	uintptr_t low = 0;
+	uintptr_t high = _count;
+
+	while (low < high) {
+		uintptr_t middle = low + ((high - low) / 2);
+		Entry *entry = &_entries[middle];
+		if ((entry->size < size) || ((entry->size == size) && (entry->freeEntry < freeEntry))) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+void
+MM_LargeFreeEntryIndex::rebuild(MM_HeapLinkedFreeHeader *freeList)
+{
+	_count = 0;
+	_complete = true;
+
+	MM_HeapLinkedFreeHeader *freeEntry = freeList;
+	while (NULL != freeEntry) {
+		insert(freeEntry, freeEntry->getSize());
+		freeEntry = freeEntry->getNext();
+	}
+
+	_valid = true;
+}
+
+void
+MM_LargeFreeEntryIndex::insert(MM_HeapLinkedFreeHeader *freeEntry, uintptr_t size)
+{
+	if (size < _threshold) {
+		return;
+	}
+
+	uintptr_t position = lowerBound(size, freeEntry);
+
+	if (_count == _capacity) {
+		/* Full: keep the largest entries, since they are the ones able to satisfy the most requests */
+		_complete = false;
+		if (0 == position) {
+			return;
+		}
+		position -= 1;
+		memmove(&_entries[0], &_entries[1], position * sizeof(Entry));
+	} else {
+		memmove(&_entries[position + 1], &_entries[position], (_count - position) * sizeof(Entry));
+		_count += 1;
+	}
+
+	_entries[position].size = size;
+	_entries[position].freeEntry = freeEntry;
+}
+
+void
+MM_LargeFreeEntryIndex::remove(MM_HeapLinkedFreeHeader *freeEntry, uintptr_t size)
+{
+	if (size < _threshold) {
+		return;
+	}
+
+	uintptr_t position = lowerBound(size, freeEntry);
+	if ((position < _count) && (_entries[position].freeEntry == freeEntry) && (_entries[position].size == size)) {
+		_count -= 1;
+		memmove(&_entries[position], &_entries[position + 1], (_count - position) * sizeof(Entry));
+	}
+}
+
+MM_HeapLinkedFreeHeader *
+MM_LargeFreeEntryIndex::findBestFit(uintptr_t size, MM_HeapLinkedFreeHeader *excludeEntry)
+{
+	for (uintptr_t position = lowerBound(size, NULL); position < _count; position++) {
+		if (_entries[position].freeEntry != excludeEntry) {
+			return _entries[position].freeEntry;
+		}
+	}
+
+	return NULL;
+}
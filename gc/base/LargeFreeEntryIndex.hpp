@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(LARGEFREEENTRYINDEX_HPP_)
+#define LARGEFREEENTRYINDEX_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+
+#include "Base.hpp"
+#include "HeapLinkedFreeHeader.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * Size ordered index over the large entries of an address ordered free list, used to find the best fit
+ * for a large allocation without walking the list.
+ *
+ * Records are kept sorted by (size, address) in a fixed capacity array. The owning memory pool keeps the
+ * index in step with the free list for every change it makes while allocating, and invalidates it for
+ * any other change (sweep, expansion, contraction, LOA resizing...); an invalid index is rebuilt with a
+ * single walk of the free list the next time it is needed.
+ *
+ * If there are more large free entries than the index can hold, the smallest ones are dropped and the
+ * index is marked incomplete: any entry it returns is still a valid fit, but a miss no longer proves that
+ * no entry fits.
+ *
+ * @ingroup GC_Base_Core
+ */
+class MM_LargeFreeEntryIndex : public MM_Base
+{
+/*
+ * Data members
+ */
+public:
+	struct Entry {
+		uintptr_t size; /**< size of the free entry when it was recorded */
+		MM_HeapLinkedFreeHeader *freeEntry; /**< the free entry */
+	};
+
+private:
+	Entry *_entries; /**< records sorted by ascending size, then address */
+	uintptr_t _count; /**< number of records in use */
+	uintptr_t _capacity; /**< number of records allocated */
+	uintptr_t _threshold; /**< minimum size of a free entry to be recorded */
+	bool _valid; /**< false if the free list has changed without the index being updated */
+	bool _complete; /**< false if large free entries were dropped for lack of capacity */
+
+/*
+ * Function members
+ */
+private:
+	/**
+	 * @return position of the first record not less than (size, freeEntry)
+	 */
+	uintptr_t lowerBound(uintptr_t size, MM_HeapLinkedFreeHeader *freeEntry);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	static MM_LargeFreeEntryIndex *newInstance(MM_EnvironmentBase *env, uintptr_t capacity, uintptr_t threshold);
+	void kill(MM_EnvironmentBase *env);
+
+	MMINLINE uintptr_t getThreshold() { return _threshold; }
+	MMINLINE bool isValid() { return _valid; }
+	MMINLINE bool isComplete() { return _complete; }
+	MMINLINE void invalidate() { _valid = false; }
+
+	/**
+	 * Discard all records. The index stays invalid until the entries of the new free list have been
+	 * inserted and validate() is called.
+	 */
+	MMINLINE void clear()
+	{
+		_count = 0;
+		_complete = true;
+		_valid = false;
+	}
+
+	/**
+	 * Declare that every large entry of the free list has been inserted since clear().
+	 */
+	MMINLINE void validate() { _valid = true; }
+
+	/**
+	 * @return size of the largest recorded free entry, 0 if there is none
+	 */
+	MMINLINE uintptr_t getLargestSize() { return (0 == _count) ? 0 : _entries[_count - 1].size; }
+
+	/**
+	 * Discard all records and record every large entry of the given free list.
+	 * @param freeList head of the address ordered free list
+	 */
+	void rebuild(MM_HeapLinkedFreeHeader *freeList);
+
+	/**
+	 * Record a free entry. Entries smaller than the threshold are ignored.
+	 */
+	void insert(MM_HeapLinkedFreeHeader *freeEntry, uintptr_t size);
+
+	/**
+	 * Remove the record of a free entry, if there is one.
+	 * @param size the size the entry had when it was inserted
+	 */
+	void remove(MM_HeapLinkedFreeHeader *freeEntry, uintptr_t size);
+
+	/**
+	 * Find the smallest recorded free entry of at least the given size. Ties are broken by lowest address.
+	 * @param size minimum size of the free entry
+	 * @param excludeEntry an entry which must not be returned (may be NULL)
+	 * @return the free entry, or NULL if no recorded entry fits
+	 */
+	MM_HeapLinkedFreeHeader *findBestFit(uintptr_t size, MM_HeapLinkedFreeHeader *excludeEntry);
+
+	MM_LargeFreeEntryIndex(uintptr_t capacity, uintptr_t threshold)
+		: MM_Base()
+		, _entries(NULL)
+		, _count(0)
+		, _capacity(capacity)
+		, _threshold(threshold)
+		, _valid(false)
+		, _complete(true)
+	{
+	}
+};
+
+#endif /* LARGEFREEENTRYINDEX_HPP_ */
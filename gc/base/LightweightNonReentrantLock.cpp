@@ -39,11 +39,12 @@
  * @param env
  * @param options
  * @param name Lock name
+ * @param queued true to queue waiters in FIFO order, each spinning on its own cache line (ignored if custom spinlocks are not used)
  * @return TRUE on success
  * @note Creates a store barrier.
  */
 bool
-MM_LightweightNonReentrantLock::initialize(MM_EnvironmentBase *env, ModronLnrlOptions *options, const char * name)
+MM_LightweightNonReentrantLock::initialize(MM_EnvironmentBase *env, ModronLnrlOptions *options, const char * name, bool queued)
 {
 	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
 
@@ -86,12 +87,20 @@ MM_LightweightNonReentrantLock::initialize(MM_EnvironmentBase *env, ModronLnrlOp
 #endif
 
 #if defined(J9MODRON_USE_CUSTOM_SPINLOCKS)
-
-	_initialized = omrgc_spinlock_init(&_spinlock) ? false : true;
-
-	_spinlock.spinCount1 = options->spinCount1;
-	_spinlock.spinCount2 = options->spinCount2;
-	_spinlock.spinCount3 = options->spinCount3;
+	_queued = queued;
+	if (_queued) {
+		_initialized = omrgc_queued_spinlock_init(&_queuedSpinlock) ? false : true;
+
+		_queuedSpinlock.spinCount1 = options->spinCount1;
+		_queuedSpinlock.spinCount2 = options->spinCount2;
+		_queuedSpinlock.spinCount3 = options->spinCount3;
+	} else {
+		_initialized = omrgc_spinlock_init(&_spinlock) ? false : true;
+
+		_spinlock.spinCount1 = options->spinCount1;
+		_spinlock.spinCount2 = options->spinCount2;
+		_spinlock.spinCount3 = options->spinCount3;
+	}
 #else /* J9MODRON_USE_CUSTOM_SPINLOCKS */
 	_initialized = MUTEX_INIT(_mutex) ? true : false;
 #endif /* J9MODRON_USE_CUSTOM_SPINLOCKS */
@@ -130,7 +139,11 @@ MM_LightweightNonReentrantLock::tearDown()
 
 	if (_initialized) {
 #if defined(J9MODRON_USE_CUSTOM_SPINLOCKS)
-		omrgc_spinlock_destroy(&_spinlock);
+		if (_queued) {
+			omrgc_queued_spinlock_destroy(&_queuedSpinlock);
+		} else {
+			omrgc_spinlock_destroy(&_spinlock);
+		}
 #else /* J9MODRON_USE_CUSTOM_SPINLOCKS */
 		MUTEX_DESTROY(_mutex);
 #endif /* J9MODRON_USE_CUSTOM_SPINLOCKS */
@@ -54,7 +54,9 @@ private:
 	MM_GCExtensionsBase *_extensions; /**< cache extensions for use in teardown() */
 
 #if defined(J9MODRON_USE_CUSTOM_SPINLOCKS)
+	bool _queued; /**< true if waiters are queued in FIFO order (_queuedSpinlock) rather than competing for _spinlock */
 	J9GCSpinlock _spinlock;
+	J9GCQueuedSpinlock _queuedSpinlock;
 #else /* J9MODRON_USE_CUSTOM_SPINLOCKS */
 	MUTEX _mutex;
 #endif /* J9MODRON_USE_CUSTOM_SPINLOCKS */
@@ -68,7 +70,7 @@ private:
 protected:
 
 public:
-	bool initialize(MM_EnvironmentBase *env, ModronLnrlOptions *options, const char * name);
+	bool initialize(MM_EnvironmentBase *env, ModronLnrlOptions *options, const char * name, bool queued = false);
 	void tearDown() ;
 
 	/**
@@ -83,7 +85,11 @@ public:
 	MMINLINE bool acquire() 
 	{
 #if defined(J9MODRON_USE_CUSTOM_SPINLOCKS)
-		omrgc_spinlock_acquire(&_spinlock, _tracing);
+		if (_queued) {
+			omrgc_queued_spinlock_acquire(&_queuedSpinlock, _tracing);
+		} else {
+			omrgc_spinlock_acquire(&_spinlock, _tracing);
+		}
 #else /* J9MODRON_USE_CUSTOM_SPINLOCKS */
 		MUTEX_ENTER(_mutex);
 #endif /* J9MODRON_USE_CUSTOM_SPINLOCKS */
@@ -101,7 +107,11 @@ public:
 	MMINLINE bool release() 
 	{
 #if defined(J9MODRON_USE_CUSTOM_SPINLOCKS)
-		omrgc_spinlock_release(&_spinlock);
+		if (_queued) {
+			omrgc_queued_spinlock_release(&_queuedSpinlock);
+		} else {
+			omrgc_spinlock_release(&_spinlock);
+		}
 #else /* J9MODRON_USE_CUSTOM_SPINLOCKS */
 		MUTEX_EXIT(_mutex);
 #endif /* J9MODRON_USE_CUSTOM_SPINLOCKS */
@@ -113,6 +123,9 @@ public:
 		_initialized(false),
 		_tracing(NULL),
 		_extensions(NULL)
+#if defined(J9MODRON_USE_CUSTOM_SPINLOCKS)
+		,_queued(false)
+#endif /* J9MODRON_USE_CUSTOM_SPINLOCKS */
 	{
 		_typeId = __FUNCTION__;
 	};
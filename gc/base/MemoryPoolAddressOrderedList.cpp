@@ -116,7 +116,7 @@ MM_MemoryPoolAddressOrderedList::initialize(MM_EnvironmentBase *env)
 	 * Tenure SubSpace for Flat will leave _largeObjectCollectorAllocateStats at NULL (no interest in Colletor stats)
 	 */
 	 
-	if (!_heapLock.initialize(env, &ext->lnrlOptions, "MM_MemoryPoolAddressOrderedList:_heapLock")) {
+	if (!_heapLock.initialize(env, &ext->lnrlOptions, "MM_MemoryPoolAddressOrderedList:_heapLock", ext->queuedHeapLocks)) {
 		return false;
 	}
 
@@ -124,6 +124,14 @@ MM_MemoryPoolAddressOrderedList::initialize(MM_EnvironmentBase *env)
 		return false;
 	}
 
+	/* Concurrent sweep connects free entries behind the pool's back while mutators allocate, so the index can not be kept in step */
+	if ((0 != ext->largeObjectBestFitThreshold) && !ext->isConcurrentSweepEnabled()) {
+		_largeFreeEntryIndex = MM_LargeFreeEntryIndex::newInstance(env, ext->largeObjectBestFitIndexCapacity, OMR_MAX(ext->largeObjectBestFitThreshold, _minimumFreeEntrySize));
+		if (NULL == _largeFreeEntryIndex) {
+			return false;
+		}
+	}
+
 	_hintActive = NULL;
 	_hintLru = 0;
 
@@ -183,6 +191,11 @@ MM_MemoryPoolAddressOrderedList::tearDown(MM_EnvironmentBase *env)
 	
 	_largeObjectCollectorAllocateStats = NULL;
 
+	if (NULL != _largeFreeEntryIndex) {
+		_largeFreeEntryIndex->kill(env);
+		_largeFreeEntryIndex = NULL;
+	}
+
 	_heapLock.tearDown();
 	_resetLock.tearDown();
 }
@@ -414,6 +427,42 @@ MM_MemoryPoolAddressOrderedList::updateHintsBeyondEntry(MM_HeapLinkedFreeHeader
  * Allocation
  ****************************************
  */
+void *
+MM_MemoryPoolAddressOrderedList::allocateBestFit(MM_EnvironmentBase *env, uintptr_t sizeInBytesRequired, bool &indexMiss)
+{
+	if (!_largeFreeEntryIndex->isValid()) {
+		_largeFreeEntryIndex->rebuild(_heapFreeList);
+	}
+
+	/* The top of the free entry is allocated, so what is left has to remain large enough to stay on the free list */
+	MM_HeapLinkedFreeHeader *freeEntry = _largeFreeEntryIndex->findBestFit(sizeInBytesRequired + _minimumFreeEntrySize, NULL);
+	if ((NULL != freeEntry) && (NULL == freeEntry->getNext())) {
+		/* Leave the top of the last free entry to the address ordered walk, to keep the end of the pool free for contraction */
+		freeEntry = _largeFreeEntryIndex->findBestFit(sizeInBytesRequired + _minimumFreeEntrySize, freeEntry);
+	}
+
+	if (NULL == freeEntry) {
+		indexMiss = _largeFreeEntryIndex->isComplete() && (_largeFreeEntryIndex->getLargestSize() < sizeInBytesRequired);
+		return NULL;
+	}
+
+	uintptr_t freeEntrySize = freeEntry->getSize();
+	uintptr_t remainingSize = freeEntrySize - sizeInBytesRequired;
+	void *addrBase = (void *)(((uint8_t *)freeEntry) + remainingSize);
+
+	freeEntry->setSize(remainingSize);
+	updateLargeFreeEntryIndex(freeEntry, freeEntrySize, freeEntry, remainingSize);
+	_largeObjectAllocateStats->decrementFreeEntrySizeClassStats(freeEntrySize);
+	_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(remainingSize);
+
+	/* Adjust the free memory size and update allocation statistics (no free entries were walked) */
+	_freeMemorySize -= sizeInBytesRequired;
+	_allocCount += 1;
+	_allocBytes += sizeInBytesRequired;
+
+	return addrBase;
+}
+
 MMINLINE void *
 MM_MemoryPoolAddressOrderedList::internalAllocate(MM_EnvironmentBase *env, uintptr_t sizeInBytesRequired, bool lockingRequired, MM_LargeObjectAllocateStats *largeObjectAllocateStats)
 {
@@ -424,7 +473,16 @@ MM_MemoryPoolAddressOrderedList::internalAllocate(MM_EnvironmentBase *env, uintp
 	J9ModronAllocateHint *allocateHintUsed;
 	void *addrBase;
 	uintptr_t largestFreeEntry = 0;
-	
+	uintptr_t currentFreeEntrySize = 0;
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uint64_t allocateStartTime = 0;
+	bool recordLatency = (NULL != largeObjectAllocateStats) && (sizeInBytesRequired >= largeObjectAllocateStats->getLargeObjectThreshold());
+
+	if (recordLatency) {
+		/* latency includes waiting for the heap lock */
+		allocateStartTime = omrtime_hires_clock();
+	}
+
 	if (lockingRequired) {
 		_heapLock.acquire();
 	}
@@ -433,6 +491,22 @@ MM_MemoryPoolAddressOrderedList::internalAllocate(MM_EnvironmentBase *env, uintp
 retry:
 #endif /* OMR_GC_CONCURRENT_SWEEP */
 
+	if ((NULL != _largeFreeEntryIndex) && (sizeInBytesRequired >= _largeFreeEntryIndex->getThreshold())) {
+		bool indexMiss = false;
+		addrBase = allocateBestFit(env, sizeInBytesRequired, indexMiss);
+		if (NULL != addrBase) {
+			goto allocated;
+		}
+		if (indexMiss) {
+			/* every free entry of at least the threshold is in the index, so there is no point walking the list */
+			largestFreeEntry = _largeFreeEntryIndex->getLargestSize();
+			if (0 == largestFreeEntry) {
+				largestFreeEntry = _largeFreeEntryIndex->getThreshold() - 1;
+			}
+			goto fail_allocate;
+		}
+	}
+
 	currentFreeEntry = _heapFreeList;
 	previousFreeEntry = NULL;
 	walkCount = 0;
@@ -447,7 +521,7 @@ retry:
 	}
 
 	while(currentFreeEntry) {
-		uintptr_t currentFreeEntrySize = currentFreeEntry->getSize();
+		currentFreeEntrySize = currentFreeEntry->getSize();
 		/* while we are walking, keep track of the largest free entry.  We will need this in the case of allocation failure to update the pool's largest free */
 		if (currentFreeEntrySize > largestFreeEntry) {
 			largestFreeEntry = currentFreeEntrySize;
@@ -472,6 +546,7 @@ retry:
 	if(!currentFreeEntry) {
 #if defined(OMR_GC_CONCURRENT_SWEEP)
 		if(_memorySubSpace->replenishPoolForAllocate(env, this, sizeInBytesRequired)) {
+			invalidateLargeFreeEntryIndex();
 			goto retry;
 		}
 #endif /* OMR_GC_CONCURRENT_SWEEP */
@@ -499,6 +574,7 @@ retry:
 
 	if (recycleHeapChunk(recycleEntry, ((uint8_t *)recycleEntry) + recycleEntrySize, previousFreeEntry, currentFreeEntry->getNext())) {
 		updateHint(currentFreeEntry, recycleEntry);
+		updateLargeFreeEntryIndex(currentFreeEntry, currentFreeEntrySize, recycleEntry, recycleEntrySize);
 		_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(recycleEntrySize);
 	} else {
 		/* Adjust the free memory size and count */
@@ -510,11 +586,16 @@ retry:
 
 		/* Removed from the free list - Kill the hint if necessary */
 		removeHint(currentFreeEntry);
+		updateLargeFreeEntryIndex(currentFreeEntry, currentFreeEntrySize, NULL, 0);
 	}
-	
+
+allocated:
 	/* Collector object allocate stats for Survivor are not interesting (_largeObjectCollectorAllocateStats is null for Survivor) */	
 	if (NULL != largeObjectAllocateStats) {
 		largeObjectAllocateStats->allocateObject(sizeInBytesRequired);
+		if (recordLatency) {
+			largeObjectAllocateStats->recordAllocateLatency(omrtime_hires_delta(allocateStartTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_NANOSECONDS));
+		}
 	}
 
 	if(lockingRequired) {
@@ -632,8 +713,10 @@ retry:
 		topOfRecycledChunk = ((uint8_t *)addrTop) + recycleEntrySize;
 		/* Recycle the remaining entry back onto the free list (if applicable) */
 		if (recycleHeapChunk(addrTop, topOfRecycledChunk, NULL, entryNext)) {
+			updateLargeFreeEntryIndex(freeEntry, freeEntrySize, (MM_HeapLinkedFreeHeader *)addrTop, recycleEntrySize);
 			_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(recycleEntrySize);
 		} else {
+			updateLargeFreeEntryIndex(freeEntry, freeEntrySize, NULL, 0);
 			/* Adjust the free memory size and count */
 			_freeMemorySize -= recycleEntrySize;
 			_freeEntryCount -= 1;
@@ -641,6 +724,7 @@ retry:
 			_allocDiscardedBytes += recycleEntrySize;
 		}
 	} else {
+		updateLargeFreeEntryIndex(freeEntry, freeEntrySize, NULL, 0);
 		/* If not recycling just update the free list pointer to the next free entry */
 		_heapFreeList = entryNext;
 		/* also update the freeEntryCount as recycleHeapChunk would do this */
@@ -714,6 +798,10 @@ MM_MemoryPoolAddressOrderedList::reset(Cause cause)
 	MM_MemoryPool::reset(cause);
 
 	clearHints();
+	if (NULL != _largeFreeEntryIndex) {
+		/* Emptied so that sweep can record the entries of the new free list */
+		_largeFreeEntryIndex->clear();
+	}
 	_heapFreeList = (MM_HeapLinkedFreeHeader *)NULL;
 
 	_lastFreeEntry = NULL;
@@ -721,6 +809,17 @@ MM_MemoryPoolAddressOrderedList::reset(Cause cause)
 	resetLargeObjectAllocateStats();
 }
 
+void
+MM_MemoryPoolAddressOrderedList::recordSweptFreeEntry(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t size)
+{
+	if (NULL != _largeFreeEntryIndex) {
+		/* Sweeping threads record entries concurrently, and nothing allocates from the pool during sweep */
+		_heapLock.acquire();
+		_largeFreeEntryIndex->insert(freeEntry, size);
+		_heapLock.release();
+	}
+}
+
 /**
  * As opposed to reset, which will empty out, this will fill out as if everything is free.
  * Returns the freelist entry created at the end of the given region
@@ -806,6 +905,8 @@ MM_MemoryPoolAddressOrderedList::expandWithRange(MM_EnvironmentBase *env, uintpt
 		return ;
 	}
 
+	invalidateLargeFreeEntryIndex();
+
 	/* Find the free entries in the list the appear before/after the range being added */
 	previousFreeEntry = NULL;
 	nextFreeEntry = _heapFreeList;
@@ -910,6 +1011,8 @@ MM_MemoryPoolAddressOrderedList::contractWithRange(MM_EnvironmentBase *env, uint
 		return NULL;
 	}
 
+	invalidateLargeFreeEntryIndex();
+
 	/* Find the free entry that encompasses the range to contract */
 	/* TODO: Could we use hints to find a better starting address?  Are hints still valid? */
 	previousFreeEntry = NULL;
@@ -1002,6 +1105,8 @@ MM_MemoryPoolAddressOrderedList::addFreeEntries(MM_EnvironmentBase *env,
 		currentFreeEntry = currentFreeEntry->getNext();
 	}
 
+	invalidateLargeFreeEntryIndex();
+
 	/* Find the first free entry, if any, within specified range */
 	MM_HeapLinkedFreeHeader *previousFreeEntry = NULL;
 	currentFreeEntry = _heapFreeList;
@@ -1094,6 +1199,8 @@ MM_MemoryPoolAddressOrderedList::removeFreeEntriesWithinRange(MM_EnvironmentBase
 	retListMemoryCount = 0;
 	retListMemorySize = 0;
 
+	invalidateLargeFreeEntryIndex();
+
 	/* Find the first free entry, if any, within specified range */
 	previousFreeEntry = NULL;
 	currentFreeEntry = _heapFreeList;
@@ -1448,6 +1555,8 @@ MM_MemoryPoolAddressOrderedList::moveHeap(MM_EnvironmentBase *env, void *srcBase
 {
 	MM_HeapLinkedFreeHeader *currentFreeEntry, *previousFreeEntry;
 
+	invalidateLargeFreeEntryIndex();
+
 	previousFreeEntry = NULL;
 	currentFreeEntry = _heapFreeList;
 	while(currentFreeEntry) {
@@ -1530,6 +1639,7 @@ MM_MemoryPoolAddressOrderedList::recycleHeapChunk(void* chunkBase, void* chunkTo
 		_freeMemorySize += chunkSize;
 		_freeEntryCount += 1;
 		_largeObjectAllocateStats->incrementFreeEntrySizeClassStats(chunkSize);
+		updateLargeFreeEntryIndex(NULL, 0, (MM_HeapLinkedFreeHeader *)chunkBase, chunkSize);
 	}
 
 	_heapLock.release();
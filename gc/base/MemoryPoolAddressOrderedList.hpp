@@ -28,6 +28,7 @@
 #include "modronopt.h"
 
 #include "HeapLinkedFreeHeader.hpp"
+#include "LargeFreeEntryIndex.hpp"
 #include "LightweightNonReentrantLock.hpp"
 #include "MemoryPoolAddressOrderedListBase.hpp"
 #include "HeapRegionDescriptor.hpp"
@@ -57,6 +58,8 @@ private:
 	struct J9ModronAllocateHint* _hintInactive;
 	struct J9ModronAllocateHint _hintStorage[HINT_ELEMENT_COUNT];
 	uintptr_t _hintLru;
+
+	MM_LargeFreeEntryIndex *_largeFreeEntryIndex; /**< best fit index of the large free entries (NULL if disabled) */
 	
 	MM_LargeObjectAllocateStats *_largeObjectCollectorAllocateStats;  /**< Same as _largeObjectAllocateStats except specifically for collector allocates */
 
@@ -73,6 +76,31 @@ private:
 	void updateHint(MM_HeapLinkedFreeHeader *oldFreeEntry, MM_HeapLinkedFreeHeader *newFreeEntry);
 	void clearHints();
 	void updateHintsBeyondEntry(MM_HeapLinkedFreeHeader *freeEntry);
+
+	/**
+	 * Note that the free list has been changed by something other than allocation. The best fit index
+	 * is rebuilt the next time it is used.
+	 */
+	MMINLINE void invalidateLargeFreeEntryIndex()
+	{
+		if (NULL != _largeFreeEntryIndex) {
+			_largeFreeEntryIndex->invalidate();
+		}
+	}
+	MMINLINE void updateLargeFreeEntryIndex(MM_HeapLinkedFreeHeader *oldFreeEntry, uintptr_t oldSize, MM_HeapLinkedFreeHeader *newFreeEntry, uintptr_t newSize)
+	{
+		if ((NULL != _largeFreeEntryIndex) && _largeFreeEntryIndex->isValid()) {
+			_largeFreeEntryIndex->remove(oldFreeEntry, oldSize);
+			_largeFreeEntryIndex->insert(newFreeEntry, newSize);
+		}
+	}
+	/**
+	 * Satisfy a large allocation from the best fitting free entry, found with the size ordered index.
+	 * The object is carved from the top of the free entry, so the entry keeps its place in the free list.
+	 * @param[out] indexMiss set to true if the index proves that no free entry is large enough
+	 * @return the allocated memory, or NULL if the allocation has to be satisfied by walking the free list
+	 */
+	void *allocateBestFit(MM_EnvironmentBase *env, uintptr_t sizeInBytesRequired, bool &indexMiss);
 	void *internalAllocate(MM_EnvironmentBase *env, uintptr_t sizeInBytesRequired, bool lockingRequired, MM_LargeObjectAllocateStats *largeObjectAllocateStats);
 	bool internalAllocateTLH(MM_EnvironmentBase *env, uintptr_t maximumSizeInBytesRequired, void * &addrBase, void * &addrTop, bool lockingRequired, MM_LargeObjectAllocateStats *largeObjectAllocateStats);
 
@@ -95,6 +123,18 @@ public:
 	virtual void tearDown(MM_EnvironmentBase *env);
 
 	virtual void reset(Cause cause = any);
+	virtual void recordSweptFreeEntry(MM_EnvironmentBase *env, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t size);
+
+	/**
+	 * Sweep has built the free list, and recorded all its large entries in the (empty since reset) best fit
+	 * index, so the index is up to date without a walk of the free list.
+	 */
+	MMINLINE void sweptFreeEntriesRecorded(MM_EnvironmentBase *env)
+	{
+		if (NULL != _largeFreeEntryIndex) {
+			_largeFreeEntryIndex->validate();
+		}
+	}
 	virtual MM_HeapLinkedFreeHeader *rebuildFreeListInRegion(MM_EnvironmentBase *env, MM_HeapRegionDescriptor *region, MM_HeapLinkedFreeHeader *previousFreeEntry);
 
 #if defined(DEBUG)
@@ -152,6 +192,7 @@ public:
 	MM_MemoryPoolAddressOrderedList(MM_EnvironmentBase *env, uintptr_t minimumFreeEntrySize) :
 		MM_MemoryPoolAddressOrderedListBase(env, minimumFreeEntrySize)
 		,_heapFreeList(NULL)
+		,_largeFreeEntryIndex(NULL)
 		,_largeObjectCollectorAllocateStats(NULL)
 	{
 		_typeId = __FUNCTION__;
@@ -160,6 +201,7 @@ public:
 	MM_MemoryPoolAddressOrderedList(MM_EnvironmentBase *env, uintptr_t minimumFreeEntrySize, const char *name) :
 		MM_MemoryPoolAddressOrderedListBase(env, minimumFreeEntrySize, name)
 		,_heapFreeList(NULL)
+		,_largeFreeEntryIndex(NULL)
 		,_largeObjectCollectorAllocateStats(NULL)
 	{
 		_typeId = __FUNCTION__;
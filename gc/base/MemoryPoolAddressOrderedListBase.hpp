@@ -206,6 +206,12 @@ public:
 
 	virtual bool createFreeEntry(MM_EnvironmentBase* env, void* addrBase, void* addrTop);
 
+	/**
+	 * Note a large free entry of the free list being built by sweep. Called, possibly in parallel, once for
+	 * every entry at least as large as the best fit threshold, when its size is final.
+	 */
+	virtual void recordSweptFreeEntry(MM_EnvironmentBase* env, MM_HeapLinkedFreeHeader* freeEntry, uintptr_t size) {}
+
 
 
 	MMINLINE bool abandonHeapChunk(void *addrBase, void *addrTop)
@@ -56,7 +56,7 @@
 bool
 J9ModronFreeList::initialize(MM_EnvironmentBase* env)
 {
-	if (!_lock.initialize(env, &env->getExtensions()->lnrlOptions, "J9ModronFreeList:_lock")) {
+	if (!_lock.initialize(env, &env->getExtensions()->lnrlOptions, "J9ModronFreeList:_lock", env->getExtensions()->queuedHeapLocks)) {
 		return false;
 	}
 
@@ -216,6 +216,17 @@ public:
 		return _delegate.getObjectSizeInBytesWithHeader(objectPtr);
 	}
 
+	/**
+	 * Returns the language defined key identifying the type of an object.
+	 * @param objectPtr Pointer to an initialized object
+	 * @return The type key of the object (0 if the language does not distinguish types)
+	 */
+	MMINLINE uintptr_t
+	getObjectTypeKey(omrobjectptr_t objectPtr)
+	{
+		return _delegate.getObjectTypeKey(objectPtr);
+	}
+
 	/**
 	 * Determine the total size of an object, in bytes, including padding bytes added to bring tail
 	 * of object into heap alignment (see GC_ObjectModelBase::adjustSizeInBytes()). If the object has
@@ -234,6 +245,20 @@ public:
 		return adjustSizeInBytes(getSizeInBytesWithHeader(objectPtr));
 	}
 
+	/**
+	 * Determine the total size of an object that has been copied, in bytes, as it was before the copy.
+	 * The size is read from the copy, so languages whose objects grow when moved must override this to
+	 * subtract the growth. OMR objects do not grow, so the consumed size of the copy is returned.
+	 *
+	 * @param[in] objectPtr points to the copy of the object
+	 * @return the total size of the original object, in bytes, including padding bytes
+	 */
+	MMINLINE uintptr_t
+	getConsumedSizeInBytesWithHeaderBeforeMove(omrobjectptr_t objectPtr)
+	{
+		return getConsumedSizeInBytesWithHeader(objectPtr);
+	}
+
 	/**
 	 * Determine the total footprint of an object, in bytes, including padding bytes added to bring tail
 	 * of object into heap alignment (see GC_ObjectModelBase::adjustSizeInBytes()). If the object has
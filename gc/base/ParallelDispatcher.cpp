@@ -35,6 +35,7 @@
 #include "CollectorLanguageInterfaceImpl.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
+#include "GCTimeline.hpp"
 #include "Heap.hpp"
 #include "Task.hpp"
 
@@ -167,7 +168,9 @@ MM_ParallelDispatcher::slaveEntryPoint(MM_EnvironmentBase *env)
 			acceptTask(env);
 			omrthread_monitor_exit(_slaveThreadMutex);	
 
+			MM_GCTimeline::recordBegin(env, env->_currentTask->getBaseVirtualTypeId());
 			env->_currentTask->run(env);
+			MM_GCTimeline::recordEnd(env, env->_currentTask->getBaseVirtualTypeId());
 
 			omrthread_monitor_enter(_slaveThreadMutex);
 			/* Returned from task - do clean up work from dispatch */
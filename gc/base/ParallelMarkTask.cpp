@@ -30,6 +30,7 @@
 #include "ParallelMarkTask.hpp"
 
 #include "EnvironmentBase.hpp"
+#include "GCTimeline.hpp"
 #include "MarkingScheme.hpp"
 #include "WorkStack.hpp"
 
@@ -45,10 +46,18 @@ MM_ParallelMarkTask::run(MM_EnvironmentBase *env)
 {
 	env->_workStack.prepareForWork(env, (MM_WorkPackets *)(_markingScheme->getWorkPackets()));
 
+	MM_GCTimeline::recordBegin(env, "mark init");
 	_markingScheme->markLiveObjectsInit(env, _initMarkMap);
+	MM_GCTimeline::recordEnd(env, "mark init");
+	MM_GCTimeline::recordBegin(env, "mark roots");
 	_markingScheme->markLiveObjectsRoots(env);
+	MM_GCTimeline::recordEnd(env, "mark roots");
+	MM_GCTimeline::recordBegin(env, "mark scan");
 	_markingScheme->markLiveObjectsScan(env);
+	MM_GCTimeline::recordEnd(env, "mark scan");
+	MM_GCTimeline::recordBegin(env, "mark complete");
 	_markingScheme->markLiveObjectsComplete(env);
+	MM_GCTimeline::recordEnd(env, "mark complete");
 
 	env->_workStack.flush(env);
 }
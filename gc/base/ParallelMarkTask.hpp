@@ -44,7 +44,7 @@ class MM_MarkingScheme;
  */
 class MM_ParallelMarkTask : public MM_ParallelTask
 {
-private:
+protected:
 	MM_MarkingScheme *_markingScheme;
 	const bool _initMarkMap;
 	MM_CycleState *_cycleState;  /**< Collection cycle state active for the task */
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#include "ParallelPrefaultTask.hpp"
+
+#include "AtomicOperations.hpp"
+#include "Dispatcher.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Math.hpp"
+#include "MemoryManager.hpp"
+#include "NUMAManager.hpp"
+
+/**
+ * Size of the unit of work handed to a single thread while prefaulting.  Also the granularity of the NUMA interleaving.
+ */
+#define PREFAULT_CHUNK_SIZE ((uintptr_t)4 * 1024 * 1024)
+
+void
+MM_ParallelPrefaultTask::run(MM_EnvironmentBase *env)
+{
+	uintptr_t chunkCount = MM_Math::roundToCeiling(_chunkSize, (uintptr_t)_highAddress - (uintptr_t)_lowAddress) / _chunkSize;
+	for (uintptr_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++) {
+		if (J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+			prefaultChunk(env, chunkIndex);
+		}
+	}
+}
+
+void
+MM_ParallelPrefaultTask::prefaultRange(MM_EnvironmentBase *env)
+{
+	uintptr_t chunkCount = MM_Math::roundToCeiling(_chunkSize, (uintptr_t)_highAddress - (uintptr_t)_lowAddress) / _chunkSize;
+	for (uintptr_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++) {
+		prefaultChunk(env, chunkIndex);
+	}
+}
+
+void
+MM_ParallelPrefaultTask::prefaultChunk(MM_EnvironmentBase *env, uintptr_t chunkIndex)
+{
+	uint8_t *chunkBase = (uint8_t *)_lowAddress + (chunkIndex * _chunkSize);
+	uint8_t *chunkTop = OMR_MIN(chunkBase + _chunkSize, (uint8_t *)_highAddress);
+
+#if defined(OMR_GC_VLHGC) || defined(OMR_GC_MODRON_SCAVENGER)
+	if (0 != _numaNodeCount) {
+		/* Binding has to happen before the first touch to have any effect.  It is only a placement hint so failure is not fatal */
+		uintptr_t j9NodeNumber = _numaNodes[chunkIndex % _numaNodeCount].j9NodeNumber;
+		env->getExtensions()->memoryManager->setNumaAffinity(_memoryHandle, j9NodeNumber, chunkBase, chunkTop - chunkBase);
+	}
+#endif /* defined(OMR_GC_VLHGC) || defined(OMR_GC_MODRON_SCAVENGER) */
+
+	/* A deferred range may already hold objects and be written concurrently, so the page is faulted in for
+	 * writing by an atomic add of zero, which can not lose a racing store.
+	 */
+	for (uint8_t *page = chunkBase; page < chunkTop; page += _pageSize) {
+		MM_AtomicOperations::add((volatile uintptr_t *)page, 0);
+	}
+}
+
+void
+MM_ParallelPrefaultTask::dispatchPrefault(MM_EnvironmentBase *env, const MM_MemoryHandle *memoryHandle, void *lowAddress, void *highAddress, uintptr_t pageSize)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	J9MemoryNodeDetail const *numaNodes = NULL;
+	uintptr_t numaNodeCount = 0;
+
+	if ((NULL != memoryHandle) && extensions->_numaManager.isPhysicalNUMASupported()) {
+		numaNodes = extensions->_numaManager.getAffinityLeaders(&numaNodeCount);
+		if (numaNodeCount < 2) {
+			/* nothing to interleave across */
+			numaNodes = NULL;
+			numaNodeCount = 0;
+		}
+	}
+
+	uintptr_t chunkSize = MM_Math::roundToCeiling(pageSize, PREFAULT_CHUNK_SIZE);
+	MM_ParallelPrefaultTask prefaultTask(env, extensions->dispatcher, lowAddress, highAddress, pageSize, chunkSize, memoryHandle, numaNodes, numaNodeCount);
+
+	if ((NULL != extensions->dispatcher) && (NULL == env->_currentTask)) {
+		extensions->dispatcher->run(env, &prefaultTask);
+	} else {
+		prefaultTask.prefaultRange(env);
+	}
+}
+
+void
+MM_ParallelPrefaultTask::prefault(MM_EnvironmentBase *env, const MM_MemoryHandle *memoryHandle, void *lowAddress, void *highAddress, uintptr_t pageSize)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	/* A task can not be dispatched from within another one (e.g. expansion of tenure from inside a scavenge),
+	 * so the range waits for the dispatcher to finish the running task. Only when too many ranges are
+	 * waiting does the calling thread touch the range itself.
+	 */
+	if ((NULL != extensions->dispatcher) && (NULL != env->_currentTask)) {
+		uintptr_t index = MM_AtomicOperations::add(&extensions->deferredPrefaultRangeCount, 1) - 1;
+		if (index < MAX_DEFERRED_PREFAULT_RANGES) {
+			MM_DeferredPrefaultRange *range = &extensions->deferredPrefaultRanges[index];
+			range->memoryHandle = memoryHandle;
+			range->lowAddress = lowAddress;
+			range->highAddress = highAddress;
+			range->pageSize = pageSize;
+			return;
+		}
+	}
+
+	dispatchPrefault(env, memoryHandle, lowAddress, highAddress, pageSize);
+}
+
+void
+MM_ParallelPrefaultTask::prefaultDeferredRanges(MM_EnvironmentBase *env)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	uintptr_t count = OMR_MIN(extensions->deferredPrefaultRangeCount, (uintptr_t)MAX_DEFERRED_PREFAULT_RANGES);
+	if (0 == count) {
+		return;
+	}
+
+	/* Take the ranges before dispatching, since each prefault task will call back in here when it completes */
+	MM_DeferredPrefaultRange ranges[MAX_DEFERRED_PREFAULT_RANGES];
+	for (uintptr_t i = 0; i < count; i++) {
+		ranges[i] = extensions->deferredPrefaultRanges[i];
+	}
+	extensions->deferredPrefaultRangeCount = 0;
+
+	for (uintptr_t i = 0; i < count; i++) {
+		dispatchPrefault(env, ranges[i].memoryHandle, ranges[i].lowAddress, ranges[i].highAddress, ranges[i].pageSize);
+	}
+}
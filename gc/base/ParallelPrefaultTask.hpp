@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Base
+ */
+
+#if !defined(PARALLELPREFAULTTASK_HPP_)
+#define PARALLELPREFAULTTASK_HPP_
+
+#include "omrcfg.h"
+#include "omrmodroncore.h"
+#include "omrport.h"
+
+#include "ParallelTask.hpp"
+
+class MM_Dispatcher;
+class MM_EnvironmentBase;
+class MM_MemoryHandle;
+
+/**
+ * Touch every page of a freshly committed heap range so that the page faults are taken by GC threads
+ * during the resize rather than by mutator threads when they first allocate into the range.
+ * The range is split into fixed size chunks which are claimed as work units.  When physical NUMA is
+ * enabled, each chunk is bound round robin to the affinity leader nodes before it is touched.
+ * @ingroup GC_Base
+ */
+class MM_ParallelPrefaultTask : public MM_ParallelTask
+{
+	/*
+	 * Data members
+	 */
+private:
+	void *_lowAddress; /**< base of the range to prefault */
+	void *_highAddress; /**< top (exclusive) of the range to prefault */
+	uintptr_t _pageSize; /**< stride between touched words */
+	uintptr_t _chunkSize; /**< size of the work unit claimed by each thread (multiple of the page size) */
+	const MM_MemoryHandle *_memoryHandle; /**< handle of the memory backing the range, NULL if the chunks must not be NUMA bound */
+	J9MemoryNodeDetail const *_numaNodes; /**< affinity leader nodes the chunks are interleaved across */
+	uintptr_t _numaNodeCount; /**< number of entries in _numaNodes (0 for no interleaving) */
+
+	/*
+	 * Function members
+	 */
+private:
+	void prefaultChunk(MM_EnvironmentBase *env, uintptr_t chunkIndex);
+
+	/**
+	 * Prefault the given range on the dispatcher threads, or on the calling thread if they are not available to it.
+	 */
+	static void dispatchPrefault(MM_EnvironmentBase *env, const MM_MemoryHandle *memoryHandle, void *lowAddress, void *highAddress, uintptr_t pageSize);
+
+public:
+	virtual uintptr_t getVMStateID() { return OMRVMSTATE_GC_PERFORM_RESIZE; };
+
+	virtual void run(MM_EnvironmentBase *env);
+
+	/**
+	 * Touch every chunk of the range on the calling thread.  Used when the dispatcher can not be
+	 * used (e.g. there is no dispatcher, or too many ranges were deferred from within another task).
+	 */
+	void prefaultRange(MM_EnvironmentBase *env);
+
+	/**
+	 * Prefault the given range in parallel.  A range committed from within another task is deferred
+	 * until the dispatcher has completed that task.
+	 * @param memoryHandle handle of the memory backing the range, or NULL to skip NUMA interleaving
+	 * @param pageSize page size of the memory backing the range
+	 */
+	static void prefault(MM_EnvironmentBase *env, const MM_MemoryHandle *memoryHandle, void *lowAddress, void *highAddress, uintptr_t pageSize);
+
+	/**
+	 * Prefault, in parallel, the ranges deferred while the task just completed by the dispatcher was running.
+	 * Called by the dispatcher once the task's threads are released.
+	 */
+	static void prefaultDeferredRanges(MM_EnvironmentBase *env);
+
+	MM_ParallelPrefaultTask(MM_EnvironmentBase *env, MM_Dispatcher *dispatcher, void *lowAddress, void *highAddress, uintptr_t pageSize, uintptr_t chunkSize, const MM_MemoryHandle *memoryHandle, J9MemoryNodeDetail const *numaNodes, uintptr_t numaNodeCount) :
+		MM_ParallelTask(env, dispatcher)
+		,_lowAddress(lowAddress)
+		,_highAddress(highAddress)
+		,_pageSize(pageSize)
+		,_chunkSize(chunkSize)
+		,_memoryHandle(memoryHandle)
+		,_numaNodes(numaNodes)
+		,_numaNodeCount(numaNodeCount)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* PARALLELPREFAULTTASK_HPP_ */
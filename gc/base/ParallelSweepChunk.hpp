@@ -40,6 +40,12 @@
 class MM_MemoryPool;
 class MM_HeapLinkedFreeHeader;
 
+/**
+ * Maximum number of free entries a chunk can link to their successor when it is connected: the trailing
+ * free entry of the previous chunk, its own leading free entry and the tail of the previous free list.
+ */
+#define PARALLEL_SWEEP_CHUNK_MAX_CONNECT_RECORDS 3
+
 /**
  * @todo Provide class documentation
  * @ingroup GC_Base
@@ -84,6 +90,16 @@ public:
 	uintptr_t _accumulatedFreeSize;
 	uintptr_t _accumulatedFreeHoles;
 
+	/* Free list writes deferred while connecting, see MM_SweepPoolManager::planConnectChunk() */
+	struct ConnectRecord {
+		void *freeEntry; /**< free entry to build */
+		uintptr_t size; /**< final size of the free entry */
+		void *nextFreeEntry; /**< next entry of the free list */
+	} _connectRecords[PARALLEL_SWEEP_CHUNK_MAX_CONNECT_RECORDS];
+	uintptr_t _connectRecordCount; /**< number of entries of _connectRecords in use */
+	void *_abandonCandidate; /**< free memory too small for the free list, to be abandoned (NULL if none) */
+	uintptr_t _abandonCandidateSize; /**< size of _abandonCandidate */
+
 	/**
 	 * clear the Chunk object.
 	 */	
@@ -147,7 +163,10 @@ public:
 		_splitCandidate(NULL),
 		_splitCandidatePreviousEntry(NULL),
 		_accumulatedFreeSize(0),
-		_accumulatedFreeHoles(0)
+		_accumulatedFreeHoles(0),
+		_connectRecordCount(0),
+		_abandonCandidate(NULL),
+		_abandonCandidateSize(0)
 	{
 		_typeId = __FUNCTION__;
 	};
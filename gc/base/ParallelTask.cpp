@@ -30,6 +30,7 @@
 #include "AtomicOperations.hpp"
 #include "Dispatcher.hpp"
 #include "EnvironmentBase.hpp"
+#include "GCTimeline.hpp"
 
 #include "ModronAssertions.h"
 
@@ -75,6 +76,7 @@ MM_ParallelTask::synchronizeGCThreads(MM_EnvironmentBase *env, const char *id)
 {
 	Trc_MM_SynchronizeGCThreads_Entry(env->getLanguageVMThread(), id);
 	env->_lastSyncPointReached = id;
+	MM_GCTimeline::recordBegin(env, id);
 	
 	if(1 < _totalThreadCount) {
 		omrthread_monitor_enter(_synchronizeMutex);
@@ -107,6 +109,7 @@ MM_ParallelTask::synchronizeGCThreads(MM_EnvironmentBase *env, const char *id)
 
 	}
 
+	MM_GCTimeline::recordEnd(env, id);
 	Trc_MM_SynchronizeGCThreads_Exit(env->getLanguageVMThread());
 }
 
@@ -117,6 +120,7 @@ MM_ParallelTask::synchronizeGCThreadsAndReleaseMaster(MM_EnvironmentBase *env, c
 
 	Trc_MM_SynchronizeGCThreadsAndReleaseMaster_Entry(env->getLanguageVMThread(), id);
 	env->_lastSyncPointReached = id;
+	MM_GCTimeline::recordBegin(env, id);
 
 	if(1 < _totalThreadCount) {
 		volatile uintptr_t index = _synchronizeIndex;
@@ -161,6 +165,7 @@ MM_ParallelTask::synchronizeGCThreadsAndReleaseMaster(MM_EnvironmentBase *env, c
 	}
 
 done:
+	MM_GCTimeline::recordEnd(env, id);
 	Trc_MM_SynchronizeGCThreadsAndReleaseMaster_Exit(env->getLanguageVMThread());
 	return isMasterThread;	
 }
@@ -172,6 +177,7 @@ MM_ParallelTask::synchronizeGCThreadsAndReleaseSingleThread(MM_EnvironmentBase *
 
 	Trc_MM_SynchronizeGCThreadsAndReleaseSingleThread_Entry(env->getLanguageVMThread(), id);
 	env->_lastSyncPointReached = id;
+	MM_GCTimeline::recordBegin(env, id);
 
 	if(1 < _totalThreadCount) {
 		volatile uintptr_t index = _synchronizeIndex;
@@ -208,6 +214,7 @@ MM_ParallelTask::synchronizeGCThreadsAndReleaseSingleThread(MM_EnvironmentBase *
 	}
 
 done:
+	MM_GCTimeline::recordEnd(env, id);
 	Trc_MM_SynchronizeGCThreadsAndReleaseSingleThread_Exit(env->getLanguageVMThread());
 	return isReleasedThread;
 }
@@ -23,7 +23,11 @@
 
 #include "PhysicalSubArenaVirtualMemory.hpp"
 
-class MM_EnvironmentBase;
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Heap.hpp"
+#include "HeapVirtualMemory.hpp"
+#include "ParallelPrefaultTask.hpp"
 
 bool
 MM_PhysicalSubArenaVirtualMemory::initialize(MM_EnvironmentBase* env)
@@ -52,3 +56,23 @@ MM_PhysicalSubArenaVirtualMemory::findAdjacentHighValidAddress(MM_EnvironmentBas
 	/* There is - return its lowest address */
 	return _highArena->getLowAddress();
 }
+
+void
+MM_PhysicalSubArenaVirtualMemory::prefaultExpandedRange(MM_EnvironmentBase* env, void* lowAddress, void* highAddress)
+{
+	MM_GCExtensionsBase* extensions = env->getExtensions();
+	if (extensions->prefaultHeapOnExpand && (lowAddress < highAddress)) {
+		/* A split heap is backed by two separate reservations, so leave it out of the NUMA interleaving.
+		 * A sub arena with an explicit node binding already got its placement when it was inflated.
+		 */
+		const MM_MemoryHandle* memoryHandle = NULL;
+		bool splitHeap = false;
+#if defined(OMR_GC_MODRON_SCAVENGER)
+		splitHeap = extensions->enableSplitHeap;
+#endif /* OMR_GC_MODRON_SCAVENGER */
+		if (!splitHeap && (0 == _numaNode)) {
+			memoryHandle = ((MM_HeapVirtualMemory*)_heap)->getVmemHandle();
+		}
+		MM_ParallelPrefaultTask::prefault(env, memoryHandle, lowAddress, highAddress, _heap->getPageSize());
+	}
+}
@@ -50,6 +50,12 @@ protected:
 
 	virtual bool initialize(MM_EnvironmentBase* env);
 
+	/**
+	 * Prefault a range that has just been committed, if requested by the prefaultHeapOnExpand option.
+	 * Must be called before the range is added to any free list.
+	 */
+	void prefaultExpandedRange(MM_EnvironmentBase* env, void* lowAddress, void* highAddress);
+
 public:
 	MMINLINE MM_PhysicalSubArenaVirtualMemory* getNextSubArena() { return _highArena; }
 	MMINLINE void setNextSubArena(MM_PhysicalSubArenaVirtualMemory* subArena) { _highArena = subArena; }
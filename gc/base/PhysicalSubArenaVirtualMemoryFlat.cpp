@@ -199,6 +199,7 @@ MM_PhysicalSubArenaVirtualMemoryFlat::expandNoCheck(MM_EnvironmentBase *env, uin
 	if(!_heap->commitMemory(lowExpandAddress, expandSize)) {
 		return 0;
 	}
+	prefaultExpandedRange(env, lowExpandAddress, highExpandAddress);
 
 	if (_highAddress != highExpandAddress) {
 		/* the area has been expanded.  Update internal values */
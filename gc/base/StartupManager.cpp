@@ -25,9 +25,13 @@
 
 #include "StartupManager.hpp"
 #if defined(OMR_GC)
+#include "AllocationSampler.hpp"
 #include "GCExtensionsBase.hpp"
 #include "ConfigurationFlat.hpp"
 #endif /* OMR_GC */
+#if defined(OMR_GC_SEGREGATED_HEAP)
+#include "SizeClasses.hpp"
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 
 #define OMR_GC_BUFFER_SIZE 256
 #define OMR_XMS "-Xms"
@@ -37,19 +41,58 @@
 #if defined(OMR_GC_MODRON_COMPACTION)
 #define OMR_XCOMPACTGC "-Xcompactgc"
 #define OMR_XCOMPACTGC_LENGTH 11
+#define OMR_XGCPROACTIVECOMPACTIONWINDOWSIZE "-Xgc:proactiveCompactionWindowSize="
+#define OMR_XGCPROACTIVECOMPACTIONWINDOWSIZE_LENGTH 35
+#define OMR_XGCPROACTIVECOMPACTION "-Xgc:proactiveCompaction"
+#define OMR_XGCPROACTIVECOMPACTION_LENGTH 24
 #endif /* OMR_GC_MODRON_COMPACTION */
 #if defined(OMR_GC_MODRON_SCAVENGER)
 #define OMR_XGCPOLICY "-Xgcpolicy:"
 #define OMR_XGCPOLICY_LENGTH 11
 #define OMR_GCPOLICY_GENCON "gencon"
 #define OMR_GCPOLICY_GENCON_LENGTH 6
+#define OMR_XGCSCAVENGERPARALLELCOPYTHRESHOLD "-Xgc:scavengerParallelCopyThreshold="
+#define OMR_XGCSCAVENGERPARALLELCOPYTHRESHOLD_LENGTH 36
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+#define OMR_XGCCONCURRENTSCAVENGERSELFHEALOBJECT "-Xgc:concurrentScavengerSelfHealObject"
+#define OMR_XGCCONCURRENTSCAVENGERSELFHEALOBJECT_LENGTH 38
+#define OMR_XGCCONCURRENTSCAVENGER "-Xgc:concurrentScavenger"
+#define OMR_XGCCONCURRENTSCAVENGER_LENGTH 24
+#endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
 #define OMR_XVERBOSEGCLOG "-Xverbosegclog:"
 #define OMR_XVERBOSEGCLOG_LENGTH 15
+#define OMR_XGCTIMELINEFILE "-Xgc:timelineFile="
+#define OMR_XGCTIMELINEFILE_LENGTH 18
 #define OMR_XGCBUFFERED_LOGGING "-Xgc:bufferedLogging"
 #define OMR_XGCBUFFERED_LOGGING_LENGTH 20
 #define OMR_XGCTHREADS "-Xgcthreads"
 #define OMR_XGCTHREADS_LENGTH 11
+#define OMR_XGCSTICKYMARKBITS "-Xgc:stickyMarkBits"
+#define OMR_XGCSTICKYMARKBITS_LENGTH 19
+#define OMR_XGCSTICKYMARKMAXMINOR "-Xgc:stickyMarkMaxMinorCollections="
+#define OMR_XGCSTICKYMARKMAXMINOR_LENGTH 35
+#define OMR_XGCSTICKYMARKMINFREE "-Xgc:stickyMarkMinFreePercent="
+#define OMR_XGCSTICKYMARKMINFREE_LENGTH 30
+#define OMR_XGCQUEUEDHEAPLOCKS "-Xgc:queuedHeapLocks"
+#define OMR_XGCQUEUEDHEAPLOCKS_LENGTH 20
+#define OMR_XGCLARGEOBJECTBESTFITTHRESHOLD "-Xgc:largeObjectBestFitThreshold="
+#define OMR_XGCLARGEOBJECTBESTFITTHRESHOLD_LENGTH 33
+#define OMR_XGCPREFAULTHEAPONEXPAND "-Xgc:prefaultHeapOnExpand"
+#define OMR_XGCPREFAULTHEAPONEXPAND_LENGTH 25
+#define OMR_XGCALLOCATIONSAMPLINGINTERVAL "-Xgc:allocationSamplingInterval="
+#define OMR_XGCALLOCATIONSAMPLINGINTERVAL_LENGTH 32
+#define OMR_XGCALLOCATIONSAMPLING "-Xgc:allocationSampling"
+#if defined(OMR_GC_SEGREGATED_HEAP)
+#define OMR_XGCREGIONLISTSHARDS "-Xgc:regionListShards="
+#define OMR_XGCREGIONLISTSHARDS_LENGTH 22
+#define OMR_XGCSIZECLASSES "-Xgc:sizeClasses="
+#define OMR_XGCSIZECLASSES_LENGTH 17
+#define OMR_XGCSIZECLASSPROFILING "-Xgc:sizeClassProfiling"
+#define OMR_XGCSIZECLASSPROFILING_LENGTH 23
+#define OMR_XGCSWEEPBUDGET "-Xgc:sweepBudget="
+#define OMR_XGCSWEEPBUDGET_LENGTH 17
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
 
 uintptr_t
 MM_StartupManager::getUDATAValue(char *option, uintptr_t *outputValue)
@@ -230,6 +273,14 @@ MM_StartupManager::loadGcOptions(MM_GCExtensionsBase *extensions)
 	/* Now override defaults with specified settings, if any */
 	bool result = parseGcOptions(extensions);
 
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+	if (result && extensions->concurrentScavenger) {
+		/* the nursery is laid out in Concurrent Scavenger Page sections, which have to cover its maximum size */
+		uintptr_t maxNurserySize = (0 != extensions->maxNewSpaceSize) ? extensions->maxNewSpaceSize : extensions->memoryMax;
+		extensions->calculateConcurrentScavengerPageParameters(maxNurserySize);
+	}
+#endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+
 	return result;
 }
 
@@ -264,6 +315,16 @@ MM_StartupManager::handleOption(MM_GCExtensionsBase *extensions, char *option)
 		extensions->nocompactOnSystemGC = 0;
 		extensions->compactOnSystemGC = 0;
 	}
+	else if (0 == strncmp(option, OMR_XGCPROACTIVECOMPACTIONWINDOWSIZE, OMR_XGCPROACTIVECOMPACTIONWINDOWSIZE_LENGTH)) {
+		if (!getUDATAMemoryValue(option + OMR_XGCPROACTIVECOMPACTIONWINDOWSIZE_LENGTH, &(extensions->proactiveCompactionWindowSize))) {
+			result = false;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCPROACTIVECOMPACTION, OMR_XGCPROACTIVECOMPACTION_LENGTH)) {
+		/* proactive compaction is a compaction trigger, so triggered compaction has to be enabled */
+		extensions->proactiveCompaction = true;
+		extensions->noCompactOnGlobalGC = 0;
+	}
 #endif /* OMR_GC_MODRON_COMPACTION */
 	else if (0 == strncmp(option, OMR_XVERBOSEGCLOG, OMR_XVERBOSEGCLOG_LENGTH)) {
 		verboseFileName = (char *) omrmem_allocate_memory(strlen(option+OMR_XVERBOSEGCLOG_LENGTH)+1, OMRMEM_CATEGORY_MM);
@@ -273,6 +334,14 @@ MM_StartupManager::handleOption(MM_GCExtensionsBase *extensions, char *option)
 			strcpy(verboseFileName, option + OMR_XVERBOSEGCLOG_LENGTH);
 		}
 	}
+	else if (0 == strncmp(option, OMR_XGCTIMELINEFILE, OMR_XGCTIMELINEFILE_LENGTH)) {
+		timelineFileName = (char *) omrmem_allocate_memory(strlen(option+OMR_XGCTIMELINEFILE_LENGTH)+1, OMRMEM_CATEGORY_MM);
+		if (NULL == timelineFileName) {
+			result = false;
+		} else {
+			strcpy(timelineFileName, option + OMR_XGCTIMELINEFILE_LENGTH);
+		}
+	}
 	else if (0 == strncmp(option, OMR_XGCBUFFERED_LOGGING, OMR_XGCBUFFERED_LOGGING_LENGTH)) {
 		extensions->bufferedLogging = true;
 	}
@@ -295,7 +364,103 @@ MM_StartupManager::handleOption(MM_GCExtensionsBase *extensions, char *option)
 			extensions->gcThreadCount = forcedThreadCount;
 			extensions->gcThreadCountForced = true;
 		}
-	} else {
+	}
+	else if (0 == strncmp(option, OMR_XGCSTICKYMARKMAXMINOR, OMR_XGCSTICKYMARKMAXMINOR_LENGTH)) {
+		uintptr_t maxMinorCollections = 0;
+		if (0 >= getUDATAValue(option + OMR_XGCSTICKYMARKMAXMINOR_LENGTH, &maxMinorCollections)) {
+			result = false;
+		} else {
+			extensions->stickyMarkMaxMinorCollections = maxMinorCollections;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCSTICKYMARKMINFREE, OMR_XGCSTICKYMARKMINFREE_LENGTH)) {
+		uintptr_t minFreePercent = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCSTICKYMARKMINFREE_LENGTH, &minFreePercent)) || (100 < minFreePercent)) {
+			result = false;
+		} else {
+			extensions->stickyMarkMinFreePercent = minFreePercent;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCSTICKYMARKBITS, OMR_XGCSTICKYMARKBITS_LENGTH)) {
+		extensions->stickyMarkBits = true;
+	}
+	else if (0 == strncmp(option, OMR_XGCQUEUEDHEAPLOCKS, OMR_XGCQUEUEDHEAPLOCKS_LENGTH)) {
+		extensions->queuedHeapLocks = true;
+	}
+	else if (0 == strncmp(option, OMR_XGCLARGEOBJECTBESTFITTHRESHOLD, OMR_XGCLARGEOBJECTBESTFITTHRESHOLD_LENGTH)) {
+		if (!getUDATAMemoryValue(option + OMR_XGCLARGEOBJECTBESTFITTHRESHOLD_LENGTH, &(extensions->largeObjectBestFitThreshold))) {
+			result = false;
+		}
+	}
+	else if (0 == strncmp(option, OMR_XGCPREFAULTHEAPONEXPAND, OMR_XGCPREFAULTHEAPONEXPAND_LENGTH)) {
+		extensions->prefaultHeapOnExpand = true;
+	}
+	else if (0 == strncmp(option, OMR_XGCALLOCATIONSAMPLINGINTERVAL, OMR_XGCALLOCATIONSAMPLINGINTERVAL_LENGTH)) {
+		if (!getUDATAMemoryValue(option + OMR_XGCALLOCATIONSAMPLINGINTERVAL_LENGTH, &(extensions->allocationSamplingInterval))) {
+			result = false;
+		}
+	}
+	else if (0 == strcmp(option, OMR_XGCALLOCATIONSAMPLING)) {
+		extensions->allocationSamplingInterval = ALLOCATION_SAMPLER_DEFAULT_INTERVAL;
+	}
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	else if (0 == strncmp(option, OMR_XGCSCAVENGERPARALLELCOPYTHRESHOLD, OMR_XGCSCAVENGERPARALLELCOPYTHRESHOLD_LENGTH)) {
+		if (!getUDATAMemoryValue(option + OMR_XGCSCAVENGERPARALLELCOPYTHRESHOLD_LENGTH, &(extensions->scavengerParallelCopyThreshold))) {
+			result = false;
+		}
+	}
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+	/* must be checked before -Xgc:concurrentScavenger, which is a prefix of it */
+	else if (0 == strncmp(option, OMR_XGCCONCURRENTSCAVENGERSELFHEALOBJECT, OMR_XGCCONCURRENTSCAVENGERSELFHEALOBJECT_LENGTH)) {
+		extensions->concurrentScavengerSelfHealObject = true;
+	}
+	else if (0 == strncmp(option, OMR_XGCCONCURRENTSCAVENGER, OMR_XGCCONCURRENTSCAVENGER_LENGTH)) {
+		extensions->concurrentScavenger = true;
+		extensions->concurrentScavengerForced = true;
+	}
+#endif /* defined(OMR_GC_CONCURRENT_SCAVENGER) */
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	else if (0 == strncmp(option, OMR_XGCREGIONLISTSHARDS, OMR_XGCREGIONLISTSHARDS_LENGTH)) {
+		uintptr_t shardCount = 0;
+		if (0 >= getUDATAValue(option + OMR_XGCREGIONLISTSHARDS_LENGTH, &shardCount)) {
+			result = false;
+		} else {
+			extensions->regionListShardCount = shardCount;
+		}
+	} else if (0 == strncmp(option, OMR_XGCSIZECLASSES, OMR_XGCSIZECLASSES_LENGTH)) {
+		/* comma separated cell sizes for size classes OMR_SIZECLASSES_MIN_SMALL..OMR_SIZECLASSES_MAX_SMALL */
+		uintptr_t cellSizes[OMR_SIZECLASSES_NUM_SMALL + 1];
+		char *cursor = option + OMR_XGCSIZECLASSES_LENGTH;
+		cellSizes[0] = 0;
+		for (uintptr_t szClass = OMR_SIZECLASSES_MIN_SMALL; result && (szClass <= OMR_SIZECLASSES_MAX_SMALL); szClass++) {
+			uintptr_t count = getUDATAValue(cursor, &cellSizes[szClass]);
+			char terminator = (OMR_SIZECLASSES_MAX_SMALL == szClass) ? '\0' : ',';
+			if ((0 >= count) || (terminator != cursor[count])) {
+				result = false;
+			} else {
+				cursor += count + 1;
+			}
+		}
+		if (result && MM_SizeClasses::isValidCellSizeTable(cellSizes)) {
+			memcpy(extensions->customSmallCellSizes, cellSizes, sizeof(cellSizes));
+		} else {
+			omrtty_printf("Invalid size class table '%s': expected %d increasing sizes ending at %d\n",
+				option + OMR_XGCSIZECLASSES_LENGTH, OMR_SIZECLASSES_NUM_SMALL, OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES);
+			result = false;
+		}
+	} else if (0 == strncmp(option, OMR_XGCSIZECLASSPROFILING, OMR_XGCSIZECLASSPROFILING_LENGTH)) {
+		extensions->sizeClassProfiling = true;
+	} else if (0 == strncmp(option, OMR_XGCSWEEPBUDGET, OMR_XGCSWEEPBUDGET_LENGTH)) {
+		uintptr_t budget = 0;
+		if (0 >= getUDATAValue(option + OMR_XGCSWEEPBUDGET_LENGTH, &budget)) {
+			result = false;
+		} else {
+			extensions->segregatedSweepBudget = budget;
+		}
+	}
+#endif /* defined(OMR_GC_SEGREGATED_HEAP) */
+	else {
 		/* unknown option */
 		result = false;
 	}
@@ -311,6 +476,10 @@ MM_StartupManager::tearDown(void)
 		omrmem_free_memory(verboseFileName);
 		verboseFileName = NULL;
 	}
+	if (NULL != timelineFileName) {
+		omrmem_free_memory(timelineFileName);
+		timelineFileName = NULL;
+	}
 }
 
 bool
@@ -325,6 +494,18 @@ MM_StartupManager::getVerboseFileName(void)
 	return verboseFileName;
 }
 
+bool
+MM_StartupManager::isTimelineEnabled(void)
+{
+	return (NULL != timelineFileName);
+}
+
+char *
+MM_StartupManager::getTimelineFileName(void)
+{
+	return timelineFileName;
+}
+
 MM_Configuration *
 MM_StartupManager::createConfiguration(MM_EnvironmentBase *env)
 {
@@ -43,6 +43,7 @@ class MM_StartupManager
 	 */
 private:
 	char *verboseFileName;
+	char *timelineFileName;
 
 protected:
 	OMR_VM *omrVM;
@@ -81,11 +82,14 @@ public:
 
 	bool isVerboseEnabled(void);
 	char * getVerboseFileName(void);
+	bool isTimelineEnabled(void);
+	char * getTimelineFileName(void);
 
 	virtual ~MM_StartupManager() { tearDown(); }
 
 	MM_StartupManager(OMR_VM *omrVM, uintptr_t defaultMinHeapSize, uintptr_t defaultMaxHeapSize)
 		: verboseFileName(NULL)
+		, timelineFileName(NULL)
 		, omrVM(omrVM)
 		, defaultMinHeapSize(defaultMinHeapSize)
 		, defaultMaxHeapSize(defaultMaxHeapSize)
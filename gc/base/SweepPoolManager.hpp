@@ -83,6 +83,20 @@ public:
 	 */
 	virtual void connectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk) = 0;
 
+	/**
+	 * Connect a chunk into the free list, possibly recording the writes to the heap in the chunk rather than
+	 * performing them. Chunks are planned in address order by a single thread, using only the chunk data.
+	 * The recorded writes are independent of each other and are performed by applyConnectChunk(), which
+	 * may be called for the chunks in any order and by any thread once all chunks are planned.
+	 * The default implementation connects the chunk immediately.
+	 */
+	virtual void planConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk) { connectChunk(env, chunk); }
+
+	/**
+	 * Perform the writes to the heap recorded by planConnectChunk().
+	 */
+	virtual void applyConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk) {}
+
 	/**
 	 * 	Add free memory slot to pool list
 	 * 
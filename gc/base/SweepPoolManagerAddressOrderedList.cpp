@@ -22,6 +22,9 @@
 
 #include "SweepPoolManagerAddressOrderedList.hpp"
 
+#include "MemoryPoolAddressOrderedList.hpp"
+#include "ParallelSweepChunk.hpp"
+
 /**
  * Allocate and initialize a new instance of the receiver.
  * @return a new instance of the receiver, or NULL on failure.
@@ -42,3 +45,50 @@ MM_SweepPoolManagerAddressOrderedList::newInstance(MM_EnvironmentBase *env)
 
 	return sweepPoolManager;
 }
+
+/**
+ * Connect the chunk, deferring all the free entries it builds to applyConnectChunk().
+ * @see MM_SweepPoolManager::planConnectChunk()
+ */
+void
+MM_SweepPoolManagerAddressOrderedList::planConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk)
+{
+	internalConnectChunk(env, chunk, true);
+}
+
+/**
+ * Build the free entries recorded by planConnectChunk(). Each one is a distinct range of the heap.
+ * @see MM_SweepPoolManager::applyConnectChunk()
+ */
+void
+MM_SweepPoolManagerAddressOrderedList::applyConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk)
+{
+	MM_MemoryPoolAddressOrderedList *memoryPool = (MM_MemoryPoolAddressOrderedList *)chunk->memoryPool;
+
+	for (uintptr_t i = 0; i < chunk->_connectRecordCount; i++) {
+		MM_ParallelSweepChunk::ConnectRecord *record = &chunk->_connectRecords[i];
+		memoryPool->createFreeEntry(env, record->freeEntry, (uint8_t *)record->freeEntry + record->size, NULL, (MM_HeapLinkedFreeHeader *)record->nextFreeEntry);
+	}
+	chunk->_connectRecordCount = 0;
+
+	if (NULL != chunk->_abandonCandidate) {
+		memoryPool->abandonMemoryInPool(env, chunk->_abandonCandidate, chunk->_abandonCandidateSize);
+		chunk->_abandonCandidate = NULL;
+		chunk->_abandonCandidateSize = 0;
+	}
+}
+
+/**
+ * Terminate the free list, which makes the best fit index of a swept pool complete.
+ * @see MM_SweepPoolManager::connectFinalChunk()
+ */
+void
+MM_SweepPoolManagerAddressOrderedList::connectFinalChunk(MM_EnvironmentBase *env, MM_MemoryPool *memoryPool)
+{
+	MM_SweepPoolManagerAddressOrderedListBase::connectFinalChunk(env, memoryPool);
+
+	/* Pools without a chunk were not swept, and their index still has to be rebuilt from the free list */
+	if (NULL != getPoolState(memoryPool)->_connectPreviousChunk) {
+		((MM_MemoryPoolAddressOrderedList *)memoryPool)->sweptFreeEntriesRecorded(env);
+	}
+}
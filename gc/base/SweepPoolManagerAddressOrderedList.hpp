@@ -48,6 +48,10 @@ public:
 
 	static MM_SweepPoolManagerAddressOrderedList *newInstance(MM_EnvironmentBase *env);
 
+	virtual void planConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk);
+	virtual void applyConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk);
+	virtual void connectFinalChunk(MM_EnvironmentBase *env, MM_MemoryPool *memoryPool);
+
 	/**
 	 * Create a SweepPoolManager object.
 	 */
@@ -97,6 +97,48 @@ MM_SweepPoolManagerAddressOrderedListBase::calculateTrailingDetails(
 	}
 }
 
+/**
+ * Note a free entry of the free list being built by sweep, once its size is final.
+ */
+MMINLINE void
+MM_SweepPoolManagerAddressOrderedListBase::recordFreeEntry(MM_EnvironmentBase *env, MM_MemoryPoolAddressOrderedListBase *memoryPool, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t freeEntrySize)
+{
+	uintptr_t threshold = _extensions->largeObjectBestFitThreshold;
+
+	/* Only large entries are of interest, so skip the call for all the others */
+	if ((0 != threshold) && (NULL != freeEntry) && (freeEntrySize >= threshold)) {
+		memoryPool->recordSweptFreeEntry(env, freeEntry, freeEntrySize);
+	}
+}
+
+/**
+ * Build a free entry at the end of the free list, and link it to the next entry.
+ *
+ * @param chunk the chunk being connected (may be NULL if deferHeapWrites is false)
+ * @param freeEntry the free entry, or NULL if the next entry is the head of the free list
+ * @param freeEntrySize final size of the free entry
+ * @param nextFreeEntry the next entry of the free list
+ * @param deferHeapWrites true to record the write in the chunk instead of performing it
+ */
+MMINLINE void
+MM_SweepPoolManagerAddressOrderedListBase::connectFreeEntry(MM_EnvironmentBase *env, MM_MemoryPoolAddressOrderedListBase *memoryPool, MM_ParallelSweepChunk *chunk, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t freeEntrySize, void *nextFreeEntry, bool deferHeapWrites)
+{
+	if (deferHeapWrites && (NULL != freeEntry)) {
+		Assert_MM_true((NULL == nextFreeEntry) || ((void *)freeEntry < nextFreeEntry));
+		Assert_MM_true(chunk->_connectRecordCount < PARALLEL_SWEEP_CHUNK_MAX_CONNECT_RECORDS);
+		MM_ParallelSweepChunk::ConnectRecord *record = &chunk->_connectRecords[chunk->_connectRecordCount];
+		record->freeEntry = freeEntry;
+		record->size = freeEntrySize;
+		record->nextFreeEntry = nextFreeEntry;
+		chunk->_connectRecordCount += 1;
+	} else {
+		/* Also used without a free entry to set the head of the free list, which is not a heap write */
+		memoryPool->connectOuterMemoryToPool(env, freeEntry, freeEntrySize, nextFreeEntry);
+	}
+
+	recordFreeEntry(env, memoryPool, freeEntry, freeEntrySize);
+}
+
 /**
  * Connect a chunk into the free list.
  * Given a previously swept chunk, connect its data to the free list of the associated memory subspace.
@@ -108,6 +150,20 @@ MM_SweepPoolManagerAddressOrderedListBase::calculateTrailingDetails(
  */
 void
 MM_SweepPoolManagerAddressOrderedListBase::connectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk)
+{
+	internalConnectChunk(env, chunk, false);
+}
+
+/**
+ * Connect a chunk into the free list.
+ * Only the chunk data and the sweep state are read, so when deferHeapWrites is true the chunk can be
+ * connected without touching the heap: every free entry whose successor becomes known is recorded in
+ * the chunk, to be built by applyConnectChunk().
+ *
+ * @param deferHeapWrites true to record the writes to the heap in the chunk instead of performing them
+ */
+void
+MM_SweepPoolManagerAddressOrderedListBase::internalConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk, bool deferHeapWrites)
 {
 #if defined(J9MODRON_SWEEP_SCHEME_CONNECT_CHUNKS_TRACE)
 	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
@@ -197,10 +253,11 @@ MM_SweepPoolManagerAddressOrderedListBase::connectChunk(MM_EnvironmentBase *env,
 				omrtty_printf("CC: trailing/leading merged %p(+%p) + %p(+%p)\n", previousConnectChunk->trailingFreeCandidate, previousConnectChunk->trailingFreeCandidateSize, leadingFreeEntry, leadingFreeEntrySize);
 #endif
 
-				memoryPool->connectOuterMemoryToPool(env,
+				connectFreeEntry(env, memoryPool, chunk,
 						previousFreeEntry,
 						previousFreeEntrySize,
-						previousConnectChunk->trailingFreeCandidate);
+						previousConnectChunk->trailingFreeCandidate,
+						deferHeapWrites);
 
 				connectChunkPostProcess(chunk, sweepState, (MM_HeapLinkedFreeHeader *)previousConnectChunk->trailingFreeCandidate, previousFreeEntry);
 				/* only for SPMSAOL */
@@ -230,10 +287,11 @@ MM_SweepPoolManagerAddressOrderedListBase::connectChunk(MM_EnvironmentBase *env,
 				omrtty_printf("CC: trailing from previous used %p(+%p)\n", previousConnectChunk->trailingFreeCandidate, previousConnectChunk->trailingFreeCandidateSize);
 #endif
 
-				memoryPool->connectOuterMemoryToPool(env,
+				connectFreeEntry(env, memoryPool, chunk,
 						previousFreeEntry,
 						previousFreeEntrySize,
-						previousConnectChunk->trailingFreeCandidate);
+						previousConnectChunk->trailingFreeCandidate,
+						deferHeapWrites);
 
 				connectChunkPostProcess(chunk, sweepState, (MM_HeapLinkedFreeHeader *)previousConnectChunk->trailingFreeCandidate, previousFreeEntry);
 				/* only for SPMSAOL */
@@ -273,10 +331,11 @@ MM_SweepPoolManagerAddressOrderedListBase::connectChunk(MM_EnvironmentBase *env,
 
 				Assert_MM_true(previousFreeEntry <= leadingFreeEntry);
 
-				memoryPool->connectOuterMemoryToPool(env,
+				connectFreeEntry(env, memoryPool, chunk,
 						previousFreeEntry,
 						previousFreeEntrySize,
-						leadingFreeEntry);
+						leadingFreeEntry,
+						deferHeapWrites);
 
 				connectChunkPostProcess(chunk, sweepState, leadingFreeEntry, previousFreeEntry);
 				/* only for SPMSAOL */
@@ -296,9 +355,14 @@ MM_SweepPoolManagerAddressOrderedListBase::connectChunk(MM_EnvironmentBase *env,
 				/* Abandon it. We need to do this in case we encounter a free entry which
 			 	 * spans 2 memory pools which is possible when LOA is enabled.
 			 	 */
-				memoryPool->abandonMemoryInPool(env,
-						leadingFreeEntry,
-						leadingFreeEntrySize);
+				if (deferHeapWrites) {
+					chunk->_abandonCandidate = leadingFreeEntry;
+					chunk->_abandonCandidateSize = leadingFreeEntrySize;
+				} else {
+					memoryPool->abandonMemoryInPool(env,
+							leadingFreeEntry,
+							leadingFreeEntrySize);
+				}
 			}
 		}
 	}
@@ -310,10 +374,11 @@ MM_SweepPoolManagerAddressOrderedListBase::connectChunk(MM_EnvironmentBase *env,
 	if(chunk->freeListHead) {
 		Assert_MM_true(previousFreeEntry < chunk->freeListHead);
 
-		memoryPool->connectOuterMemoryToPool(env,
+		connectFreeEntry(env, memoryPool, chunk,
 				previousFreeEntry,
 				previousFreeEntrySize,
-				chunk->freeListHead);
+				chunk->freeListHead,
+				deferHeapWrites);
 
 		/* Set split candidate information */
 		connectChunkPostProcess(chunk, sweepState, chunk->freeListHead, previousFreeEntry);
@@ -378,10 +443,11 @@ MM_SweepPoolManagerAddressOrderedListBase::flushFinalChunk(
 
 		} else {
 			/* It is - fold it into the free list */
-			memoryPool->connectOuterMemoryToPool(envModron,
+			connectFreeEntry(envModron, memoryPool, NULL,
 					sweepState->_connectPreviousFreeEntry,
 					sweepState->_connectPreviousFreeEntrySize,
-					sweepState->_connectPreviousChunk->trailingFreeCandidate);
+					sweepState->_connectPreviousChunk->trailingFreeCandidate,
+					false);
 
 			sweepState->_connectPreviousPreviousFreeEntry = sweepState->_connectPreviousFreeEntry;
 			sweepState->_connectPreviousFreeEntry = (MM_HeapLinkedFreeHeader *)sweepState->_connectPreviousChunk->trailingFreeCandidate;
@@ -411,6 +477,7 @@ MM_SweepPoolManagerAddressOrderedListBase::connectFinalChunk(
 		((MM_MemoryPoolAddressOrderedListBase *)memoryPool)->connectFinalMemoryToPool(envModron,
 				sweepState->_connectPreviousFreeEntry,
 				sweepState->_connectPreviousFreeEntrySize);
+		recordFreeEntry(envModron, (MM_MemoryPoolAddressOrderedListBase *)memoryPool, sweepState->_connectPreviousFreeEntry, sweepState->_connectPreviousFreeEntrySize);
 
  		sweepState->updateLargestFreeEntry(sweepState->_connectPreviousFreeEntrySize, sweepState->_connectPreviousPreviousFreeEntry);
 	}
@@ -503,6 +570,9 @@ MM_SweepPoolManagerAddressOrderedListBase::addFreeMemory(MM_EnvironmentBase *env
 				memoryPool->getLargeObjectAllocateStats()->incrementFreeEntrySizeClassStats(heapFreeByteCount, &env->_freeEntrySizeClassStats);
 			}
 
+			/* The previous tail is now linked to the new entry, so it will not change again */
+			recordFreeEntry(env, memoryPool, sweepChunk->freeListTail, sweepChunk->freeListTailSize);
+
 			sweepChunk->previousFreeListTail = sweepChunk->freeListTail;
 			sweepChunk->freeListTail = (MM_HeapLinkedFreeHeader *)address;
 			sweepChunk->freeListTailSize = heapFreeByteCount;
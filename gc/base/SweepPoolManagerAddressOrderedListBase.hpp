@@ -42,6 +42,7 @@
 class MM_AllocateDescription;
 class MM_EnvironmentBase;
 class MM_MemoryPool;
+class MM_MemoryPoolAddressOrderedListBase;
 class MM_HeapLinkedFreeHeader;
 
 class MM_SweepPoolManagerAddressOrderedListBase : public MM_SweepPoolManager
@@ -51,6 +52,9 @@ private:
 protected:
 
 	MMINLINE void calculateTrailingDetails(MM_ParallelSweepChunk *sweepChunk, uintptr_t *trailingCandidate, uintptr_t trailingCandidateSlotCount);
+	MMINLINE void recordFreeEntry(MM_EnvironmentBase *env, MM_MemoryPoolAddressOrderedListBase *memoryPool, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t freeEntrySize);
+	MMINLINE void connectFreeEntry(MM_EnvironmentBase *env, MM_MemoryPoolAddressOrderedListBase *memoryPool, MM_ParallelSweepChunk *chunk, MM_HeapLinkedFreeHeader *freeEntry, uintptr_t freeEntrySize, void *nextFreeEntry, bool deferHeapWrites);
+	void internalConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk, bool deferHeapWrites);
 	MMINLINE virtual void connectChunkPostProcess(MM_ParallelSweepChunk *chunk, MM_SweepPoolState *sweepState, MM_HeapLinkedFreeHeader* splitCandidate, MM_HeapLinkedFreeHeader* splitCandidatePreviousEntry){}
 	MMINLINE void updateLargestFreeEntryInChunk(MM_ParallelSweepChunk *chunk, MM_SweepPoolState *sweepState, MM_HeapLinkedFreeHeader* previousFreeEntry)
 	{
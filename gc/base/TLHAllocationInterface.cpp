@@ -125,6 +125,7 @@ MM_TLHAllocationInterface::kill(MM_EnvironmentBase *env)
 	 MM_GCExtensionsBase *extensions = env->getExtensions();
 
 	 if(shouldFlush) {
+		restoreTopForSampling(env, extensions->allocationSampler);
 		extensions->allocationStats.merge(&_stats);
 		_stats.clear();
 		/* Since AllocationStats have been reset, reset the base */
@@ -207,6 +208,13 @@ MM_TLHAllocationInterface::allocateObject(MM_EnvironmentBase *env, MM_AllocateDe
 		_stats._allocationBytes += allocDescription->getContiguousBytes();
 		_stats._allocationCount += 1;
 
+		/* objects allocated from a TLH are sampled when the TLH runs out or reaches the lowered top */
+		MM_AllocationSampler *sampler = env->getExtensions()->allocationSampler;
+		if (NULL != sampler) {
+			restoreTopForSampling(env, sampler);
+			sampler->allocationNotify(env, &_samplerState, result, allocDescription->getContiguousBytes());
+			lowerTopForSampling();
+		}
 	}
 
 	env->_oolTraceAllocationBytes += (_stats.bytesAllocated() - _bytesAllocatedBase); /* Increment by bytes allocated */
@@ -214,6 +222,28 @@ MM_TLHAllocationInterface::allocateObject(MM_EnvironmentBase *env, MM_AllocateDe
 	return result;
 }
 
+void
+MM_TLHAllocationInterface::restoreTopForSampling(MM_EnvironmentBase *env, MM_AllocationSampler *sampler)
+{
+	uintptr_t tlhBytes = _tlhAllocationSupport.restoreTopForSampling();
+#if defined(OMR_GC_NON_ZERO_TLH)
+	tlhBytes += _tlhAllocationSupportNonZero.restoreTopForSampling();
+#endif /* defined(OMR_GC_NON_ZERO_TLH) */
+
+	if (NULL != sampler) {
+		sampler->tlhAllocationNotify(env, &_samplerState, tlhBytes);
+	}
+}
+
+void
+MM_TLHAllocationInterface::lowerTopForSampling()
+{
+	_tlhAllocationSupport.lowerTopForSampling(_samplerState.bytesUntilSample);
+#if defined(OMR_GC_NON_ZERO_TLH)
+	_tlhAllocationSupportNonZero.lowerTopForSampling(_samplerState.bytesUntilSample);
+#endif /* defined(OMR_GC_NON_ZERO_TLH) */
+}
+
 void *
 MM_TLHAllocationInterface::allocateArray(MM_EnvironmentBase *env, MM_AllocateDescription *allocateDescription, MM_MemorySpace *memorySpace, bool shouldCollectOnFailure)
 {
@@ -290,6 +320,11 @@ MM_TLHAllocationInterface::flushCache(MM_EnvironmentBase *env)
 	}	
 #endif /* OMR_GC_THREAD_LOCAL_HEAP */		
 	
+	/* Give the TLHs back to the heap up to their real top, even if the sampler has gone since they were lowered,
+	 * and record any pending sample before the collection can move or free the sampled object.
+	 */
+	restoreTopForSampling(env, extensions->allocationSampler);
+
 	extensions->allocationStats.merge(&_stats);
 	_stats.clear();
 	/* Since AllocationStats have been reset, reset the base as well*/
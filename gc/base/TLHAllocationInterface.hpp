@@ -32,6 +32,7 @@
 #include "omrcomp.h"
 #include "omrmodroncore.h"
 
+#include "AllocationSampler.hpp"
 #include "ObjectAllocationInterface.hpp"
 #include "TLHAllocationSupport.hpp"
 
@@ -63,6 +64,7 @@ private:
 
 	bool _cachedAllocationsEnabled; /**< Are cached allocations enabled? */
 	uintptr_t _bytesAllocatedBase; /**< Bytes allocated at the start of an allocation request.  Relative to _stats.bytesAllocated(). */
+	MM_AllocationSampler::ThreadState _samplerState; /**< Allocation sampler countdown and pending sample of the owning thread (zeroed until first used) */
 
 public:
 	static MM_TLHAllocationInterface *newInstance(MM_EnvironmentBase *env);
@@ -93,6 +95,17 @@ private:
 	void reconnect(MM_EnvironmentBase *env, bool shouldFlush);
 	void *allocateFromTLH(MM_EnvironmentBase *env, MM_AllocateDescription *allocDescription, bool shouldCollectOnFailure);
 
+	/**
+	 * Give the TLHs back their real top, and count the bytes allocated from them towards the next allocation sample.
+	 * @param sampler the allocation sampler, NULL if it has gone
+	 */
+	void restoreTopForSampling(MM_EnvironmentBase *env, MM_AllocationSampler *sampler);
+
+	/**
+	 * Lower the top of the TLHs to the next allocation sample.
+	 */
+	void lowerTopForSampling();
+
 	/**
 	 * Create a ThreadLocalHeap object.
 	 */
@@ -104,13 +117,16 @@ private:
 		_tlhAllocationSupportNonZero(env, false),
 #endif /* defined(OMR_GC_NON_ZERO_TLH) */
 		_cachedAllocationsEnabled(true),
-		_bytesAllocatedBase(0)
+		_bytesAllocatedBase(0),
+		_samplerState()
 	{
 		_typeId = __FUNCTION__;
 		_tlhAllocationSupport._objectAllocationInterface = this;
+		_tlhAllocationSupport._samplerState = &_samplerState;
 
 #if defined(OMR_GC_NON_ZERO_TLH)
 		_tlhAllocationSupportNonZero._objectAllocationInterface = this;
+		_tlhAllocationSupportNonZero._samplerState = &_samplerState;
 #endif /* defined(OMR_GC_NON_ZERO_TLH) */
 	};
 };
@@ -117,6 +117,8 @@ MM_TLHAllocationSupport::clear(MM_EnvironmentBase *env)
 	} else {
 		/* Clear current information accumulated */
 		setAllZeroes();
+		_realTop = NULL;
+		_sampledAlloc = NULL;
 	}
 
 	_tlh->refreshSize = extensions->tlhInitialSize;
@@ -141,6 +143,8 @@ MM_TLHAllocationSupport::restart(MM_EnvironmentBase *env)
 
 	/* Clear current information accumulated */
 	setAllZeroes();
+	_realTop = NULL;
+	_sampledAlloc = NULL;
 
 	_tlh->refreshSize = MM_Math::roundToCeiling(extensions->tlhInitialSize, refreshSize / 2);
 };
@@ -296,9 +300,19 @@ MM_TLHAllocationSupport::allocateFromTLH(MM_EnvironmentBase *env, MM_AllocateDes
 
 	Assert_MM_true(!env->getExtensions()->isSegregatedHeap());
 	uintptr_t sizeInBytesRequired = allocDescription->getContiguousBytes();
-	/* If there's insufficient space, refresh the current TLH */
+	MM_AllocationSampler *sampler = NULL;
 	if (sizeInBytesRequired > getSize()) {
-		refresh(env, allocDescription, shouldCollectOnFailure);
+		/* The TLH has run out, or reached the allocation sample its top was lowered to. Either way the sampler
+		 * is brought up to date here, so that allocations which fit in the TLH cost it nothing.
+		 */
+		sampler = env->getExtensions()->allocationSampler;
+		if (NULL != sampler) {
+			sampler->tlhAllocationNotify(env, _samplerState, restoreTopForSampling());
+		}
+		/* If there's insufficient space, refresh the current TLH */
+		if (sizeInBytesRequired > getSize()) {
+			refresh(env, allocDescription, shouldCollectOnFailure);
+		}
 	}
 
 	/* Try to fit the allocate into the current TLH */
@@ -317,6 +331,13 @@ MM_TLHAllocationSupport::allocateFromTLH(MM_EnvironmentBase *env, MM_AllocateDes
 		allocDescription->completedFromTlh();
 	}
 
+	if (NULL != sampler) {
+		if (NULL != memPtr) {
+			sampler->allocationNotify(env, _samplerState, memPtr, sizeInBytesRequired);
+		}
+		lowerTopForSampling(_samplerState->bytesUntilSample);
+	}
+
 	return memPtr;
 };
 
@@ -364,6 +385,8 @@ MM_TLHAllocationSupport::setupTLH(MM_EnvironmentBase *env, void *addrBase, void
 	setBase(addrBase);
 	setAlloc(addrBase);
 	setTop(addrTop);
+	_realTop = NULL;
+	_sampledAlloc = NULL;
 	if (NULL != memorySubSpace) {
 		setObjectFlags(memorySubSpace->getObjectFlags());
 	}
@@ -374,6 +397,42 @@ MM_TLHAllocationSupport::setupTLH(MM_EnvironmentBase *env, void *addrBase, void
 #endif /* OMR_GC_TLH_PREFETCH_FTA */
 }
 
+uintptr_t
+MM_TLHAllocationSupport::restoreTopForSampling()
+{
+	uintptr_t allocatedBytes = 0;
+
+	if (NULL != _realTop) {
+		if (NULL != _tlh->realHeapAlloc) {
+			/* inline allocation has been disabled since, so the TLH must keep looking full */
+			setAlloc(_realTop);
+		}
+		setTop(_realTop);
+		_realTop = NULL;
+	}
+	if (NULL != _sampledAlloc) {
+		allocatedBytes = (uintptr_t)getRealAlloc() - (uintptr_t)_sampledAlloc;
+		_sampledAlloc = NULL;
+	}
+
+	return allocatedBytes;
+}
+
+void
+MM_TLHAllocationSupport::lowerTopForSampling(uintptr_t bytesUntilSample)
+{
+	void *alloc = getRealAlloc();
+
+	if (NULL != alloc) {
+		_sampledAlloc = alloc;
+		/* a disabled TLH already sends every allocation out of line */
+		if ((NULL == _tlh->realHeapAlloc) && (bytesUntilSample < getSize())) {
+			_realTop = getTop();
+			setTop((void *)((uintptr_t)alloc + bytesUntilSample));
+		}
+	}
+}
+
 void
 MM_TLHAllocationSupport::updateFrequentObjectsStats(MM_EnvironmentBase *env)
 {
@@ -34,6 +34,7 @@
 #include "omrcomp.h"
 #include "modronbase.h"
 
+#include "AllocationSampler.hpp"
 #include "GCExtensionsBase.hpp"
 #include "EnvironmentBase.hpp"
 #include "HeapLinkedFreeHeader.hpp"
@@ -77,12 +78,16 @@ private:
 	intptr_t * const _pointerToTlhPrefetchFTA; /**< pointer to tlhPrefetchFTA field for this TLH in J9VMThread structure (can be tlhPrefetchFTA or nonZeroTlhPrefetchFTA) */
 
 	MM_ObjectAllocationInterface *_objectAllocationInterface; /**< Pointer to TLHAllocationInterface instance */
+	MM_AllocationSampler::ThreadState *_samplerState; /**< Allocation sampler state of the TLHAllocationInterface instance */
 
 	MM_HeapLinkedFreeHeaderTLH *_abandonedList; /**< List of abandoned TLHs. Shaped like a free list. */
 	uintptr_t _abandonedListSize; /**< Number of entries in the abandoned list. */
 
 	const bool _zeroTLH; /**< if true this TLH is primary (might be cleared by batchClearTLH), if false this is secondary TLH (and it would not be cleared ever) */
 
+	void *_realTop; /**< top of the current TLH while it is lowered to the next allocation sample (NULL if not lowered) */
+	void *_sampledAlloc; /**< TLH allocation pointer when the allocation sampler was last brought up to date (NULL if not tracked) */
+
 public:
 protected:
 private:
@@ -172,6 +177,19 @@ private:
 
 	void updateFrequentObjectsStats(MM_EnvironmentBase *env);
 
+	/**
+	 * Undo lowerTopForSampling(), so the TLH has its real extent again.
+	 * @return the bytes allocated from the TLH since lowerTopForSampling()
+	 */
+	uintptr_t restoreTopForSampling();
+
+	/**
+	 * Start counting allocations from the current allocation pointer, and lower the top of the TLH to the next
+	 * sample point if it falls within the TLH.
+	 * @param bytesUntilSample allocated bytes remaining before the next sample
+	 */
+	void lowerTopForSampling(uintptr_t bytesUntilSample);
+
 	/**
 	 * Create a ThreadLocalHeap object.
 	 */
@@ -183,9 +201,12 @@ private:
 		_pointerToHeapTop(_languageTLH.getPointerToHeapTop(env, zeroTLH)),
 		_pointerToTlhPrefetchFTA(_languageTLH.getPointerToTlhPrefetchFTA(env, zeroTLH)),
 		_objectAllocationInterface(NULL),
+		_samplerState(NULL),
 		_abandonedList(NULL),
 		_abandonedListSize(0),
-		_zeroTLH(zeroTLH)
+		_zeroTLH(zeroTLH),
+		_realTop(NULL),
+		_sampledAlloc(NULL)
 	{};
 
 	/*
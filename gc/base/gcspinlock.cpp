@@ -192,3 +192,232 @@ omrgc_spinlock_release(J9GCSpinlock *spinlock)
 	}
 	return result;
 }
+
+#define J9GC_QUEUED_SPINLOCK_HELD ((uintptr_t)0x1)
+#define J9GC_QUEUED_SPINLOCK_HEAD_PARKED ((uintptr_t)0x2)
+
+#define J9GC_QUEUED_SPINLOCK_NODE_WAITING ((uintptr_t)0)
+#define J9GC_QUEUED_SPINLOCK_NODE_PARKED ((uintptr_t)1)
+#define J9GC_QUEUED_SPINLOCK_NODE_GRANTED ((uintptr_t)2)
+
+/**
+ * Spin (with back-off) until the predecessor hands the head of the queue over to the node.
+ * The node state is polled for at most spinCount2 * spinCount3 iterations, after which the thread parks.
+ * @param[in] spinlock queued spinlock being acquired
+ * @param[in] node queue node of the calling thread
+ * @return true if the thread had to park
+ */
+static bool
+queuedSpinlockWaitForHead(J9GCQueuedSpinlock *spinlock, J9GCQueuedSpinlockNode *node)
+{
+	for (uintptr_t spinCount3 = spinlock->spinCount3; spinCount3 > 0; spinCount3--) {
+		for (uintptr_t spinCount2 = spinlock->spinCount2; spinCount2 > 0; spinCount2--) {
+			if (J9GC_QUEUED_SPINLOCK_NODE_GRANTED == node->state) {
+				return false;
+			}
+
+			MM_AtomicOperations::yieldCPU();
+
+			/* begin tight loop */
+			for (uintptr_t spinCount1 = spinlock->spinCount1; spinCount1 > 0; spinCount1--)	{
+				MM_AtomicOperations::nop();
+			} /* end tight loop */
+		}
+#if defined(OMR_THR_YIELD_ALG)
+		omrthread_yield_new(spinCount3);
+#else /* OMR_THR_YIELDALG */
+		omrthread_yield();
+#endif /* OMR_THR_YIELDALG */
+	}
+
+	/* Announce that we are about to park; if the predecessor granted in the meantime the exchange fails */
+	if (J9GC_QUEUED_SPINLOCK_NODE_WAITING == MM_AtomicOperations::lockCompareExchange(&node->state, J9GC_QUEUED_SPINLOCK_NODE_WAITING, J9GC_QUEUED_SPINLOCK_NODE_PARKED)) {
+		while (J9GC_QUEUED_SPINLOCK_NODE_GRANTED != node->state) {
+			if (0 != omrthread_park(0, 0)) {
+				/* park returns immediately while the thread has a pending interrupt */
+				omrthread_yield();
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Acquire the lock word as the head of the queue.
+ * The lock word is polled for at most spinCount2 * spinCount3 iterations before the thread
+ * waits on the OS semaphore, to be posted by the next release.
+ * @param[in] spinlock queued spinlock being acquired
+ * @return true if the thread had to wait on the semaphore
+ */
+static bool
+queuedSpinlockAcquireAsHead(J9GCQueuedSpinlock *spinlock)
+{
+	bool waited = false;
+	for (;;) {
+		for (uintptr_t spinCount3 = spinlock->spinCount3; spinCount3 > 0; spinCount3--) {
+			for (uintptr_t spinCount2 = spinlock->spinCount2; spinCount2 > 0; spinCount2--) {
+				if ((0 == spinlock->lockWord) && (0 == MM_AtomicOperations::lockCompareExchange(&spinlock->lockWord, 0, J9GC_QUEUED_SPINLOCK_HELD))) {
+					return waited;
+				}
+
+				MM_AtomicOperations::yieldCPU();
+
+				/* begin tight loop */
+				for (uintptr_t spinCount1 = spinlock->spinCount1; spinCount1 > 0; spinCount1--)	{
+					MM_AtomicOperations::nop();
+				} /* end tight loop */
+			}
+#if defined(OMR_THR_YIELD_ALG)
+			omrthread_yield_new(spinCount3);
+#else /* OMR_THR_YIELDALG */
+			omrthread_yield();
+#endif /* OMR_THR_YIELDALG */
+		}
+
+		/* Only the head of the queue ever parks on the lock word, so a single flag is sufficient */
+		if (J9GC_QUEUED_SPINLOCK_HELD == MM_AtomicOperations::lockCompareExchange(&spinlock->lockWord, J9GC_QUEUED_SPINLOCK_HELD, J9GC_QUEUED_SPINLOCK_HELD | J9GC_QUEUED_SPINLOCK_HEAD_PARKED)) {
+			j9sem_wait(spinlock->osSemaphore);
+			waited = true;
+		}
+	}
+}
+
+/**
+ * Hand the head of the queue over to the successor of node, if there is one.
+ * Once this returns the node is no longer referenced by the queue.
+ * @param[in] spinlock queued spinlock that has just been acquired
+ * @param[in] node queue node of the calling thread
+ */
+static void
+queuedSpinlockPassHead(J9GCQueuedSpinlock *spinlock, J9GCQueuedSpinlockNode *node)
+{
+	if ((node == spinlock->tail) && ((uintptr_t)node == MM_AtomicOperations::lockCompareExchange((volatile uintptr_t *)&spinlock->tail, (uintptr_t)node, (uintptr_t)NULL))) {
+		/* no successor */
+		return;
+	}
+
+	/* A successor has swapped itself in as the tail but may not have linked itself to us yet */
+	J9GCQueuedSpinlockNode *successor = node->next;
+	while (NULL == successor) {
+		MM_AtomicOperations::yieldCPU();
+		successor = node->next;
+	}
+
+	/* The successor node may go away as soon as it observes GRANTED, so read the thread first */
+	omrthread_t successorThread = successor->thread;
+	if (J9GC_QUEUED_SPINLOCK_NODE_WAITING != MM_AtomicOperations::lockCompareExchange(&successor->state, J9GC_QUEUED_SPINLOCK_NODE_WAITING, J9GC_QUEUED_SPINLOCK_NODE_GRANTED)) {
+		/* the successor has parked (or is about to) */
+		MM_AtomicOperations::lockCompareExchange(&successor->state, J9GC_QUEUED_SPINLOCK_NODE_PARKED, J9GC_QUEUED_SPINLOCK_NODE_GRANTED);
+		omrthread_unpark(successorThread);
+	}
+}
+
+/**
+ * Wait on a queued spinlock.
+ * An uncontended lock is taken with a single atomic on the lock word. Otherwise the thread
+ * queues up behind earlier waiters and spins on its own queue node until it becomes the head.
+ * @param[in] spinlock queued spinlock to be waited on
+ * @param[in] lockTracing lock statistics
+ * @return  0 on success or negative value on failure
+ */
+intptr_t
+omrgc_queued_spinlock_acquire(J9GCQueuedSpinlock *spinlock, J9ThreadMonitorTracing*  lockTracing)
+{
+	bool slow = false;
+
+	if ((NULL != spinlock->tail) || (0 != MM_AtomicOperations::lockCompareExchange(&spinlock->lockWord, 0, J9GC_QUEUED_SPINLOCK_HELD))) {
+		J9GCQueuedSpinlockNode node;
+		node.next = NULL;
+		node.state = J9GC_QUEUED_SPINLOCK_NODE_WAITING;
+		node.thread = omrthread_self();
+
+		/* Atomically swap ourselves in as the new tail of the queue */
+		J9GCQueuedSpinlockNode *predecessor = spinlock->tail;
+		for (;;) {
+			J9GCQueuedSpinlockNode *oldTail = predecessor;
+			predecessor = (J9GCQueuedSpinlockNode *)MM_AtomicOperations::lockCompareExchange((volatile uintptr_t *)&spinlock->tail, (uintptr_t)oldTail, (uintptr_t)&node);
+			if (oldTail == predecessor) {
+				break;
+			}
+		}
+
+		if (NULL != predecessor) {
+			predecessor->next = &node;
+			slow = queuedSpinlockWaitForHead(spinlock, &node);
+		}
+
+		slow = queuedSpinlockAcquireAsHead(spinlock) || slow;
+		queuedSpinlockPassHead(spinlock, &node);
+	}
+
+#if defined(OMR_THR_JLM)
+	J9ThreadMonitorTracing* tracing = lockTracing;
+	if (tracing != NULL) {
+		if (slow) {
+			tracing->slow_count++;
+		}
+		UPDATE_JLM_MON_ENTER(tracing);
+	}
+#endif /* OMR_THR_JLM */
+	/* On out-of-order memory models (e.g. Power4), ensure that all reads and writes have been completed at this point */
+	MM_AtomicOperations::readWriteBarrier();
+	return 0;
+}
+
+/**
+ * Destroy a queued spinlock.
+ * @param[in] spinlock queued spinlock to be destroyed
+ * @return  0 on success or negative value on failure
+ */
+intptr_t
+omrgc_queued_spinlock_destroy(J9GCQueuedSpinlock *spinlock)
+{
+	return j9sem_destroy(spinlock->osSemaphore);
+}
+
+/**
+ * Initialize a queued spinlock.
+ * @param[in] spinlock pointer to queued spinlock to be initialized
+ * @return  0 on success or negative value on failure
+ */
+intptr_t
+omrgc_queued_spinlock_init(J9GCQueuedSpinlock *spinlock)
+{
+	intptr_t result;
+
+	spinlock->lockWord = 0;
+	spinlock->tail = NULL;
+
+	result = j9sem_init(&spinlock->osSemaphore, 0);
+
+	MM_AtomicOperations::writeBarrier();
+
+	return result;
+}
+
+/**
+ * Release a queued spinlock.
+ * @param[in] spinlock queued spinlock to be released
+ * @return  0 on success or negative value on failure
+ */
+intptr_t
+omrgc_queued_spinlock_release(J9GCQueuedSpinlock *spinlock)
+{
+	intptr_t result = 0;
+	MM_AtomicOperations::writeBarrier();
+
+	uintptr_t oldValue = spinlock->lockWord;
+	for (;;) {
+		uintptr_t value = MM_AtomicOperations::lockCompareExchange(&spinlock->lockWord, oldValue, 0);
+		if (oldValue == value) {
+			break;
+		}
+		oldValue = value;
+	}
+
+	if (J9GC_QUEUED_SPINLOCK_HEAD_PARKED == (oldValue & J9GC_QUEUED_SPINLOCK_HEAD_PARKED)) {
+		result = j9sem_post(spinlock->osSemaphore); /* Wake the head of the queue */
+	}
+	return result;
+}
@@ -35,10 +35,40 @@ typedef struct J9GCSpinlock {
     uintptr_t spinCount3;
 } J9GCSpinlock;
 
+/**
+ * Queue node of a waiter on a J9GCQueuedSpinlock.
+ * The node lives on the stack of the acquiring thread, which spins on its own state field only.
+ */
+typedef struct J9GCQueuedSpinlockNode {
+    struct J9GCQueuedSpinlockNode * volatile next;
+    volatile uintptr_t state;
+    omrthread_t thread;
+} J9GCQueuedSpinlockNode;
+
+/**
+ * Spinlock with a FIFO queue of waiters (MCS style) in front of a single lock word.
+ * Only the waiter at the head of the queue polls the lock word, all other waiters spin
+ * on their own queue node and park after a bounded spin, so the lock word cache line is
+ * not hammered under heavy contention and waiters acquire the lock in arrival order.
+ */
+typedef struct J9GCQueuedSpinlock {
+    volatile uintptr_t lockWord;
+    j9sem_t osSemaphore;
+    uintptr_t spinCount1;
+    uintptr_t spinCount2;
+    uintptr_t spinCount3;
+    J9GCQueuedSpinlockNode * volatile tail;
+} J9GCQueuedSpinlock;
+
 
 intptr_t omrgc_spinlock_destroy(J9GCSpinlock *spinlock);
 intptr_t omrgc_spinlock_init(J9GCSpinlock *spinlock);
 intptr_t omrgc_spinlock_release(J9GCSpinlock *spinlock);
 intptr_t omrgc_spinlock_acquire(J9GCSpinlock *spinlock, J9ThreadMonitorTracing*  lockTracing);
 
+intptr_t omrgc_queued_spinlock_destroy(J9GCQueuedSpinlock *spinlock);
+intptr_t omrgc_queued_spinlock_init(J9GCQueuedSpinlock *spinlock);
+intptr_t omrgc_queued_spinlock_release(J9GCQueuedSpinlock *spinlock);
+intptr_t omrgc_queued_spinlock_acquire(J9GCQueuedSpinlock *spinlock, J9ThreadMonitorTracing*  lockTracing);
+
 #endif /* GCSPINLOCK_HPP_ */
@@ -83,6 +83,8 @@ getCompactionReasonAsString(CompactReason reason)
 			return "previous scavenge aborted";
 		case COMPACT_CONTRACT:
 			return "compact to aid heap contraction";
+		case COMPACT_PREDICTED_FRAGMENTATION:
+			return "large allocation failure predicted";
 		default:
 			return "unknown";
 	}
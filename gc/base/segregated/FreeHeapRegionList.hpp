@@ -96,6 +96,19 @@ public:
 	}
 
 	virtual uintptr_t getMaxRegions() = 0;
+
+	/**
+	 * A free list may be split into several independently locked shards to reduce contention.
+	 * Bulk transfers between lists are performed one shard at a time.
+	 * @return the number of shards making up the receiver
+	 */
+	virtual uintptr_t getShardCount() { return 1; }
+
+	/**
+	 * @param index The index of the shard, less than getShardCount()
+	 * @return the shard at the given index (the receiver itself for an unsharded list)
+	 */
+	virtual MM_FreeHeapRegionList *getShard(uintptr_t index) { return this; }
 		
 	/* Methods inherited from HeapRegionList */
 	virtual bool isEmpty() { return 0 == _length; }
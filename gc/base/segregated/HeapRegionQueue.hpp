@@ -76,6 +76,19 @@ public:
 
 	virtual uintptr_t debugCountFreeBytesInRegions() = 0;
 
+	/**
+	 * A queue may be split into several independently locked shards to reduce contention.
+	 * Bulk transfers between queues are performed one shard at a time.
+	 * @return the number of shards making up the receiver
+	 */
+	virtual uintptr_t getShardCount() { return 1; }
+
+	/**
+	 * @param index The index of the shard, less than getShardCount()
+	 * @return the shard at the given index (the receiver itself for an unsharded queue)
+	 */
+	virtual MM_HeapRegionQueue *getShard(uintptr_t index) { return this; }
+
 	/* Virtual methods inherited from RegionList */
 	virtual bool isEmpty() = 0;
 	virtual uintptr_t getTotalRegions() = 0;
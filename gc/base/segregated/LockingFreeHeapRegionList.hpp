@@ -72,8 +72,17 @@ public:
 	
 	virtual void
 	push(MM_HeapRegionQueue *srcAsPQ)
-	{ 
-		MM_LockingHeapRegionQueue* src = MM_LockingHeapRegionQueue::asLockingHeapRegionQueue(srcAsPQ);
+	{
+		uintptr_t shardCount = srcAsPQ->getShardCount();
+		for (uintptr_t i = 0; i < shardCount; i++) {
+			pushAll(MM_LockingHeapRegionQueue::asLockingHeapRegionQueue(srcAsPQ->getShard(i)));
+		}
+	}
+
+	/* push all of src (which must be unsharded) on the front of the receiver */
+	void
+	pushAll(MM_LockingHeapRegionQueue *src)
+	{
 		if (src->_head == NULL) { /* Nothing to move - single read needs no lock */
 			return;
 		}
@@ -104,8 +113,17 @@ public:
 	
 	virtual void 
 	push(MM_FreeHeapRegionList *srcAsFPL) 
-	{ 
-		MM_LockingFreeHeapRegionList* src = MM_LockingFreeHeapRegionList::asLockingFreeHeapRegionList(srcAsFPL);
+	{
+		uintptr_t shardCount = srcAsFPL->getShardCount();
+		for (uintptr_t i = 0; i < shardCount; i++) {
+			pushAll(MM_LockingFreeHeapRegionList::asLockingFreeHeapRegionList(srcAsFPL->getShard(i)));
+		}
+	}
+
+	/* push all of src (which must be unsharded) on the front of the receiver */
+	void
+	pushAll(MM_LockingFreeHeapRegionList *src)
+	{
 		if (src->_head == NULL) { /* Nothing to move - single read needs no lock */
 			return;
 		}
@@ -89,7 +89,15 @@ public:
 	/* enqueue src at the _end_ of the receiver's queue */
 	virtual void enqueue(MM_HeapRegionQueue *srcAsPQ)
 	{
-		MM_LockingHeapRegionQueue* src = MM_LockingHeapRegionQueue::asLockingHeapRegionQueue(srcAsPQ);
+		uintptr_t shardCount = srcAsPQ->getShardCount();
+		for (uintptr_t i = 0; i < shardCount; i++) {
+			enqueueAll(MM_LockingHeapRegionQueue::asLockingHeapRegionQueue(srcAsPQ->getShard(i)));
+		}
+	}
+
+	/* enqueue all of src (which must be unsharded) at the _end_ of the receiver's queue */
+	void enqueueAll(MM_LockingHeapRegionQueue *src)
+	{
 		if (NULL == src->_head) { /* Nothing to move - single read needs no lock */
 			return;
 		}
@@ -139,7 +147,8 @@ public:
 
 	virtual uintptr_t dequeue(MM_HeapRegionQueue *targetAsPQ, uintptr_t count)
 	{
-		MM_LockingHeapRegionQueue* target = MM_LockingHeapRegionQueue::asLockingHeapRegionQueue(targetAsPQ);
+		/* a sharded target receives everything into its first shard */
+		MM_LockingHeapRegionQueue* target = MM_LockingHeapRegionQueue::asLockingHeapRegionQueue(targetAsPQ->getShard(0));
 		lock();
 		target->lock();
 		uintptr_t moved = dequeueInternal(target, count);
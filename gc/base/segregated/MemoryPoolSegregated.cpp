@@ -312,16 +312,46 @@ MM_MemoryPoolSegregated::abandonHeapChunk(void *addrBase, void *addrTop)
 	return false;
 }
 
+uintptr_t
+MM_MemoryPoolSegregated::getApproximateUnsweptFreeMemorySize()
+{
+	uintptr_t unsweptFree = 0;
+	if (0 != _regionPool->getCurrentTotalCountOfSweepRegions()) {
+		MM_SizeClasses *sizeClasses = _extensions->defaultSizeClasses;
+		for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+			uintptr_t unsweptRegions = _regionPool->getCurrentCountOfSweepRegions(sizeClass);
+			if (0 != unsweptRegions) {
+				float occupancy = OMR_MAX(0.0f, OMR_MIN(1.0f, _regionPool->getOccupancy(sizeClass)));
+				uintptr_t regionCellBytes = sizeClasses->getNumCells(sizeClass) * sizeClasses->getCellSize(sizeClass);
+				unsweptFree += (uintptr_t)((float)(unsweptRegions * regionCellBytes) * (1.0f - occupancy));
+			}
+		}
+		/* Cells never allocated since the region was last swept are not in use either, so only count the dead
+		 * share of the allocated bytes, assuming they are spread evenly over the regions in use.
+		 */
+		uintptr_t inUseRegionBytes = _regionPool->getRegionsInuse() * _extensions->regionSize;
+		if (0 != inUseRegionBytes) {
+			float fill = OMR_MIN(1.0f, (float)_bytesInUse / inUseRegionBytes);
+			unsweptFree = (uintptr_t)((float)unsweptFree * fill);
+		}
+	}
+	return unsweptFree;
+}
+
 uintptr_t
 MM_MemoryPoolSegregated::getApproximateFreeMemorySize()
 {
-	return (_extensions->getHeap()->getHeapRegionManager()->getHeapSize() - getBytesInUse());
+	uintptr_t bytesInUse = getBytesInUse();
+	bytesInUse -= OMR_MIN(bytesInUse, getApproximateUnsweptFreeMemorySize());
+	return (_extensions->getHeap()->getHeapRegionManager()->getHeapSize() - bytesInUse);
 }
 
 uintptr_t
 MM_MemoryPoolSegregated::getApproximateActiveFreeMemorySize()
 {
-	return (_extensions->getHeap()->getActiveMemorySize() - getBytesInUse());
+	uintptr_t bytesInUse = getBytesInUse();
+	bytesInUse -= OMR_MIN(bytesInUse, getApproximateUnsweptFreeMemorySize());
+	return (_extensions->getHeap()->getActiveMemorySize() - bytesInUse);
 }
 
 uintptr_t
@@ -75,6 +75,12 @@ public:
 
 	MM_SegregatedAllocationTracker* createAllocationTracker(MM_EnvironmentBase* env);
 
+	/**
+	 * Estimate the free bytes in small regions left on the sweep lists by a budgeted sweep (-Xgc:sweepBudget),
+	 * from the average occupancy of their size class and how full the regions in use are. Those bytes are only
+	 * credited to the pool once the regions are swept lazily by allocating threads, so they still count as in use.
+	 */
+	uintptr_t getApproximateUnsweptFreeMemorySize();
 	uintptr_t getApproximateActiveFreeMemorySize();
 	virtual uintptr_t getApproximateFreeMemorySize();
 	virtual uintptr_t getActualFreeMemorySize();
@@ -38,6 +38,9 @@
 #include "OMR_VMThread.hpp"
 #include "OMRVMThreadListIterator.hpp"
 #include "SegregatedAllocationInterface.hpp"
+#include "ShardedFreeHeapRegionList.hpp"
+#include "ShardedHeapRegionQueue.hpp"
+#include "SweepStats.hpp"
 
 #include "RegionPoolSegregated.hpp"
 
@@ -135,12 +138,21 @@ MM_RegionPoolSegregated::initialize(MM_EnvironmentBase *env)
 MM_HeapRegionQueue*
 MM_RegionPoolSegregated::allocateHeapRegionQueue(MM_EnvironmentBase *env, MM_HeapRegionList::RegionListKind regionListKind, bool singleRegionsOnly, bool concurrentAccess, bool trackFreeBytes)
 {
+	uintptr_t shardCount = env->getExtensions()->regionListShardCount;
+	if (concurrentAccess && (0 < shardCount)) {
+		return MM_ShardedHeapRegionQueue::newInstance(env, regionListKind, singleRegionsOnly, shardCount, trackFreeBytes);
+	}
 	return MM_LockingHeapRegionQueue::newInstance(env, regionListKind, singleRegionsOnly, concurrentAccess, trackFreeBytes);
 }
 
 MM_FreeHeapRegionList*
 MM_RegionPoolSegregated::allocateFreeHeapRegionList(MM_EnvironmentBase *env, MM_HeapRegionList::RegionListKind regionListKind, bool singleRegionsOnly)
 {
+	/* the coalesce list detaches regions from arbitrary positions, so only the single and multi free lists may be sharded */
+	uintptr_t shardCount = env->getExtensions()->regionListShardCount;
+	if ((MM_HeapRegionList::HRL_KIND_COALESCE != regionListKind) && (0 < shardCount)) {
+		return MM_ShardedFreeHeapRegionList::newInstance(env, regionListKind, singleRegionsOnly, shardCount);
+	}
 	return MM_LockingFreeHeapRegionList::newInstance(env, regionListKind, singleRegionsOnly);
 }
 
@@ -408,9 +420,18 @@ MM_RegionPoolSegregated::sweepAndAllocateRegionFromSmallSizeClass(MM_Environment
 	MM_HeapRegionDescriptorSegregated *region = _smallSweepRegions[sizeClass]->dequeue();
 
 	if (region != NULL) {
+		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+		uint64_t startTime = omrtime_hires_clock();
 		_sweepScheme->sweepRegion(env, region);
+		uint64_t sweepTime = omrtime_hires_clock() - startTime;
+		MM_AtomicOperations::add(&_lazySweptRegionCount, 1);
+		MM_AtomicOperations::addU64(&_lazySweepTime, sweepTime);
+		uint64_t maxSweepTime = _maxLazySweepTime;
+		while ((sweepTime > maxSweepTime) && (maxSweepTime != MM_AtomicOperations::lockCompareExchangeU64(&_maxLazySweepTime, maxSweepTime, sweepTime))) {
+			maxSweepTime = _maxLazySweepTime;
+		}
 		/* Keep maintaining the occupancy info even while doing nondeterministic sweeps */
-		_smallOccupancy[sizeClass] = (_smallOccupancy[sizeClass] * 0.9f) + (region->getMemoryPoolACL()->getMarkCount() / region->getNumCells() * 0.1f );
+		_smallOccupancy[sizeClass] = (_smallOccupancy[sizeClass] * 0.9f) + ((float)region->getMemoryPoolACL()->getMarkCount() / region->getNumCells() * 0.1f);
 		decrementCurrentCountOfSweepRegions(sizeClass, 1);
 		decrementCurrentTotalCountOfSweepRegions(1);
 		_smallFullRegions[sizeClass]->enqueue(region);
@@ -418,6 +439,18 @@ MM_RegionPoolSegregated::sweepAndAllocateRegionFromSmallSizeClass(MM_Environment
 	return region;
 }
 
+void
+MM_RegionPoolSegregated::consumeLazySweepStats(MM_SweepStats *sweepStats)
+{
+	/* Called with mutators stopped, so no lazy sweep can race with the reset */
+	sweepStats->_lazySweptRegionCount = _lazySweptRegionCount;
+	sweepStats->_lazySweepTime = _lazySweepTime;
+	sweepStats->_maxLazySweepTime = _maxLazySweepTime;
+	_lazySweptRegionCount = 0;
+	_lazySweepTime = 0;
+	_maxLazySweepTime = 0;
+}
+
 void
 MM_RegionPoolSegregated::updateOccupancy (uintptr_t sizeClass, uintptr_t occupancy)
 {
@@ -39,6 +39,7 @@ class MM_FreeHeapRegionList;
 class MM_HeapRegionDescriptorSegregated;
 class MM_HeapRegionQueue;
 class MM_LockingHeapRegionQueue;
+class MM_SweepStats;
 
 #define PRIMARY_BUCKET 0
 #define SKIP_AVAILABLE_REGION_FOR_ALLOCATION 1
@@ -136,6 +137,9 @@ private:
 	volatile uintptr_t _currentTotalCountOfSweepRegions;
 	
 	bool _isSweepingSmall; /**< if GC is sweeping small pages */
+	volatile uintptr_t _lazySweptRegionCount; /**< Number of small regions swept by allocating threads since the stats were last consumed */
+	volatile uint64_t _lazySweepTime; /**< Total time (hires ticks) spent in lazy sweep increments since the stats were last consumed */
+	volatile uint64_t _maxLazySweepTime; /**< Longest single lazy sweep increment (hires ticks) since the stats were last consumed */
 	uintptr_t _splitAvailableListSplitCount; /* number of split available region queues per size class per defragment bucket */
 	uint8_t _skipAvailableRegionForAllocation[OMR_SIZECLASSES_NUM_SMALL+1]; /* per size class flag to indicate if there is any available regions left for allocation for that size class */
 
@@ -241,6 +245,12 @@ public:
 	void resetSkipAvailableRegionForAllocation() { memset(&_skipAvailableRegionForAllocation[0], 0, sizeof(_skipAvailableRegionForAllocation)); }
 
 	void updateOccupancy (uintptr_t sizeClass, uintptr_t occupancy);
+
+	/**
+	 * Move the lazy sweep increment counters accumulated by allocating threads into the given stats and reset them.
+	 * @param[out] sweepStats stats to receive the lazy sweep counters
+	 */
+	void consumeLazySweepStats(MM_SweepStats *sweepStats);
 	
 
 	MMINLINE MM_FreeHeapRegionList *getSingleFreeList() { return _singleFreeList; }
@@ -277,6 +287,9 @@ public:
 		, _largeSweepRegions(NULL)
 		, _regionsInUse(0)
 		, _isSweepingSmall(false)
+		, _lazySweptRegionCount(0)
+		, _lazySweepTime(0)
+		, _maxLazySweepTime(0)
 	{
 		_typeId = __FUNCTION__;
 	}
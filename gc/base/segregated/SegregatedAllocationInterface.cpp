@@ -35,6 +35,7 @@
 #include "MemorySubSpace.hpp"
 #include "SizeClasses.hpp"
 #include "ObjectHeapIteratorSegregated.hpp"
+#include "SegregatedAllocationTracker.hpp"
 
 #include "SegregatedAllocationInterface.hpp"
 
@@ -149,6 +150,10 @@ MM_SegregatedAllocationInterface::allocateObject(MM_EnvironmentBase *env, MM_All
 	uintptr_t sizeInBytes = allocateDescription->getBytesRequested();
 	/* Record the memory space from which the allocation takes place in the AD */
 	allocateDescription->setMemorySpace(memorySpace);
+
+	if (env->getExtensions()->sizeClassProfiling && (NULL != env->_allocationTracker)) {
+		env->_allocationTracker->addAllocationSize(env, sizeInBytes);
+	}
 	
 	if (shouldCollectOnFailure) {
 		allocateDescription->setObjectFlags(memorySpace->getDefaultMemorySubSpace()->getObjectFlags());
@@ -60,6 +60,15 @@ MM_SegregatedAllocationTracker::initialize(MM_EnvironmentBase *env, uintptr_t vo
 	_flushThreshold = flushThreshold;
 	_globalBytesInUse = globalBytesInUse;
 	updateAllocationTrackerThreshold(env);
+
+	if (env->getExtensions()->sizeClassProfiling) {
+		uintptr_t countsSize = sizeof(uintptr_t) * OMR_SIZECLASSES_HISTOGRAM_BUCKETS;
+		_allocationSizeCounts = (uintptr_t *)env->getForge()->allocate(countsSize, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+		if (NULL == _allocationSizeCounts) {
+			return false;
+		}
+		memset(_allocationSizeCounts, 0, countsSize);
+	}
 	return true;
 }
 
@@ -71,6 +80,12 @@ MM_SegregatedAllocationTracker::tearDown(MM_EnvironmentBase *env)
 	 */
 	flushBytes();
 	updateAllocationTrackerThreshold(env);
+
+	if (NULL != _allocationSizeCounts) {
+		flushAllocationSizes(env);
+		env->getForge()->free(_allocationSizeCounts);
+		_allocationSizeCounts = NULL;
+	}
 }
 
 void
@@ -134,4 +149,18 @@ MM_SegregatedAllocationTracker::flushBytes()
 	_bytesAllocated = 0;
 }
 
+/**
+ * Merges this thread's allocation size counts into the global size class histogram.
+ */
+void
+MM_SegregatedAllocationTracker::flushAllocationSizes(MM_EnvironmentBase *env)
+{
+	MM_SizeClasses *sizeClasses = env->getExtensions()->defaultSizeClasses;
+	if (NULL != sizeClasses) {
+		sizeClasses->addAllocationSizeCounts(env, _allocationSizeCounts);
+	}
+	memset(_allocationSizeCounts, 0, sizeof(uintptr_t) * OMR_SIZECLASSES_HISTOGRAM_BUCKETS);
+	_allocationSizesRecorded = 0;
+}
+
 #endif /* OMR_GC_SEGREGATED_HEAP */
@@ -25,8 +25,13 @@
 
 #include "omrcomp.h"
 
+#include "SizeClasses.hpp"
+
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
+/* Number of allocations a tracker counts locally before merging them into the global size histogram */
+#define ALLOCATION_SIZE_FLUSH_THRESHOLD 4096
+
 class MM_EnvironmentBase;
 
 class MM_SegregatedAllocationTracker : public MM_BaseVirtual
@@ -37,6 +42,8 @@ private:
 	intptr_t _bytesAllocated; /**< A negative amount indicates this tracker has freed more bytes than allocated. */
 	uintptr_t _flushThreshold; /**< If |bytesAllocated| > this threshold, we'll flush the bytes allocated to the pool. */
 	volatile uintptr_t *_globalBytesInUse; /**< The memory pool accumulator to flush bytes to */
+	uintptr_t *_allocationSizeCounts; /**< Allocation counts per size histogram bucket, only allocated when size class profiling is enabled */
+	uintptr_t _allocationSizesRecorded; /**< Number of allocations counted in _allocationSizeCounts since it was last flushed */
 
 public:
 	static MM_SegregatedAllocationTracker* newInstance(MM_EnvironmentBase *env, volatile uintptr_t *globalBytesInUse, uintptr_t flushThreshold);
@@ -48,6 +55,22 @@ public:
 	void addBytesAllocated(MM_EnvironmentBase* env, uintptr_t bytesAllocated);
 	void addBytesFreed(MM_EnvironmentBase* env, uintptr_t bytesFreed);
 	intptr_t getUnflushedBytesAllocated(MM_EnvironmentBase* env) { return _bytesAllocated; }
+
+	/**
+	 * Count an allocation request in the size histogram used to tune the size class table.
+	 * Does nothing unless size class profiling is enabled.
+	 */
+	MMINLINE void
+	addAllocationSize(MM_EnvironmentBase* env, uintptr_t sizeInBytes)
+	{
+		if (NULL != _allocationSizeCounts) {
+			_allocationSizeCounts[MM_SizeClasses::getHistogramBucket(sizeInBytes)] += 1;
+			_allocationSizesRecorded += 1;
+			if (_allocationSizesRecorded >= ALLOCATION_SIZE_FLUSH_THRESHOLD) {
+				flushAllocationSizes(env);
+			}
+		}
+	}
 	
 protected:
 	virtual bool initialize(MM_EnvironmentBase *env, uintptr_t volatile *globalBytesInUse, uintptr_t flushThreshold);
@@ -58,11 +81,14 @@ private:
 		_bytesAllocated(0)
 		,_flushThreshold(0)
 		,_globalBytesInUse(NULL)
+		,_allocationSizeCounts(NULL)
+		,_allocationSizesRecorded(0)
 	{
 		_typeId = __FUNCTION__;
 	};
 
 	void flushBytes();
+	void flushAllocationSizes(MM_EnvironmentBase* env);
 };
 
 #endif /* OMR_GC_SEGREGATED_HEAP */
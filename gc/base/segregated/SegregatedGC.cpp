@@ -30,6 +30,7 @@
 #include "modronapicore.hpp"
 #include "MemoryPoolSegregated.hpp"
 #include "ParallelMarkTask.hpp"
+#include "RegionPoolSegregated.hpp"
 #include "SegregatedAllocationInterface.hpp"
 #include "SegregatedMarkingScheme.hpp"
 #include "SegregatedSweepTask.hpp"
@@ -225,10 +226,16 @@ MM_SegregatedGC::internalGarbageCollect(MM_EnvironmentBase *env, MM_MemorySubSpa
 	 * Sweeping
 	 */
 	MM_SweepStats *sweepStats = &_extensions->globalGCStats.sweepStats;
+	MM_MemoryPoolSegregated *memoryPool = (MM_MemoryPoolSegregated *) env->getDefaultMemorySubSpace()->getMemoryPool();
+	MM_RegionPoolSegregated *regionPool = memoryPool->getRegionPool();
+	/* Lazy sweep increments run by allocating threads since the previous cycle */
+	regionPool->consumeLazySweepStats(sweepStats);
 	reportSweepStart(env);
 	sweepStats->_startTime = omrtime_hires_clock();
-	MM_SegregatedSweepTask sweepTask(env, _dispatcher, _sweepScheme, (MM_MemoryPoolSegregated *) env->getDefaultMemorySubSpace()->getMemoryPool());
+	MM_SegregatedSweepTask sweepTask(env, _dispatcher, _sweepScheme, memoryPool);
 	_dispatcher->run(env, &sweepTask);
+	/* Regions left behind by a budgeted sweep (-Xgc:sweepBudget) are swept lazily on allocation */
+	sweepStats->_unsweptRegionCount = regionPool->getCurrentTotalCountOfSweepRegions();
 	MM_MemorySubSpace *activeSubSpace = env->_cycleState->_activeSubSpace;
 	bool isExplicitGC = env->_cycleState->_gcCode.isExplicitGC();
 	/* We now have accurate free space statistics so recalculate any expand/contract amount */
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "modronopt.h"
+
+#include "EnvironmentBase.hpp"
+#include "HeapRegionDescriptorSegregated.hpp"
+#include "Math.hpp"
+#include "ShardedFreeHeapRegionList.hpp"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+MM_ShardedFreeHeapRegionList *
+MM_ShardedFreeHeapRegionList::newInstance(MM_EnvironmentBase *env, MM_HeapRegionList::RegionListKind regionListKind, bool singleRegionsOnly, uintptr_t shardCount)
+{
+	MM_ShardedFreeHeapRegionList *fpl = (MM_ShardedFreeHeapRegionList *)env->getForge()->allocate(sizeof(MM_ShardedFreeHeapRegionList), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (fpl) {
+		new (fpl) MM_ShardedFreeHeapRegionList(regionListKind, singleRegionsOnly, shardCount);
+		if (!fpl->initialize(env)) {
+			fpl->kill(env);
+			return NULL;
+		}
+	}
+	return fpl;
+}
+
+void
+MM_ShardedFreeHeapRegionList::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_ShardedFreeHeapRegionList::initialize(MM_EnvironmentBase *env)
+{
+	Assert_MM_true(0 < _shardCount);
+	_shardStride = MM_Math::roundToCeiling(HEAP_REGION_SHARD_ALIGNMENT, sizeof(MM_LockingFreeHeapRegionList));
+	/* the forge only guarantees pointer alignment, so over-allocate to keep each shard on its own cache lines */
+	_shardsMemory = env->getForge()->allocate((_shardStride * _shardCount) + HEAP_REGION_SHARD_ALIGNMENT - 1, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _shardsMemory) {
+		return false;
+	}
+	_shards = (void *)MM_Math::roundToCeiling(HEAP_REGION_SHARD_ALIGNMENT, (uintptr_t)_shardsMemory);
+
+	/* construct every shard before initializing any so that tearDown can safely visit them all */
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		new (getLockingShard(i)) MM_LockingFreeHeapRegionList(_regionListKind, _singleRegionsOnly);
+	}
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		if (!getLockingShard(i)->initialize(env)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+MM_ShardedFreeHeapRegionList::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _shards) {
+		for (uintptr_t i = 0; i < _shardCount; i++) {
+			getLockingShard(i)->tearDown(env);
+		}
+		env->getForge()->free(_shardsMemory);
+		_shardsMemory = NULL;
+		_shards = NULL;
+	}
+}
+
+void
+MM_ShardedFreeHeapRegionList::push(MM_HeapRegionQueue *src)
+{
+	uintptr_t srcShardCount = src->getShardCount();
+	uintptr_t home = MM_ShardedHeapRegionQueue::getHomeShardIndex(_shardCount);
+	for (uintptr_t i = 0; i < srcShardCount; i++) {
+		getLockingShard((home + i) % _shardCount)->push(src->getShard(i));
+	}
+}
+
+void
+MM_ShardedFreeHeapRegionList::push(MM_FreeHeapRegionList *src)
+{
+	uintptr_t srcShardCount = src->getShardCount();
+	uintptr_t home = MM_ShardedHeapRegionQueue::getHomeShardIndex(_shardCount);
+	for (uintptr_t i = 0; i < srcShardCount; i++) {
+		getLockingShard((home + i) % _shardCount)->push(src->getShard(i));
+	}
+}
+
+MM_HeapRegionDescriptorSegregated *
+MM_ShardedFreeHeapRegionList::pop()
+{
+	MM_HeapRegionDescriptorSegregated *region = NULL;
+	uintptr_t home = MM_ShardedHeapRegionQueue::getHomeShardIndex(_shardCount);
+	for (uintptr_t i = 0; (NULL == region) && (i < _shardCount); i++) {
+		MM_LockingFreeHeapRegionList *shard = getLockingShard((home + i) % _shardCount);
+		/* unlocked emptiness check avoids taking the lock of shards with nothing to give */
+		if (!shard->isEmpty()) {
+			region = shard->pop();
+		}
+	}
+	return region;
+}
+
+MM_HeapRegionDescriptorSegregated *
+MM_ShardedFreeHeapRegionList::allocate(MM_EnvironmentBase *env, uintptr_t szClass, uintptr_t numRegions, uintptr_t maxExcess)
+{
+	MM_HeapRegionDescriptorSegregated *region = NULL;
+	uintptr_t home = MM_ShardedHeapRegionQueue::getHomeShardIndex(_shardCount);
+	for (uintptr_t i = 0; (NULL == region) && (i < _shardCount); i++) {
+		MM_LockingFreeHeapRegionList *shard = getLockingShard((home + i) % _shardCount);
+		if (!shard->isEmpty()) {
+			region = shard->allocate(env, szClass, numRegions, maxExcess);
+		}
+	}
+	return region;
+}
+
+bool
+MM_ShardedFreeHeapRegionList::isEmpty()
+{
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		if (!getLockingShard(i)->isEmpty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uintptr_t
+MM_ShardedFreeHeapRegionList::getTotalRegions()
+{
+	uintptr_t count = 0;
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		count += getLockingShard(i)->getTotalRegions();
+	}
+	return count;
+}
+
+uintptr_t
+MM_ShardedFreeHeapRegionList::getMaxRegions()
+{
+	uintptr_t max = 0;
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		uintptr_t shardMax = getLockingShard(i)->getMaxRegions();
+		max = (max > shardMax) ? max : shardMax;
+	}
+	return max;
+}
+
+void
+MM_ShardedFreeHeapRegionList::showList(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	omrtty_printf("ShardedFreeHeapRegionList 0x%x (%d shards):\n", this, _shardCount);
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		getLockingShard(i)->showList(env);
+	}
+}
+
+#endif /* OMR_GC_SEGREGATED_HEAP */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SHARDEDFREEHEAPREGIONLIST_HPP_)
+#define SHARDEDFREEHEAPREGIONLIST_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "modronopt.h"
+
+#include "EnvironmentBase.hpp"
+#include "FreeHeapRegionList.hpp"
+#include "HeapRegionDescriptorSegregated.hpp"
+#include "LockingFreeHeapRegionList.hpp"
+#include "ShardedHeapRegionQueue.hpp"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+/**
+ * A free region list split into several independently locked shards.
+ * Regions are pushed to and popped from the calling thread's home shard first.
+ * Since a region's shard is not recorded, detach() is not supported, so a sharded
+ * list must not be used as the coalesce list.
+ */
+class MM_ShardedFreeHeapRegionList : public MM_FreeHeapRegionList
+{
+/* Data members & types */
+public:
+protected:
+private:
+	uintptr_t _shardCount; /**< Number of shards, at least 1 */
+	uintptr_t _shardStride; /**< Distance in bytes between consecutive shards in _shards */
+	void *_shardsMemory; /**< Forge allocation backing _shards, freed in tearDown */
+	void *_shards; /**< Storage for the shards, each an MM_LockingFreeHeapRegionList, aligned to HEAP_REGION_SHARD_ALIGNMENT */
+
+/* Methods */
+public:
+	static MM_ShardedFreeHeapRegionList *newInstance(MM_EnvironmentBase *env, MM_HeapRegionList::RegionListKind regionListKind, bool singleRegionsOnly, uintptr_t shardCount);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	bool initialize(MM_EnvironmentBase *env);
+	virtual void tearDown(MM_EnvironmentBase *env);
+
+	MM_ShardedFreeHeapRegionList(MM_HeapRegionList::RegionListKind regionListKind, bool singleRegionsOnly, uintptr_t shardCount) :
+		MM_FreeHeapRegionList(regionListKind, singleRegionsOnly),
+		_shardCount(shardCount),
+		_shardStride(0),
+		_shardsMemory(NULL),
+		_shards(NULL)
+	{
+		_typeId = __FUNCTION__;
+	}
+
+	virtual void
+	push(MM_HeapRegionDescriptorSegregated *region)
+	{
+		getLockingShard(MM_ShardedHeapRegionQueue::getHomeShardIndex(_shardCount))->push(region);
+	}
+
+	virtual void push(MM_HeapRegionQueue *src);
+	virtual void push(MM_FreeHeapRegionList *src);
+
+	virtual MM_HeapRegionDescriptorSegregated *pop();
+
+	virtual void
+	detach(MM_HeapRegionDescriptorSegregated *cur)
+	{
+		Assert_MM_unreachable();
+	}
+
+	virtual MM_HeapRegionDescriptorSegregated* allocate(MM_EnvironmentBase *env, uintptr_t szClass, uintptr_t numRegions, uintptr_t maxExcess);
+
+	virtual uintptr_t getTotalRegions();
+	virtual uintptr_t getMaxRegions();
+
+	virtual uintptr_t getShardCount() { return _shardCount; }
+	virtual MM_FreeHeapRegionList *getShard(uintptr_t index) { return getLockingShard(index); }
+
+	virtual bool isEmpty();
+	virtual void showList(MM_EnvironmentBase *env);
+
+protected:
+private:
+	MMINLINE MM_LockingFreeHeapRegionList *
+	getLockingShard(uintptr_t index)
+	{
+		return (MM_LockingFreeHeapRegionList *)((uintptr_t)_shards + (index * _shardStride));
+	}
+};
+
+#endif /* OMR_GC_SEGREGATED_HEAP */
+
+#endif /* SHARDEDFREEHEAPREGIONLIST_HPP_ */
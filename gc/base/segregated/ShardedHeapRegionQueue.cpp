@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "modronopt.h"
+
+#include "EnvironmentBase.hpp"
+#include "HeapRegionDescriptorSegregated.hpp"
+#include "Math.hpp"
+#include "ShardedHeapRegionQueue.hpp"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+MM_ShardedHeapRegionQueue *
+MM_ShardedHeapRegionQueue::newInstance(MM_EnvironmentBase *env, RegionListKind regionListKind, bool singleRegionsOnly, uintptr_t shardCount, bool trackFreeBytes)
+{
+	MM_ShardedHeapRegionQueue *regionList = (MM_ShardedHeapRegionQueue *)env->getForge()->allocate(sizeof(MM_ShardedHeapRegionQueue), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (regionList) {
+		new (regionList) MM_ShardedHeapRegionQueue(regionListKind, singleRegionsOnly, shardCount, trackFreeBytes);
+		if (!regionList->initialize(env)) {
+			regionList->kill(env);
+			return NULL;
+		}
+	}
+	return regionList;
+}
+
+void
+MM_ShardedHeapRegionQueue::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_ShardedHeapRegionQueue::initialize(MM_EnvironmentBase *env)
+{
+	Assert_MM_true(0 < _shardCount);
+	_shardStride = MM_Math::roundToCeiling(HEAP_REGION_SHARD_ALIGNMENT, sizeof(MM_LockingHeapRegionQueue));
+	/* the forge only guarantees pointer alignment, so over-allocate to keep each shard on its own cache lines */
+	_shardsMemory = env->getForge()->allocate((_shardStride * _shardCount) + HEAP_REGION_SHARD_ALIGNMENT - 1, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _shardsMemory) {
+		return false;
+	}
+	_shards = (void *)MM_Math::roundToCeiling(HEAP_REGION_SHARD_ALIGNMENT, (uintptr_t)_shardsMemory);
+
+	/* construct every shard before initializing any so that tearDown can safely visit them all */
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		new (getLockingShard(i)) MM_LockingHeapRegionQueue(_regionListKind, _singleRegionsOnly, true, _trackFreeBytes);
+	}
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		if (!getLockingShard(i)->initialize(env)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+MM_ShardedHeapRegionQueue::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _shards) {
+		for (uintptr_t i = 0; i < _shardCount; i++) {
+			getLockingShard(i)->tearDown(env);
+		}
+		env->getForge()->free(_shardsMemory);
+		_shardsMemory = NULL;
+		_shards = NULL;
+	}
+}
+
+void
+MM_ShardedHeapRegionQueue::enqueue(MM_HeapRegionQueue *src)
+{
+	uintptr_t srcShardCount = src->getShardCount();
+	uintptr_t home = getHomeShardIndex(_shardCount);
+	for (uintptr_t i = 0; i < srcShardCount; i++) {
+		/* spread the source shards over the receiver's shards, starting at the caller's home shard */
+		getLockingShard((home + i) % _shardCount)->enqueue(src->getShard(i));
+	}
+}
+
+MM_HeapRegionDescriptorSegregated *
+MM_ShardedHeapRegionQueue::dequeue()
+{
+	MM_HeapRegionDescriptorSegregated *region = NULL;
+	uintptr_t home = getHomeShardIndex(_shardCount);
+	for (uintptr_t i = 0; (NULL == region) && (i < _shardCount); i++) {
+		region = getLockingShard((home + i) % _shardCount)->dequeueIfNonEmpty();
+	}
+	return region;
+}
+
+uintptr_t
+MM_ShardedHeapRegionQueue::dequeue(MM_HeapRegionQueue *target, uintptr_t count)
+{
+	uintptr_t moved = 0;
+	uintptr_t home = getHomeShardIndex(_shardCount);
+	for (uintptr_t i = 0; (moved < count) && (i < _shardCount); i++) {
+		MM_LockingHeapRegionQueue *shard = getLockingShard((home + i) % _shardCount);
+		if (!shard->isEmpty()) {
+			moved += shard->dequeue(target, count - moved);
+		}
+	}
+	return moved;
+}
+
+bool
+MM_ShardedHeapRegionQueue::isEmpty()
+{
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		if (!getLockingShard(i)->isEmpty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uintptr_t
+MM_ShardedHeapRegionQueue::getTotalRegions()
+{
+	uintptr_t count = 0;
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		count += getLockingShard(i)->getTotalRegions();
+	}
+	return count;
+}
+
+void
+MM_ShardedHeapRegionQueue::showList(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	omrtty_printf("ShardedHeapRegionQueue 0x%x (%d shards):\n", this, _shardCount);
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		getLockingShard(i)->showList(env);
+	}
+}
+
+uintptr_t
+MM_ShardedHeapRegionQueue::debugCountFreeBytesInRegions()
+{
+	uintptr_t freeBytes = 0;
+	for (uintptr_t i = 0; i < _shardCount; i++) {
+		freeBytes += getLockingShard(i)->debugCountFreeBytesInRegions();
+	}
+	return freeBytes;
+}
+
+#endif /* OMR_GC_SEGREGATED_HEAP */
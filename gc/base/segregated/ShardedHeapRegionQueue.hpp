@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SHARDEDHEAPREGIONQUEUE_HPP_)
+#define SHARDEDHEAPREGIONQUEUE_HPP_
+
+#include "omrcfg.h"
+#include "omrthread.h"
+#include "modronopt.h"
+
+#include "EnvironmentBase.hpp"
+#include "HeapRegionDescriptorSegregated.hpp"
+#include "HeapRegionQueue.hpp"
+#include "LockingHeapRegionQueue.hpp"
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+
+/**
+ * Shards are padded out to this many bytes so that threads working on different shards
+ * do not share cache lines.
+ */
+#define HEAP_REGION_SHARD_ALIGNMENT 128
+
+/**
+ * A region queue split into several independently locked shards.
+ * Each thread enqueues to and dequeues from its home shard, only visiting the other shards
+ * when its home shard is empty, so concurrent sweep and allocation threads rarely contend
+ * on the same lock. The queue is not FIFO across shards.
+ */
+class MM_ShardedHeapRegionQueue : public MM_HeapRegionQueue
+{
+public:
+protected:
+private:
+	uintptr_t _shardCount; /**< Number of shards, at least 1 */
+	uintptr_t _shardStride; /**< Distance in bytes between consecutive shards in _shards */
+	void *_shardsMemory; /**< Forge allocation backing _shards, freed in tearDown */
+	void *_shards; /**< Storage for the shards, each an MM_LockingHeapRegionQueue, aligned to HEAP_REGION_SHARD_ALIGNMENT */
+	bool _trackFreeBytes; /**< Passed on to each shard */
+
+public:
+	static MM_ShardedHeapRegionQueue *newInstance(MM_EnvironmentBase *env, RegionListKind regionListKind, bool singleRegionsOnly, uintptr_t shardCount, bool trackFreeBytes = false);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	bool initialize(MM_EnvironmentBase *env);
+	virtual void tearDown(MM_EnvironmentBase *env);
+
+	MM_ShardedHeapRegionQueue(RegionListKind regionListKind, bool singleRegionsOnly, uintptr_t shardCount, bool trackFreeBytes) :
+		MM_HeapRegionQueue(regionListKind, singleRegionsOnly, trackFreeBytes),
+		_shardCount(shardCount),
+		_shardStride(0),
+		_shardsMemory(NULL),
+		_shards(NULL),
+		_trackFreeBytes(trackFreeBytes)
+	{
+		_typeId = __FUNCTION__;
+	}
+
+	/**
+	 * Pick the shard the calling thread should use first.
+	 * @param shardCount The number of shards to choose from
+	 * @return an index less than shardCount which is stable for the calling thread
+	 */
+	MMINLINE static uintptr_t
+	getHomeShardIndex(uintptr_t shardCount)
+	{
+		uintptr_t key = (uintptr_t)omrthread_self();
+		key ^= key >> 13;
+		key *= (uintptr_t)0x5bd1e995;
+		key ^= key >> 15;
+		return key % shardCount;
+	}
+
+	virtual void enqueue(MM_HeapRegionDescriptorSegregated *region)
+	{
+		getLockingShard(getHomeShardIndex(_shardCount))->enqueue(region);
+	}
+
+	virtual void enqueue(MM_HeapRegionQueue *src);
+
+	virtual MM_HeapRegionDescriptorSegregated *dequeue();
+
+	virtual uintptr_t dequeue(MM_HeapRegionQueue *target, uintptr_t count);
+
+	virtual uintptr_t debugCountFreeBytesInRegions();
+
+	virtual uintptr_t getShardCount() { return _shardCount; }
+	virtual MM_HeapRegionQueue *getShard(uintptr_t index) { return getLockingShard(index); }
+
+	virtual bool isEmpty();
+	virtual uintptr_t getTotalRegions();
+	virtual void showList(MM_EnvironmentBase *env);
+
+protected:
+private:
+	MMINLINE MM_LockingHeapRegionQueue *
+	getLockingShard(uintptr_t index)
+	{
+		return (MM_LockingHeapRegionQueue *)((uintptr_t)_shards + (index * _shardStride));
+	}
+};
+
+#endif /* OMR_GC_SEGREGATED_HEAP */
+
+#endif /* SHARDEDHEAPREGIONQUEUE_HPP_ */
@@ -21,7 +21,12 @@
  *******************************************************************************/
 #include "SizeClasses.hpp"
 
+#include "omrport.h"
+
+#include "AtomicOperations.hpp"
 #include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "HeapLinkedFreeHeader.hpp"
 
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
@@ -61,7 +66,23 @@ MM_SizeClasses::initialize(MM_EnvironmentBase *env)
 	_smallNumCells = sizeClasses->smallNumCells;
 	_sizeClassIndex = sizeClasses->sizeClassIndex;
 	
-	memcpy(_smallCellSizes, initialCellSizes, sizeof(initialCellSizes));
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	if (0 != extensions->customSmallCellSizes[OMR_SIZECLASSES_MAX_SMALL]) {
+		/* an alternate table was loaded at startup; it was validated when the option was parsed */
+		Assert_MM_true(isValidCellSizeTable(extensions->customSmallCellSizes));
+		memcpy(_smallCellSizes, extensions->customSmallCellSizes, sizeof(extensions->customSmallCellSizes));
+	} else {
+		memcpy(_smallCellSizes, initialCellSizes, sizeof(initialCellSizes));
+	}
+
+	if (extensions->sizeClassProfiling) {
+		uintptr_t histogramSize = sizeof(uintptr_t) * OMR_SIZECLASSES_HISTOGRAM_BUCKETS;
+		_allocationSizeHistogram = (uintptr_t *)env->getForge()->allocate(histogramSize, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+		if (NULL == _allocationSizeHistogram) {
+			return false;
+		}
+		memset((void *)_allocationSizeHistogram, 0, histogramSize);
+	}
 	
 	_sizeClassIndex[0] = 0;
 	_smallNumCells[0] = 0;
@@ -79,7 +100,161 @@ MM_SizeClasses::initialize(MM_EnvironmentBase *env)
 void
 MM_SizeClasses::tearDown(MM_EnvironmentBase *envModron)
 {
-	
+	if (NULL != _allocationSizeHistogram) {
+		reportFragmentation(envModron);
+		envModron->getForge()->free((void *)_allocationSizeHistogram);
+		_allocationSizeHistogram = NULL;
+	}
+}
+
+void
+MM_SizeClasses::addAllocationSizeCounts(MM_EnvironmentBase *env, uintptr_t *counts)
+{
+	if (NULL != _allocationSizeHistogram) {
+		for (uintptr_t bucket = 0; bucket < OMR_SIZECLASSES_HISTOGRAM_BUCKETS; bucket++) {
+			if (0 != counts[bucket]) {
+				MM_AtomicOperations::add(&_allocationSizeHistogram[bucket], counts[bucket]);
+			}
+		}
+	}
+}
+
+bool
+MM_SizeClasses::isValidCellSizeTable(const uintptr_t *cellSizes)
+{
+	if ((0 != cellSizes[0]) || (OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES != cellSizes[OMR_SIZECLASSES_MAX_SMALL])) {
+		return false;
+	}
+	/* free cells are linked through a free header, so no cell may be smaller than one */
+	if (cellSizes[OMR_SIZECLASSES_MIN_SMALL] < sizeof(MM_HeapLinkedFreeHeader)) {
+		return false;
+	}
+	for (uintptr_t szClass = OMR_SIZECLASSES_MIN_SMALL; szClass <= OMR_SIZECLASSES_MAX_SMALL; szClass++) {
+		if ((cellSizes[szClass] <= cellSizes[szClass - 1]) || (0 != (cellSizes[szClass] % sizeof(uintptr_t)))) {
+			return false;
+		}
+		if ((0 != (cellSizes[szClass] % 8)) && (0 != (cellSizes[szClass - 1] % 8))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool
+MM_SizeClasses::generateCellSizeTable(MM_EnvironmentBase *env, const uintptr_t *histogram, uintptr_t *cellSizes)
+{
+	/* Dynamic programming over histogram bucket boundaries: cost[k][j] is the least number of bytes
+	 * wasted by serving every allocation of at most j buckets with k size classes, the largest being j.
+	 */
+	const uintptr_t maxBucket = OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES / sizeof(uintptr_t);
+	const uintptr_t columns = maxBucket + 1;
+	const uintptr_t rows = OMR_SIZECLASSES_NUM_SMALL + 1;
+	const uint64_t unreachable = (uint64_t)-1;
+	uintptr_t scratchSize = (sizeof(uint64_t) * 2 * columns) + ((sizeof(uint64_t) + sizeof(uintptr_t)) * rows * columns);
+	uint64_t *countPrefix = (uint64_t *)env->getForge()->allocate(scratchSize, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL == countPrefix) {
+		return false;
+	}
+	uint64_t *weightPrefix = countPrefix + columns;
+	uint64_t *cost = weightPrefix + columns;
+	uintptr_t *previous = (uintptr_t *)(cost + (rows * columns));
+
+	countPrefix[0] = histogram[0];
+	weightPrefix[0] = 0;
+	for (uintptr_t j = 1; j < columns; j++) {
+		countPrefix[j] = countPrefix[j - 1] + histogram[j];
+		weightPrefix[j] = weightPrefix[j - 1] + ((uint64_t)histogram[j] * j);
+	}
+
+	for (uintptr_t k = 0; k < rows; k++) {
+		for (uintptr_t j = 0; j < columns; j++) {
+			cost[(k * columns) + j] = unreachable;
+			previous[(k * columns) + j] = 0;
+		}
+	}
+	cost[0] = 0;
+
+	for (uintptr_t k = 1; k < rows; k++) {
+		for (uintptr_t j = k; j < columns; j++) {
+			if ((0 != ((j * sizeof(uintptr_t)) % 8)) || ((j * sizeof(uintptr_t)) < sizeof(MM_HeapLinkedFreeHeader))) {
+				continue;
+			}
+			for (uintptr_t i = k - 1; i < j; i++) {
+				uint64_t base = cost[((k - 1) * columns) + i];
+				if (unreachable != base) {
+					/* bytes wasted by rounding every allocation in buckets (i, j] up to bucket j */
+					uint64_t waste = (((countPrefix[j] - countPrefix[i]) * j) - (weightPrefix[j] - weightPrefix[i])) * sizeof(uintptr_t);
+					if ((base + waste) < cost[(k * columns) + j]) {
+						cost[(k * columns) + j] = base + waste;
+						previous[(k * columns) + j] = i;
+					}
+				}
+			}
+		}
+	}
+
+	uintptr_t boundary = maxBucket;
+	for (uintptr_t k = OMR_SIZECLASSES_NUM_SMALL; k > 0; k--) {
+		cellSizes[k] = boundary * sizeof(uintptr_t);
+		boundary = previous[(k * columns) + boundary];
+	}
+	cellSizes[0] = 0;
+
+	env->getForge()->free(countPrefix);
+	return true;
+}
+
+void
+MM_SizeClasses::reportFragmentationForTable(MM_EnvironmentBase *env, const char *description, const uintptr_t *histogram, const uintptr_t *cellSizes)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uint64_t totalRequested = 0;
+	uint64_t totalWasted = 0;
+
+	omrtty_printf("Size class fragmentation (%s):\n", description);
+	omrtty_printf("  class  cellSize     allocations   requestedBytes      wastedBytes  waste%%\n");
+	uintptr_t bucket = 1;
+	for (uintptr_t szClass = OMR_SIZECLASSES_MIN_SMALL; szClass <= OMR_SIZECLASSES_MAX_SMALL; szClass++) {
+		uint64_t allocations = 0;
+		uint64_t requested = 0;
+		for (; (bucket * sizeof(uintptr_t)) <= cellSizes[szClass]; bucket++) {
+			allocations += histogram[bucket];
+			requested += (uint64_t)histogram[bucket] * bucket * sizeof(uintptr_t);
+		}
+		uint64_t wasted = (allocations * cellSizes[szClass]) - requested;
+		totalRequested += requested;
+		totalWasted += wasted;
+		omrtty_printf("  %5zu  %8zu  %14llu  %15llu  %15llu  %6.2f\n", szClass, cellSizes[szClass], allocations, requested, wasted,
+			(0 == (requested + wasted)) ? 0.0 : ((100.0 * wasted) / (requested + wasted)));
+	}
+	omrtty_printf("  total small bytes requested %llu, wasted %llu (%.2f%%); large allocations %zu\n", totalRequested, totalWasted,
+		(0 == (totalRequested + totalWasted)) ? 0.0 : ((100.0 * totalWasted) / (totalRequested + totalWasted)),
+		histogram[OMR_SIZECLASSES_HISTOGRAM_LARGE_BUCKET]);
+}
+
+void
+MM_SizeClasses::reportFragmentation(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uintptr_t histogram[OMR_SIZECLASSES_HISTOGRAM_BUCKETS];
+	uintptr_t generatedCellSizes[OMR_SIZECLASSES_NUM_SMALL + 1];
+
+	if (NULL == _allocationSizeHistogram) {
+		return;
+	}
+	for (uintptr_t bucket = 0; bucket < OMR_SIZECLASSES_HISTOGRAM_BUCKETS; bucket++) {
+		histogram[bucket] = _allocationSizeHistogram[bucket];
+	}
+
+	reportFragmentationForTable(env, "current table", histogram, _smallCellSizes);
+
+	if (generateCellSizeTable(env, histogram, generatedCellSizes)) {
+		reportFragmentationForTable(env, "generated table", histogram, generatedCellSizes);
+		omrtty_printf("Generated size class table: -Xgc:sizeClasses=");
+		for (uintptr_t szClass = OMR_SIZECLASSES_MIN_SMALL; szClass <= OMR_SIZECLASSES_MAX_SMALL; szClass++) {
+			omrtty_printf((OMR_SIZECLASSES_MAX_SMALL == szClass) ? "%zu\n" : "%zu,", generatedCellSizes[szClass]);
+		}
+	}
 }
 
 #endif /* OMR_GC_SEGREGATED_HEAP */
@@ -31,6 +31,13 @@
 
 #if defined(OMR_GC_SEGREGATED_HEAP)
 
+/**
+ * Number of buckets in an allocation size histogram: one per uintptr_t-sized step
+ * up to OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES, plus one for all large allocations.
+ */
+#define OMR_SIZECLASSES_HISTOGRAM_BUCKETS ((OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES / sizeof(uintptr_t)) + 2)
+#define OMR_SIZECLASSES_HISTOGRAM_LARGE_BUCKET (OMR_SIZECLASSES_HISTOGRAM_BUCKETS - 1)
+
 class MM_EnvironmentBase;
 
 class MM_SizeClasses : public MM_BaseVirtual
@@ -42,6 +49,7 @@ private:
 	uintptr_t* _smallCellSizes; /**< Array mapping size classes to the cell size of that size class. The array actually lives in the J9JavaVM. */
 	uintptr_t* _smallNumCells; /**< Array mapping size classes to the number of cells on a region of that size class. The array actually lives in the J9JavaVM. */
 	uintptr_t* _sizeClassIndex; /**< maps size request to size classes. The array actually lives in the OMR vm. */
+	volatile uintptr_t* _allocationSizeHistogram; /**< Allocation counts per histogram bucket, only allocated when size class profiling is enabled */
 	
 /* Methods */
 public:
@@ -72,16 +80,58 @@ public:
 		}
 		return _sizeClassIndex[sizeInBytes / sizeof(uintptr_t)];
 	}
-	
+
+	/**
+	 * @return the histogram bucket which counts allocations of sizeInBytes
+	 */
+	MMINLINE static uintptr_t getHistogramBucket(uintptr_t sizeInBytes)
+	{
+		if (sizeInBytes > OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES) {
+			return OMR_SIZECLASSES_HISTOGRAM_LARGE_BUCKET;
+		}
+		return (sizeInBytes + sizeof(uintptr_t) - 1) / sizeof(uintptr_t);
+	}
+
+	/**
+	 * Merge a thread's allocation size counts into the global histogram.
+	 * @param counts Array of OMR_SIZECLASSES_HISTOGRAM_BUCKETS counts
+	 */
+	void addAllocationSizeCounts(MM_EnvironmentBase *env, uintptr_t *counts);
+
+	/**
+	 * Print allocation counts and internal fragmentation for each size class, both for the
+	 * table in use and for a table generated from the allocation size histogram.
+	 */
+	void reportFragmentation(MM_EnvironmentBase *env);
+
+	/**
+	 * Check that a cell size table has the shape required by MM_SizeClasses: a leading 0,
+	 * strictly increasing uintptr_t-aligned sizes from at least one free header up to
+	 * OMR_SIZECLASSES_MAX_SMALL_SIZE_BYTES, and no two adjacent sizes which are not multiples of 8.
+	 * @param cellSizes Array of OMR_SIZECLASSES_NUM_SMALL+1 cell sizes
+	 */
+	static bool isValidCellSizeTable(const uintptr_t *cellSizes);
+
+	/**
+	 * Generate the cell size table which minimizes internal fragmentation for the given
+	 * allocation size histogram. Cell sizes are restricted to multiples of 8 no smaller than a free header.
+	 * @param histogram Array of OMR_SIZECLASSES_HISTOGRAM_BUCKETS allocation counts
+	 * @param cellSizes[out] Array of OMR_SIZECLASSES_NUM_SMALL+1 cell sizes
+	 * @return false if scratch memory could not be allocated
+	 */
+	static bool generateCellSizeTable(MM_EnvironmentBase *env, const uintptr_t *histogram, uintptr_t *cellSizes);
+
 protected:
 	bool initialize(MM_EnvironmentBase *env);
 	virtual void tearDown(MM_EnvironmentBase *env);
 	MM_SizeClasses(MM_EnvironmentBase* env)
+		: _allocationSizeHistogram(NULL)
 	{
 		_typeId = __FUNCTION__;
 	};
 	
 private:
+	void reportFragmentationForTable(MM_EnvironmentBase *env, const char *description, const uintptr_t *histogram, const uintptr_t *cellSizes);
 };
 
 #endif /* OMR_GC_SEGREGATED_HEAP */
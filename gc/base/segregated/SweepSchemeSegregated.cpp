@@ -103,6 +103,7 @@ MM_SweepSchemeSegregated::sweep(MM_EnvironmentBase *env, MM_MemoryPoolSegregated
 	_isFixHeapForWalk = isFixHeapForWalk;
 
 	if (env->_currentTask->synchronizeGCThreadsAndReleaseMaster(env, UNIQUE_ID)) {
+		startSweepBudget(env);
 		preSweep(env);
 		env->_currentTask->releaseSynchronizedGCThreads(env);
 	}
@@ -130,6 +131,28 @@ MM_SweepSchemeSegregated::sweep(MM_EnvironmentBase *env, MM_MemoryPoolSegregated
 	}
 }
 
+void
+MM_SweepSchemeSegregated::startSweepBudget(MM_EnvironmentBase *env)
+{
+	uintptr_t budget = env->getExtensions()->segregatedSweepBudget;
+	_sweepDeadline = 0;
+	if ((0 != budget) && !_isFixHeapForWalk) {
+		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+		_sweepDeadline = omrtime_hires_clock() + ((budget * omrtime_hires_frequency()) / 1000000);
+	}
+}
+
+bool
+MM_SweepSchemeSegregated::isSweepBudgetExhausted(MM_EnvironmentBase *env)
+{
+	bool exhausted = false;
+	if (0 != _sweepDeadline) {
+		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+		exhausted = (omrtime_hires_clock() >= _sweepDeadline);
+	}
+	return exhausted;
+}
+
 void
 MM_SweepSchemeSegregated::preSweep(MM_EnvironmentBase *env)
 {
@@ -521,9 +544,15 @@ MM_SweepSchemeSegregated::incrementalSweepSmall(MM_EnvironmentBase *env)
 	 * if a region contains no marked objects, then it can be returned to a free list.
 	 */
 	MM_SizeClasses *sizeClasses = ext->defaultSizeClasses;
-	while (regionPool->getCurrentTotalCountOfSweepRegions()) {
-		for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; sizeClass <= OMR_SIZECLASSES_MAX_SMALL; sizeClass++) {
+	bool budgetExhausted = false;
+	while (!budgetExhausted && regionPool->getCurrentTotalCountOfSweepRegions()) {
+		for (uintptr_t sizeClass = OMR_SIZECLASSES_MIN_SMALL; !budgetExhausted && (sizeClass <= OMR_SIZECLASSES_MAX_SMALL); sizeClass++) {
 			while (regionPool->getCurrentCountOfSweepRegions(sizeClass)) {
+				/* Once the pause budget runs out, leave the remaining regions to allocating threads */
+				if (isSweepBudgetExhausted(env)) {
+					budgetExhausted = true;
+					break;
+				}
 				float yetToComplete = (float)regionPool->getCurrentCountOfSweepRegions(sizeClass) / regionPool->getInitialCountOfSweepRegions(sizeClass);
 				float totalYetToComplete = (float)regionPool->getCurrentTotalCountOfSweepRegions() / regionPool->getInitialTotalCountOfSweepRegions();
 				
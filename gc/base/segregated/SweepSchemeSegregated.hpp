@@ -53,6 +53,7 @@ protected:
 private:
 	bool _isFixHeapForWalk;
 	bool _clearMarkMapAfterSweep; /**< If a region should be unmarked after it is swept */
+	uint64_t _sweepDeadline; /**< hires clock value at which small region sweeping stops and is left to allocating threads (0 for no deadline) */
 
 	/*
 	 * Function members
@@ -86,6 +87,7 @@ protected:
 		,_markMap(markMap)
 		,_isFixHeapForWalk(false)
 		,_clearMarkMapAfterSweep(true)
+		,_sweepDeadline(0)
 	{
 		_typeId = __FUNCTION__;
 	};
@@ -102,6 +104,17 @@ private:
 	void incrementalSweepLarge(MM_EnvironmentBase *env);
 	void incrementalCoalesceFreeRegions(MM_EnvironmentBase *env);
 
+	/**
+	 * Start the sweep time budget (-Xgc:sweepBudget) for this cycle.  Heap walk fixups are always swept completely.
+	 */
+	void startSweepBudget(MM_EnvironmentBase *env);
+
+	/**
+	 * @return True if the sweep time budget has run out; the remaining small regions stay on the sweep lists
+	 * to be swept lazily on allocation (see MM_RegionPoolSegregated::sweepAndAllocateRegionFromSmallSizeClass)
+	 */
+	bool isSweepBudgetExhausted(MM_EnvironmentBase *env);
+
 	MMINLINE bool addFreeChunk(MM_MemoryPoolAggregatedCellList *memoryPoolACL, uintptr_t *freeChunk, uintptr_t freeChunkSize, uintptr_t minimumFreeEntrySize, uintptr_t freeChunkCellCount)
 	{
 		bool result = false;
@@ -414,9 +414,8 @@ MM_CompactScheme::createSubAreaTable(MM_EnvironmentStandard *env, bool singleThr
 			void *highAddress = region->getHighAddress();
 			uintptr_t areaSize = region->getSize();
 			MM_MemorySubSpace *memorySubSpace = region->getSubSpace();
-			intptr_t state = SubAreaEntry::init;
 
-			if (singleThreaded) {
+			if (singleThreaded && (NULL == _windowLow)) {
 				size = areaSize;
 			}
 			_subAreaTable[i].firstObject = (omrobjectptr_t)lowAddress;
@@ -426,6 +425,12 @@ MM_CompactScheme::createSubAreaTable(MM_EnvironmentStandard *env, bool singleThr
 
 			for( uintptr_t subAreaNum=0; subAreaNum < numSubAreas; subAreaNum++){
 				uint8_t *p = (uint8_t*)(((uintptr_t)lowAddress) + (subAreaNum * size));
+				intptr_t state = SubAreaEntry::init;
+
+				/* outside of the compaction window objects stay in place */
+				if ((NULL != _windowLow) && (((void *)(p + size) <= _windowLow) || ((void *)p >= _windowHigh))) {
+					state = SubAreaEntry::fixup_only;
+				}
 
 				_subAreaTable[i].freeChunk = (omrobjectptr_t)p;
 				_subAreaTable[i].memoryPool = memorySubSpace->getMemoryPool(p);
@@ -700,6 +705,11 @@ void MM_CompactScheme::rebuildFreelist(MM_EnvironmentStandard *env)
 
 				currentFreeBase = NULL;
 				currentFreeSize = 0;
+
+				if (SubAreaEntry::fixup_only == subAreaTable[i].state) {
+					/* objects did not move, but the free list was reset, so add back the space between them */
+					currentFreeBase = addFreeEntriesInFixupSubArea(env, memorySubSpace, poolState, subAreaTable[i].firstObject, subAreaTable[i + 1].firstObject);
+				}
 			}
         } while (subAreaTable[i++].state != SubAreaEntry::end_segment);
 
@@ -714,6 +724,24 @@ void MM_CompactScheme::rebuildFreelist(MM_EnvironmentStandard *env)
 	}
 }
 
+void *
+MM_CompactScheme::addFreeEntriesInFixupSubArea(MM_EnvironmentStandard *env, MM_MemorySubSpace *memorySubSpace, MM_CompactMemoryPoolState *poolState, omrobjectptr_t start, omrobjectptr_t end)
+{
+	/* no marked object starts in the page of the next sub area's first object */
+	MM_HeapMapIterator markedObjectIterator(_extensions, _markMap, (uintptr_t *)start, (uintptr_t *)pageStart(pageIndex(end)));
+	void *freeBase = (void *)start;
+	omrobjectptr_t objectPtr = NULL;
+
+	while (NULL != (objectPtr = markedObjectIterator.nextObject())) {
+		if ((void *)objectPtr > freeBase) {
+			addFreeEntry(env, memorySubSpace, poolState, freeBase, (uintptr_t)objectPtr - (uintptr_t)freeBase);
+		}
+		freeBase = (void *)((uintptr_t)objectPtr + _extensions->objectModel.getConsumedSizeInBytesWithHeader(objectPtr));
+	}
+
+	return (freeBase < (void *)end) ? freeBase : NULL;
+}
+
 /*
  * Call appropriate Memory Pool to add a new free entry to the pool. If the free entry
  * spans more than one subpool then it will be split into 2 free entries.
@@ -1411,7 +1439,7 @@ MM_CompactScheme::rebuildMarkbits(MM_EnvironmentStandard *env)
 		intptr_t i;
         for (i = 0; subAreaTable[i].state != SubAreaEntry::end_segment; i++) {
         	/* We only have to rebuild the markbits for sub areas which contain moved objects */
-        	if (subAreaTable->state != SubAreaEntry::fixup_only) {
+        	if (subAreaTable[i].state != SubAreaEntry::fixup_only) {
 	        	if (changeSubAreaAction(env, &subAreaTable[i], SubAreaEntry::rebuilding_mark_bits)) {
 	        		rebuildMarkbitsInSubArea(env, region, subAreaTable, i);
 				}
@@ -138,6 +138,8 @@ protected:
     SubAreaEntry *_subAreaTable;  /**< Reference to the subAreaTable which is shared data from the SweepHeapSectioning */
     omrobjectptr_t _compactFrom;
     omrobjectptr_t _compactTo;
+    void *_windowLow; /**< low address of the range to compact, NULL to compact the whole heap */
+    void *_windowHigh; /**< high address of the range to compact */
     MM_CompactDelegate _delegate;
 
 public:
@@ -281,6 +283,18 @@ protected:
 
     void rebuildMarkbits(MM_EnvironmentStandard *env);
 
+    /**
+     * Add the gaps between the marked objects of a fixup_only sub area to the free list being rebuilt.
+     *
+     * @param env[in] the current thread
+     * @param memorySubSpace[in] the subspace owning the sub area
+     * @param poolState[in] the free list being rebuilt
+     * @param start[in] first object of the sub area
+     * @param end[in] first object of the next sub area
+     * @return the start of the free space at the end of the sub area, NULL if it ends with an object
+     */
+    void *addFreeEntriesInFixupSubArea(MM_EnvironmentStandard *env, MM_MemorySubSpace *memorySubSpace, MM_CompactMemoryPoolState *poolState, omrobjectptr_t start, omrobjectptr_t end);
+
     /**
      * Rebuild mark bits within the specified subArea
      *
@@ -323,6 +337,18 @@ public:
 	
 	MMINLINE void setMarkMap(MM_MarkMap *markMap) {	_markMap = markMap;}
 
+	/**
+	 * Restrict the next compactions to the sub areas overlapping [low, high). The objects of the
+	 * other sub areas do not move and only have their references fixed up.
+	 * @param low low address of the range to compact, NULL to compact the whole heap
+	 * @param high high address of the range to compact
+	 */
+	MMINLINE void setCompactionWindow(void *low, void *high)
+	{
+		_windowLow = low;
+		_windowHigh = high;
+	}
+
 	/**
 	 * Create a CompactScheme object.
 	 */
@@ -335,6 +361,8 @@ public:
         , _markMap(markingScheme->getMarkMap())
         , _subAreaTableSize(0)
     	, _subAreaTable(NULL)
+    	, _windowLow(NULL)
+    	, _windowHigh(NULL)
     	, _delegate()
     {
     	_typeId = __FUNCTION__;
@@ -683,6 +683,16 @@ MM_ConcurrentSweepScheme::connectChunk(MM_EnvironmentBase *env, MM_ParallelSweep
 	postConnectChunk(env, chunk);
 }
 
+/**
+ * @copydoc MM_ParallelSweepScheme::planConnectChunk(MM_EnvironmentBase *, MM_ParallelSweepChunk *)
+ * @note Chunks are always connected immediately, since mutators may allocate from the connected free list.
+ */
+void
+MM_ConcurrentSweepScheme::planConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk)
+{
+	connectChunk(env, chunk);
+}
+
 /**
  * Flush any remaining free list data from the last chunk processed for every memory subspace.
  */
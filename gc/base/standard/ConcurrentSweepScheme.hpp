@@ -142,6 +142,7 @@ protected:
 	virtual void setupForSweep(MM_EnvironmentBase *env);
 
 	virtual void connectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk);
+	virtual void planConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk);
 
 	virtual void flushAllFinalChunks(MM_EnvironmentBase *env);
 
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#include "FragmentationModel.hpp"
+
+#include "spacesaving.h"
+
+#include "AllocateDescription.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Heap.hpp"
+#include "LargeObjectAllocateStats.hpp"
+#include "Math.hpp"
+#include "MemoryPool.hpp"
+#include "MemorySpace.hpp"
+#include "MemorySubSpace.hpp"
+#include "ParallelSweepChunk.hpp"
+#include "SweepHeapSectioning.hpp"
+
+/**
+ * The demand loses 1/FRAGMENTATION_MODEL_DEMAND_DECAY of its value every global collection
+ * in which no larger object is allocated.
+ */
+#define FRAGMENTATION_MODEL_DEMAND_DECAY 8
+
+/**
+ * Default compaction window, as a fraction of the tenure space.
+ */
+#define FRAGMENTATION_MODEL_DEFAULT_WINDOW_DIVISOR 8
+
+MM_FragmentationModel *
+MM_FragmentationModel::newInstance(MM_EnvironmentBase *env)
+{
+	MM_FragmentationModel *model = (MM_FragmentationModel *)env->getForge()->allocate(sizeof(MM_FragmentationModel), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != model) {
+		new(model) MM_FragmentationModel(env);
+		if (!model->initialize(env)) {
+			model->kill(env);
+			model = NULL;
+		}
+	}
+	return model;
+}
+
+void
+MM_FragmentationModel::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_FragmentationModel::initialize(MM_EnvironmentBase *env)
+{
+	return true;
+}
+
+void
+MM_FragmentationModel::tearDown(MM_EnvironmentBase *env)
+{
+}
+
+MM_FragmentationModel::MM_FragmentationModel(MM_EnvironmentBase *env)
+	: MM_BaseVirtual()
+	, _extensions(env->getExtensions())
+	, _demandSize(0)
+	, _previousLargestFreeEntry(0)
+	, _averageDecline(0)
+	, _predictedCyclesUntilFailure(UDATA_MAX)
+	, _compactionRecommended(false)
+	, _windowLow(NULL)
+	, _windowHigh(NULL)
+{
+	_typeId = __FUNCTION__;
+}
+
+/**
+ * Find the size of the largest objects allocated since the previous global collection.
+ */
+uintptr_t
+MM_FragmentationModel::sampleDemand(MM_EnvironmentBase *env, MM_AllocateDescription *allocDescription)
+{
+	uintptr_t demand = 0;
+
+	if (NULL != allocDescription) {
+		demand = allocDescription->getBytesRequested();
+	}
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+	if (_extensions->scavengerEnabled) {
+		demand = OMR_MAX(demand, _extensions->scavengerStats._failedTenureLargest);
+	}
+#endif /* OMR_GC_MODRON_SCAVENGER */
+
+	MM_MemoryPool *memoryPool = _extensions->heap->getDefaultMemorySpace()->getTenureMemorySubSpace()->getMemoryPool();
+	MM_LargeObjectAllocateStats *stats = memoryPool->getLargeObjectAllocateStats();
+	if (NULL != stats) {
+		/* the current sizes are only reset when averaged, so look at both */
+		OMRSpaceSaving *sizeLists[] = { stats->getSpaceSavingSizes(), stats->getSpaceSavingSizesAveragePercent() };
+		for (uintptr_t list = 0; list < sizeof(sizeLists) / sizeof(sizeLists[0]); list++) {
+			OMRSpaceSaving *sizes = sizeLists[list];
+			if (NULL != sizes) {
+				uintptr_t count = spaceSavingGetCurSize(sizes);
+				for (uintptr_t k = 1; k <= count; k++) {
+					if (0 != spaceSavingGetKthMostFreqCount(sizes, k)) {
+						demand = OMR_MAX(demand, (uintptr_t)spaceSavingGetKthMostFreq(sizes, k));
+					}
+				}
+			}
+		}
+	}
+
+	return demand;
+}
+
+void
+MM_FragmentationModel::update(MM_EnvironmentBase *env, MM_AllocateDescription *allocDescription)
+{
+	MM_MemorySubSpace *tenureSubSpace = _extensions->heap->getDefaultMemorySpace()->getTenureMemorySubSpace();
+	MM_MemoryPool *memoryPool = tenureSubSpace->getMemoryPool();
+	uintptr_t largestFreeEntry = memoryPool->getLargestFreeEntry();
+	uintptr_t freeBytes = memoryPool->getActualFreeMemorySize();
+
+	_compactionRecommended = false;
+	_predictedCyclesUntilFailure = UDATA_MAX;
+	_windowLow = NULL;
+	_windowHigh = NULL;
+
+	uintptr_t decayedDemand = _demandSize - (_demandSize / FRAGMENTATION_MODEL_DEMAND_DECAY);
+	_demandSize = OMR_MAX(decayedDemand, sampleDemand(env, allocDescription));
+	/* no compaction can serve a request larger than half of the tenure space, so do not let one keep asking */
+	_demandSize = OMR_MIN(_demandSize, tenureSubSpace->getActiveMemorySize() / 2);
+
+	if (0 != _previousLargestFreeEntry) {
+		intptr_t decline = (intptr_t)_previousLargestFreeEntry - (intptr_t)largestFreeEntry;
+		_averageDecline = ((3 * _averageDecline) + decline) / 4;
+	}
+	_previousLargestFreeEntry = largestFreeEntry;
+
+	if (0 == _demandSize) {
+		return;
+	}
+
+	if (largestFreeEntry < _demandSize) {
+		_predictedCyclesUntilFailure = 0;
+	} else if (_averageDecline > 0) {
+		_predictedCyclesUntilFailure = (largestFreeEntry - _demandSize) / (uintptr_t)_averageDecline;
+	}
+
+	/* Compaction only helps if the free memory is there but scattered; otherwise the heap has to grow */
+	if ((_predictedCyclesUntilFailure <= FRAGMENTATION_MODEL_PREDICTION_HORIZON) && (freeBytes >= (2 * _demandSize))) {
+		_compactionRecommended = true;
+
+		uintptr_t windowSize = _extensions->proactiveCompactionWindowSize;
+		if (0 == windowSize) {
+			windowSize = MM_Math::roundToCeiling(DESIRED_SUBAREA_SIZE, tenureSubSpace->getActiveMemorySize() / FRAGMENTATION_MODEL_DEFAULT_WINDOW_DIVISOR);
+		}
+		if (!selectCompactionWindow(env, windowSize)) {
+			/* no window frees enough contiguous memory - compact everything */
+			_windowLow = NULL;
+			_windowHigh = NULL;
+		}
+	}
+}
+
+/**
+ * Slide a window of windowSize bytes over the sweep chunks of each contiguous heap range and pick the one
+ * in which compaction would gain the most contiguous free memory. The gain of a chunk is the free memory
+ * (including the dark matter) outside of its largest entry, which compaction folds into a single entry.
+ * The window free and gain totals are kept as running sums: each chunk is added once when the window
+ * reaches it and subtracted once when the window moves past it.
+ * @return true if the selected window yields an entry of at least twice the demand
+ */
+bool
+MM_FragmentationModel::selectCompactionWindow(MM_EnvironmentBase *env, uintptr_t windowSize)
+{
+	MM_SweepHeapSectioning *sectioning = _extensions->sweepHeapSectioning;
+	if (NULL == sectioning) {
+		return false;
+	}
+
+	uintptr_t bestGain = 0;
+	uintptr_t bestFree = 0;
+
+	uintptr_t windowChunks = 0;
+	uintptr_t windowFree = 0;
+	uintptr_t windowGain = 0;
+	void *windowTop = NULL;
+
+	MM_SweepHeapSectioningIterator startIterator(sectioning);
+	MM_SweepHeapSectioningIterator endIterator(sectioning);
+	MM_ParallelSweepChunk *end = NULL; /* next chunk to add to the window */
+	MM_ParallelSweepChunk *start = NULL;
+	while (NULL != (start = startIterator.nextChunk())) {
+		if (NULL == start->chunkBase) {
+			continue;
+		}
+
+		if (0 == windowChunks) {
+			/* start of a contiguous range, or the previous window ended at a gap */
+			windowTop = start->chunkBase;
+			endIterator = startIterator;
+			end = start;
+		}
+
+		/* extend the window over the chunks following it while they are contiguous */
+		void *windowLimit = (void *)((uintptr_t)start->chunkBase + windowSize);
+		while ((NULL != end) && (end->chunkBase == windowTop) && (windowTop < windowLimit)) {
+			uintptr_t chunkFree = end->freeBytes + end->_darkMatterBytes;
+			windowFree += chunkFree;
+			windowGain += (chunkFree > end->_largestFreeEntry) ? (chunkFree - end->_largestFreeEntry) : 0;
+			windowChunks += 1;
+			windowTop = end->chunkTop;
+			end = endIterator.nextChunk();
+		}
+
+		if (windowGain > bestGain) {
+			bestGain = windowGain;
+			bestFree = windowFree;
+			_windowLow = start->chunkBase;
+			_windowHigh = windowTop;
+		}
+
+		/* slide the window past start */
+		uintptr_t startFree = start->freeBytes + start->_darkMatterBytes;
+		windowFree -= startFree;
+		windowGain -= (startFree > start->_largestFreeEntry) ? (startFree - start->_largestFreeEntry) : 0;
+		windowChunks -= 1;
+	}
+
+	return bestFree >= (2 * _demandSize);
+}
+
+void
+MM_FragmentationModel::compactionCompleted(MM_EnvironmentBase *env)
+{
+	/* the demand that requested the compaction has been served; relearn it from later allocations */
+	_demandSize = 0;
+	_previousLargestFreeEntry = 0;
+	_averageDecline = 0;
+	_compactionRecommended = false;
+	_windowLow = NULL;
+	_windowHigh = NULL;
+}
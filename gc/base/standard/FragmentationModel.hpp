@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Modron_Standard
+ */
+
+#if !defined(FRAGMENTATIONMODEL_HPP_)
+#define FRAGMENTATIONMODEL_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "modronbase.h"
+
+#include "BaseVirtual.hpp"
+
+class MM_AllocateDescription;
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+
+/**
+ * Number of global collections ahead of a predicted large allocation failure at which a
+ * proactive compaction is requested.
+ */
+#define FRAGMENTATION_MODEL_PREDICTION_HORIZON 2
+
+/**
+ * Model of tenure fragmentation used to compact before large allocations start failing.
+ *
+ * After every global sweep the model samples the largest free entry and the free memory of the
+ * tenure pool, and the size of the largest objects recently allocated (the allocation that
+ * triggered the collection, objects which failed to tenure and the most frequent large allocation
+ * sizes). The demand is decayed slowly so that a single large allocation keeps influencing the
+ * next few cycles. The shrinking rate of the largest free entry is smoothed across cycles and
+ * used to predict how many collections remain before the largest free entry can no longer
+ * satisfy the demand.
+ *
+ * When a failure is predicted within FRAGMENTATION_MODEL_PREDICTION_HORIZON collections, and the
+ * heap has enough free memory that the problem is its layout rather than its occupancy, the
+ * model uses the per chunk free statistics left behind by the sweep to select the address range
+ * (of -Xgc:proactiveCompactionWindowSize bytes) whose compaction yields the largest contiguous
+ * free entry, so that only this window has to be compacted.
+ *
+ * @ingroup GC_Modron_Standard
+ */
+class MM_FragmentationModel : public MM_BaseVirtual
+{
+/*
+ * Data members
+ */
+public:
+protected:
+private:
+	MM_GCExtensionsBase *_extensions;
+	uintptr_t _demandSize; /**< decayed size of the largest objects recently allocated */
+	uintptr_t _previousLargestFreeEntry; /**< largest free entry after the previous sweep (0 if unknown) */
+	intptr_t _averageDecline; /**< smoothed shrinking of the largest free entry per global collection */
+	uintptr_t _predictedCyclesUntilFailure; /**< predicted number of global collections until the demand can not be met (UDATA_MAX if none predicted) */
+	bool _compactionRecommended; /**< true if the last update predicted a failure within the horizon */
+	void *_windowLow; /**< low address of the range to compact (NULL to compact the whole heap) */
+	void *_windowHigh; /**< high address of the range to compact */
+
+/*
+ * Function members
+ */
+public:
+	static MM_FragmentationModel *newInstance(MM_EnvironmentBase *env);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Sample the tenure free list after sweep and update the prediction. Must be called by the master
+	 * thread once the sweep has completed and before the sweep chunks are reused by a compaction.
+	 * @param env[in] The master thread of this collection
+	 * @param allocDescription[in] The allocation which triggered the collection (may be NULL)
+	 */
+	void update(MM_EnvironmentBase *env, MM_AllocateDescription *allocDescription);
+
+	/**
+	 * Reset the trend and the demand after a compaction, which makes the largest free entry jump.
+	 */
+	void compactionCompleted(MM_EnvironmentBase *env);
+
+	/**
+	 * @return true if a large allocation failure is predicted within the horizon
+	 */
+	MMINLINE bool isCompactionRecommended() { return _compactionRecommended; }
+
+	/**
+	 * @return low address of the range that should be compacted, or NULL if the whole heap should be compacted
+	 */
+	MMINLINE void *getCompactionWindowLow() { return _windowLow; }
+
+	/**
+	 * @return high address of the range that should be compacted
+	 */
+	MMINLINE void *getCompactionWindowHigh() { return _windowHigh; }
+
+	/**
+	 * @return predicted number of global collections until the demand can not be met, UDATA_MAX if none is predicted
+	 */
+	MMINLINE uintptr_t getPredictedCyclesUntilFailure() { return _predictedCyclesUntilFailure; }
+
+	MM_FragmentationModel(MM_EnvironmentBase *env);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	virtual void tearDown(MM_EnvironmentBase *env);
+
+private:
+	uintptr_t sampleDemand(MM_EnvironmentBase *env, MM_AllocateDescription *allocDescription);
+	bool selectCompactionWindow(MM_EnvironmentBase *env, uintptr_t windowSize);
+};
+
+#endif /* FRAGMENTATIONMODEL_HPP_ */
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(HEAPDUMPFORMAT_HPP_)
+#define HEAPDUMPFORMAT_HPP_
+
+/**
+ * @file
+ * Layout of the binary heap dump produced by MM_HeapDumpWriter and consumed by MM_HeapDumpReader.
+ *
+ * A dump starts with the HEAP_DUMP_MAGIC bytes followed by two varints: the format version and the
+ * object alignment shift of the heap.  The rest of the file is a sequence of object records:
+ *
+ *   varint address >> shift
+ *   varint consumed size in bytes >> shift
+ *   varint type id >> shift (address of the indirect object, 0 if the object has none)
+ *   varint reference >> shift, for every non-NULL reference slot
+ *   varint 0 (end of record)
+ *
+ * Varints are unsigned LEB128: 7 bits per byte, low order group first, high bit set on all but the last byte.
+ * Records are written by several GC threads, so they are grouped by heap chunk rather than sorted by address.
+ */
+
+#define HEAP_DUMP_MAGIC "OMRHDUMP"
+#define HEAP_DUMP_MAGIC_LENGTH 8
+#define HEAP_DUMP_VERSION 1
+#define HEAP_DUMP_MAX_VARINT_BYTES 10
+#define HEAP_DUMP_DEFAULT_BUFFER_SIZE (1024 * 1024)
+
+#endif /* HEAPDUMPFORMAT_HPP_ */
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <string.h>
+
+#include "HeapDumpReader.hpp"
+
+MM_HeapDumpReader *
+MM_HeapDumpReader::newInstance(OMRPortLibrary *portLibrary, const char *fileName, uintptr_t bufferSize)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	MM_HeapDumpReader *reader = (MM_HeapDumpReader *)omrmem_allocate_memory(sizeof(MM_HeapDumpReader), OMRMEM_CATEGORY_MM);
+	if (NULL != reader) {
+		new(reader) MM_HeapDumpReader(portLibrary, bufferSize);
+		if (!reader->initialize(fileName)) {
+			reader->kill();
+			reader = NULL;
+		}
+	}
+	return reader;
+}
+
+void
+MM_HeapDumpReader::kill()
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+	tearDown();
+	omrmem_free_memory(this);
+}
+
+bool
+MM_HeapDumpReader::initialize(const char *fileName)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	if (_bufferSize < (HEAP_DUMP_MAGIC_LENGTH + (2 * HEAP_DUMP_MAX_VARINT_BYTES))) {
+		return false;
+	}
+	_buffer = (uint8_t *)omrmem_allocate_memory(_bufferSize, OMRMEM_CATEGORY_MM);
+	if (NULL == _buffer) {
+		return false;
+	}
+	_cursor = _buffer;
+	_top = _buffer;
+
+	_fileDescriptor = omrfile_open(fileName, EsOpenRead, 0);
+	if (-1 == _fileDescriptor) {
+		return false;
+	}
+
+	fill();
+	if (((uintptr_t)(_top - _cursor) < HEAP_DUMP_MAGIC_LENGTH) || (0 != memcmp(_cursor, HEAP_DUMP_MAGIC, HEAP_DUMP_MAGIC_LENGTH))) {
+		return false;
+	}
+	_cursor += HEAP_DUMP_MAGIC_LENGTH;
+
+	uint64_t version = 0;
+	uint64_t shift = 0;
+	if (!readVarint(&version) || (HEAP_DUMP_VERSION != version) || !readVarint(&shift) || (shift >= (sizeof(uintptr_t) * 8))) {
+		return false;
+	}
+	_version = (uintptr_t)version;
+	_objectAlignmentShift = (uintptr_t)shift;
+
+	return true;
+}
+
+void
+MM_HeapDumpReader::tearDown()
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	if (-1 != _fileDescriptor) {
+		omrfile_close(_fileDescriptor);
+		_fileDescriptor = -1;
+	}
+	if (NULL != _buffer) {
+		omrmem_free_memory(_buffer);
+		_buffer = NULL;
+	}
+}
+
+void
+MM_HeapDumpReader::fill()
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(_portLibrary);
+
+	uintptr_t remaining = _top - _cursor;
+	memmove(_buffer, _cursor, remaining);
+	_cursor = _buffer;
+	_top = _buffer + remaining;
+
+	while (!_endOfFile && (_top < (_buffer + _bufferSize))) {
+		intptr_t bytesRead = omrfile_read(_fileDescriptor, _top, (intptr_t)((_buffer + _bufferSize) - _top));
+		if (0 >= bytesRead) {
+			_endOfFile = true;
+		} else {
+			_top += bytesRead;
+		}
+	}
+}
+
+bool
+MM_HeapDumpReader::readVarint(uint64_t *value)
+{
+	if (((uintptr_t)(_top - _cursor) < HEAP_DUMP_MAX_VARINT_BYTES) && !_endOfFile) {
+		fill();
+	}
+
+	uint64_t result = 0;
+	for (uintptr_t i = 0; i < HEAP_DUMP_MAX_VARINT_BYTES; i++) {
+		if (_cursor >= _top) {
+			return false;
+		}
+		uint8_t byte = *_cursor++;
+		result |= ((uint64_t)(byte & 0x7F)) << (7 * i);
+		if (0 == (byte & 0x80)) {
+			*value = result;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+MM_HeapDumpReader::nextObject(MM_HeapDumpObject *object)
+{
+	uintptr_t reference = 0;
+	while (nextReference(&reference)) {
+		/* skip references the caller did not read */
+	}
+	if (_corrupt) {
+		return false;
+	}
+
+	if ((_cursor >= _top) && !_endOfFile) {
+		fill();
+	}
+	if (_cursor >= _top) {
+		/* clean end of dump */
+		return false;
+	}
+
+	uint64_t address = 0;
+	uint64_t size = 0;
+	uint64_t typeId = 0;
+	if (!readVarint(&address) || (0 == address) || !readVarint(&size) || !readVarint(&typeId)) {
+		_corrupt = true;
+		return false;
+	}
+	object->address = (uintptr_t)address << _objectAlignmentShift;
+	object->size = (uintptr_t)size << _objectAlignmentShift;
+	object->typeId = (uintptr_t)typeId << _objectAlignmentShift;
+	_inRecord = true;
+
+	return true;
+}
+
+bool
+MM_HeapDumpReader::nextReference(uintptr_t *reference)
+{
+	if (!_inRecord) {
+		return false;
+	}
+
+	uint64_t value = 0;
+	if (!readVarint(&value)) {
+		_corrupt = true;
+		_inRecord = false;
+		return false;
+	}
+	if (0 == value) {
+		_inRecord = false;
+		return false;
+	}
+	*reference = (uintptr_t)value << _objectAlignmentShift;
+
+	return true;
+}
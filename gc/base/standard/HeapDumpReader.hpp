@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(HEAPDUMPREADER_HPP_)
+#define HEAPDUMPREADER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrport.h"
+
+#include "BaseVirtual.hpp"
+#include "HeapDumpFormat.hpp"
+
+/**
+ * Fixed fields of an object record read from a heap dump.
+ */
+struct MM_HeapDumpObject {
+	uintptr_t address; /**< address of the object when the dump was taken */
+	uintptr_t size; /**< consumed size of the object in bytes */
+	uintptr_t typeId; /**< address of the indirect object (eg, class) of the object, 0 if none */
+};
+
+/**
+ * Sequential reader for dumps written by MM_HeapDumpWriter. Only needs a port library, so it can be used
+ * by offline tools as well as in process. Memory use is bounded by the read buffer: references of an object
+ * are streamed rather than collected.
+ *
+ * Usage:
+ *   MM_HeapDumpObject object;
+ *   while (reader->nextObject(&object)) {
+ *       uintptr_t reference;
+ *       while (reader->nextReference(&reference)) { ... }
+ *   }
+ *   if (reader->isCorrupt()) { ... }
+ * @ingroup GC_Modron_Standard
+ */
+class MM_HeapDumpReader : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	OMRPortLibrary *_portLibrary;
+	intptr_t _fileDescriptor; /**< dump file */
+	uint8_t *_buffer; /**< read buffer */
+	uintptr_t _bufferSize;
+	uint8_t *_cursor; /**< next unread byte in the buffer */
+	uint8_t *_top; /**< end of the valid bytes in the buffer */
+	bool _endOfFile; /**< true once the file has been read to the end */
+	bool _corrupt; /**< true if a malformed header or record was found */
+	bool _inRecord; /**< true while references of the current object remain to be read */
+	uintptr_t _version; /**< format version of the dump */
+	uintptr_t _objectAlignmentShift; /**< shift applied to addresses and sizes by the writer */
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	/**
+	 * Move the unread bytes to the start of the buffer and read more from the file.
+	 */
+	void fill();
+
+	/**
+	 * Decode the next varint.
+	 * @return false if the file ends, or the varint is malformed
+	 */
+	bool readVarint(uint64_t *value);
+
+protected:
+	bool initialize(const char *fileName);
+	void tearDown();
+
+public:
+	/**
+	 * Open a heap dump and validate its header.
+	 * @return the reader, or NULL if the file cannot be read or is not a heap dump
+	 */
+	static MM_HeapDumpReader *newInstance(OMRPortLibrary *portLibrary, const char *fileName, uintptr_t bufferSize = HEAP_DUMP_DEFAULT_BUFFER_SIZE);
+	virtual void kill();
+
+	/**
+	 * Read the next object record, skipping any unread references of the previous one.
+	 * @return false at the end of the dump, or if the dump is corrupt
+	 */
+	bool nextObject(MM_HeapDumpObject *object);
+
+	/**
+	 * Read the next outgoing reference of the current object.
+	 * @return false once all references of the current object have been read
+	 */
+	bool nextReference(uintptr_t *reference);
+
+	/**
+	 * @return true if reading stopped on a malformed or truncated record
+	 */
+	bool isCorrupt() { return _corrupt; }
+
+	uintptr_t getVersion() { return _version; }
+
+	MM_HeapDumpReader(OMRPortLibrary *portLibrary, uintptr_t bufferSize)
+		: MM_BaseVirtual()
+		, _portLibrary(portLibrary)
+		, _fileDescriptor(-1)
+		, _buffer(NULL)
+		, _bufferSize(bufferSize)
+		, _cursor(NULL)
+		, _top(NULL)
+		, _endOfFile(false)
+		, _corrupt(false)
+		, _inRecord(false)
+		, _version(0)
+		, _objectAlignmentShift(0)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* HEAPDUMPREADER_HPP_ */
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "ModronAssertions.h"
+
+#include "Dispatcher.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "HeapWalker.hpp"
+#include "ObjectIterator.hpp"
+#include "ObjectModel.hpp"
+#include "SlotObject.hpp"
+
+#include "HeapDumpWriter.hpp"
+
+MM_HeapDumpWriter *
+MM_HeapDumpWriter::newInstance(MM_EnvironmentBase *env, MM_HeapWalker *heapWalker, const char *fileName, uintptr_t bufferSize)
+{
+	MM_HeapDumpWriter *writer = (MM_HeapDumpWriter *)env->getForge()->allocate(sizeof(MM_HeapDumpWriter), OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if (NULL != writer) {
+		new(writer) MM_HeapDumpWriter(env, heapWalker, bufferSize);
+		if (!writer->initialize(env, fileName)) {
+			writer->kill(env);
+			writer = NULL;
+		}
+	}
+	return writer;
+}
+
+void
+MM_HeapDumpWriter::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+bool
+MM_HeapDumpWriter::initialize(MM_EnvironmentBase *env, const char *fileName)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+
+	/* the buffers must at least hold the file header */
+	if (_bufferSize < (HEAP_DUMP_MAGIC_LENGTH + (2 * HEAP_DUMP_MAX_VARINT_BYTES))) {
+		return false;
+	}
+
+	_objectAlignmentShift = extensions->objectModel.getObjectAlignmentShift();
+	_bufferCount = extensions->dispatcher->threadCountMaximum();
+	_buffers = (MM_HeapDumpBuffer *)env->getForge()->allocate(sizeof(MM_HeapDumpBuffer) * _bufferCount, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	_bufferMemory = (uint8_t *)env->getForge()->allocate(_bufferSize * _bufferCount, OMR::GC::AllocationCategory::DIAGNOSTIC, OMR_GET_CALLSITE());
+	if ((NULL == _buffers) || (NULL == _bufferMemory)) {
+		return false;
+	}
+	for (uintptr_t i = 0; i < _bufferCount; i++) {
+		_buffers[i].base = _bufferMemory + (i * _bufferSize);
+		_buffers[i].cursor = _buffers[i].base;
+		_buffers[i].top = _buffers[i].base + _bufferSize;
+		_buffers[i].objectCount = 0;
+		_buffers[i].holdingWriteLock = false;
+	}
+
+	if (0 != omrthread_monitor_init_with_name(&_writeMonitor, 0, "MM_HeapDumpWriter::write")) {
+		_writeMonitor = NULL;
+		return false;
+	}
+
+	_fileDescriptor = omrfile_open(fileName, EsOpenWrite | EsOpenCreate | EsOpenTruncate, 0666);
+	if (-1 == _fileDescriptor) {
+		return false;
+	}
+
+	return true;
+}
+
+void
+MM_HeapDumpWriter::tearDown(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	if (-1 != _fileDescriptor) {
+		omrfile_close(_fileDescriptor);
+		_fileDescriptor = -1;
+	}
+	if (NULL != _writeMonitor) {
+		omrthread_monitor_destroy(_writeMonitor);
+		_writeMonitor = NULL;
+	}
+	if (NULL != _bufferMemory) {
+		env->getForge()->free(_bufferMemory);
+		_bufferMemory = NULL;
+	}
+	if (NULL != _buffers) {
+		env->getForge()->free(_buffers);
+		_buffers = NULL;
+	}
+}
+
+bool
+MM_HeapDumpWriter::writeHeapDump(MM_EnvironmentBase *env)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+
+	_writeFailed = false;
+	_objectCount = 0;
+	_bytesWritten = 0;
+	if (-1 == omrfile_seek(_fileDescriptor, 0, EsSeekSet)) {
+		_writeFailed = true;
+	}
+
+	/* header, written through the master thread's buffer ahead of any record */
+	MM_HeapDumpBuffer *header = &_buffers[env->getSlaveID()];
+	memcpy(header->cursor, HEAP_DUMP_MAGIC, HEAP_DUMP_MAGIC_LENGTH);
+	header->cursor += HEAP_DUMP_MAGIC_LENGTH;
+	writeVarint(env, header, HEAP_DUMP_VERSION);
+	writeVarint(env, header, _objectAlignmentShift);
+	flushBuffer(env, header);
+
+	/* walk live objects only, in parallel across heap chunks */
+	_heapWalker->allObjectsDo(env, writeObjectRecord, (void *)this, 0, true, true);
+
+	for (uintptr_t i = 0; i < _bufferCount; i++) {
+		flushBuffer(env, &_buffers[i]);
+		_objectCount += _buffers[i].objectCount;
+		_buffers[i].objectCount = 0;
+	}
+
+	if (!_writeFailed) {
+		omrfile_set_length(_fileDescriptor, (int64_t)_bytesWritten);
+	}
+
+	return !_writeFailed;
+}
+
+void
+MM_HeapDumpWriter::writeObjectRecord(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectptr_t object, void *userData)
+{
+	((MM_HeapDumpWriter *)userData)->writeObject(MM_EnvironmentBase::getEnvironment(omrVMThread), object);
+}
+
+void
+MM_HeapDumpWriter::writeObject(MM_EnvironmentBase *env, omrobjectptr_t object)
+{
+	MM_GCExtensionsBase *extensions = env->getExtensions();
+	Assert_MM_true(env->getSlaveID() < _bufferCount);
+	MM_HeapDumpBuffer *buffer = &_buffers[env->getSlaveID()];
+
+	writeVarint(env, buffer, (uintptr_t)object >> _objectAlignmentShift);
+	writeVarint(env, buffer, extensions->objectModel.getConsumedSizeInBytesWithHeader(object) >> _objectAlignmentShift);
+	writeVarint(env, buffer, (uintptr_t)extensions->objectModel.getIndirectObject(object) >> _objectAlignmentShift);
+
+	GC_ObjectIterator objectIterator(env->getOmrVM(), object);
+	GC_SlotObject *slotObject = NULL;
+	while (NULL != (slotObject = objectIterator.nextSlot())) {
+		omrobjectptr_t reference = slotObject->readReferenceFromSlot();
+		if (NULL != reference) {
+			writeVarint(env, buffer, (uintptr_t)reference >> _objectAlignmentShift);
+		}
+	}
+	writeVarint(env, buffer, 0);
+
+	buffer->objectCount += 1;
+	if (buffer->holdingWriteLock) {
+		endRecord(env, buffer);
+	}
+}
+
+void
+MM_HeapDumpWriter::flushPartialRecord(MM_EnvironmentBase *env, MM_HeapDumpBuffer *buffer)
+{
+	if (!buffer->holdingWriteLock) {
+		omrthread_monitor_enter(_writeMonitor);
+		buffer->holdingWriteLock = true;
+	}
+	writeToFile(env, buffer->base, buffer->cursor - buffer->base);
+	buffer->cursor = buffer->base;
+}
+
+void
+MM_HeapDumpWriter::endRecord(MM_EnvironmentBase *env, MM_HeapDumpBuffer *buffer)
+{
+	writeToFile(env, buffer->base, buffer->cursor - buffer->base);
+	buffer->cursor = buffer->base;
+	buffer->holdingWriteLock = false;
+	omrthread_monitor_exit(_writeMonitor);
+}
+
+void
+MM_HeapDumpWriter::flushBuffer(MM_EnvironmentBase *env, MM_HeapDumpBuffer *buffer)
+{
+	Assert_MM_true(!buffer->holdingWriteLock);
+	if (buffer->cursor > buffer->base) {
+		omrthread_monitor_enter(_writeMonitor);
+		writeToFile(env, buffer->base, buffer->cursor - buffer->base);
+		omrthread_monitor_exit(_writeMonitor);
+		buffer->cursor = buffer->base;
+	}
+}
+
+void
+MM_HeapDumpWriter::writeToFile(MM_EnvironmentBase *env, void *data, uintptr_t size)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uint8_t *cursor = (uint8_t *)data;
+
+	while (!_writeFailed && (0 < size)) {
+		intptr_t written = omrfile_write(_fileDescriptor, cursor, (intptr_t)size);
+		if (0 >= written) {
+			_writeFailed = true;
+		} else {
+			cursor += written;
+			size -= written;
+			_bytesWritten += written;
+		}
+	}
+}
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(HEAPDUMPWRITER_HPP_)
+#define HEAPDUMPWRITER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrthread.h"
+
+#include "BaseVirtual.hpp"
+#include "HeapDumpFormat.hpp"
+
+class MM_EnvironmentBase;
+class MM_HeapRegionDescriptor;
+class MM_HeapWalker;
+
+/**
+ * Output buffer owned by a single GC thread while the heap is being dumped.
+ */
+struct MM_HeapDumpBuffer {
+	uint8_t *base; /**< start of the buffer */
+	uint8_t *cursor; /**< next byte to be written */
+	uint8_t *top; /**< end of the buffer */
+	uintptr_t objectCount; /**< number of object records written through this buffer */
+	bool holdingWriteLock; /**< true while a record too large for the buffer is being streamed to the file */
+};
+
+/**
+ * Streams the live objects of the heap and their references to a file in the format described in HeapDumpFormat.hpp.
+ * The heap is walked in parallel by the GC threads, each encoding records into its own fixed size buffer that is
+ * appended to the file with one large write when it fills, so memory use is bounded by the buffer size times the
+ * number of GC threads regardless of heap size.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_HeapDumpWriter : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+private:
+	MM_HeapWalker *_heapWalker; /**< walker used to find the live objects */
+	intptr_t _fileDescriptor; /**< dump file */
+	uintptr_t _bufferSize; /**< size of each per thread buffer */
+	uintptr_t _bufferCount; /**< one buffer per GC thread */
+	MM_HeapDumpBuffer *_buffers;
+	uint8_t *_bufferMemory; /**< backing store for all buffers */
+	omrthread_monitor_t _writeMonitor; /**< serializes appends to the dump file */
+	uintptr_t _objectAlignmentShift; /**< addresses and sizes are stored shifted right by this amount */
+	uintptr_t _objectCount; /**< number of object records in the last dump */
+	uint64_t _bytesWritten; /**< size of the last dump */
+	volatile bool _writeFailed; /**< set when any write to the dump file fails */
+protected:
+public:
+
+	/*
+	 * Function members
+	 */
+private:
+	static void writeObjectRecord(OMR_VMThread *omrVMThread, MM_HeapRegionDescriptor *region, omrobjectptr_t object, void *userData);
+	void writeObject(MM_EnvironmentBase *env, omrobjectptr_t object);
+
+	/**
+	 * Append a varint to the buffer, making room first if needed.
+	 */
+	MMINLINE void
+	writeVarint(MM_EnvironmentBase *env, MM_HeapDumpBuffer *buffer, uint64_t value)
+	{
+		if ((uintptr_t)(buffer->top - buffer->cursor) < HEAP_DUMP_MAX_VARINT_BYTES) {
+			flushPartialRecord(env, buffer);
+		}
+		uint8_t *cursor = buffer->cursor;
+		while (value >= 0x80) {
+			*cursor++ = (uint8_t)(value | 0x80);
+			value >>= 7;
+		}
+		*cursor++ = (uint8_t)value;
+		buffer->cursor = cursor;
+	}
+
+	/**
+	 * Write out a full buffer in the middle of a record. The write lock is kept until the record is complete
+	 * so that records from other threads cannot be interleaved with it.
+	 */
+	void flushPartialRecord(MM_EnvironmentBase *env, MM_HeapDumpBuffer *buffer);
+
+	/**
+	 * Release the write lock taken by flushPartialRecord(), writing the tail of the record first.
+	 */
+	void endRecord(MM_EnvironmentBase *env, MM_HeapDumpBuffer *buffer);
+
+	void flushBuffer(MM_EnvironmentBase *env, MM_HeapDumpBuffer *buffer);
+
+	/**
+	 * Append bytes to the dump file. The caller must hold the write monitor.
+	 */
+	void writeToFile(MM_EnvironmentBase *env, void *data, uintptr_t size);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env, const char *fileName);
+	void tearDown(MM_EnvironmentBase *env);
+
+public:
+	/**
+	 * Create a writer for the given dump file.
+	 * @param heapWalker walker of the active global collector
+	 * @param fileName file to create, truncated if it exists
+	 * @param bufferSize size of the per GC thread output buffers
+	 */
+	static MM_HeapDumpWriter *newInstance(MM_EnvironmentBase *env, MM_HeapWalker *heapWalker, const char *fileName, uintptr_t bufferSize = HEAP_DUMP_DEFAULT_BUFFER_SIZE);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Write a dump of all live objects. The caller must have exclusive VM access.
+	 * @return true if the complete dump was written
+	 */
+	bool writeHeapDump(MM_EnvironmentBase *env);
+
+	/**
+	 * @return the number of object records written by the last dump
+	 */
+	uintptr_t getObjectCount() { return _objectCount; }
+
+	/**
+	 * @return the size in bytes of the last dump
+	 */
+	uint64_t getBytesWritten() { return _bytesWritten; }
+
+	MM_HeapDumpWriter(MM_EnvironmentBase *env, MM_HeapWalker *heapWalker, uintptr_t bufferSize)
+		: MM_BaseVirtual()
+		, _heapWalker(heapWalker)
+		, _fileDescriptor(-1)
+		, _bufferSize(bufferSize)
+		, _bufferCount(0)
+		, _buffers(NULL)
+		, _bufferMemory(NULL)
+		, _writeMonitor(NULL)
+		, _objectAlignmentShift(0)
+		, _objectCount(0)
+		, _bytesWritten(0)
+		, _writeFailed(false)
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* HEAPDUMPWRITER_HPP_ */
@@ -39,6 +39,7 @@
 #include "CycleState.hpp"
 #include "Dispatcher.hpp"
 #include "EnvironmentBase.hpp"
+#include "FragmentationModel.hpp"
 #include "GlobalAllocationManager.hpp"
 #include "Heap.hpp"
 #include "HeapMapIterator.hpp"
@@ -60,11 +61,13 @@
 #include "ParallelGlobalGC.hpp"
 #include "ParallelHeapWalker.hpp"
 #include "ParallelMarkTask.hpp"
+#include "ParallelStickyMarkTask.hpp"
 #include "ParallelSweepScheme.hpp"
 #include "ParallelTask.hpp"
 #if defined(OMR_GC_MODRON_SCAVENGER)
 #include "Scavenger.hpp"
 #endif /* OMR_GC_MODRON_SCAVENGER */
+#include "StickyMarkCardTable.hpp"
 #include "WorkPackets.hpp"
 
 /* OMRTODO temporary workaround to allow both ut_j9mm.h and ut_omrmm.h to be included.
@@ -230,6 +233,20 @@ MM_ParallelGlobalGC::initialize(MM_EnvironmentBase *env)
 
 	_delegate.initialize(env, this, _markingScheme);
 
+#if !defined(OMR_GC_OBJECT_MAP)
+	/* sticky mark bits need the mark map and the card table to belong to this collector alone */
+	if (_extensions->stickyMarkBits && !_extensions->isConcurrentMarkEnabled() && !_extensions->isScavengerEnabled()) {
+		_stickyMarkCardTable = MM_StickyMarkCardTable::newInstance(env, _extensions->getHeap());
+		if (NULL == _stickyMarkCardTable) {
+			goto error_no_memory;
+		}
+		_extensions->cardTable = _stickyMarkCardTable;
+	} else
+#endif /* !defined(OMR_GC_OBJECT_MAP) */
+	{
+		_extensions->stickyMarkBits = false;
+	}
+
 	_sweepScheme = createSweepScheme(env, this);
 	if (NULL == _sweepScheme) {
 		goto error_no_memory;
@@ -247,6 +264,13 @@ MM_ParallelGlobalGC::initialize(MM_EnvironmentBase *env)
 	if(NULL == _compactScheme) {
 		goto error_no_memory;
 	}
+
+	if (_extensions->proactiveCompaction) {
+		_fragmentationModel = MM_FragmentationModel::newInstance(env);
+		if (NULL == _fragmentationModel) {
+			goto error_no_memory;
+		}
+	}
 #endif /* defined(OMR_GC_MODRON_COMPACTION) */
 
 	_heapWalker = MM_ParallelHeapWalker::newInstance(this, _markingScheme->getMarkMap(), env);
@@ -297,6 +321,12 @@ MM_ParallelGlobalGC::tearDown(MM_EnvironmentBase *env)
 {
 	_delegate.tearDown(env);
 
+	if (NULL != _stickyMarkCardTable) {
+		_stickyMarkCardTable->kill(env);
+		_stickyMarkCardTable = NULL;
+		_extensions->cardTable = NULL;
+	}
+
 	if(NULL != _markingScheme) {
 		_markingScheme->kill(env);
 		_markingScheme = NULL;
@@ -312,6 +342,11 @@ MM_ParallelGlobalGC::tearDown(MM_EnvironmentBase *env)
 		_compactScheme->kill(env);
 		_compactScheme = NULL;
 	}
+
+	if (NULL != _fragmentationModel) {
+		_fragmentationModel->kill(env);
+		_fragmentationModel = NULL;
+	}
 #endif /* OMR_GC_MODRON_COMPACTION */
 
 	if (NULL != _heapWalker) {
@@ -384,6 +419,7 @@ MM_ParallelGlobalGC::masterThreadGarbageCollect(MM_EnvironmentBase *env, MM_Allo
 	
 	/* Clear the gc stats structure */
 	_extensions->globalGCStats.clear();
+	_extensions->globalGCStats.stickyMarkMinorGC = !initMarkMap && (NULL != _stickyMarkCardTable);
 
 #if defined(OMR_GC_MODRON_COMPACTION)
 	_compactThisCycle = false;
@@ -439,6 +475,10 @@ MM_ParallelGlobalGC::masterThreadGarbageCollect(MM_EnvironmentBase *env, MM_Allo
 	bool compactedThisCycle = false;
 #if defined(OMR_GC_MODRON_COMPACTION)
 	compactedThisCycle = _compactThisCycle;
+	if (compactedThisCycle) {
+		/* compaction reuses the mark map, the next cycle has to rebuild it */
+		_stickyMarkFullCollectionRequired = true;
+	}
 #endif /* OMR_GC_MODRON_COMPACTION */
 
 	/* If the J9VM_DEBUG_ATTRIBUTE_ALLOW_USER_HEAP_WALK flag is set then fix the heap so that it can be walked
@@ -446,7 +486,7 @@ MM_ParallelGlobalGC::masterThreadGarbageCollect(MM_EnvironmentBase *env, MM_Allo
 	 */
 	if (_delegate.isAllowUserHeapWalk() || env->_cycleState->_gcCode.isRASDumpGC()) {
 		if (!_fixHeapForWalkCompleted) {
-#if defined(J9VM_GC_MODRON_COMPACTION)
+#if defined(OMR_GC_MODRON_COMPACTION)
 			if (compactedThisCycle) {
 				OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
 				U_64 startTime = omrtime_hires_clock();
@@ -454,7 +494,7 @@ MM_ParallelGlobalGC::masterThreadGarbageCollect(MM_EnvironmentBase *env, MM_Allo
 				_extensions->globalGCStats.fixHeapForWalkTime = omrtime_hires_delta(startTime, omrtime_hires_clock(), OMRPORT_TIME_DELTA_IN_MICROSECONDS);
 				_extensions->globalGCStats.fixHeapForWalkReason = FIXUP_DEBUG_TOOLING;
 			} else
-#endif /* J9VM_GC_MODRON_COMPACTION */
+#endif /* OMR_GC_MODRON_COMPACTION */
 			{
 				fixHeapForWalk(env, MEMORY_TYPE_RAM, FIXUP_DEBUG_TOOLING, fixObject);
 			}
@@ -597,6 +637,12 @@ MM_ParallelGlobalGC::shouldCompactThisCycle(MM_EnvironmentBase *env, MM_Allocate
 		compactReason = COMPACT_AGGRESSIVE;
 		goto compactionReqd;
 	}
+
+	/* Compact ahead of a large allocation failure predicted from the trend of the largest free entry */
+	if ((NULL != _fragmentationModel) && _fragmentationModel->isCompactionRecommended()) {
+		compactReason = COMPACT_PREDICTED_FRAGMENTATION;
+		goto compactionReqd;
+	}
 	
 #if defined(OMR_GC_THREAD_LOCAL_HEAP)	
 
@@ -762,6 +808,10 @@ MM_ParallelGlobalGC::sweep(MM_EnvironmentBase *env, MM_AllocateDescription *allo
 	MM_MemorySubSpace *activeSubSpace = env->_cycleState->_activeSubSpace;
 	bool isExplicitGC = env->_cycleState->_gcCode.isExplicitGC();
 #if defined(OMR_GC_MODRON_COMPACTION)
+	if (NULL != _fragmentationModel) {
+		_fragmentationModel->update(env, allocDescription);
+	}
+
 	/* Decide is a compaction is required - this decision must be made after we sweep since we use the largestFreeEntrySize, as changed by sweep, to determine if a compaction should be done */
 	_compactThisCycle = shouldCompactThisCycle(env, allocDescription, activeSubSpace->maxExpansionInSpace(env), env->_cycleState->_gcCode);
 
@@ -843,8 +893,17 @@ MM_ParallelGlobalGC::markAll(MM_EnvironmentBase *env, bool initMarkMap)
 	}
 
 	/* run the mark */
-	MM_ParallelMarkTask markTask(env, _dispatcher, _markingScheme, initMarkMap, env->_cycleState);
-	_dispatcher->run(env, &markTask);
+	if (!initMarkMap && (NULL != _stickyMarkCardTable)) {
+		MM_ParallelStickyMarkTask markTask(env, _dispatcher, _markingScheme, _stickyMarkCardTable, env->_cycleState);
+		_dispatcher->run(env, &markTask);
+	} else {
+		MM_ParallelMarkTask markTask(env, _dispatcher, _markingScheme, initMarkMap, env->_cycleState);
+		_dispatcher->run(env, &markTask);
+		if (NULL != _stickyMarkCardTable) {
+			/* every object reachable from a dirty card has just been marked */
+			_stickyMarkCardTable->clearAllCards(env);
+		}
+	}
 	
 	Assert_MM_true(_markingScheme->getWorkPackets()->isAllPacketsEmpty());
 
@@ -879,12 +938,23 @@ MM_ParallelGlobalGC::masterThreadCompact(MM_EnvironmentBase *env, MM_AllocateDes
 	markMap->setMarkMapValid(false);
 	_compactScheme->setMarkMap(markMap);
 
+	/* A predicted failure only requires the most fragmented part of the heap to be compacted */
+	bool aggressive = env->_cycleState->_gcCode.shouldAggressivelyCompact();
+	if ((NULL != _fragmentationModel) && !aggressive && (COMPACT_PREDICTED_FRAGMENTATION == compactStats->_compactReason)) {
+		_compactScheme->setCompactionWindow(_fragmentationModel->getCompactionWindowLow(), _fragmentationModel->getCompactionWindowHigh());
+	}
+
 	reportCompactStart(env);
 	compactStats->_startTime = omrtime_hires_clock();
-	MM_ParallelCompactTask compactTask(env, _dispatcher, _compactScheme, rebuildMarkBits, env->_cycleState->_gcCode.shouldAggressivelyCompact());
+	MM_ParallelCompactTask compactTask(env, _dispatcher, _compactScheme, rebuildMarkBits, aggressive);
 	_dispatcher->run(env, &compactTask);
 	compactStats->_endTime = omrtime_hires_clock();
 	reportCompactEnd(env);
+
+	_compactScheme->setCompactionWindow(NULL, NULL);
+	if (NULL != _fragmentationModel) {
+		_fragmentationModel->compactionCompleted(env);
+	}
 	
 	/* Remember the gc count of the last compaction */ 
 	_extensions->globalGCStats.compactStats._lastHeapCompaction= _extensions->globalGCStats.gcCount;
@@ -1090,12 +1160,43 @@ MM_ParallelGlobalGC::internalGarbageCollect(MM_EnvironmentBase *env, MM_MemorySu
 	if (_disableGC) {
 		env->_cycleState->_activeSubSpace->checkResize(env, allocDescription, false);
 		env->_cycleState->_activeSubSpace->performResize(env, allocDescription);
-	} else {
+	} else if (NULL == _stickyMarkCardTable) {
 		masterThreadGarbageCollect(env, allocDescription, true, false);
+	} else {
+		bool minorCollection = shouldRunStickyMarkMinorCollection(env);
+		_stickyMarkFullCollectionRequired = false;
+
+		masterThreadGarbageCollect(env, allocDescription, !minorCollection, false);
+
+		if (minorCollection) {
+			_stickyMarkMinorCollectionCount += 1;
+			_extensions->globalGCStats.stickyMarkMinorGCCount += 1;
+		} else {
+			_stickyMarkMinorCollectionCount = 0;
+		}
+
+		/* objects that died after being marked are only reclaimed by a full collection */
+		MM_Heap *heap = _extensions->heap;
+		uintptr_t minFreeBytes = (heap->getActiveMemorySize() / 100) * _extensions->stickyMarkMinFreePercent;
+		if (heap->getApproximateActiveFreeMemorySize() < minFreeBytes) {
+			_stickyMarkFullCollectionRequired = true;
+		}
 	}
 	return true;
 }
 
+bool
+MM_ParallelGlobalGC::shouldRunStickyMarkMinorCollection(MM_EnvironmentBase *env)
+{
+	MM_GCCode gcCode = env->_cycleState->_gcCode;
+
+	return !_stickyMarkFullCollectionRequired
+		&& (_stickyMarkMinorCollectionCount < _extensions->stickyMarkMaxMinorCollections)
+		&& !gcCode.isExplicitGC()
+		&& !gcCode.isAggressiveGC()
+		&& !gcCode.isRASDumpGC();
+}
+
 /**
  * This routine prepares the heap for a parallel walk by performing
  * a marking phase.
@@ -1175,8 +1276,19 @@ MM_ParallelGlobalGC::heapAddRange(MM_EnvironmentBase *env, MM_MemorySubSpace *su
 		goto parallelGlobalGC_failed_heapAddRange;
 	}
 
+	if (NULL != _stickyMarkCardTable) {
+		result = _stickyMarkCardTable->heapAddRange(env, subspace, size, lowAddress, highAddress);
+		if (0 == result) {
+			goto stickyMarkCardTable_failed_heapAddRange;
+		}
+		/* the next minor collection relies on the mark bits of the new range, which are not cleared when committed */
+		_markingScheme->getMarkMap()->setBitsInRange(env, lowAddress, highAddress, true);
+	}
+
 	return true;
 
+stickyMarkCardTable_failed_heapAddRange:
+	_delegate.heapRemoveRange(env, subspace, size, lowAddress, highAddress, NULL, NULL);
 parallelGlobalGC_failed_heapAddRange:
 #if defined(OMR_GC_OBJECT_MAP)
 	_extensions->getObjectMap()->heapRemoveRange(env, subspace, size, lowAddress, highAddress, NULL, NULL);
@@ -1200,6 +1312,9 @@ MM_ParallelGlobalGC::heapRemoveRange(MM_EnvironmentBase *env, MM_MemorySubSpace
 	result = result && _sweepScheme->heapRemoveRange(env, subspace, size, lowAddress, highAddress, lowValidAddress, highValidAddress);
 
 	result = result && _delegate.heapRemoveRange(env, subspace, size, lowAddress, highAddress, lowValidAddress, highValidAddress);
+	if (NULL != _stickyMarkCardTable) {
+		result = result && _stickyMarkCardTable->heapRemoveRange(env, subspace, size, lowAddress, highAddress, lowValidAddress, highValidAddress);
+	}
 
 	return result;
 }
@@ -1219,7 +1334,7 @@ MM_ParallelGlobalGC::collectorStartup(MM_GCExtensionsBase* extensions)
 {
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	if (extensions->scavengerEnabled && (NULL != extensions->scavenger)) {
-		extensions->scavenger->collectorStartup(extensions);
+		return extensions->scavenger->collectorStartup(extensions);
 	}
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
 	return true;
@@ -43,8 +43,10 @@
 class MM_CollectionStatisticsStandard;
 class MM_CompactScheme;
 class MM_Dispatcher;
+class MM_FragmentationModel;
 class MM_MarkingScheme;
 class MM_MemorySubSpace;
+class MM_StickyMarkCardTable;
 
 /**
  * Multi-threaded mark and sweep global collector.
@@ -63,8 +65,13 @@ private:
 #if defined(OMR_GC_MODRON_COMPACTION)
 	MM_CompactScheme *_compactScheme;
 	bool _compactThisCycle;		/**< keep a decision should compact run this cycle */
+	MM_FragmentationModel *_fragmentationModel; /**< predicts large allocation failures to compact proactively (NULL unless -Xgc:proactiveCompaction) */
 #endif /* OMR_GC_MODRON_COMPACTION */
 
+	MM_StickyMarkCardTable *_stickyMarkCardTable; /**< Cards dirtied since the last cycle, NULL unless sticky mark bit minor collections are enabled */
+	bool _stickyMarkFullCollectionRequired; /**< True if the mark map can not be trusted by the next cycle (first cycle, compaction or low free memory) */
+	uintptr_t _stickyMarkMinorCollectionCount; /**< Number of sticky mark bit minor collections since the last full collection */
+
 protected:
 	MM_MarkingScheme *_markingScheme;
 	MM_ParallelSweepScheme *_sweepScheme;
@@ -144,6 +151,16 @@ private:
 	 *	@param initMarkMap instruct should mark map be initialized (might be already partially done like in conrurrentGC) 
 	 */
 	void markAll(MM_EnvironmentBase *env, bool initMarkMap);
+
+	/**
+	 * Decide whether this cycle may run as a sticky mark bit minor collection, keeping the mark bits of the
+	 * previous cycle and tracing only from the roots and the dirty cards. Explicit, aggressive and RAS dump
+	 * collections are always full, as is the first cycle and any cycle following a compaction, a minor collection
+	 * that left less than stickyMarkMinFreePercent of the heap free, or stickyMarkMaxMinorCollections minor
+	 * collections in a row.
+	 * @return true if the cycle should be a minor collection
+	 */
+	bool shouldRunStickyMarkMinorCollection(MM_EnvironmentBase *env);
 	
 	/**
 	 *	Main call for Sweep operation
@@ -314,7 +331,11 @@ public:
 #if defined(OMR_GC_MODRON_COMPACTION)
 		, _compactScheme(NULL)
 		, _compactThisCycle(false)
+		, _fragmentationModel(NULL)
 #endif /* OMR_GC_MODRON_COMPACTION */
+		, _stickyMarkCardTable(NULL)
+		, _stickyMarkFullCollectionRequired(true)
+		, _stickyMarkMinorCollectionCount(0)
 		, _markingScheme(NULL)
 		, _sweepScheme(NULL)
 		, _heapWalker(NULL)
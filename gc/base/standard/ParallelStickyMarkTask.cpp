@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#include "ParallelStickyMarkTask.hpp"
+
+#include "CardCleanerForMarking.hpp"
+#include "EnvironmentBase.hpp"
+#include "MarkingScheme.hpp"
+#include "StickyMarkCardTable.hpp"
+#include "WorkStack.hpp"
+
+void
+MM_ParallelStickyMarkTask::run(MM_EnvironmentBase *env)
+{
+	env->_workStack.prepareForWork(env, (MM_WorkPackets *)(_markingScheme->getWorkPackets()));
+
+	_markingScheme->markLiveObjectsInit(env, false);
+	_markingScheme->markLiveObjectsRoots(env);
+
+	/* rescan objects marked in earlier cycles that have been stored into since, to find references to new objects */
+	MM_CardCleanerForMarking cardCleaner(_markingScheme);
+	_cardTable->cleanAllCards(env, &cardCleaner);
+
+	_markingScheme->markLiveObjectsScan(env);
+	_markingScheme->markLiveObjectsComplete(env);
+
+	env->_workStack.flush(env);
+}
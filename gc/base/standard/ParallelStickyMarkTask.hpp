@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(PARALLELSTICKYMARKTASK_HPP_)
+#define PARALLELSTICKYMARKTASK_HPP_
+
+#include "omrcfg.h"
+
+#include "ParallelMarkTask.hpp"
+
+class MM_StickyMarkCardTable;
+
+/**
+ * Mark task for a sticky mark bit minor collection. The mark map is not cleared, so objects marked
+ * in earlier cycles are treated as live and are not traced again; tracing starts from the roots and
+ * from the marked objects in cards dirtied since the previous cycle.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_ParallelStickyMarkTask : public MM_ParallelMarkTask
+{
+private:
+	MM_StickyMarkCardTable *_cardTable; /**< Cards dirtied by the write barrier since the previous cycle */
+
+public:
+	virtual void run(MM_EnvironmentBase *env);
+
+	/**
+	 * Create a ParallelStickyMarkTask object.
+	 */
+	MM_ParallelStickyMarkTask(MM_EnvironmentBase *env,
+			MM_Dispatcher *dispatcher,
+			MM_MarkingScheme *markingScheme,
+			MM_StickyMarkCardTable *cardTable,
+			MM_CycleState *cycleState) :
+		MM_ParallelMarkTask(env, dispatcher, markingScheme, false, cycleState)
+		,_cardTable(cardTable)
+	{
+		_typeId = __FUNCTION__;
+	};
+};
+
+#endif /* PARALLELSTICKYMARKTASK_HPP_ */
@@ -32,6 +32,7 @@
 #include "Dispatcher.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
+#include "GCTimeline.hpp"
 #include "Heap.hpp"
 #include "HeapMemoryPoolIterator.hpp"
 #include "HeapLinkedFreeHeader.hpp"
@@ -670,6 +671,23 @@ MM_ParallelSweepScheme::connectChunk(MM_EnvironmentBase *env, MM_ParallelSweepCh
 	sweepPoolManager->connectChunk(env, chunk);
 }
 
+/**
+ * Connect a chunk into the free list, possibly leaving the writes to the heap to applyAllChunkConnections().
+ * @see MM_SweepPoolManager::planConnectChunk()
+ */
+void
+MM_ParallelSweepScheme::planConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk)
+{
+	MM_SweepPoolManager *sweepPoolManager = chunk->memoryPool->getSweepPoolManager();
+	sweepPoolManager->planConnectChunk(env, chunk);
+}
+
+/**
+ * Connect all chunks into the free lists of their memory pools.
+ * This is the serial part of the connection: the free list state is carried from chunk to chunk in address
+ * order, reading only the chunk data. The writes to the heap it implies are recorded in the chunks, to be
+ * performed in parallel by applyAllChunkConnections().
+ */
 void
 MM_ParallelSweepScheme::connectAllChunks(MM_EnvironmentBase *env, uintptr_t totalChunkCount)
 {
@@ -684,11 +702,29 @@ MM_ParallelSweepScheme::connectAllChunks(MM_EnvironmentBase *env, uintptr_t tota
 		sweepChunk = sectioningIterator.nextChunk();
 		Assert_MM_true(sweepChunk != NULL);  /* Should never return NULL */
 
-		connectChunk(env, sweepChunk);
+		planConnectChunk(env, sweepChunk);
 	}
+}
 
-	/* Walk all memory spaces flushing the previous free entry */
-	flushAllFinalChunks(env);
+/**
+ * Perform the writes to the heap recorded in the chunks by connectAllChunks().
+ * Called by all work threads; the chunks are independent of each other.
+ */
+void
+MM_ParallelSweepScheme::applyAllChunkConnections(MM_EnvironmentBase *env, uintptr_t totalChunkCount)
+{
+	MM_ParallelSweepChunk *sweepChunk;
+	MM_SweepHeapSectioningIterator sectioningIterator(_sweepHeapSectioning);
+
+	for (uintptr_t chunkNum = 0; chunkNum < totalChunkCount; chunkNum++) {
+		sweepChunk = sectioningIterator.nextChunk();
+		Assert_MM_true(sweepChunk != NULL);  /* Should never return NULL */
+
+		if (J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+			MM_SweepPoolManager *sweepPoolManager = sweepChunk->memoryPool->getSweepPoolManager();
+			sweepPoolManager->applyConnectChunk(env, sweepChunk);
+		}
+	}
 }
 
 /**
@@ -772,9 +808,11 @@ MM_ParallelSweepScheme::internalSweep(MM_EnvironmentBase *env)
 	}
 
 	/* ..all threads now join in to do actual sweep */
+	MM_GCTimeline::recordBegin(env, "sweep chunks");
 	sweepAllChunks(env, _chunksPrepared);
+	MM_GCTimeline::recordEnd(env, "sweep chunks");
 	
-	/* ..and then master thread finishes off by connecting all the chunks */
+	/* ..and then master thread plans the connection of all the chunks */
 	if (env->_currentTask->synchronizeGCThreadsAndReleaseMaster(env, UNIQUE_ID)) {
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
 		uint64_t mergeStartTime, mergeEndTime;
@@ -785,9 +823,6 @@ MM_ParallelSweepScheme::internalSweep(MM_EnvironmentBase *env)
 
 		connectAllChunks(env, _chunksPrepared);
 
-		_extensions->splitFreeListNumberChunksPrepared = _chunksPrepared;
-		allPoolsPostProcess(env);
-
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
 		mergeEndTime = omrtime_hires_clock();
 		env->_sweepStats.addToMergeTime(mergeStartTime, mergeEndTime);
@@ -795,6 +830,22 @@ MM_ParallelSweepScheme::internalSweep(MM_EnvironmentBase *env)
 
 		env->_currentTask->releaseSynchronizedGCThreads(env);
 	}
+
+	/* ..all threads build the free entries linking the chunks.. */
+	MM_GCTimeline::recordBegin(env, "connect chunks");
+	applyAllChunkConnections(env, _chunksPrepared);
+	MM_GCTimeline::recordEnd(env, "connect chunks");
+
+	/* ..and the master thread terminates the free lists */
+	if (env->_currentTask->synchronizeGCThreadsAndReleaseMaster(env, UNIQUE_ID)) {
+		/* Walk all memory spaces flushing the previous free entry */
+		flushAllFinalChunks(env);
+
+		_extensions->splitFreeListNumberChunksPrepared = _chunksPrepared;
+		allPoolsPostProcess(env);
+
+		env->_currentTask->releaseSynchronizedGCThreads(env);
+	}
 }
 
 /**
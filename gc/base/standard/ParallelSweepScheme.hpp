@@ -131,7 +131,9 @@ protected:
 	uintptr_t prepareAllChunks(MM_EnvironmentBase *env);
 	
 	virtual void connectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk);
+	virtual void planConnectChunk(MM_EnvironmentBase *env, MM_ParallelSweepChunk *chunk);
 	void connectAllChunks(MM_EnvironmentBase *env, uintptr_t totalChunkCount);
+	void applyAllChunkConnections(MM_EnvironmentBase *env, uintptr_t totalChunkCount);
 
 	void initializeSweepStates(MM_EnvironmentBase *env);
 
@@ -1207,6 +1207,7 @@ MM_PhysicalSubArenaVirtualMemorySemiSpace::expandNoCheck(MM_EnvironmentBase *env
 			/* Memory couldn't be commited (for whatever reason) - can't expand */
 			return 0;
 		}
+		prefaultExpandedRange(env, newLowAddress, _lowAddress);
 		/* The survivor space will have its free list rebuilt - don't bother adding memory */
 		if(debug) {
 			omrtty_printf("\tRemove: allocate(%p %p)\n", freeRangeToTransferBase, (void *)_lowSemiSpaceRegion->getHighAddress());
@@ -1277,6 +1278,7 @@ MM_PhysicalSubArenaVirtualMemorySemiSpace::expandNoCheck(MM_EnvironmentBase *env
 			/* Memory couldn't be commited (for whatever reason) - can't expand */
 			return 0;
 		}
+		prefaultExpandedRange(env, newLowAddress, _lowAddress);
 		/* Adjust the high and low segment ranges (high gains at its base, low gives
 		 * way at top and gains at base)
 		 */
@@ -56,6 +56,7 @@
 #include "EnvironmentBase.hpp"
 #include "EnvironmentStandard.hpp"
 #include "ForwardedHeader.hpp"
+#include "GCTimeline.hpp"
 #include "IndexableObjectScanner.hpp"
 #include "Heap.hpp"
 #include "HeapRegionDescriptorStandard.hpp"
@@ -660,6 +661,7 @@ MM_Scavenger::mergeGCStatsBase(MM_EnvironmentBase *env, MM_ScavengerStats *final
 	finalGCStats->_aliasToCopyCacheCount += scavStats->_aliasToCopyCacheCount;
 	finalGCStats->_arraySplitCount += scavStats->_arraySplitCount;
 	finalGCStats->_arraySplitAmount += scavStats->_arraySplitAmount;
+	finalGCStats->_largeObjectCopyHelpCount += scavStats->_largeObjectCopyHelpCount;
 #endif /* J9MODRON_TGC_PARALLEL_STATISTICS */
 
 	finalGCStats->_flipDiscardBytes += scavStats->_flipDiscardBytes;
@@ -1233,6 +1235,87 @@ MM_Scavenger::copyObjectSlot(MM_EnvironmentStandard *env, GC_SlotObject *slotObj
 	return copyAndForward(env, slotObject);
 }
 
+void
+MM_Scavenger::copyObjectContents(MM_EnvironmentStandard *env, void *destination, void *source, uintptr_t size)
+{
+	uintptr_t threshold = _extensions->scavengerParallelCopyThreshold;
+	if ((0 == threshold) || (size < threshold)
+		|| (NULL == env->_currentTask) || (1 >= env->_currentTask->getThreadCount())
+		|| (0 != MM_AtomicOperations::lockCompareExchange(&_largeObjectCopyOwner, 0, 1))
+	) {
+		/* small object, no one to help, or another large object copy is already being shared */
+		memcpy(destination, source, size);
+		return;
+	}
+
+	_largeObjectCopySource = (uint8_t *)source;
+	_largeObjectCopyDestination = (uint8_t *)destination;
+	_largeObjectCopySize = size;
+	_largeObjectCopyChunkSize = OMR_MAX(_extensions->scavengerScanCacheMaximumSize, DEFAULT_SCAN_CACHE_MINIMUM_SIZE);
+	_largeObjectCopyNextOffset = 0;
+	MM_AtomicOperations::writeBarrier();
+	_largeObjectCopyActive = true;
+	MM_AtomicOperations::readWriteBarrier();
+
+	/* wake up threads idling for scan work, so they can help */
+	if (0 != _waitingCount) {
+		omrthread_monitor_enter(_scanCacheMonitor);
+		if (0 != _waitingCount) {
+			omrthread_monitor_notify_all(_scanCacheMonitor);
+		}
+		omrthread_monitor_exit(_scanCacheMonitor);
+	}
+
+	copyLargeObjectChunks(env);
+
+	/* All chunks are claimed. Turn away new helpers, and wait for the ones still copying their chunk */
+	_largeObjectCopyActive = false;
+	MM_AtomicOperations::readWriteBarrier();
+	while (0 != _largeObjectCopyHelpers) {
+		MM_AtomicOperations::yieldCPU();
+	}
+	MM_AtomicOperations::readBarrier();
+
+	_largeObjectCopyOwner = 0;
+}
+
+uintptr_t
+MM_Scavenger::copyLargeObjectChunks(MM_EnvironmentStandard *env)
+{
+	uintptr_t chunkSize = _largeObjectCopyChunkSize;
+	uintptr_t size = _largeObjectCopySize;
+	uintptr_t chunksCopied = 0;
+
+	for (;;) {
+		uintptr_t offset = MM_AtomicOperations::add(&_largeObjectCopyNextOffset, chunkSize) - chunkSize;
+		if (offset >= size) {
+			break;
+		}
+		memcpy(_largeObjectCopyDestination + offset, _largeObjectCopySource + offset, OMR_MIN(chunkSize, size - offset));
+		chunksCopied += 1;
+	}
+
+	return chunksCopied;
+}
+
+void
+MM_Scavenger::helpLargeObjectCopy(MM_EnvironmentStandard *env)
+{
+	if (isLargeObjectCopyWorkAvailable()) {
+		MM_AtomicOperations::add(&_largeObjectCopyHelpers, 1);
+		/* the owner may have finished claiming chunks (and be about to reuse the shared state) since we looked */
+		if (_largeObjectCopyActive) {
+#if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
+			env->_scavengerStats._largeObjectCopyHelpCount += copyLargeObjectChunks(env);
+#else /* J9MODRON_TGC_PARALLEL_STATISTICS */
+			copyLargeObjectChunks(env);
+#endif /* J9MODRON_TGC_PARALLEL_STATISTICS */
+		}
+		MM_AtomicOperations::writeBarrier();
+		MM_AtomicOperations::subtract(&_largeObjectCopyHelpers, 1);
+	}
+}
+
 omrobjectptr_t
 MM_Scavenger::copyObject(MM_EnvironmentStandard *env, MM_ForwardedHeader* forwardedHeader)
 {
@@ -1437,7 +1520,7 @@ MM_Scavenger::copy(MM_EnvironmentStandard *env, MM_ForwardedHeader* forwardedHea
 		} else
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 		{
-			memcpy((void *)destinationObjectPtr, forwardedHeader->getObject(), objectCopySizeInBytes);
+			copyObjectContents(env, (void *)destinationObjectPtr, forwardedHeader->getObject(), objectCopySizeInBytes);
 
 			/* Copy the preserved fields from the forwarded header into the destination object */
 			forwardedHeader->fixupForwardedObject(destinationObjectPtr);
@@ -1837,6 +1920,9 @@ MM_Scavenger::getNextScanCache(MM_EnvironmentStandard *env)
 #endif /* OMR_SCAVENGER_TRACE || J9MODRON_TGC_PARALLEL_STATISTICS */
 
  	while (!doneFlag && !shouldAbortScanLoop()) {
+		/* Idle threads help with copying a large object, which its owner has to finish before scanning on */
+		helpLargeObjectCopy(env);
+
  		while (_cachedEntryCount > 0) {
  			cache = getNextScanCacheFromList(env);
 
@@ -1870,7 +1956,7 @@ MM_Scavenger::getNextScanCache(MM_EnvironmentStandard *env)
 				_extensions->copyScanRatio.reset(env, false);
 				omrthread_monitor_notify_all(_scanCacheMonitor);
 			} else {
-				while((0 == _cachedEntryCount) && (doneIndex == _doneIndex) && !shouldAbortScanLoop()) {
+				while((0 == _cachedEntryCount) && (doneIndex == _doneIndex) && !shouldAbortScanLoop() && !isLargeObjectCopyWorkAvailable()) {
 					flushBuffersForGetNextScanCache(env);
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
 					uint64_t waitEndTime, waitStartTime;
@@ -2092,16 +2178,25 @@ MM_Scavenger::workThreadGarbageCollect(MM_EnvironmentStandard *env)
 	 */
 	MM_ScavengerRootScanner rootScanner(env, this);
 
+	MM_GCTimeline::recordBegin(env, "remembered set");
 	rootScanner.scavengeRememberedSet(env);
+	MM_GCTimeline::recordEnd(env, "remembered set");
 
+	MM_GCTimeline::recordBegin(env, "roots");
 	rootScanner.scanRoots(env);
+	MM_GCTimeline::recordEnd(env, "roots");
 
-	if(completeScan(env)) {
+	MM_GCTimeline::recordBegin(env, "scan");
+	bool scanCompleted = completeScan(env);
+	MM_GCTimeline::recordEnd(env, "scan");
+	if(scanCompleted) {
+		MM_GCTimeline::recordBegin(env, "clearable");
 		if (_rescanThreadsForRememberedObjects) {
 			rootScanner.rescanThreadSlots(env);
 			flushRememberedSet(env);
 		}
 		rootScanner.scanClearable(env);
+		MM_GCTimeline::recordEnd(env, "clearable");
 	}
 	rootScanner.flush(env);
 
@@ -3430,6 +3525,83 @@ MM_Scavenger::fixupObjectScan(MM_EnvironmentStandard *env, omrobjectptr_t object
 	}
 }
 
+bool
+MM_Scavenger::mutatorReadBarrierHealSlot(MM_EnvironmentStandard *env, GC_SlotObject *slotObject)
+{
+	MM_ScavengerStats *scavStats = &env->_scavengerStats;
+	omrobjectptr_t objectPtr = slotObject->readReferenceFromSlot();
+	/* copy() counts only the copies this thread made, so a change in its counts means the object
+	 * was copied here rather than found already forwarded by a GC thread or another mutator */
+	uintptr_t copyCount = scavStats->_flipCount + scavStats->_tenureAggregateCount;
+
+	copyAndForward(env, slotObject);
+
+	if (copyCount != (scavStats->_flipCount + scavStats->_tenureAggregateCount)) {
+		scavStats->_readObjectBarrierCopy += 1;
+	}
+	bool healed = (objectPtr != slotObject->readReferenceFromSlot());
+	if (healed) {
+		scavStats->_readObjectBarrierUpdate += 1;
+	}
+	return healed;
+}
+
+bool
+MM_Scavenger::mutatorReadBarrierSlowPath(MM_EnvironmentStandard *env, omrobjectptr_t parentObject, GC_SlotObject *slotObject)
+{
+	OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+	uint64_t startTime = omrtime_hires_clock();
+	MM_ScavengerStats *scavStats = &env->_scavengerStats;
+	bool healed = false;
+
+	scavStats->_readObjectBarrierCount += 1;
+
+	if (isConcurrentInProgress()) {
+		healed = mutatorReadBarrierHealSlot(env, slotObject);
+
+		if (_extensions->concurrentScavengerSelfHealObject && (NULL != parentObject)) {
+			/* Heal the rest of the object now, rather than taking a slow path hit for each of its slots */
+			GC_SlotObject *siblingSlot = NULL;
+			GC_ObjectScannerState objectScannerState;
+			GC_ObjectScanner *objectScanner = getObjectScanner(env, parentObject, (void *) &objectScannerState, GC_ObjectScanner::scanHeap);
+			if (NULL != objectScanner) {
+				while (NULL != (siblingSlot = objectScanner->getNextSlot())) {
+					omrobjectptr_t objectPtr = siblingSlot->readReferenceFromSlot();
+					if ((NULL != objectPtr) && isObjectInEvacuateMemory(objectPtr)) {
+						mutatorReadBarrierHealSlot(env, siblingSlot);
+					}
+				}
+			}
+		}
+	}
+
+	scavStats->_readObjectBarrierTime += omrtime_hires_clock() - startTime;
+	return healed;
+}
+
+void
+MM_Scavenger::mergeMutatorReadBarrierStats(MM_EnvironmentBase *env)
+{
+	MM_ScavengerStats *finalGCStats = &_extensions->scavengerStats;
+	GC_OMRVMThreadListIterator threadIterator(_extensions->getOmrVM());
+	OMR_VMThread *walkThread = NULL;
+
+	while (NULL != (walkThread = threadIterator.nextOMRVMThread())) {
+		MM_EnvironmentStandard *threadEnvironment = MM_EnvironmentStandard::getEnvironment(walkThread);
+		if (MUTATOR_THREAD == threadEnvironment->getThreadType()) {
+			MM_ScavengerStats *scavStats = &threadEnvironment->_scavengerStats;
+			finalGCStats->_readObjectBarrierCount += scavStats->_readObjectBarrierCount;
+			finalGCStats->_readObjectBarrierTime += scavStats->_readObjectBarrierTime;
+			finalGCStats->_readObjectBarrierCopy += scavStats->_readObjectBarrierCopy;
+			finalGCStats->_readObjectBarrierUpdate += scavStats->_readObjectBarrierUpdate;
+			scavStats->_readObjectBarrierCount = 0;
+			scavStats->_readObjectBarrierTime = 0;
+			scavStats->_readObjectBarrierCopy = 0;
+			scavStats->_readObjectBarrierUpdate = 0;
+		}
+	}
+}
+
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 
 void
@@ -4656,6 +4828,9 @@ MM_Scavenger::scavengeComplete(MM_EnvironmentBase *envBase)
 
 	Assert_MM_true(_scavengeCacheFreeList.areAllCachesReturned());
 
+	/* mutators are stopped, so their read barrier counters for this cycle are final */
+	mergeMutatorReadBarrierStats(env);
+
 	return false;
 }
 
@@ -4813,9 +4988,13 @@ MM_Scavenger::workThreadProcessRoots(MM_EnvironmentStandard *env)
 	MM_ScavengerRootScanner rootScanner(env, this);
 
 	/* Indirect refs, only. */
+	MM_GCTimeline::recordBegin(env, "remembered set");
 	rootScanner.scavengeRememberedSet(env);
+	MM_GCTimeline::recordEnd(env, "remembered set");
 
+	MM_GCTimeline::recordBegin(env, "roots");
 	rootScanner.scanRoots(env);
+	MM_GCTimeline::recordEnd(env, "roots");
 
 	/* Push any thread local copy caches to scan queue and abandon unused memory to make it walkable.
 	 * This is important to do only for GC threads that will not be used in concurrent phase, but at this point
@@ -4834,9 +5013,13 @@ MM_Scavenger::workThreadScan(MM_EnvironmentStandard *env)
 
 	/* Direct refs, only. */
 	MM_ScavengerRootScanner rootScanner(env, this);
+	MM_GCTimeline::recordBegin(env, "remembered set");
 	rootScanner.scavengeRememberedSet(env);
+	MM_GCTimeline::recordEnd(env, "remembered set");
 
+	MM_GCTimeline::recordBegin(env, "scan");
 	completeScan(env);
+	MM_GCTimeline::recordEnd(env, "scan");
 	// todo: are these two steps really necessary?
 	// we probably have to clear all things for master since it'll be doing final release/clear on behalf of mutator threads
 	// but is it really needed for slaves as well?
@@ -4859,11 +5042,15 @@ MM_Scavenger::workThreadComplete(MM_EnvironmentStandard *env)
 	/* Complete scan loop regardless if we already aborted. If so, the scan operation will just fix up pointers that still point to forwarded objects.
 	 * This is important particularly for Tenure space where recovery procedure will not walk the Tenure space for exhaustive fixup.
 	 */
+	MM_GCTimeline::recordBegin(env, "scan");
 	completeScan(env);
+	MM_GCTimeline::recordEnd(env, "scan");
 
 	if (!isBackOutFlagRaised()) {
 		/* If aborted, the clearable work will be done by mandatory percolate global GC */
+		MM_GCTimeline::recordBegin(env, "clearable");
 		rootScanner.scanClearable(env);
+		MM_GCTimeline::recordEnd(env, "clearable");
 	}
 	rootScanner.flush(env);
 
@@ -106,6 +106,14 @@ private:
 	omrthread_monitor_t _scanCacheMonitor; /**< monitor to synchronize threads on scan lists */
 	omrthread_monitor_t _freeCacheMonitor; /**< monitor to synchronize threads on free list */
 	volatile uintptr_t _waitingCount; /**< count of threads waiting  on scan cache queues (blocked via _scanCacheMonitor); threads never wait on _freeCacheMonitor */
+	volatile uintptr_t _largeObjectCopyOwner; /**< 1 while a copying thread owns the shared large object copy state below */
+	volatile bool _largeObjectCopyActive; /**< true while chunks of the shared large object copy may still be claimed */
+	volatile uintptr_t _largeObjectCopyHelpers; /**< number of threads currently helping with the shared large object copy */
+	volatile uintptr_t _largeObjectCopyNextOffset; /**< offset of the next unclaimed chunk of the shared large object copy */
+	uint8_t *_largeObjectCopySource; /**< source of the shared large object copy */
+	uint8_t *_largeObjectCopyDestination; /**< destination of the shared large object copy */
+	uintptr_t _largeObjectCopySize; /**< bytes to copy in the shared large object copy */
+	uintptr_t _largeObjectCopyChunkSize; /**< bytes claimed at a time from the shared large object copy */
 	uintptr_t _cacheLineAlignment; /**< The number of bytes per cache line which is used to determine which boundaries in memory represent the beginning of a cache line */
 	volatile bool _rescanThreadsForRememberedObjects; /**< Indicates that thread-referenced objects were tenured and threads must be rescanned */
 
@@ -217,6 +225,36 @@ public:
 
 	MMINLINE omrobjectptr_t copy(MM_EnvironmentStandard *env, MM_ForwardedHeader* forwardedHeader);
 
+	/**
+	 * Copy the contents of an object to its new location. Objects of at least scavengerParallelCopyThreshold
+	 * bytes are split into scan cache sized chunks, which GC threads idling in getNextScanCache() can claim and
+	 * copy in parallel. The copy is complete when this returns.
+	 * @param destination new location of the object
+	 * @param source object in evacuate space
+	 * @param size bytes to copy
+	 */
+	void copyObjectContents(MM_EnvironmentStandard *env, void *destination, void *source, uintptr_t size);
+
+	/**
+	 * Claim and copy chunks of the shared large object copy until none are left.
+	 * @return number of chunks copied by the calling thread
+	 */
+	uintptr_t copyLargeObjectChunks(MM_EnvironmentStandard *env);
+
+	/**
+	 * Help with the shared large object copy, if one is in progress.
+	 */
+	void helpLargeObjectCopy(MM_EnvironmentStandard *env);
+
+	/**
+	 * @return true if the shared large object copy has chunks left to claim
+	 */
+	MMINLINE bool
+	isLargeObjectCopyWorkAvailable()
+	{
+		return _largeObjectCopyActive && (_largeObjectCopyNextOffset < _largeObjectCopySize);
+	}
+
 	MMINLINE void updateCopyScanCounts(MM_EnvironmentBase* env, uint64_t slotsScanned, uint64_t slotsCopied);
 	bool splitIndexableObjectScanner(MM_EnvironmentStandard *env, GC_ObjectScanner *objectScanner, uintptr_t startIndex, omrobjectptr_t *rememberedSetSlot);
 
@@ -617,6 +655,33 @@ public:
 	
 	void reportConcurrentScavengeStart(MM_EnvironmentStandard *env);
 	void reportConcurrentScavengeEnd(MM_EnvironmentStandard *env);
+
+	/**
+	 * Heal one slot for the read barrier slow path, and count the update, and the copy if this thread made it.
+	 * @param env mutator thread
+	 * @param slotObject slot that refers to an object in evacuate space
+	 * @return true if the slot was updated
+	 */
+	bool mutatorReadBarrierHealSlot(MM_EnvironmentStandard *env, GC_SlotObject *slotObject);
+
+	/**
+	 * Read barrier slow path, for a mutator thread that loaded a reference into evacuate space during the
+	 * concurrent phase. The slot is healed to point at the copy of the object, copying it first if needed.
+	 * If concurrentScavengerSelfHealObject is set, every other reference slot of the parent object is healed
+	 * as well, so later loads from the same object take the barrier fast path.
+	 * Barrier hits, healed slots, copied objects and time spent are counted in the thread's scavenger stats.
+	 * @param env mutator thread
+	 * @param parentObject object containing the slot, or NULL if the slot is not within a heap object
+	 * @param slotObject the loaded slot
+	 * @return true if the slot was updated
+	 */
+	bool mutatorReadBarrierSlowPath(MM_EnvironmentStandard *env, omrobjectptr_t parentObject, GC_SlotObject *slotObject);
+
+	/**
+	 * Fold the read barrier counters of all mutator threads into the cycle stats, and reset them.
+	 * Must be called while mutators are stopped.
+	 */
+	void mergeMutatorReadBarrierStats(MM_EnvironmentBase *env);
 	
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 
@@ -769,6 +834,14 @@ public:
 		, _scanCacheMonitor(NULL)
 		, _freeCacheMonitor(NULL)
 		, _waitingCount(0)
+		, _largeObjectCopyOwner(0)
+		, _largeObjectCopyActive(false)
+		, _largeObjectCopyHelpers(0)
+		, _largeObjectCopyNextOffset(0)
+		, _largeObjectCopySource(NULL)
+		, _largeObjectCopyDestination(NULL)
+		, _largeObjectCopySize(0)
+		, _largeObjectCopyChunkSize(0)
 		, _cacheLineAlignment(0)
 #if !defined(OMR_GC_CONCURRENT_SCAVENGER)
 		, _rescanThreadsForRememberedObjects(false)
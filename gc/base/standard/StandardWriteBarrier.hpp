@@ -38,8 +38,8 @@ struct OMR_VMThread;
  * Out-of-line write barrier. In the absence of other (equivalent inline) write barrier, this method must
  * be called whenever a child reference is assigned to a parent slot.
  *
- * To support OMR concurrent marking and/or generational collectors, this method calls the necessary
- * concurrent and generational write barriers.
+ * To support OMR concurrent marking, generational collectors and/or sticky mark bit minor collections,
+ * this method calls the necessary concurrent, generational and card dirtying write barriers.
  *
  * @param omrThread The thread making the assignment of child reference into parent slot
  * @param parentObject the parent object
@@ -48,7 +48,6 @@ struct OMR_VMThread;
 MMINLINE void
 standardWriteBarrier(OMR_VMThread *omrThread, omrobjectptr_t parentObject, omrobjectptr_t childObject)
 {
-#if defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_MODRON_CONCURRENT_MARK)
 	MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrThread);
 	MM_GCExtensionsBase *extensions = env->getExtensions();
 #if defined(OMR_GC_MODRON_SCAVENGER)
@@ -66,7 +65,10 @@ standardWriteBarrier(OMR_VMThread *omrThread, omrobjectptr_t parentObject, omrob
 		extensions->cardTable->dirtyCard(env, parentObject);
 	}
 #endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
-#endif /* defined(OMR_GC_MODRON_SCAVENGER) || defined(OMR_GC_MODRON_CONCURRENT_MARK) */
+	if (extensions->stickyMarkBits) {
+		/* the next sticky mark bit minor collection rescans the parent if it was marked by an earlier cycle */
+		extensions->cardTable->dirtyCard(env, parentObject);
+	}
 }
 
 /**
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#include "StickyMarkCardTable.hpp"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Heap.hpp"
+#include "HeapRegionDescriptor.hpp"
+#include "HeapRegionIterator.hpp"
+
+MM_StickyMarkCardTable *
+MM_StickyMarkCardTable::newInstance(MM_EnvironmentBase *env, MM_Heap *heap)
+{
+	MM_StickyMarkCardTable *cardTable = (MM_StickyMarkCardTable *)env->getForge()->allocate(sizeof(MM_StickyMarkCardTable), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != cardTable) {
+		new(cardTable) MM_StickyMarkCardTable();
+		if (!cardTable->initialize(env, heap)) {
+			cardTable->kill(env);
+			cardTable = NULL;
+		}
+	}
+	return cardTable;
+}
+
+bool
+MM_StickyMarkCardTable::heapAddRange(MM_EnvironmentBase *env, MM_MemorySubSpace *subspace, uintptr_t size, void *lowAddress, void *highAddress)
+{
+	bool result = commitCardTableMemory(env, heapAddrToCardAddr(env, lowAddress), heapAddrToCardAddr(env, highAddress));
+	if (result) {
+		clearCardsInRange(env, lowAddress, highAddress);
+	}
+	return result;
+}
+
+bool
+MM_StickyMarkCardTable::heapRemoveRange(MM_EnvironmentBase *env, MM_MemorySubSpace *subspace, uintptr_t size, void *lowAddress, void *highAddress, void *lowValidAddress, void *highValidAddress)
+{
+	Card *lowValidCard = (NULL == lowValidAddress) ? NULL : heapAddrToCardAddr(env, lowValidAddress);
+	Card *highValidCard = (NULL == highValidAddress) ? NULL : heapAddrToCardAddr(env, highValidAddress);
+
+	return decommitCardTableMemory(env, heapAddrToCardAddr(env, lowAddress), heapAddrToCardAddr(env, highAddress), lowValidCard, highValidCard);
+}
+
+void
+MM_StickyMarkCardTable::clearAllCards(MM_EnvironmentBase *env)
+{
+	MM_HeapRegionDescriptor *region = NULL;
+	GC_HeapRegionIterator regionIterator(env->getExtensions()->heap->getHeapRegionManager());
+	while (NULL != (region = regionIterator.nextRegion())) {
+		clearCardsInRange(env, region->getLowAddress(), region->getHighAddress());
+	}
+}
+
+void
+MM_StickyMarkCardTable::cleanAllCards(MM_EnvironmentBase *env, MM_CardCleaner *cardCleaner)
+{
+	/* only committed heap has committed cards; every thread walks the same regions so work units line up */
+	MM_HeapRegionDescriptor *region = NULL;
+	GC_HeapRegionIterator regionIterator(env->getExtensions()->heap->getHeapRegionManager());
+	while (NULL != (region = regionIterator.nextRegion())) {
+		cleanCardTableForRange(env, cardCleaner, region->getLowAddress(), region->getHighAddress());
+	}
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(STICKYMARKCARDTABLE_HPP_)
+#define STICKYMARKCARDTABLE_HPP_
+
+#include "omrcfg.h"
+
+#include "CardTable.hpp"
+
+class MM_CardCleaner;
+class MM_EnvironmentBase;
+class MM_Heap;
+class MM_MemorySubSpace;
+
+/**
+ * Card table used by the flat global collector when running sticky mark bit minor collections.
+ * The write barrier dirties the card of every object stored into between collections; a minor
+ * collection rescans the marked objects in dirty cards so that references from objects marked
+ * in a previous cycle to objects allocated since then are traced.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_StickyMarkCardTable : public MM_CardTable
+{
+public:
+protected:
+private:
+public:
+	static MM_StickyMarkCardTable *newInstance(MM_EnvironmentBase *env, MM_Heap *heap);
+
+	/**
+	 * Commit and clear the cards covering a newly added heap range.
+	 * @return true if the card table memory was committed
+	 */
+	bool heapAddRange(MM_EnvironmentBase *env, MM_MemorySubSpace *subspace, uintptr_t size, void *lowAddress, void *highAddress);
+
+	/**
+	 * Decommit the cards covering a removed heap range.
+	 * @return true if the card table memory was decommitted
+	 */
+	bool heapRemoveRange(MM_EnvironmentBase *env, MM_MemorySubSpace *subspace, uintptr_t size, void *lowAddress, void *highAddress, void *lowValidAddress, void *highValidAddress);
+
+	/**
+	 * Clean every card backing committed heap memory. Called when a full collection rebuilds the
+	 * mark map, as every object reachable from a dirty card is then marked anyway.
+	 */
+	void clearAllCards(MM_EnvironmentBase *env);
+
+	/**
+	 * Invoke the card cleaner on every dirty card backing committed heap memory.
+	 * This multi-threaded version must be executed under Parallel Task only.
+	 * @param env[in] A GC thread participating in the task
+	 * @param cardCleaner[in] The card cleaner implementation which will be invoked to clean each card
+	 */
+	void cleanAllCards(MM_EnvironmentBase *env, MM_CardCleaner *cardCleaner);
+
+	/**
+	 * Create a StickyMarkCardTable object.
+	 */
+	MM_StickyMarkCardTable()
+		: MM_CardTable()
+	{
+		_typeId = __FUNCTION__;
+	}
+};
+
+#endif /* STICKYMARKCARDTABLE_HPP_ */
@@ -42,6 +42,9 @@ omrobjectptr_t OMR_GC_AllocateObject(OMR_VMThread * omrVMThread, uintptr_t alloc
 
 omr_error_t OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode);
 
+/* Print the allocation sites recorded by the allocation sampler (-Xgc:allocationSamplingInterval) */
+omr_error_t OMR_GC_DumpAllocationSamples(OMR_VMThread* omrVMThread);
+
 #ifdef __cplusplus
 } /* extern "C" { */
 #endif
@@ -25,6 +25,7 @@
 #include "objectdescription.h"
 
 #include "AllocateInitialization.hpp"
+#include "AllocationSampler.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
 #include "Heap.hpp"
@@ -67,3 +68,15 @@ OMR_GC_SystemCollect(OMR_VMThread* omrVMThread, uint32_t gcCode)
 	}
 	return result;
 }
+
+omr_error_t
+OMR_GC_DumpAllocationSamples(OMR_VMThread* omrVMThread)
+{
+	MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrVMThread);
+	MM_AllocationSampler *sampler = env->getExtensions()->allocationSampler;
+	if (NULL == sampler) {
+		return OMR_ERROR_NOT_AVAILABLE;
+	}
+	sampler->dump(env);
+	return OMR_ERROR_NONE;
+}
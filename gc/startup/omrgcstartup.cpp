@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2015, 2017 IBM Corp. and others
+ * Copyright (c) 2015, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -26,6 +26,7 @@
 #include "objectdescription.h"
 
 #include "AllocateDescription.hpp"
+#include "AllocationSampler.hpp"
 #include "AtomicOperations.hpp"
 #include "Collector.hpp"
 #include "CollectorLanguageInterface.hpp"
@@ -33,6 +34,7 @@
 #include "Dispatcher.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
+#include "GCTimeline.hpp"
 #include "GlobalCollector.hpp"
 #include "Heap.hpp"
 #include "HeapMemorySubSpaceIterator.hpp"
@@ -64,11 +66,25 @@ collectorCreationHelper(OMR_VM *omrVM, MM_EnvironmentBase *env)
 	} else {
 		globalCollector->setGlobalCollector(true);
 		extensions->setGlobalCollector(globalCollector);
+	}
 
-		if (!extensions->getGlobalCollector()->collectorStartup(extensions)) {
-			omrtty_printf("Failed to start global collector.\n");
-			rc = OMR_ERROR_INTERNAL;
-		}
+	return rc;
+}
+
+/**
+ * Start the global collector. This has to wait for the default memory space, which creates the
+ * scavenger in generational configurations.
+ */
+static omr_error_t
+collectorStartupHelper(OMR_VM *omrVM)
+{
+	OMRPORT_ACCESS_FROM_OMRVM(omrVM);
+	MM_GCExtensionsBase *extensions = MM_GCExtensionsBase::getExtensions(omrVM);
+	omr_error_t rc = OMR_ERROR_NONE;
+
+	if (!extensions->getGlobalCollector()->collectorStartup(extensions)) {
+		omrtty_printf("Failed to start global collector.\n");
+		rc = OMR_ERROR_INTERNAL;
 	}
 
 	return rc;
@@ -180,6 +196,11 @@ heapCreationHelper(OMR_VM *omrVM, MM_StartupManager *startupManager, bool create
 	extensions->configuration->defaultMemorySpaceAllocated(extensions, memorySpace);
 	extensions->heap->setDefaultMemorySpace(memorySpace);
 
+	if (createCollector && (OMR_ERROR_NONE != collectorStartupHelper(omrVM))) {
+		rc = OMR_ERROR_INTERNAL;
+		goto done;
+	}
+
 	if (startupManager->isVerboseEnabled()) {
 		extensions->verboseGCManager = startupManager->createVerboseManager(&envBase);
 		if (NULL == extensions->verboseGCManager) {
@@ -192,6 +213,24 @@ heapCreationHelper(OMR_VM *omrVM, MM_StartupManager *startupManager, bool create
 		extensions->verboseGCManager->setInitializedTime(omrtime_hires_clock());
 	}
 
+	if (startupManager->isTimelineEnabled()) {
+		extensions->gcTimeline = MM_GCTimeline::newInstance(&envBase, startupManager->getTimelineFileName(), extensions->dispatcher->threadCountMaximum(), GC_TIMELINE_EVENTS_PER_THREAD);
+		if (NULL == extensions->gcTimeline) {
+			omrtty_printf("Failed to create GC timeline.\n");
+			rc = OMR_ERROR_INTERNAL;
+			goto done;
+		}
+	}
+
+	if (0 != extensions->allocationSamplingInterval) {
+		extensions->allocationSampler = MM_AllocationSampler::newInstance(&envBase, extensions->allocationSamplingInterval, ALLOCATION_SAMPLER_DEFAULT_CAPACITY);
+		if (NULL == extensions->allocationSampler) {
+			omrtty_printf("Failed to create allocation sampler.\n");
+			rc = OMR_ERROR_INTERNAL;
+			goto done;
+		}
+	}
+
 done:
 	return rc;
 }
@@ -284,6 +323,8 @@ OMR_GC_InitializeCollector(OMR_VMThread* omrVMThread)
 
 			/* Make sure sweep scheme is up-to-date with the heap configuration */
 			globalCollector->heapReconfigured(env);
+
+			rc = collectorStartupHelper(omrVMThread->_vm);
 		}
 	}
 
@@ -322,6 +363,16 @@ OMR_GC_ShutdownHeap(OMR_VM *omrVM)
 			extensions->verboseGCManager = NULL;
 		}
 
+		if (NULL != extensions->gcTimeline) {
+			extensions->gcTimeline->kill(&env);
+			extensions->gcTimeline = NULL;
+		}
+
+		if (NULL != extensions->allocationSampler) {
+			extensions->allocationSampler->kill(&env);
+			extensions->allocationSampler = NULL;
+		}
+
 		if (NULL != extensions->configuration) {
 			extensions->configuration->kill(&env);
 		}
@@ -61,6 +61,11 @@ public:
 	uint32_t _tenureFragmentation; /**< fragmentation indicator, can be NO_FRAGMENTATION, MICRO_FRAGMENTATION, MACRO_FRAGMENTATION, indicate if fragmentation info are ready in _microFragmentedSize and _macroFragmentedSize */
 	uintptr_t _microFragmentedSize; /**< Micro Fragmentation in Byte */
 	uintptr_t _macroFragmentedSize; /**< Macro Fragmentation in Byte*/
+	uintptr_t _largeObjectAllocateCount; /**< number of large tenure allocations with a recorded latency */
+	uint64_t _largeObjectAllocateLatencyP50; /**< median large tenure allocation latency, in nanoseconds */
+	uint64_t _largeObjectAllocateLatencyP90; /**< 90th percentile large tenure allocation latency, in nanoseconds */
+	uint64_t _largeObjectAllocateLatencyP99; /**< 99th percentile large tenure allocation latency, in nanoseconds */
+	uint64_t _largeObjectAllocateLatencyMax; /**< longest large tenure allocation latency, in nanoseconds */
 private:
 protected:
 public:
@@ -95,6 +100,22 @@ public:
 			stats->_totalFreeLOAHeapSize = 0;
 		}
 
+		MM_MemorySubSpace *tenureSubSpace = extensions->heap->getDefaultMemorySpace()->getTenureMemorySubSpace();
+		MM_LargeObjectAllocateStats *tenureAllocateStats = (NULL == tenureSubSpace) ? NULL : tenureSubSpace->getLargeObjectAllocateStats();
+		if (NULL != tenureAllocateStats) {
+			stats->_largeObjectAllocateCount = tenureAllocateStats->getAllocateLatencyCount();
+			stats->_largeObjectAllocateLatencyP50 = tenureAllocateStats->getAllocateLatencyPercentile(50);
+			stats->_largeObjectAllocateLatencyP90 = tenureAllocateStats->getAllocateLatencyPercentile(90);
+			stats->_largeObjectAllocateLatencyP99 = tenureAllocateStats->getAllocateLatencyPercentile(99);
+			stats->_largeObjectAllocateLatencyMax = tenureAllocateStats->getAllocateLatencyMax();
+		} else {
+			stats->_largeObjectAllocateCount = 0;
+			stats->_largeObjectAllocateLatencyP50 = 0;
+			stats->_largeObjectAllocateLatencyP90 = 0;
+			stats->_largeObjectAllocateLatencyP99 = 0;
+			stats->_largeObjectAllocateLatencyMax = 0;
+		}
+
 #if defined(OMR_GC_MODRON_SCAVENGER)
 		stats->_scavengerEnabled = extensions->scavengerEnabled;
 #else
@@ -163,6 +184,11 @@ public:
 		, _tenureFragmentation(NO_FRAGMENTATION)
 		, _microFragmentedSize(0)
 		, _macroFragmentedSize(0)
+		, _largeObjectAllocateCount(0)
+		, _largeObjectAllocateLatencyP50(0)
+		, _largeObjectAllocateLatencyP90(0)
+		, _largeObjectAllocateLatencyP99(0)
+		, _largeObjectAllocateLatencyMax(0)
 	{};
 };
 
@@ -42,6 +42,8 @@
 class MM_GlobalGCStats {
 public:
 	uintptr_t gcCount; /**< Count of the number of GC cycles that have occurred */
+	uintptr_t stickyMarkMinorGCCount; /**< Count of the GC cycles that ran as sticky mark bit minor collections */
+	bool stickyMarkMinorGC; /**< True if the current cycle is a sticky mark bit minor collection */
 	MM_WorkPacketStats workPacketStats;
 	MM_SweepStats sweepStats;
 #if defined(OMR_GC_MODRON_COMPACTION)
@@ -59,7 +61,8 @@ public:
 
 	MMINLINE void clear()
 	{
-		/* gcCount is not cleared as the value must persist across cycles */
+		/* gcCount and stickyMarkMinorGCCount are not cleared as the values must persist across cycles */
+		stickyMarkMinorGC = false;
 
 		workPacketStats.clear();
 		sweepStats.clear();
@@ -79,6 +82,8 @@ public:
 
 	MM_GlobalGCStats()
 		: gcCount(0)
+		, stickyMarkMinorGCCount(0)
+		, stickyMarkMinorGC(false)
 		, workPacketStats()
 		, sweepStats()
 #if defined(OMR_GC_MODRON_COMPACTION)
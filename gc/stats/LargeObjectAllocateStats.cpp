@@ -24,6 +24,7 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "omrport.h"
 
@@ -511,6 +512,7 @@ MM_LargeObjectAllocateStats::initialize(MM_EnvironmentBase *env, uint16_t maxAll
 	_maxAllocateSizes = maxAllocateSizes;
 	_largeObjectThreshold = largeObjectThreshold;
 	_sizeClassRatio = sizeClassRatio;
+	memset(_allocateLatencyCounts, 0, sizeof(_allocateLatencyCounts));
 	_sizeClassRatioLog = log(_sizeClassRatio);
 	_maxHeapSize = maxHeapSize;
 
@@ -639,6 +641,10 @@ MM_LargeObjectAllocateStats::resetCurrent()
 {
 	spaceSavingClear(_spaceSavingSizes);
 	spaceSavingClear(_spaceSavingSizeClasses);
+
+	memset(_allocateLatencyCounts, 0, sizeof(_allocateLatencyCounts));
+	_allocateLatencyCount = 0;
+	_allocateLatencyMax = 0;
 }
 
 void
@@ -666,6 +672,47 @@ MM_LargeObjectAllocateStats::allocateObject(uintptr_t allocateSize)
 	}
 }
 
+void
+MM_LargeObjectAllocateStats::recordAllocateLatency(uint64_t latency)
+{
+	uintptr_t bucket = 0;
+	for (uint64_t remaining = latency; 0 != remaining; remaining >>= 1) {
+		bucket += 1;
+	}
+
+	_allocateLatencyCounts[OMR_MIN(bucket, LARGE_OBJECT_ALLOCATE_LATENCY_BUCKETS - 1)] += 1;
+	_allocateLatencyCount += 1;
+	if (latency > _allocateLatencyMax) {
+		_allocateLatencyMax = latency;
+	}
+}
+
+uint64_t
+MM_LargeObjectAllocateStats::getAllocateLatencyPercentile(uintptr_t percentile)
+{
+	if (0 == _allocateLatencyCount) {
+		return 0;
+	}
+
+	/* rank of the percentile sample, rounded up (1 based) */
+	uintptr_t rank = (uintptr_t)((((uint64_t)_allocateLatencyCount * percentile) + 99) / 100);
+	uintptr_t seen = 0;
+	uint64_t latency = _allocateLatencyMax;
+
+	for (uintptr_t bucket = 0; bucket < LARGE_OBJECT_ALLOCATE_LATENCY_BUCKETS; bucket++) {
+		seen += _allocateLatencyCounts[bucket];
+		if (seen >= rank) {
+			if (bucket < (LARGE_OBJECT_ALLOCATE_LATENCY_BUCKETS - 1)) {
+				/* upper bound of bucket i is 2^i - 1 */
+				latency = OMR_MIN(((uint64_t)1 << bucket) - 1, _allocateLatencyMax);
+			}
+			break;
+		}
+	}
+
+	return latency;
+}
+
 void
 MM_LargeObjectAllocateStats::mergeCurrent(MM_LargeObjectAllocateStats *statsToMerge)
 {
@@ -686,6 +733,13 @@ MM_LargeObjectAllocateStats::mergeCurrent(MM_LargeObjectAllocateStats *statsToMe
 	for(i = 0; i < spaceSavingGetCurSize(spaceSavingToMerge); i++ ){
 		spaceSavingUpdate(_spaceSavingSizeClasses, spaceSavingGetKthMostFreq(spaceSavingToMerge, i + 1), spaceSavingGetKthMostFreqCount(spaceSavingToMerge, i + 1));
 	}
+
+	/* merge allocation latencies - current */
+	for (i = 0; i < LARGE_OBJECT_ALLOCATE_LATENCY_BUCKETS; i++) {
+		_allocateLatencyCounts[i] += statsToMerge->_allocateLatencyCounts[i];
+	}
+	_allocateLatencyCount += statsToMerge->_allocateLatencyCount;
+	_allocateLatencyMax = OMR_MAX(_allocateLatencyMax, statsToMerge->_allocateLatencyMax);
 }
 
 void
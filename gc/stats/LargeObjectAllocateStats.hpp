@@ -182,6 +182,11 @@ private:
 	uintptr_t _TLHSizeClassIndex; /**< preserved next value of sizeClassIndex on last invocation of simulateAllocateTLHs */
 	uintptr_t _TLHFrequentAllocationSize;/**< preserved next value of FrequentAllocationSize on last invocation of simulateAllocateTLHs */
 
+#define LARGE_OBJECT_ALLOCATE_LATENCY_BUCKETS 64
+	uintptr_t _allocateLatencyCounts[LARGE_OBJECT_ALLOCATE_LATENCY_BUCKETS]; /**< current histogram of large allocation latencies; bucket 0 counts 0ns, bucket i counts [2^(i-1), 2^i) ns */
+	uintptr_t _allocateLatencyCount; /**< current number of large allocations with a recorded latency */
+	uint64_t _allocateLatencyMax; /**< current longest large allocation latency, in nanoseconds */
+
 	MMINLINE uintptr_t getNextSizeClass(uintptr_t sizeClassIndex, uintptr_t maxSizeClasses);
 	MMINLINE bool isFirstIterationCompleteForCurrentStride(uintptr_t sizeClassIndex, uintptr_t maxSizeClasses);
 
@@ -235,6 +240,30 @@ public:
 	 */
 	void allocateObject(uintptr_t allocateSize);
 
+	/**
+	 * Invoked by allocator to record how long a successful large allocation took, including waiting for the pool lock.
+	 * @param latency time taken by the allocation, in nanoseconds
+	 */
+	void recordAllocateLatency(uint64_t latency);
+
+	/**
+	 * @return number of large allocations with a recorded latency, since the current stats were reset
+	 */
+	uintptr_t getAllocateLatencyCount() { return _allocateLatencyCount; }
+
+	/**
+	 * @return longest recorded large allocation latency in nanoseconds, since the current stats were reset
+	 */
+	uint64_t getAllocateLatencyMax() { return _allocateLatencyMax; }
+
+	/**
+	 * Estimate a percentile of the recorded large allocation latencies. Latencies are kept in power of two buckets,
+	 * so the result is the upper bound of the bucket the percentile falls in (but never more than the maximum).
+	 * @param percentile percentile to estimate (1 - 100)
+	 * @return the latency in nanoseconds, 0 if none were recorded
+	 */
+	uint64_t getAllocateLatencyPercentile(uintptr_t percentile);
+
 	/**
 	 * Merge CURRENT this/these stats with provided stats. The result is stored back into this stats
      * @param statsToMerge to be added to this stats
@@ -349,7 +378,9 @@ public:
 		_freeMemoryBeforeEstimate(0),
 		_maxHeapSize(0),
 		_TLHSizeClassIndex(0),
-		_TLHFrequentAllocationSize(0)
+		_TLHFrequentAllocationSize(0),
+		_allocateLatencyCount(0),
+		_allocateLatencyMax(0)
 	{
 	}
 
@@ -55,6 +55,7 @@ MM_ScavengerStats::MM_ScavengerStats()
 	,_aliasToCopyCacheCount(0)
 	,_arraySplitCount(0)
 	,_arraySplitAmount(0)
+	,_largeObjectCopyHelpCount(0)
 	,_workStallCount(0)
 	,_completeStallCount(0)
 	,_syncStallCount(0)
@@ -90,6 +91,8 @@ MM_ScavengerStats::MM_ScavengerStats()
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	,_readObjectBarrierCopy(0)
 	,_readObjectBarrierUpdate(0)
+	,_readObjectBarrierCount(0)
+	,_readObjectBarrierTime(0)
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 	,_flipHistoryNewIndex(0)
 {
@@ -157,6 +160,7 @@ MM_ScavengerStats::clear(bool firstIncrement)
 	_acquireScanListCount = 0;
 	_acquireListLockCount = 0;
 	_aliasToCopyCacheCount = 0;
+	_largeObjectCopyHelpCount = 0;
 	_workStallCount = 0;
 	_completeStallCount = 0;
 	_syncStallCount = 0;
@@ -188,6 +192,8 @@ MM_ScavengerStats::clear(bool firstIncrement)
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	_readObjectBarrierCopy = 0;
 	_readObjectBarrierUpdate = 0;
+	_readObjectBarrierCount = 0;
+	_readObjectBarrierTime = 0;
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 
 	_leafObjectCount = 0;
@@ -86,6 +86,7 @@ public:
 	uintptr_t _aliasToCopyCacheCount;
 	uintptr_t _arraySplitCount;
 	uintptr_t _arraySplitAmount;
+	uintptr_t _largeObjectCopyHelpCount; /**< The number of large object copy chunks the thread copied on behalf of another thread */
 	uintptr_t _workStallCount; /**< The number of times the thread stalled, and subsequently received more work */
 	uintptr_t _completeStallCount; /**< The number of times the thread stalled, and waited for all other threads to complete working */
 	uintptr_t _syncStallCount; /**< The number of times the thread stalled at a sync point */
@@ -139,6 +140,8 @@ public:
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	uint64_t _readObjectBarrierCopy; /**< Number of objects copied by read barrier */
 	uint64_t _readObjectBarrierUpdate; /**< Number of reference slots updates, which may be (often is) preceded by object copy */ 
+	uint64_t _readObjectBarrierCount; /**< Number of read barrier slow path invocations (loads of a reference into evacuate space) */
+	uint64_t _readObjectBarrierTime; /**< Time spent in the read barrier slow path, in hi-res ticks */
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 
 protected:
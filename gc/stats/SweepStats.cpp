@@ -44,6 +44,13 @@ MM_SweepStats::clear()
 	mergeTime = 0;
 	sweepChunksProcessed = 0;
 #endif /* J9MODRON_TGC_PARALLEL_STATISTICS */			
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	_unsweptRegionCount = 0;
+	_lazySweptRegionCount = 0;
+	_lazySweepTime = 0;
+	_maxLazySweepTime = 0;
+#endif /* OMR_GC_SEGREGATED_HEAP */
 }
 	
 void
@@ -59,6 +66,13 @@ MM_SweepStats::merge(MM_SweepStats *statsToMerge)
 	mergeTime += statsToMerge->mergeTime;
 	sweepChunksProcessed += statsToMerge->sweepChunksProcessed;
 #endif /* J9MODRON_TGC_PARALLEL_STATISTICS */
+
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	_unsweptRegionCount += statsToMerge->_unsweptRegionCount;
+	_lazySweptRegionCount += statsToMerge->_lazySweptRegionCount;
+	_lazySweepTime += statsToMerge->_lazySweepTime;
+	_maxLazySweepTime = OMR_MAX(_maxLazySweepTime, statsToMerge->_maxLazySweepTime);
+#endif /* OMR_GC_SEGREGATED_HEAP */
 }
 
 #if defined(J9MODRON_TGC_PARALLEL_STATISTICS)
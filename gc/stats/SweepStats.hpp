@@ -55,6 +55,13 @@ public:
 	uint64_t _startTime;	/**< Sweep start time */
 	uint64_t _endTime;		/**< Sweep end time */
 
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	uintptr_t _unsweptRegionCount; /**< Small regions left for lazy sweeping when the sweep pause ran out of budget */
+	uintptr_t _lazySweptRegionCount; /**< Small regions swept by allocating threads since the previous cycle */
+	uint64_t _lazySweepTime; /**< Total time spent in lazy sweep increments since the previous cycle */
+	uint64_t _maxLazySweepTime; /**< Longest single lazy sweep increment since the previous cycle */
+#endif /* OMR_GC_SEGREGATED_HEAP */
+
 	void clear();
 	void merge(MM_SweepStats *statsToMerge);
 
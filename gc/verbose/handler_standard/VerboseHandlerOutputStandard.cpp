@@ -329,9 +329,26 @@ MM_VerboseHandlerOutputStandard::handleSweepEnd(J9HookInterface** hook, uintptr_
 	bool deltaTimeSuccess = getTimeDeltaInMicroSeconds(&duration, sweepStats->_startTime, sweepStats->_endTime);
 
 	enterAtomicReportingBlock();
-	handleGCOPStanza(env, "sweep", env->_cycleState->_verboseContextID, duration, deltaTimeSuccess);
-
-	handleSweepEndInternal(env, eventData);
+#if defined(OMR_GC_SEGREGATED_HEAP)
+	if (extensions->isSegregatedHeap()) {
+		MM_VerboseWriterChain* writer = getManager()->getWriterChain();
+		OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+		uint64_t lazySweepMicros = omrtime_hires_delta(0, sweepStats->_lazySweepTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+		uint64_t maxLazySweepMicros = omrtime_hires_delta(0, sweepStats->_maxLazySweepTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+
+		handleGCOPOuterStanzaStart(env, "sweep", env->_cycleState->_verboseContextID, duration, deltaTimeSuccess);
+		writer->formatAndOutput(env, 1, "<lazy-sweep-info unsweptregions=\"%zu\" lazysweptregions=\"%zu\" timems=\"%llu.%03.3llu\" maxtimems=\"%llu.%03.3llu\" />",
+				sweepStats->_unsweptRegionCount, sweepStats->_lazySweptRegionCount,
+				lazySweepMicros / 1000, lazySweepMicros % 1000, maxLazySweepMicros / 1000, maxLazySweepMicros % 1000);
+		handleSweepEndInternal(env, eventData);
+		handleGCOPOuterStanzaEnd(env);
+		writer->flush(env);
+	} else
+#endif /* OMR_GC_SEGREGATED_HEAP */
+	{
+		handleGCOPStanza(env, "sweep", env->_cycleState->_verboseContextID, duration, deltaTimeSuccess);
+		handleSweepEndInternal(env, eventData);
+	}
 	exitAtomicReportingBlock();
 }
 
@@ -420,6 +437,14 @@ MM_VerboseHandlerOutputStandard::handleScavengeEnd(J9HookInterface** hook, uintp
 	if (event->cycleEnd) {
 		writer->formatAndOutput(env, 1, "<scavenger-info tenureage=\"%zu\" tenuremask=\"%4zx\" tiltratio=\"%zu\" />",
 				cycleScavengerStats->_tenureAge, cycleScavengerStats->getFlipHistory(0)->_tenureMask, cycleScavengerStats->_tiltRatio);
+#if defined(OMR_GC_CONCURRENT_SCAVENGER)
+		if (0 != cycleScavengerStats->_readObjectBarrierCount) {
+			uint64_t readBarrierMicros = omrtime_hires_delta(0, cycleScavengerStats->_readObjectBarrierTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS);
+			writer->formatAndOutput(env, 1, "<read-barrier hits=\"%llu\" slotshealed=\"%llu\" objectscopied=\"%llu\" timems=\"%llu.%03.3llu\" />",
+					cycleScavengerStats->_readObjectBarrierCount, cycleScavengerStats->_readObjectBarrierUpdate, cycleScavengerStats->_readObjectBarrierCopy,
+					readBarrierMicros / 1000, readBarrierMicros % 1000);
+		}
+#endif /* OMR_GC_CONCURRENT_SCAVENGER */
 	}
 
 	if (0 != scavengerStats->_flipCount) {
@@ -912,6 +937,12 @@ MM_VerboseHandlerOutputStandard::outputMemoryInfoInnerStanza(MM_EnvironmentBase
 		outputMemType(env, indent, "tenure", stats->_totalFreeTenureHeapSize, stats->_totalTenureHeapSize, stats->_tenureFragmentation, stats->_microFragmentedSize, stats->_macroFragmentedSize);
 	}
 
+	if (0 != stats->_largeObjectAllocateCount) {
+		writer->formatAndOutput(env, indent, "<large-object-allocation count=\"%zu\" p50ns=\"%llu\" p90ns=\"%llu\" p99ns=\"%llu\" maxns=\"%llu\" />",
+				stats->_largeObjectAllocateCount, stats->_largeObjectAllocateLatencyP50, stats->_largeObjectAllocateLatencyP90,
+				stats->_largeObjectAllocateLatencyP99, stats->_largeObjectAllocateLatencyMax);
+	}
+
 	outputMemoryInfoInnerStanzaInternal(env, indent, statsBase);
 
 	if (stats->_scavengerEnabled) {
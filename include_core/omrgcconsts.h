@@ -270,7 +270,8 @@ typedef enum {
 	COMPACT_ALWAYS = 7,
 	COMPACT_ABORTED_SCAVENGE = 8,
 	COMPACT_CONTRACT = 11,
-	COMPACT_AGGRESSIVE= 12
+	COMPACT_AGGRESSIVE= 12,
+	COMPACT_PREDICTED_FRAGMENTATION = 13
 } CompactReason;
 
 typedef enum {
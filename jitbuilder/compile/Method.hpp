@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2014, 2016 IBM Corp. and others
+ * Copyright (c) 2014, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -120,6 +120,7 @@ class ResolvedMethod : public ResolvedMethodBase, public Method
         _lineNumber(lineNumber),
         _name(name),
         _signature(0),
+        _externalName(0),
         _numParms(numParms),
         _parmTypes(parmTypes),
         _returnType(returnType),
@@ -0,0 +1,387 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "control/CompileThreadPool.hpp"
+
+#include <new>
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/SegmentPool.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "env/VerboseLog.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "infra/Assert.hpp"
+
+extern int32_t compileMethodBuilderWithScratchMemory(TR::MethodBuilder *m, TR_Hotness hotness, uint8_t **entry, TR::SegmentProvider *scratchSegmentProvider, uint8_t **codeMemory);
+
+// Compilations recurse deeply over the IL; give compile threads the same room as a main thread
+#define COMPILE_THREAD_STACK_SIZE (8 * 1024 * 1024)
+
+// Scratch memory segments each compile thread keeps warm between compilations (64 x 64KB)
+#define SCRATCH_SEGMENT_SIZE (1 << 16)
+#define SCRATCH_SEGMENT_CACHE_SIZE 64
+
+// Most scratch memory lent to synchronous compiles at once; further concurrent ones use private memory
+#define SCRATCH_MEMORY_LIMIT 4
+
+// Cached scratch segments are returned to the system after the pool has had no work for this long
+#define SCRATCH_MEMORY_IDLE_TRIM_MILLIS 1000
+
+JitBuilder::CompileThreadPool::CompileThreadPool(omrthread_monitor_t monitor, CompileThread *threads, int32_t numThreads)
+   : _monitor(monitor),
+     _threads(threads),
+     _numThreads(numThreads),
+     _runningThreads(0),
+     _shuttingDown(false),
+     _queueHead(NULL),
+     _queueTail(NULL),
+     _spareScratchMemory(NULL),
+     _scratchMemoryCount(0),
+     _spareScratchMemoryTrimmed(true)
+   {
+   }
+
+JitBuilder::CompileThreadPool *
+JitBuilder::CompileThreadPool::create(int32_t numThreads)
+   {
+   ThreadAttachment attachment;
+   if (!attachment.isAttached())
+      return NULL;
+
+   if (numThreads < 1)
+      numThreads = 1;
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   CompileThread *threads = static_cast<CompileThread *>(allocator.allocate(numThreads * sizeof(CompileThread), std::nothrow));
+   if (NULL == threads)
+      return NULL;
+
+   omrthread_monitor_t monitor = NULL;
+   if (0 != omrthread_monitor_init_with_name(&monitor, 0, "JIT-CompileThreadPoolMonitor"))
+      {
+      allocator.deallocate(threads);
+      return NULL;
+      }
+
+   CompileThreadPool *pool = new (allocator, std::nothrow) CompileThreadPool(monitor, threads, numThreads);
+   if (NULL == pool)
+      {
+      omrthread_monitor_destroy(monitor);
+      allocator.deallocate(threads);
+      return NULL;
+      }
+
+   omrthread_monitor_enter(monitor);
+   for (int32_t i = 0; i < numThreads; i++)
+      {
+      threads[i]._pool = pool;
+      threads[i]._activeMethodBuilder = NULL;
+      omrthread_t handle = NULL;
+      if (J9THREAD_SUCCESS != omrthread_create(&handle, COMPILE_THREAD_STACK_SIZE, J9THREAD_PRIORITY_NORMAL, 0, compileThreadEntry, &threads[i]))
+         break;
+      pool->_runningThreads += 1;
+      }
+   pool->_numThreads = pool->_runningThreads;
+   omrthread_monitor_exit(monitor);
+
+   if (0 == pool->_numThreads)
+      {
+      pool->destroy();
+      return NULL;
+      }
+
+   return pool;
+   }
+
+void
+JitBuilder::CompileThreadPool::destroy()
+   {
+   ThreadAttachment attachment;
+   TR_ASSERT_FATAL(attachment.isAttached(), "Failed to attach to the thread library");
+
+   omrthread_monitor_enter(_monitor);
+   _shuttingDown = true;
+   omrthread_monitor_notify_all(_monitor);
+   while (_runningThreads > 0)
+      omrthread_monitor_wait(_monitor);
+   omrthread_monitor_exit(_monitor);
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   while (NULL != _spareScratchMemory)
+      {
+      ScratchMemory *scratchMemory = _spareScratchMemory;
+      _spareScratchMemory = scratchMemory->_next;
+      _scratchMemoryCount -= 1;
+      reportScratchMemory("Synchronous compile", scratchMemory->_segmentPool);
+      scratchMemory->~ScratchMemory();
+      allocator.deallocate(scratchMemory);
+      }
+   TR_ASSERT(0 == _scratchMemoryCount, "Scratch memory still borrowed when the pool was destroyed");
+
+   omrthread_monitor_destroy(_monitor);
+   allocator.deallocate(_threads);
+   this->~CompileThreadPool();
+   allocator.deallocate(this);
+   }
+
+JitBuilder::CompileRequest *
+JitBuilder::CompileThreadPool::submit(TR::MethodBuilder *methodBuilder, TR_Hotness hotness, bool publish)
+   {
+   ThreadAttachment attachment;
+   if (!attachment.isAttached())
+      return NULL;
+
+   CompileRequest *request = static_cast<CompileRequest *>(TR::Compiler->persistentAllocator().allocate(sizeof(CompileRequest), std::nothrow));
+   if (NULL == request)
+      return NULL;
+
+   request->_methodBuilder = methodBuilder;
+   request->_hotness = hotness;
+   request->_publish = publish;
+   request->_entry = NULL;
+   request->_codeMemory = NULL;
+   request->_rc = 0;
+   request->_complete = false;
+   request->_next = NULL;
+
+   omrthread_monitor_enter(_monitor);
+   if (_shuttingDown)
+      {
+      // No thread is left to service the request and nobody would complete it
+      omrthread_monitor_exit(_monitor);
+      TR::Compiler->persistentAllocator().deallocate(request);
+      return NULL;
+      }
+   if (NULL == _queueTail)
+      _queueHead = request;
+   else
+      _queueTail->_next = request;
+   _queueTail = request;
+   omrthread_monitor_notify_all(_monitor);
+   omrthread_monitor_exit(_monitor);
+
+   return request;
+   }
+
+int32_t
+JitBuilder::CompileThreadPool::wait(CompileRequest *request, uint8_t **entry, uint8_t **codeMemory)
+   {
+   ThreadAttachment attachment;
+   TR_ASSERT_FATAL(attachment.isAttached(), "Failed to attach to the thread library");
+
+   omrthread_monitor_enter(_monitor);
+   while (!request->_complete)
+      omrthread_monitor_wait(_monitor);
+   omrthread_monitor_exit(_monitor);
+
+   *entry = request->_entry;
+   if (NULL != codeMemory)
+      *codeMemory = request->_codeMemory;
+   int32_t rc = request->_rc;
+   TR::Compiler->persistentAllocator().deallocate(request);
+   return rc;
+   }
+
+int J9THREAD_PROC
+JitBuilder::CompileThreadPool::compileThreadEntry(void *arg)
+   {
+   CompileThread *compileThread = static_cast<CompileThread *>(arg);
+   compileThread->_pool->run(compileThread);
+   return 0;
+   }
+
+JitBuilder::ScratchMemory *
+JitBuilder::CompileThreadPool::acquireScratchMemory()
+   {
+   if (TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging))
+      return NULL;
+
+   ThreadAttachment attachment;
+   if (!attachment.isAttached())
+      return NULL;
+
+   omrthread_monitor_enter(_monitor);
+   ScratchMemory *scratchMemory = _spareScratchMemory;
+   if (NULL != scratchMemory)
+      {
+      _spareScratchMemory = scratchMemory->_next;
+      scratchMemory->_next = NULL;
+      omrthread_monitor_exit(_monitor);
+      return scratchMemory;
+      }
+   if (_shuttingDown || _scratchMemoryCount >= SCRATCH_MEMORY_LIMIT)
+      {
+      omrthread_monitor_exit(_monitor);
+      return NULL;
+      }
+   _scratchMemoryCount += 1;
+   omrthread_monitor_exit(_monitor);
+
+   void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(ScratchMemory), std::nothrow);
+   if (NULL == storage)
+      {
+      omrthread_monitor_enter(_monitor);
+      _scratchMemoryCount -= 1;
+      omrthread_monitor_exit(_monitor);
+      return NULL;
+      }
+   return new (storage) ScratchMemory(SCRATCH_SEGMENT_SIZE, SCRATCH_SEGMENT_CACHE_SIZE, TR::RawAllocator());
+   }
+
+void
+JitBuilder::CompileThreadPool::releaseScratchMemory(ScratchMemory *scratchMemory)
+   {
+   ThreadAttachment attachment;
+   TR_ASSERT_FATAL(attachment.isAttached(), "Failed to attach to the thread library");
+
+   omrthread_monitor_enter(_monitor);
+   scratchMemory->_next = _spareScratchMemory;
+   _spareScratchMemory = scratchMemory;
+   // Wake an idle compile thread so that the segments are trimmed if no more work arrives
+   _spareScratchMemoryTrimmed = false;
+   omrthread_monitor_notify_all(_monitor);
+   omrthread_monitor_exit(_monitor);
+   }
+
+// Return the cached segments of a compile thread and of the spare scratch memory to the
+// system. Called by an idle compile thread with _monitor held; spares are not in use while
+// they are on the list.
+void
+JitBuilder::CompileThreadPool::trimScratchMemory(ScratchMemory &ownScratchMemory)
+   {
+   ownScratchMemory._segmentPool.trim();
+   for (ScratchMemory *scratchMemory = _spareScratchMemory; NULL != scratchMemory; scratchMemory = scratchMemory->_next)
+      scratchMemory->_segmentPool.trim();
+   _spareScratchMemoryTrimmed = true;
+   }
+
+void
+JitBuilder::CompileThreadPool::reportScratchMemory(const char *owner, TR::SegmentPool &segmentPool)
+   {
+   if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerbosePerformance))
+      {
+      size_t requests = segmentPool.requests();
+      TR_VerboseLog::writeLineLocked(
+         TR_Vlog_MEMORY,
+         "%s scratch segments: requested=%llu reused=%llu (%llu%%) trimmed=%llu cached=%llu",
+         owner,
+         static_cast<unsigned long long>(requests),
+         static_cast<unsigned long long>(segmentPool.reusedSegments()),
+         static_cast<unsigned long long>(requests > 0 ? (segmentPool.reusedSegments() * 100) / requests : 0),
+         static_cast<unsigned long long>(segmentPool.trimmedSegments()),
+         static_cast<unsigned long long>(segmentPool.storedSegments()));
+      }
+   }
+
+bool
+JitBuilder::CompileThreadPool::isMethodBuilderActive(TR::MethodBuilder *methodBuilder)
+   {
+   for (int32_t i = 0; i < _numThreads; i++)
+      {
+      if (_threads[i]._activeMethodBuilder == methodBuilder)
+         return true;
+      }
+   return false;
+   }
+
+// Unlink and return the oldest queued request whose MethodBuilder is not being compiled, if any.
+// Caller must hold _monitor.
+JitBuilder::CompileRequest *
+JitBuilder::CompileThreadPool::nextRequest()
+   {
+   CompileRequest *previous = NULL;
+   for (CompileRequest *request = _queueHead; NULL != request; previous = request, request = request->_next)
+      {
+      if (!isMethodBuilderActive(request->_methodBuilder))
+         {
+         if (NULL == previous)
+            _queueHead = request->_next;
+         else
+            previous->_next = request->_next;
+         if (_queueTail == request)
+            _queueTail = previous;
+         request->_next = NULL;
+         return request;
+         }
+      }
+   return NULL;
+   }
+
+void
+JitBuilder::CompileThreadPool::run(CompileThread *compileThread)
+   {
+   // Scratch memory outlives each compilation so that later compiles on this thread
+   // reuse segments instead of going back to the system for every one of them
+   ScratchMemory scratchMemory(SCRATCH_SEGMENT_SIZE, SCRATCH_SEGMENT_CACHE_SIZE, TR::RawAllocator());
+   TR::SegmentProvider *scratchSegmentProvider =
+      TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging) ? NULL : &scratchMemory._segmentPool;
+
+   omrthread_monitor_enter(_monitor);
+   bool trimmed = true;
+   while (true)
+      {
+      CompileRequest *request = nextRequest();
+      if (NULL == request)
+         {
+         // Blocked requests are released by a compile finishing, so only stop once the queue is empty
+         if (_shuttingDown && (NULL == _queueHead))
+            break;
+         if (trimmed && _spareScratchMemoryTrimmed)
+            {
+            omrthread_monitor_wait(_monitor);
+            }
+         else if (J9THREAD_TIMED_OUT == omrthread_monitor_wait_timed(_monitor, SCRATCH_MEMORY_IDLE_TRIM_MILLIS, 0) && NULL == _queueHead)
+            {
+            // Nothing to compile for a while: give the cached scratch segments back
+            trimScratchMemory(scratchMemory);
+            trimmed = true;
+            }
+         continue;
+         }
+
+      trimmed = false;
+
+      compileThread->_activeMethodBuilder = request->_methodBuilder;
+      omrthread_monitor_exit(_monitor);
+
+      uint8_t *entry = NULL;
+      uint8_t *codeMemory = NULL;
+      int32_t rc = compileMethodBuilderWithScratchMemory(request->_methodBuilder, request->_hotness, &entry, scratchSegmentProvider, request->_publish ? NULL : &codeMemory);
+
+      omrthread_monitor_enter(_monitor);
+      compileThread->_activeMethodBuilder = NULL;
+      request->_entry = entry;
+      request->_codeMemory = codeMemory;
+      request->_rc = rc;
+      request->_complete = true;
+      omrthread_monitor_notify_all(_monitor);
+      }
+
+   reportScratchMemory("Compile thread", scratchMemory._segmentPool);
+   scratchMemory._segmentPool.trim();
+
+   _runningThreads -= 1;
+   omrthread_monitor_notify_all(_monitor);
+   omrthread_exit(_monitor);
+   }
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_COMPILETHREADPOOL_INCL
+#define JITBUILDER_COMPILETHREADPOOL_INCL
+
+#include <stdint.h>
+#include "omrthread.h"
+#include "compile/CompilationTypes.hpp"
+#include "env/RawAllocator.hpp"
+#include "env/SegmentPool.hpp"
+#include "env/SystemSegmentProvider.hpp"
+
+namespace TR { class MethodBuilder; }
+
+namespace JitBuilder
+{
+
+/**
+ * Attaches the calling thread to the OMR thread library for the lifetime of the object.
+ * Already-attached threads only have their attach count bumped.
+ */
+class ThreadAttachment
+   {
+public:
+   ThreadAttachment() : _self(NULL)
+      {
+      if (J9THREAD_SUCCESS != omrthread_attach_ex(&_self, J9THREAD_ATTR_DEFAULT))
+         _self = NULL;
+      }
+
+   ~ThreadAttachment()
+      {
+      if (NULL != _self)
+         omrthread_detach(_self);
+      }
+
+   bool isAttached() const { return NULL != _self; }
+
+private:
+   omrthread_t _self;
+   };
+
+/**
+ * @brief Handle for a MethodBuilder compilation queued on a CompileThreadPool.
+ *
+ * A request is created by CompileThreadPool::submit() and is released by
+ * CompileThreadPool::wait(); it must not be used after wait() returns.
+ */
+struct CompileRequest
+   {
+   TR::MethodBuilder *_methodBuilder; ///< builder to compile
+   TR_Hotness _hotness;               ///< optimization level to compile at
+   bool _publish;                     ///< install the body for callers (e.g. behind a tiered entry stub) as soon as it is compiled
+   uint8_t *_entry;                   ///< entry point of the compiled body, valid once _complete
+   uint8_t *_codeMemory;              ///< code cache allocation holding the body, valid once _complete
+   int32_t _rc;                       ///< compilation return code, valid once _complete
+   bool _complete;                    ///< set by the compiling thread when _entry and _rc are final
+   CompileRequest *_next;             ///< next request in the pending queue
+   };
+
+/**
+ * @brief Scratch memory kept warm across compilations: a bounded TR::SegmentPool over
+ * system segments. Each compile thread owns one; synchronous compiles borrow one from
+ * the pool with CompileThreadPool::acquireScratchMemory().
+ */
+struct ScratchMemory
+   {
+   ScratchMemory(size_t segmentSize, size_t cacheSize, TR::RawAllocator rawAllocator)
+      : _systemSegmentProvider(segmentSize, rawAllocator),
+        _segmentPool(_systemSegmentProvider, cacheSize, rawAllocator),
+        _next(NULL)
+      {
+      }
+
+   TR::SystemSegmentProvider _systemSegmentProvider;
+   TR::SegmentPool _segmentPool;
+   ScratchMemory *_next;              ///< next spare in the pool's list while not borrowed
+   };
+
+/**
+ * @brief A fixed set of compilation threads servicing asynchronous MethodBuilder compiles.
+ *
+ * Requests are serviced in submission order, except that a MethodBuilder is never compiled
+ * by two threads at once, since a builder holds the symbols of the compilation in progress.
+ * A request whose builder is busy is skipped until the compile using it completes.
+ * Builders sharing a TR::TypeDictionary are compiled concurrently: the dictionary only
+ * holds type definitions, while the symbol references created for struct and union fields
+ * are kept by the builder being compiled (see TR::MethodBuilder::fieldSymRefs()).
+ *
+ * Every compilation runs entirely on a pool thread, so its TR_Memory, scratch segment
+ * provider and TR::Compilation are private to that thread. Each thread keeps a bounded
+ * TR::SegmentPool of scratch segments alive across the compilations it performs, and
+ * reports its reuse rate under -Xjit:verbose={compilePerformance} when it stops. The pool
+ * also lends a bounded number of such segment pools to synchronous compiles. Cached
+ * segments are returned to the system once the pool has been idle for a while. Code cache
+ * reservation goes through TR::CodeCacheManager, which hands each concurrent
+ * compilation its own cache.
+ *
+ * Any thread may submit to or wait on the pool; threads not yet known to the OMR thread
+ * library are attached for the duration of the call.
+ */
+class CompileThreadPool
+   {
+public:
+   /**
+    * Create a pool and start its compilation threads.
+    * @param numThreads number of compilation threads to start (at least one)
+    * @return the new pool, or NULL if it could not be created
+    */
+   static CompileThreadPool *create(int32_t numThreads);
+
+   /**
+    * Wait for all queued compilations to finish, stop the compilation threads and free the pool.
+    * Callers should wait() for every request they submitted before the pool is destroyed.
+    */
+   void destroy();
+
+   /**
+    * Queue a MethodBuilder for compilation.
+    * @param hotness optimization level to compile the method at
+    * @param publish false if the submitter installs the compiled body itself, or frees it
+    *        with TR::CodeCacheManager::freeCodeMemory() if it decides not to use it
+    * @return a handle to pass to wait(), or NULL if the request could not be allocated
+    *         or the pool is shutting down
+    */
+   CompileRequest *submit(TR::MethodBuilder *methodBuilder, TR_Hotness hotness, bool publish = true);
+
+   /**
+    * Block until the given request has been compiled, then release it.
+    * @param[out] entry entry point of the compiled method (NULL on failure)
+    * @param[out] codeMemory if not NULL, the code cache allocation holding the compiled body
+    * @return the compilation return code
+    */
+   int32_t wait(CompileRequest *request, uint8_t **entry, uint8_t **codeMemory = NULL);
+
+   /**
+    * Borrow warm scratch memory for a compilation running on the calling thread.
+    * @return scratch memory to hand back with releaseScratchMemory(), or NULL if every
+    *         spare is lent out or scratch memory debugging is enabled; the caller then
+    *         uses scratch memory private to its compilation
+    */
+   ScratchMemory *acquireScratchMemory();
+
+   /**
+    * Return scratch memory obtained from acquireScratchMemory(), keeping its segments cached.
+    */
+   void releaseScratchMemory(ScratchMemory *scratchMemory);
+
+   int32_t numThreads() const { return _numThreads; }
+
+private:
+   struct CompileThread
+      {
+      CompileThreadPool *_pool;
+      TR::MethodBuilder *_activeMethodBuilder; ///< builder of the request being compiled, or NULL when idle
+      };
+
+   CompileThreadPool(omrthread_monitor_t monitor, CompileThread *threads, int32_t numThreads);
+
+   static int J9THREAD_PROC compileThreadEntry(void *arg);
+   void run(CompileThread *compileThread);
+   CompileRequest *nextRequest();
+   bool isMethodBuilderActive(TR::MethodBuilder *methodBuilder);
+   void trimScratchMemory(ScratchMemory &ownScratchMemory);
+   static void reportScratchMemory(const char *owner, TR::SegmentPool &segmentPool);
+
+   omrthread_monitor_t _monitor; ///< guards all fields below and signals queue and completion changes
+   CompileThread *_threads;
+   int32_t _numThreads;
+   int32_t _runningThreads;      ///< threads that have not yet exited
+   bool _shuttingDown;
+   CompileRequest *_queueHead;
+   CompileRequest *_queueTail;
+   ScratchMemory *_spareScratchMemory;  ///< scratch memory not lent to a synchronous compile
+   int32_t _scratchMemoryCount;         ///< scratch memory created for synchronous compiles
+   bool _spareScratchMemoryTrimmed;     ///< no spare has cached segments since the last idle trim
+   };
+
+} // namespace JitBuilder
+
+#endif // JITBUILDER_COMPILETHREADPOOL_INCL
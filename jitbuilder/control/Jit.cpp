@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2014, 2017 IBM Corp. and others
+ * Copyright (c) 2014, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -20,19 +20,24 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <new>
 #include <stdio.h>
 #include "codegen/CodeGenerator.hpp"
 #include "compile/CompilationTypes.hpp"
 #include "compile/Method.hpp"
 #include "control/CompileMethod.hpp"
+#include "control/CompileThreadPool.hpp"
+#include "control/TieredCompilation.hpp"
 #include "env/CompilerEnv.hpp"
 #include "env/FrontEnd.hpp"
 #include "env/IO.hpp"
+#include "env/CompilePhaseProfiler.hpp"
 #include "env/RawAllocator.hpp"
 #include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
 #include "ilgen/MethodBuilder.hpp"
 #include "ilgen/TypeDictionary.hpp"
 #include "runtime/CodeCache.hpp"
+#include "runtime/PersistentMethodCache.hpp"
 #include "runtime/Runtime.hpp"
 #include "runtime/JBJitConfig.hpp"
 
@@ -43,6 +48,12 @@
 extern TR_RuntimeHelperTable runtimeHelpers;
 extern void setupCodeCacheParameters(int32_t *, OMR::CodeCacheCodeGenCallbacks *callBacks, int32_t *numHelpers, int32_t *CCPreLoadedCodeSize);
 
+// Services compileMethodBuilderAsync(); sized by -Xjit:compilationThreads=<n>
+static JitBuilder::CompileThreadPool *compileThreadPool = NULL;
+
+// Recompiles tiered methods once they get hot; NULL where entry stubs are unsupported
+static JitBuilder::TieredCompilation *tieredCompilation = NULL;
+
 static void
 initHelper(void *helper, TR_RuntimeHelper id)
    {
@@ -146,6 +157,12 @@ initializeJitBuilder(TR_RuntimeHelper *helperIDs, void **helperAddresses, int32_
 
    initializeCodeCache(fe.codeCacheManager());
 
+   compileThreadPool = JitBuilder::CompileThreadPool::create(TR::Options::getNumUsableCompilationThreads());
+   if (NULL == compileThreadPool)
+      return false;
+
+   tieredCompilation = JitBuilder::TieredCompilation::create(compileThreadPool);
+
    return true;
    }
 
@@ -168,6 +185,8 @@ initializeJitBuilder(TR_RuntimeHelper *helperIDs, void **helperAddresses, int32_
 // An individual program should link statically against JitBuilder, then call:
 //     initializeJit() or initializeJitWithOptions() to initialize the Jit
 //     compileMethodBuilder() as many times as needed to create compiled code
+//       (or compileMethodBuilderAsync() followed by waitForMethodBuilderCompilation()
+//       to compile on the JIT's compilation threads, or compileMethodBuilders() for a batch)
 //     shuwdownJit() when the test is complete
 //
 
@@ -188,23 +207,170 @@ initializeJit()
    return initializeJitBuilder(0, 0, 0, (char *)"-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator");
    }
 
-extern "C"
+// Hotness of a method's first compilation: the fast tier and the first tier of
+// tiered compilation map onto the cold optimization strategy
+static TR_Hotness
+initialHotness(TR::MethodBuilder *m)
+   {
+   return (m->usesFastCompilation() || m->usesTieredCompilation()) ? cold : warm;
+   }
+
+// Hand out a counting entry stub for the first compilation of a tiered method
+static uint8_t *
+publishEntry(TR::MethodBuilder *m, TR_Hotness hotness, uint8_t *entry)
+   {
+   if (NULL != entry && hotness < hot && m->usesTieredCompilation() && NULL != tieredCompilation)
+      return tieredCompilation->install(m, entry);
+   return entry;
+   }
+
+// Compile with scratch memory from a caller supplied provider (e.g. a compile thread's
+// TR::SegmentPool), or from a provider private to this compilation if NULL. If codeMemory
+// is not NULL the body is not published: the caller receives its code cache allocation
+// and either publishes the entry point or frees the body.
 int32_t
-compileMethodBuilder(TR::MethodBuilder *m, uint8_t **entry)
+compileMethodBuilderWithScratchMemory(TR::MethodBuilder *m, TR_Hotness hotness, uint8_t **entry, TR::SegmentProvider *scratchSegmentProvider, uint8_t **codeMemory)
    {
    TR::ResolvedMethod resolvedMethod(m);
    TR::IlGeneratorMethodDetails details(&resolvedMethod);
 
+   TR_ASSERT(NULL == codeMemory || NULL != scratchSegmentProvider, "Unpublished compilations need a scratch segment provider");
+
    int32_t rc=0;
-   *entry = compileMethodFromDetails(NULL, details, warm, rc);
-   m->typeDictionary()->NotifyCompilationDone();
+   if (NULL != scratchSegmentProvider)
+      *entry = compileMethodFromDetails(NULL, details, hotness, rc, *scratchSegmentProvider, codeMemory);
+   else
+      *entry = compileMethodFromDetails(NULL, details, hotness, rc);
+
+   if (0 == rc && NULL == codeMemory)
+      *entry = publishEntry(m, hotness, *entry);
+
    return rc;
    }
 
+// Runs on the calling thread and may overlap compilations on the pool threads; only the
+// builder itself must not be compiled elsewhere at the same time (see Jit.hpp)
+extern "C"
+int32_t
+compileMethodBuilder(TR::MethodBuilder *m, uint8_t **entry)
+   {
+   // Borrow warm scratch memory from the compile thread pool rather than building up a
+   // fresh set of segments for every synchronous compile
+   JitBuilder::ScratchMemory *scratchMemory = NULL;
+   if (NULL != compileThreadPool)
+      scratchMemory = compileThreadPool->acquireScratchMemory();
+
+   int32_t rc = compileMethodBuilderWithScratchMemory(m, initialHotness(m), entry, NULL != scratchMemory ? &scratchMemory->_segmentPool : NULL, NULL);
+
+   if (NULL != scratchMemory)
+      compileThreadPool->releaseScratchMemory(scratchMemory);
+   return rc;
+   }
+
+extern "C"
+JitBuilder::CompileRequest *
+compileMethodBuilderAsync(TR::MethodBuilder *m)
+   {
+   if (NULL == compileThreadPool)
+      return NULL;
+   return compileThreadPool->submit(m, initialHotness(m));
+   }
+
+extern "C"
+int32_t
+waitForMethodBuilderCompilation(JitBuilder::CompileRequest *request, uint8_t **entry)
+   {
+   if (NULL == compileThreadPool || NULL == request)
+      {
+      *entry = NULL;
+      return COMPILATION_FAILED;
+      }
+   return compileThreadPool->wait(request, entry);
+   }
+
+extern "C"
+int32_t
+compileMethodBuilders(TR::MethodBuilder **methods, int32_t count, uint8_t **entries)
+   {
+   if (count <= 0)
+      return COMPILATION_SUCCEEDED;
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   JitBuilder::CompileRequest **requests = NULL;
+   if (NULL != compileThreadPool)
+      requests = static_cast<JitBuilder::CompileRequest **>(allocator.allocate(count * (sizeof(JitBuilder::CompileRequest *) + sizeof(uint8_t *)), std::nothrow));
+   if (NULL == requests)
+      {
+      for (int32_t i = 0; i < count; i++)
+         entries[i] = NULL;
+      return COMPILATION_FAILED;
+      }
+   uint8_t **codeMemory = reinterpret_cast<uint8_t **>(requests + count);
+
+   // Queue the whole batch before waiting so that every compilation thread has work.
+   // Bodies are not published as they complete: the batch is committed once all are done.
+   for (int32_t i = 0; i < count; i++)
+      requests[i] = compileThreadPool->submit(methods[i], initialHotness(methods[i]), false);
+
+   int32_t batchRC = COMPILATION_SUCCEEDED;
+   for (int32_t i = 0; i < count; i++)
+      {
+      int32_t rc = COMPILATION_FAILED;
+      entries[i] = NULL;
+      codeMemory[i] = NULL;
+      if (NULL != requests[i])
+         rc = compileThreadPool->wait(requests[i], &entries[i], &codeMemory[i]);
+      if (COMPILATION_SUCCEEDED == batchRC && COMPILATION_SUCCEEDED != rc)
+         batchRC = rc;
+      }
+   allocator.deallocate(requests);
+
+   // A batch is installed as a unit: if any method failed, the bodies that did compile are
+   // returned to the code cache and none of the entry points are handed out
+   for (int32_t i = 0; i < count; i++)
+      {
+      if (COMPILATION_SUCCEEDED == batchRC)
+         {
+         entries[i] = publishEntry(methods[i], initialHotness(methods[i]), entries[i]);
+         }
+      else
+         {
+         if (NULL != codeMemory[i])
+            JitBuilder::FrontEnd::instance()->codeCacheManager().freeCodeMemory(codeMemory[i]);
+         entries[i] = NULL;
+         }
+      }
+
+   return batchRC;
+   }
+
+extern "C"
+void
+retireMethodBuilder(TR::MethodBuilder *m)
+   {
+   if (NULL != tieredCompilation)
+      tieredCompilation->retire(m);
+   }
+
 extern "C"
 void
 shutdownJit()
    {
+   if (NULL != tieredCompilation)
+      {
+      tieredCompilation->destroy();
+      tieredCompilation = NULL;
+      }
+
+   if (NULL != compileThreadPool)
+      {
+      compileThreadPool->destroy();
+      compileThreadPool = NULL;
+      }
+
+   TR::CompilePhaseProfile::shutdown();
+   TR::PersistentMethodCache::shutdown();
+
    auto fe = JitBuilder::FrontEnd::instance();
 
    TR::CodeCacheManager &codeCacheManager = fe->codeCacheManager();
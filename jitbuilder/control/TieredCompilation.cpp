@@ -0,0 +1,321 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "control/TieredCompilation.hpp"
+
+#include <new>
+#include <stddef.h>
+#include <string.h>
+#include "AtomicSupport.hpp"
+#include "control/CompileThreadPool.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/VerboseLog.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "infra/Assert.hpp"
+#include "runtime/CodeCache.hpp"
+#include "runtime/CodeCacheManager.hpp"
+
+#define SAMPLER_THREAD_STACK_SIZE (256 * 1024)
+
+/**
+ * Code cache resident entry point of a tiered method:
+ *
+ *    inc dword ptr [rip + _invocations]
+ *    jmp qword ptr [rip + _target]
+ *
+ * Callers never see the compiled body's address, so redirecting them only
+ * takes an aligned store to _target.
+ */
+struct JitBuilder::TieredCompilation::EntryStub
+   {
+   uint8_t _code[16];
+   uint8_t * volatile _target;
+   volatile uint32_t _invocations; ///< not updated atomically; only compared against the threshold
+   uint32_t _padding;
+   };
+
+JitBuilder::TieredCompilation::TieredCompilation(omrthread_monitor_t monitor, CompileThreadPool *compileThreadPool, uint32_t threshold, int64_t sampleInterval)
+   : _monitor(monitor),
+     _compileThreadPool(compileThreadPool),
+     _threshold(threshold),
+     _sampleInterval(sampleInterval),
+     _samplerRunning(false),
+     _shuttingDown(false),
+     _recompiling(false),
+     _recompiledMethods(0),
+     _methods(NULL)
+   {
+   }
+
+JitBuilder::TieredCompilation *
+JitBuilder::TieredCompilation::create(CompileThreadPool *compileThreadPool)
+   {
+#if defined(TR_HOST_X86) && defined(TR_HOST_64BIT)
+   ThreadAttachment attachment;
+   if (!attachment.isAttached())
+      return NULL;
+
+   int32_t threshold = TR::Options::getTieredCompilationThreshold();
+   int32_t sampleInterval = TR::Options::getTieredCompilationSampleInterval();
+
+   omrthread_monitor_t monitor = NULL;
+   if (0 != omrthread_monitor_init_with_name(&monitor, 0, "JIT-TieredCompilationMonitor"))
+      return NULL;
+
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   TieredCompilation *tiered = new (allocator, std::nothrow) TieredCompilation(
+      monitor,
+      compileThreadPool,
+      threshold > 0 ? threshold : 1,
+      sampleInterval > 0 ? sampleInterval : 1);
+   if (NULL == tiered)
+      {
+      omrthread_monitor_destroy(monitor);
+      return NULL;
+      }
+
+   tiered->_samplerRunning = true;
+   omrthread_t handle = NULL;
+   if (J9THREAD_SUCCESS != omrthread_create(&handle, SAMPLER_THREAD_STACK_SIZE, J9THREAD_PRIORITY_NORMAL, 0, samplerThreadEntry, tiered))
+      {
+      tiered->_samplerRunning = false;
+      tiered->destroy();
+      return NULL;
+      }
+
+   return tiered;
+#else
+   return NULL;
+#endif
+   }
+
+void
+JitBuilder::TieredCompilation::destroy()
+   {
+   ThreadAttachment attachment;
+   TR_ASSERT_FATAL(attachment.isAttached(), "Failed to attach to the thread library");
+
+   omrthread_monitor_enter(_monitor);
+   _shuttingDown = true;
+   omrthread_monitor_notify_all(_monitor);
+   while (_samplerRunning)
+      omrthread_monitor_wait(_monitor);
+   omrthread_monitor_exit(_monitor);
+
+   if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerbosePerformance))
+      {
+      TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Tiered compilation: %d methods recompiled at hot", _recompiledMethods);
+      }
+
+   // The stubs live in the code cache and go away with it
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   TieredMethod *method = _methods;
+   while (NULL != method)
+      {
+      TieredMethod *next = method->_next;
+      allocator.deallocate(method);
+      method = next;
+      }
+
+   omrthread_monitor_destroy(_monitor);
+   this->~TieredCompilation();
+   allocator.deallocate(this);
+   }
+
+JitBuilder::TieredCompilation::EntryStub *
+JitBuilder::TieredCompilation::allocateStub(uint8_t *target)
+   {
+   TR::CodeCacheManager *manager = TR::CodeCacheManager::instance();
+   int32_t numReserved = 0;
+   TR::CodeCache *codeCache = manager->reserveCodeCache(false, sizeof(EntryStub), 0, &numReserved);
+   if (NULL == codeCache)
+      return NULL;
+
+   uint8_t *coldCode = NULL;
+   uint8_t *memory = manager->allocateCodeMemory(sizeof(EntryStub), 0, &codeCache, &coldCode, false, false);
+   if (NULL != codeCache)
+      manager->unreserveCodeCache(codeCache);
+   if (NULL == memory)
+      return NULL;
+
+   EntryStub *stub = reinterpret_cast<EntryStub *>(memory);
+   TR_ASSERT_FATAL(0 == (reinterpret_cast<uintptr_t>(&stub->_target) & (sizeof(stub->_target) - 1)), "Entry stub target slot must be aligned to be patched atomically");
+   static const uint8_t code[sizeof(stub->_code)] =
+      {
+      0xFF, 0x05, offsetof(EntryStub, _invocations) - 6, 0x00, 0x00, 0x00, // inc dword ptr [rip + _invocations]
+      0xFF, 0x25, offsetof(EntryStub, _target) - 12, 0x00, 0x00, 0x00,      // jmp qword ptr [rip + _target]
+      0xCC, 0xCC, 0xCC, 0xCC
+      };
+   stub->_target = target;
+   stub->_invocations = 0;
+   stub->_padding = 0;
+   memcpy(stub->_code, code, sizeof(code));
+   return stub;
+   }
+
+uint8_t *
+JitBuilder::TieredCompilation::install(TR::MethodBuilder *methodBuilder, uint8_t *startPC)
+   {
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   TieredMethod *method = static_cast<TieredMethod *>(allocator.allocate(sizeof(TieredMethod), std::nothrow));
+   if (NULL == method)
+      return startPC;
+
+   EntryStub *stub = allocateStub(startPC);
+   if (NULL == stub)
+      {
+      allocator.deallocate(method);
+      return startPC;
+      }
+
+   method->_methodBuilder = methodBuilder;
+   method->_stub = stub;
+   method->_request = NULL;
+   method->_done = false;
+
+   // Compile threads install without holding any lock, so push with a CAS;
+   // the sampler only ever walks the list from a snapshot of its head
+   uintptr_t head;
+   do {
+      head = reinterpret_cast<uintptr_t>(_methods);
+      method->_next = reinterpret_cast<TieredMethod *>(head);
+      } while (head != VM_AtomicSupport::lockCompareExchange(reinterpret_cast<volatile uintptr_t *>(&_methods), head, reinterpret_cast<uintptr_t>(method)));
+
+   return stub->_code;
+   }
+
+void
+JitBuilder::TieredCompilation::retire(TR::MethodBuilder *methodBuilder)
+   {
+   ThreadAttachment attachment;
+   TR_ASSERT_FATAL(attachment.isAttached(), "Failed to attach to the thread library");
+
+   omrthread_monitor_enter(_monitor);
+   // The sampler only submits methods that are not done, and only while holding _monitor
+   for (TieredMethod *method = _methods; NULL != method; method = method->_next)
+      {
+      if (method->_methodBuilder == methodBuilder)
+         method->_done = true;
+      }
+   // A recompilation already queued still uses the builder until sample() has collected it
+   while (_recompiling)
+      omrthread_monitor_wait(_monitor);
+   for (TieredMethod *method = _methods; NULL != method; method = method->_next)
+      {
+      if (method->_methodBuilder == methodBuilder)
+         method->_methodBuilder = NULL;
+      }
+   omrthread_monitor_exit(_monitor);
+   }
+
+int32_t
+JitBuilder::TieredCompilation::recompiledMethods()
+   {
+   ThreadAttachment attachment;
+   TR_ASSERT_FATAL(attachment.isAttached(), "Failed to attach to the thread library");
+
+   omrthread_monitor_enter(_monitor);
+   int32_t recompiled = _recompiledMethods;
+   omrthread_monitor_exit(_monitor);
+   return recompiled;
+   }
+
+int J9THREAD_PROC
+JitBuilder::TieredCompilation::samplerThreadEntry(void *arg)
+   {
+   TieredCompilation *tiered = static_cast<TieredCompilation *>(arg);
+
+   omrthread_monitor_enter(tiered->_monitor);
+   while (!tiered->_shuttingDown)
+      {
+      omrthread_monitor_wait_timed(tiered->_monitor, tiered->_sampleInterval, 0);
+      if (!tiered->_shuttingDown)
+         tiered->sample();
+      }
+   tiered->_samplerRunning = false;
+   omrthread_monitor_notify_all(tiered->_monitor);
+   omrthread_exit(tiered->_monitor);
+   return 0;
+   }
+
+// Queue every method that crossed the threshold, then patch each stub as its hot body
+// arrives. Called with _monitor held; releases it while waiting for the compilations so
+// that compile threads can keep installing new methods.
+void
+JitBuilder::TieredCompilation::sample()
+   {
+   TieredMethod *methods = _methods;
+   bool queued = false;
+   for (TieredMethod *method = methods; NULL != method; method = method->_next)
+      {
+      if (method->_done || method->_stub->_invocations < _threshold)
+         continue;
+
+      method->_request = _compileThreadPool->submit(method->_methodBuilder, hot);
+      if (NULL == method->_request)
+         method->_done = true;
+      else
+         queued = true;
+      }
+
+   if (!queued)
+      return;
+
+   _recompiling = true;
+   omrthread_monitor_exit(_monitor);
+
+   int32_t recompiled = 0;
+   for (TieredMethod *method = methods; NULL != method; method = method->_next)
+      {
+      if (NULL == method->_request)
+         continue;
+
+      uint8_t *entry = NULL;
+      int32_t rc = _compileThreadPool->wait(method->_request, &entry);
+      method->_request = NULL;
+      method->_done = true;
+      if (0 != rc || NULL == entry)
+         continue;
+
+      // Make the new body visible before any caller can jump to it
+      VM_AtomicSupport::writeBarrier();
+      method->_stub->_target = entry;
+      recompiled++;
+
+      if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerbosePerformance))
+         {
+         TR_VerboseLog::writeLineLocked(
+            TR_Vlog_PERF,
+            "Tiered compilation: recompiled %s at hot after %u invocations, entry %p",
+            method->_methodBuilder->getMethodName(),
+            method->_stub->_invocations,
+            entry);
+         }
+      }
+
+   omrthread_monitor_enter(_monitor);
+   _recompiledMethods += recompiled;
+   _recompiling = false;
+   omrthread_monitor_notify_all(_monitor);
+   }
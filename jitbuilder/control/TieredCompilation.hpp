@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_TIEREDCOMPILATION_INCL
+#define JITBUILDER_TIEREDCOMPILATION_INCL
+
+#include <stdint.h>
+#include "omrthread.h"
+
+namespace TR { class MethodBuilder; }
+
+namespace JitBuilder
+{
+
+class CompileThreadPool;
+struct CompileRequest;
+
+/**
+ * @brief Recompiles frequently invoked MethodBuilders at hot.
+ *
+ * A method that uses tiered compilation (TR::MethodBuilder::setUseTieredCompilation()) is
+ * first compiled at cold. Its callers are handed the address of a small entry stub in the
+ * code cache rather than the compiled body; the stub bumps an invocation counter and jumps
+ * through a patchable target slot. A sampling thread wakes every
+ * -Xjit:tieredCompilationSampleInterval milliseconds, queues every method whose counter has
+ * reached -Xjit:tieredCompilationThreshold on the CompileThreadPool at hot, and once the new
+ * body is ready stores its address into the stub, so existing callers move to it on their
+ * next call. The cold body stays in the code cache for threads still running it.
+ * JitBuilder has no separate hot optimization strategy: hot maps onto the warm strategy
+ * (see JitBuilder::Optimizer), so the recompilation moves a method from the cold to the
+ * full warm set of optimizations.
+ *
+ * The manager keeps a pointer to each installed MethodBuilder for its recompilation. A
+ * builder that is destroyed before the JIT shuts down must first be retired with retire().
+ *
+ * Entry stubs are only implemented for x86-64; elsewhere create() returns NULL and tiered
+ * methods are compiled once, like any other method.
+ */
+class TieredCompilation
+   {
+public:
+   /**
+    * Create the tiered compilation manager and start its sampling thread.
+    * @param compileThreadPool pool that performs the hot recompilations
+    * @return the new manager, or NULL if tiered compilation is unsupported or could not be started
+    */
+   static TieredCompilation *create(CompileThreadPool *compileThreadPool);
+
+   /**
+    * Stop the sampling thread, wait for any recompilation in progress and free the manager.
+    * Must be called before the CompileThreadPool is destroyed.
+    */
+   void destroy();
+
+   /**
+    * Route calls to a freshly compiled tiered method through a counting entry stub.
+    * @param methodBuilder builder that produced startPC; recompiled once the method gets hot
+    * @param startPC entry point of the cold body
+    * @return the stub's entry point, or startPC if no stub could be allocated
+    */
+   uint8_t *install(TR::MethodBuilder *methodBuilder, uint8_t *startPC);
+
+   /**
+    * Stop sampling the methods compiled from a builder, waiting for a recompilation of
+    * theirs that is already in progress. Entry points handed out for them stay valid and
+    * keep running the body they currently point at; afterwards the builder may be destroyed.
+    */
+   void retire(TR::MethodBuilder *methodBuilder);
+
+   /**
+    * @return number of methods recompiled at hot and patched so far
+    */
+   int32_t recompiledMethods();
+
+private:
+   struct EntryStub;
+
+   struct TieredMethod
+      {
+      TR::MethodBuilder *_methodBuilder; ///< NULL once retired
+      EntryStub *_stub;
+      CompileRequest *_request; ///< hot recompilation in progress, or NULL
+      bool _done;               ///< recompiled (or recompilation failed); no longer sampled
+      TieredMethod *_next;
+      };
+
+   TieredCompilation(omrthread_monitor_t monitor, CompileThreadPool *compileThreadPool, uint32_t threshold, int64_t sampleInterval);
+
+   static int J9THREAD_PROC samplerThreadEntry(void *arg);
+   void sample();
+   static EntryStub *allocateStub(uint8_t *target);
+
+   omrthread_monitor_t _monitor;           ///< guards the fields below and signals shutdown
+   CompileThreadPool *_compileThreadPool;
+   uint32_t _threshold;                    ///< invocations before a method is recompiled
+   int64_t _sampleInterval;                ///< milliseconds between scans of the counters
+   bool _samplerRunning;
+   bool _shuttingDown;
+   bool _recompiling;                      ///< sample() is waiting for queued recompilations
+   int32_t _recompiledMethods;
+   TieredMethod *_methods;
+   };
+
+} // namespace JitBuilder
+
+#endif // JITBUILDER_TIEREDCOMPILATION_INCL
@@ -101,6 +101,7 @@ static const OptimizationStrategy JBcoldStrategyOpts[] =
    { OMR::localCSE                                                                 },
    { OMR::basicBlockExtension                                                      },
    { OMR::cheapTacticalGlobalRegisterAllocatorGroup                                },
+   { OMR::endOpts                                                                  },
    };
 
 static const OptimizationStrategy JBwarmStrategyOpts[] =
@@ -209,8 +210,10 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
 
 
    omrCompilationStrategies[noOpt] = JBwarmStrategyOpts;
-   omrCompilationStrategies[cold]  = JBwarmStrategyOpts;
+   omrCompilationStrategies[cold]  = JBcoldStrategyOpts;
    omrCompilationStrategies[warm]  = JBwarmStrategyOpts;
+   // There is no separate hot strategy yet: tiered recompilations at hot get the full
+   // warm strategy, which is what distinguishes them from the cold first compile
    omrCompilationStrategies[hot]   = JBwarmStrategyOpts;
 
    }
@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright (c) 2016, 2016 IBM Corp. and others
+ * Copyright (c) 2016, 2018 IBM Corp. and others
  *
  * This program and the accompanying materials are made available under
  * the terms of the Eclipse Public License 2.0 which accompanies this
@@ -23,8 +23,36 @@
 #include <stdint.h>
 
 namespace TR { class MethodBuilder; }
+namespace JitBuilder { struct CompileRequest; }
 class TR_Memory;
 
 extern "C" bool initializeJit();
+extern "C" bool initializeJitWithOptions(char *options);
+// Compile a MethodBuilder on the calling thread. Any number of threads may call this
+// while the compilation threads are busy, but a builder must not be passed here while
+// it is queued for an asynchronous compile, nor again once it has been compiled as a
+// tiered method (its recompilation runs on a compilation thread at any time).
 extern "C" uint32_t compileMethodBuilder(TR::MethodBuilder *m, uint8_t **entry);
+
+// Queue a MethodBuilder for compilation on one of the JIT's compilation threads
+// (-Xjit:compilationThreads=<n>, default 1). Returns NULL if the request could not be queued,
+// including before initializeJit() and after shutdownJit().
+// Builders sharing a TypeDictionary may be compiled at the same time.
+extern "C" JitBuilder::CompileRequest *compileMethodBuilderAsync(TR::MethodBuilder *m);
+
+// Block until an asynchronous compilation completes; releases the request and returns
+// the same code compileMethodBuilder() would have.
+extern "C" int32_t waitForMethodBuilderCompilation(JitBuilder::CompileRequest *request, uint8_t **entry);
+
+// Compile a batch of MethodBuilders in parallel on the JIT's compilation threads and
+// wait for all of them. entries[i] receives the entry point for methods[i]; the entries
+// are only filled in once every method in the batch has compiled, and all are NULL if
+// any of them failed. Returns 0 or the return code of the first failing method.
+extern "C" int32_t compileMethodBuilders(TR::MethodBuilder **methods, int32_t count, uint8_t **entries);
+
+// Stop recompiling the tiered methods compiled from a MethodBuilder so that the builder can
+// be destroyed before shutdownJit(). Waits for a recompilation already in progress; entry
+// points handed out for the builder stay valid.
+extern "C" void retireMethodBuilder(TR::MethodBuilder *m);
+
 extern "C" void shutdownJit();
@@ -0,0 +1,228 @@
+/*******************************************************************************
+ * Copyright (c) 2018, 2018 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+
+#include "Jit.hpp"
+#include "ilgen/TypeDictionary.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "IterativeFib.hpp"
+#include "NestedLoop.hpp"
+#include "CompilationTiers.hpp"
+
+// Compiles a few sample methods (the IterativeFib and NestedLoop samples, which
+// are linked in without their main(), and a straight line expression) at the
+// default (warm) tier and at the fast tier, reporting average compile time and the time taken to run each
+// compiled body so the two tiers can be compared.
+
+#define COMPILES_PER_TIER 10
+
+static int32_t
+referenceFib(int32_t n)
+   {
+   if (n < 2)
+      return n;
+   uint32_t lastSum = 0, sum = 1;
+   for (int32_t i = 1; i < n; i++)
+      {
+      uint32_t tempSum = sum + lastSum;
+      lastSum = sum;
+      sum = tempSum;
+      }
+   return (int32_t)sum;
+   }
+
+static int32_t
+referenceNestedLoop(int32_t n)
+   {
+   // six nested loops of n iterations each increment x once per innermost iteration
+   uint32_t x = 0;
+   if (n > 0)
+      {
+      x = 1;
+      for (int32_t level = 0; level < 6; level++)
+         x *= (uint32_t)n;
+      }
+   return (int32_t)x;
+   }
+
+TierPolynomialMethod::TierPolynomialMethod(TR::TypeDictionary *types)
+   : MethodBuilder(types)
+   {
+   DefineLine(LINETOSTR(__LINE__));
+   DefineFile(__FILE__);
+
+   DefineName("tier_polynomial");
+   DefineParameter("n", Int32);
+   DefineReturnType(Int32);
+   }
+
+bool
+TierPolynomialMethod::buildIL()
+   {
+   // ((3n + 5)n - 7)n + 11, mixed with n >> 3
+   Store("p",
+      Add(
+         Mul(
+            Sub(
+               Mul(
+                  Add(
+                     Mul(
+                        ConstInt32(3),
+                        Load("n")),
+                     ConstInt32(5)),
+                  Load("n")),
+               ConstInt32(7)),
+            Load("n")),
+         ConstInt32(11)));
+
+   Return(
+      Xor(
+         Load("p"),
+         ShiftR(
+            Load("n"),
+            ConstInt32(3))));
+
+   return true;
+   }
+
+static int32_t
+referencePolynomial(int32_t n)
+   {
+   uint32_t un = (uint32_t)n;
+   uint32_t p = ((3 * un + 5) * un - 7) * un + 11;
+   return (int32_t)(p ^ (uint32_t)(n >> 3));
+   }
+
+typedef TR::MethodBuilder *(CreateBuilderFunctionType)(TR::TypeDictionary *types);
+typedef int32_t (ReferenceFunctionType)(int32_t);
+
+template <class Builder>
+static TR::MethodBuilder *
+createBuilder(TR::TypeDictionary *types)
+   {
+   return new Builder(types);
+   }
+
+struct TierBenchmark
+   {
+   const char *name;
+   CreateBuilderFunctionType *create;
+   ReferenceFunctionType *reference;
+   int32_t argument;
+   int32_t invocations;
+   };
+
+static TierBenchmark benchmarks[] =
+   {
+   { "iterfib",    createBuilder<IterativeFibonacciMethod>, referenceFib,        40, 1000000  },
+   { "nestedloop", createBuilder<NestedLoopMethod>,         referenceNestedLoop, 16, 20       },
+   { "polynomial", createBuilder<TierPolynomialMethod>,     referencePolynomial, 12, 10000000 },
+   };
+
+static const int32_t numBenchmarks = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+static double
+microsecondsSince(std::chrono::steady_clock::time_point start)
+   {
+   return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+   }
+
+// Returns false if compilation fails or the compiled body computes the wrong answer
+static bool
+runBenchmark(TierBenchmark *benchmark, bool fastTier)
+   {
+   TR::TypeDictionary types;
+   TierFunctionType *function = NULL;
+   double compileMicros = 0.0;
+
+   for (int32_t i = 0; i < COMPILES_PER_TIER; i++)
+      {
+      TR::MethodBuilder *builder = benchmark->create(&types);
+      if (fastTier)
+         builder->setUseFastCompilation();
+
+      uint8_t *entry = 0;
+      auto start = std::chrono::steady_clock::now();
+      int32_t rc = compileMethodBuilder(builder, &entry);
+      compileMicros += microsecondsSince(start);
+      delete builder;
+
+      if (rc != 0)
+         {
+         fprintf(stderr, "FAIL: compilation error %d for %s\n", rc, benchmark->name);
+         return false;
+         }
+      function = (TierFunctionType *)entry;
+      }
+
+   // alternate between two arguments so the calls cannot be folded away
+   int32_t expected[2] = { benchmark->reference(benchmark->argument), benchmark->reference(benchmark->argument + 1) };
+   int32_t mismatch = 0;
+   auto start = std::chrono::steady_clock::now();
+   for (int32_t i = 0; i < benchmark->invocations; i++)
+      mismatch |= function(benchmark->argument + (i & 1)) ^ expected[i & 1];
+   double runMicros = microsecondsSince(start);
+
+   printf("%-12s %-5s %12.1f %12.1f\n",
+          benchmark->name, fastTier ? "fast" : "warm",
+          compileMicros / COMPILES_PER_TIER, runMicros);
+
+   if (mismatch != 0)
+      {
+      fprintf(stderr, "FAIL: %s computed a wrong result at the %s tier\n", benchmark->name, fastTier ? "fast" : "warm");
+      return false;
+      }
+   return true;
+   }
+
+int
+main(int argc, char *argv[])
+   {
+   printf("Step 1: initialize JIT\n");
+   bool initialized = initializeJit();
+   if (!initialized)
+      {
+      fprintf(stderr, "FAIL: could not initialize JIT\n");
+      exit(-1);
+      }
+
+   printf("Step 2: compile and run each method at the warm and fast tiers\n");
+   printf("%-12s %-5s %12s %12s\n", "method", "tier", "compile(us)", "run(us)");
+   for (int32_t b = 0; b < numBenchmarks; b++)
+      {
+      if (!runBenchmark(&benchmarks[b], false) || !runBenchmark(&benchmarks[b], true))
+         {
+         shutdownJit();
+         exit(-2);
+         }
+      }
+
+   printf("Step 3: shutdown JIT\n");
+   shutdownJit();
+
+   printf("PASS\n");
+   }
@@ -82,6 +82,7 @@ IterativeFibonacciMethod::buildIL()
    }
 
 
+#if !defined(NO_SAMPLE_MAIN)
 int
 main(int argc, char *argv[])
    {
@@ -116,3 +117,4 @@ main(int argc, char *argv[])
 
    printf("PASS\n");
    }
+#endif // !defined(NO_SAMPLE_MAIN)
@@ -95,6 +95,7 @@ NestedLoopMethod::buildIL()
    }
 
 
+#if !defined(NO_SAMPLE_MAIN)
 int
 main(int argc, char *argv[])
    {
@@ -129,3 +130,4 @@ main(int argc, char *argv[])
 
    printf("PASS\n");
    }
+#endif // !defined(NO_SAMPLE_MAIN)
@@ -67,6 +67,15 @@ if test "x$BUILD_WITH_CMAKE" = "xyes"; then
     if test "x$RUN_TESTS" != "xno"; then
       time ctest -V
     fi
+    if test "x$RUN_POINTER_GRAPH_COMPARISON" = "xyes"; then
+      # Build the gctest of a full reference configuration next to this compressed one, and compare them
+      mkdir ../build-full
+      cd ../build-full
+      time cmake -Wdev -G "$CMAKE_GENERATOR" $CMAKE_DEFINES -DOMR_GC_COMPRESSED_POINTERS=OFF -DOMR_INTERP_COMPRESSED_OBJECT_HEADER=OFF -C../cmake/caches/Travis.cmake ..
+      time cmake --build . --target omrgctest -- -j $BUILD_JOBS
+      cd ../build
+      time bash ../scripts/compare-pointer-graph.sh ../build-full .
+    fi
   fi
 else
   # Cross Compile Toolchain and Configuration Options for AArch64
@@ -75,8 +84,8 @@ else
   elif test $SPEC = "linux_arm"; then
     get_cc_toolchain ${ARM_TOOLCHAIN_URL}
   else
-    # Linux 64 compressed references build and the 	Lint builds do not run in CMake
-    # Remove the Linux 64 compressed references build once the Autotool build infrastructure is retired
+    # Lint builds do not run in CMake. The Linux 64 compressed references build is also covered by a
+    # CMake build; remove the Autotool one once the Autotool build infrastructure is retired
     export EXTRA_CONFIGURE_ARGS="--enable-DDR"
   fi
 
@@ -0,0 +1,75 @@
+#!/bin/bash
+###############################################################################
+# Copyright (c) 2018, 2018 IBM Corp. and others
+#
+# This program and the accompanying materials are made available under
+# the terms of the Eclipse Public License 2.0 which accompanies this
+# distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+# or the Apache License, Version 2.0 which accompanies this distribution and
+# is available at https://www.apache.org/licenses/LICENSE-2.0.
+#
+# This Source Code may also be made available under the following
+# Secondary Licenses when the conditions for such availability set
+# forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+# General Public License, version 2 with the GNU Classpath
+# Exception [1] and GNU General Public License, version 2 with the
+# OpenJDK Assembly Exception [2].
+#
+# [1] https://www.gnu.org/software/classpath/license.html
+# [2] http://openjdk.java.net/legal/assembly-exception.html
+#
+# SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+###############################################################################
+
+# Run perftest/gctest/configuration/pointer_graph_config.xml with the omrgctest of a full reference
+# build and of a compressed reference build, and compare the footprint and traversal time of the graph.
+# Fails if the compressed build does not shrink the graph.
+#
+# usage: compare-pointer-graph.sh <full reference build dir> <compressed reference build dir>
+
+set -e
+
+if test $# -ne 2; then
+  echo "usage: $0 <full reference build dir> <compressed reference build dir>"
+  exit 1
+fi
+
+# pointer_graph_config.xml is perfTests[2] in fvtest/gctest/GCConfigTest.cpp
+POINTER_GRAPH_TEST="perfTest/GCConfigTest.test/2"
+
+FULL_BUILD_DIR=$(cd "$1" && pwd)
+COMPRESSED_BUILD_DIR=$(cd "$2" && pwd)
+
+# the gctest configuration paths are relative to the source root
+cd "$(dirname "$0")/.."
+
+function run_pointer_graph
+{
+  BUILD_DIR=$1
+  OUTPUT=$("$BUILD_DIR/fvtest/gctest/omrgctest" --gtest_filter=$POINTER_GRAPH_TEST -logLevel=info 2>&1)
+  echo "$OUTPUT" | grep -E "Reference slot size|Time elapsed in gc|Graph traversal" >&2
+  echo "$OUTPUT" | grep "Graph traversal:" | tail -1
+}
+
+FULL=$(run_pointer_graph "$FULL_BUILD_DIR")
+COMPRESSED=$(run_pointer_graph "$COMPRESSED_BUILD_DIR")
+if test "x$FULL" = "x" || test "x$COMPRESSED" = "x"; then
+  echo "$POINTER_GRAPH_TEST did not report a graph traversal"
+  exit 1
+fi
+
+# Graph traversal: <objects> objects, <references> references, <bytes> bytes (<n> bytes/object), <ns> ns/reference ...
+FULL_BYTES=$(echo "$FULL" | sed -e 's/.* references, \([0-9]*\) bytes .*/\1/')
+FULL_NANOS=$(echo "$FULL" | sed -e 's/.* \([0-9]*\) ns\/reference.*/\1/')
+COMPRESSED_BYTES=$(echo "$COMPRESSED" | sed -e 's/.* references, \([0-9]*\) bytes .*/\1/')
+COMPRESSED_NANOS=$(echo "$COMPRESSED" | sed -e 's/.* \([0-9]*\) ns\/reference.*/\1/')
+
+echo "                      graph bytes  ns/reference"
+printf "full references      %12s  %12s\n" $FULL_BYTES $FULL_NANOS
+printf "compressed references%12s  %12s\n" $COMPRESSED_BYTES $COMPRESSED_NANOS
+echo "compressed footprint: $((COMPRESSED_BYTES * 100 / FULL_BYTES))% of full"
+
+if test $COMPRESSED_BYTES -ge $FULL_BYTES; then
+  echo "Compressed references did not reduce the pointer graph footprint"
+  exit 1
+fi